@@ -0,0 +1,348 @@
+#include "api/ChessEngine.h"
+
+#include "core/engine/search/PVSEngine.h"
+#include "core/utils/MoveNotations.h"
+#include "uci/Options.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+#if not defined(DISABLE_THREADS)
+    #include <thread>
+#endif
+
+static_assert(sizeof(PackedBoard) == CE_PACKED_BOARD_SIZE);
+
+/**
+ * @brief Die Bibliothek enthält keine UCI-Schleife, die Engine liest aber
+ * einige Einstellungen aus den UCI-Optionen. Sie werden hier mit ihren
+ * Standardwerten definiert und nie verändert. Threads und MultiPV
+ * werden pro Engine gesetzt (siehe CESearchLimits).
+ */
+UCI::Options UCI::options = {
+    UCI::Option("Threads", "1", "1", "512"),
+    UCI::Option("MultiPV", "1", "1", "256"),
+    UCI::Option("Move Overhead", "0", "0", "5000"),
+    UCI::Option("Ponder", "false")
+};
+
+struct CEEngine {
+    Board board;
+    PVSEngine engine;
+    std::string error;
+
+    #if not defined(DISABLE_THREADS)
+        std::thread searchThread;
+    #endif
+
+    /**
+     * @brief Gibt an, ob eine Suche läuft bzw. eine mit
+     * ceStartSearch gestartete Suche noch nicht abgeholt wurde.
+     */
+    AtomicBool busy = false;
+
+    /**
+     * @brief Wird bei jedem Checkup überprüft, damit ein Abbruch vor
+     * dem eigentlichen Start der Suche nicht verloren geht.
+     */
+    AtomicBool stopRequested = false;
+
+    CESearchCallback onIteration = nullptr;
+    void* userData = nullptr;
+    int lastIterationDepth = 0;
+
+    CEEngine() : engine(board, 2, nullptr, false) {}
+};
+
+namespace {
+    void fillResult(CEEngine* handle, CESearchResult* result) {
+        PVSEngine& engine = handle->engine;
+        std::vector<Variation> variations = engine.getVariations();
+
+        std::memset(result, 0, sizeof(CESearchResult));
+        result->depth = engine.getMaxDepthReached();
+        result->nodes = engine.getNodesSearched();
+        result->time = engine.getElapsedTime();
+        result->numVariations = std::min(variations.size(), (size_t)CE_MAX_VARIATIONS);
+
+        for(uint32_t i = 0; i < result->numVariations; i++) {
+            const Variation& variation = variations[i];
+            CEVariation& ceVariation = result->variations[i];
+
+            ceVariation.score = variation.score;
+            if(isMateScore(variation.score))
+                ceVariation.mate = variation.score > 0 ? isMateIn(variation.score) : -isMateIn(variation.score);
+
+            ceVariation.depth = variation.depth;
+            ceVariation.selectiveDepth = variation.selectiveDepth;
+            ceVariation.length = std::min(variation.moves.size(), (size_t)CE_MAX_PV_LENGTH);
+
+            for(uint32_t j = 0; j < ceVariation.length; j++)
+                ceVariation.moves[j] = variation.moves[j].getMove();
+        }
+
+        if(result->numVariations > 0 && result->variations[0].length > 0) {
+            result->bestMove = result->variations[0].moves[0];
+
+            if(result->variations[0].length > 1)
+                result->ponderMove = result->variations[0].moves[1];
+        }
+    }
+
+    /**
+     * @brief Wird von der Suche in regelmäßigen Abständen auf dem Suchthread aufgerufen.
+     */
+    void checkup(CEEngine* handle) {
+        if(handle->stopRequested.load())
+            handle->engine.stop();
+
+        int depth = handle->engine.getMaxDepthReached();
+        if(handle->onIteration && depth > handle->lastIterationDepth) {
+            handle->lastIterationDepth = depth;
+
+            CESearchResult result;
+            fillResult(handle, &result);
+            handle->onIteration(&result, handle->userData);
+        }
+    }
+
+    void runSearch(CEEngine* handle, const CESearchLimits& limits, CESearchResult* result) {
+        UCI::SearchParams params;
+
+        if(limits.depth > 0)
+            params.depth = limits.depth;
+
+        if(limits.nodes > 0)
+            params.nodes = limits.nodes;
+
+        if(limits.movetime > 0) {
+            params.movetime = limits.movetime;
+            params.useMovetime = true;
+        }
+
+        handle->engine.setNumThreads(std::max(limits.threads, 1u));
+        handle->engine.setMultiPV(std::clamp(limits.multiPV, 1u, (uint32_t)CE_MAX_VARIATIONS));
+        handle->lastIterationDepth = 0;
+
+        handle->engine.search(params);
+
+        if(result)
+            fillResult(handle, result);
+    }
+
+    /**
+     * @brief Reserviert die Engine für eine Suche oder eine Änderung der
+     * Position bzw. der Transpositionstabelle.
+     *
+     * @return false, wenn bereits eine Suche läuft.
+     */
+    bool acquire(CEEngine* handle) {
+        bool expected = false;
+        if(!handle->busy.compare_exchange_strong(expected, true)) {
+            handle->error = "A search is already running";
+            return false;
+        }
+
+        return true;
+    }
+}
+
+CEEngine* ceCreateEngine(size_t hashSize) {
+    try {
+        CEEngine* handle = new CEEngine();
+        handle->engine.setHashTableCapacity(hashSize * (1 << 20) / TT_ENTRY_SIZE);
+        handle->engine.setCheckupCallback([handle]() { checkup(handle); });
+        return handle;
+    } catch(std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+void ceDestroyEngine(CEEngine* engine) {
+    if(!engine)
+        return;
+
+    ceStopSearch(engine);
+    ceWaitSearch(engine, nullptr);
+    delete engine;
+}
+
+int ceSetHashSize(CEEngine* engine, size_t hashSize) {
+    if(!acquire(engine))
+        return -1;
+
+    engine->engine.setHashTableCapacity(hashSize * (1 << 20) / TT_ENTRY_SIZE);
+
+    engine->busy.store(false);
+    return 0;
+}
+
+int ceNewGame(CEEngine* engine) {
+    if(!acquire(engine))
+        return -1;
+
+    engine->engine.newGame();
+
+    engine->busy.store(false);
+    return 0;
+}
+
+int ceSetPositionFEN(CEEngine* engine, const char* fen) {
+    if(!acquire(engine))
+        return -1;
+
+    int status = 0;
+    try {
+        engine->board = Board(std::string(fen));
+    } catch(std::invalid_argument& e) {
+        engine->error = e.what();
+        status = -1;
+    }
+
+    engine->busy.store(false);
+    return status;
+}
+
+int ceSetPositionPacked(CEEngine* engine, const void* packedBoard) {
+    PackedBoard packed;
+    std::memcpy(&packed, packedBoard, sizeof(PackedBoard));
+
+    // Der Puffer stammt vom Aufrufer und wird vor dem Entpacken überprüft
+    const char* error = Board::validatePackedBoard(packed);
+    if(error) {
+        engine->error = std::string("Invalid packed board: ") + error;
+        return -1;
+    }
+
+    if(!acquire(engine))
+        return -1;
+
+    engine->board = Board(packed);
+
+    engine->busy.store(false);
+    return 0;
+}
+
+int ceMakeMove(CEEngine* engine, const char* move) {
+    if(!acquire(engine))
+        return -1;
+
+    int status = 0;
+    Move m = fromUCINotation(move, engine->board);
+    if(m.exists())
+        engine->board.makeMove(m);
+    else {
+        engine->error = std::string("Illegal move ") + move;
+        status = -1;
+    }
+
+    engine->busy.store(false);
+    return status;
+}
+
+int ceUndoMove(CEEngine* engine) {
+    if(!acquire(engine))
+        return -1;
+
+    int status = 0;
+    if(!engine->board.getMoveHistory().empty())
+        engine->board.undoMove();
+    else {
+        engine->error = "No moves to undo";
+        status = -1;
+    }
+
+    engine->busy.store(false);
+    return status;
+}
+
+int ceGetFEN(CEEngine* engine, char* buffer, size_t size) {
+    std::string fen = engine->board.toFEN();
+    if(fen.size() + 1 > size)
+        return -1;
+
+    std::memcpy(buffer, fen.c_str(), fen.size() + 1);
+    return (int)fen.size();
+}
+
+size_t ceGetLegalMoves(CEEngine* engine, uint16_t* moves, size_t capacity) {
+    Array<Move, 256> legalMoves;
+    engine->board.generateLegalMoves(legalMoves);
+
+    for(size_t i = 0; i < std::min(legalMoves.size(), capacity); i++)
+        moves[i] = legalMoves[i].getMove();
+
+    return legalMoves.size();
+}
+
+int ceSearch(CEEngine* engine, const CESearchLimits* limits, CESearchResult* result,
+             CESearchCallback onIteration, void* userData) {
+    if(!acquire(engine))
+        return -1;
+
+    engine->stopRequested.store(false);
+    engine->onIteration = onIteration;
+    engine->userData = userData;
+
+    runSearch(engine, limits ? *limits : CESearchLimits{}, result);
+
+    engine->busy.store(false);
+    return 0;
+}
+
+int ceStartSearch(CEEngine* engine, const CESearchLimits* limits,
+                  CESearchCallback onIteration, CESearchCallback onFinish, void* userData) {
+    if(!acquire(engine))
+        return -1;
+
+    engine->stopRequested.store(false);
+    engine->onIteration = onIteration;
+    engine->userData = userData;
+
+    CESearchLimits searchLimits = limits ? *limits : CESearchLimits{};
+
+    auto searchFunc = [engine, searchLimits, onFinish, userData]() {
+        CESearchResult result;
+        runSearch(engine, searchLimits, &result);
+
+        if(onFinish)
+            onFinish(&result, userData);
+    };
+
+    #if not defined(DISABLE_THREADS)
+        engine->searchThread = std::thread(searchFunc);
+    #else
+        searchFunc();
+    #endif
+
+    return 0;
+}
+
+void ceStopSearch(CEEngine* engine) {
+    engine->stopRequested.store(true);
+    engine->engine.stop();
+}
+
+void ceWaitSearch(CEEngine* engine, CESearchResult* result) {
+    #if not defined(DISABLE_THREADS)
+        if(engine->searchThread.joinable())
+            engine->searchThread.join();
+    #endif
+
+    if(result)
+        fillResult(engine, result);
+
+    engine->busy.store(false);
+}
+
+void ceMoveToUCI(uint16_t move, char* buffer) {
+    std::string str = Move(move).exists() ? Move(move).toString() : "0000";
+    std::memcpy(buffer, str.c_str(), str.size() + 1);
+}
+
+const char* ceGetError(CEEngine* engine) {
+    return engine->error.c_str();
+}
\ No newline at end of file
@@ -0,0 +1,200 @@
+#ifndef CHESS_ENGINE_API_H
+#define CHESS_ENGINE_API_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Die native Schnittstelle der Engine (bin/libchessengine.so, siehe make lib).
+ *
+ * Jede Engine (CEEngine) besitzt ihr eigenes Spielfeld, ihre eigene
+ * Transpositionstabelle und ihre eigenen Suchthreads. Verschiedene Engines
+ * können gleichzeitig aus verschiedenen Threads verwendet werden, eine
+ * einzelne Engine darf aber immer nur von einem Thread gleichzeitig
+ * verwendet werden (ausgenommen ceStopSearch).
+ *
+ * Züge werden wie in der Klasse Move als 16-bit Integer dargestellt
+ * und können mit ceMoveToUCI in die UCI-Notation umgewandelt werden.
+ */
+
+#if defined(__GNUC__)
+    #define CE_API __attribute__((visibility("default")))
+#else
+    #define CE_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Die maximale Länge einer Variante und die maximale Anzahl an Varianten in einem Ergebnis.
+ */
+#define CE_MAX_PV_LENGTH 64
+#define CE_MAX_VARIATIONS 16
+
+/**
+ * @brief Die Größe einer Position im Format von PackedBoard in Bytes.
+ */
+#define CE_PACKED_BOARD_SIZE 27
+
+typedef struct CEEngine CEEngine;
+
+/**
+ * @brief Die Grenzen einer Suche. Ein Wert von 0 bedeutet keine Grenze.
+ * Ohne jede Grenze sucht die Engine, bis ceStopSearch aufgerufen wird.
+ */
+typedef struct CESearchLimits {
+    int32_t depth;
+    uint64_t nodes;
+    uint32_t movetime; // in Millisekunden
+    uint32_t threads; // 0: 1 Thread
+    uint32_t multiPV; // 0: 1 Variante, höchstens CE_MAX_VARIATIONS
+} CESearchLimits;
+
+typedef struct CEVariation {
+    int32_t score; // in Centipawns aus der Sicht des Spielers am Zug
+    int32_t mate; // Anzahl der Züge bis zum Matt (negativ, wenn der Spieler am Zug matt gesetzt wird), sonst 0
+    int32_t depth;
+    int32_t selectiveDepth;
+    uint32_t length;
+    uint16_t moves[CE_MAX_PV_LENGTH];
+} CEVariation;
+
+typedef struct CESearchResult {
+    uint16_t bestMove; // 0, wenn es keinen legalen Zug gibt
+    uint16_t ponderMove; // 0, wenn die Hauptvariante nur einen Zug enthält
+    int32_t depth;
+    uint64_t nodes;
+    uint64_t time; // in Millisekunden
+    uint32_t numVariations;
+    CEVariation variations[CE_MAX_VARIATIONS];
+} CESearchResult;
+
+/**
+ * @brief Wird mit dem (Zwischen-)Ergebnis einer Suche aufgerufen. Das
+ * Ergebnis ist nur während des Aufrufs gültig.
+ */
+typedef void (*CESearchCallback)(const CESearchResult* result, void* userData);
+
+/**
+ * @brief Erstellt eine Engine in der Startposition.
+ *
+ * @param hashSize Die Größe der Transpositionstabelle in MB.
+ * @return Die Engine oder NULL, wenn nicht genug Speicher vorhanden ist.
+ */
+CE_API CEEngine* ceCreateEngine(size_t hashSize);
+
+/**
+ * @brief Bricht eine laufende Suche ab und gibt die Engine frei.
+ */
+CE_API void ceDestroyEngine(CEEngine* engine);
+
+/**
+ * @brief Ändert die Größe der Transpositionstabelle (in MB). Der Inhalt geht verloren.
+ *
+ * @return 0 oder -1, wenn eine Suche der Engine läuft (siehe ceGetError).
+ */
+CE_API int ceSetHashSize(CEEngine* engine, size_t hashSize);
+
+/**
+ * @brief Bereitet die Engine auf eine neue, unabhängige Partie vor. Die Einträge
+ * der Transpositionstabelle werden dabei als veraltet markiert.
+ *
+ * @return 0 oder -1, wenn eine Suche der Engine läuft (siehe ceGetError).
+ */
+CE_API int ceNewGame(CEEngine* engine);
+
+/**
+ * @brief Setzt die Position aus einer FEN.
+ *
+ * @return 0 oder -1, wenn die FEN ungültig ist oder eine Suche der Engine läuft (siehe ceGetError).
+ */
+CE_API int ceSetPositionFEN(CEEngine* engine, const char* fen);
+
+/**
+ * @brief Setzt die Position aus einer Position im Format von PackedBoard (CE_PACKED_BOARD_SIZE Bytes).
+ *
+ * @return 0 oder -1, wenn die Position ungültig ist oder eine Suche der Engine läuft (siehe ceGetError).
+ */
+CE_API int ceSetPositionPacked(CEEngine* engine, const void* packedBoard);
+
+/**
+ * @brief Führt einen Zug in UCI-Notation (z.B. e2e4 oder e7e8q) aus.
+ *
+ * @return 0 oder -1, wenn der Zug nicht legal ist oder eine Suche der Engine läuft (siehe ceGetError).
+ */
+CE_API int ceMakeMove(CEEngine* engine, const char* move);
+
+/**
+ * @brief Nimmt den letzten Zug zurück.
+ *
+ * @return 0 oder -1, wenn kein Zug ausgeführt wurde oder eine Suche der Engine läuft (siehe ceGetError).
+ */
+CE_API int ceUndoMove(CEEngine* engine);
+
+/**
+ * @brief Schreibt die FEN der aktuellen Position in buffer (inklusive Nullterminator).
+ *
+ * @return Die Länge der FEN oder -1, wenn der Puffer zu klein ist.
+ */
+CE_API int ceGetFEN(CEEngine* engine, char* buffer, size_t size);
+
+/**
+ * @brief Schreibt die legalen Züge der aktuellen Position in moves.
+ *
+ * @return Die Anzahl der legalen Züge (auch wenn sie größer als capacity ist).
+ */
+CE_API size_t ceGetLegalMoves(CEEngine* engine, uint16_t* moves, size_t capacity);
+
+/**
+ * @brief Durchsucht die aktuelle Position synchron.
+ *
+ * @param onIteration Wird auf dem Suchthread aufgerufen, wenn seit dem letzten Aufruf
+ * mindestens eine Iteration abgeschlossen wurde (darf NULL sein).
+ * @return 0 oder -1, wenn eine Suche der Engine bereits läuft.
+ */
+CE_API int ceSearch(CEEngine* engine, const CESearchLimits* limits, CESearchResult* result,
+                    CESearchCallback onIteration, void* userData);
+
+/**
+ * @brief Startet eine Suche auf einem eigenen Thread und kehrt sofort zurück.
+ * Bis die Suche mit ceWaitSearch beendet wurde, darf die Engine nur
+ * mit ceStopSearch und ceWaitSearch verwendet werden. Funktionen, die die Position
+ * oder die Transpositionstabelle ändern, geben in dieser Zeit -1 zurück.
+ *
+ * @param onIteration Wird auf dem Suchthread aufgerufen, wenn seit dem letzten Aufruf
+ * mindestens eine Iteration abgeschlossen wurde (darf NULL sein).
+ * @param onFinish Wird mit dem Endergebnis aufgerufen (darf NULL sein).
+ * @return 0 oder -1, wenn eine Suche der Engine bereits läuft.
+ */
+CE_API int ceStartSearch(CEEngine* engine, const CESearchLimits* limits,
+                         CESearchCallback onIteration, CESearchCallback onFinish, void* userData);
+
+/**
+ * @brief Bricht die laufende Suche ab. Darf aus jedem Thread aufgerufen werden.
+ */
+CE_API void ceStopSearch(CEEngine* engine);
+
+/**
+ * @brief Wartet auf das Ende einer mit ceStartSearch gestarteten Suche.
+ *
+ * @param result Das Endergebnis (darf NULL sein).
+ */
+CE_API void ceWaitSearch(CEEngine* engine, CESearchResult* result);
+
+/**
+ * @brief Schreibt einen Zug in UCI-Notation in buffer (mindestens 6 Bytes).
+ */
+CE_API void ceMoveToUCI(uint16_t move, char* buffer);
+
+/**
+ * @brief Gibt die Beschreibung des letzten Fehlers der Engine zurück.
+ */
+CE_API const char* ceGetError(CEEngine* engine);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
\ No newline at end of file
@@ -3,13 +3,13 @@
 #include "core/chess/ZobristDefinitions.h"
 #include "core/chess/movegen/NewMovegen.h"
 #include "core/utils/MoveNotations.h"
+#include "core/utils/Profiler.h"
 
 #include <stdio.h>
 #include <stdexcept>
 
 Board::Board() {
     hashValue = generateHashValue();
-    moveHistory.reserve(256);
 }
 
 Board::Board(std::string fen) {
@@ -181,6 +181,124 @@ Board::Board(std::string fen) {
     hashValue = generateHashValue();
 }
 
+Board::Board(const PackedBoard& packedBoard) {
+    const char* error = validatePackedBoard(packedBoard);
+    if(error)
+        throw std::invalid_argument(std::string("Invalid packed board: ") + error);
+
+    for(int i = 0; i < 15; i++)
+        pieceBitboard[i] = Bitboard(0ULL);
+
+    for(int i = 0; i < 64; i++)
+        pieces[i] = EMPTY;
+
+    uint64_t occupancy;
+    std::memcpy(&occupancy, packedBoard.occupancy, sizeof(occupancy));
+
+    // Die Figuren sind in aufsteigender Reihenfolge der belegten Felder gespeichert
+    Bitboard occupied = occupancy;
+    int index = 0;
+    while(occupied) {
+        int square = occupied.popFSB();
+        int piece = (packedBoard.pieces[index / 2] >> ((index % 2) * 4)) & 0xF;
+        index++;
+
+        pieces[square] = piece;
+        pieceBitboard[piece].setBit(square);
+    }
+
+    side = (packedBoard.sideAndCastling & 1) ? BLACK : WHITE;
+    castlingPermission = (packedBoard.sideAndCastling >> 1) & 0xF;
+    enPassantSquare = packedBoard.enPassantSquare;
+    fiftyMoveRule = packedBoard.fiftyMoveRule;
+    age = side == WHITE ? 0 : 1;
+
+    generateSpecialBitboards();
+    hashValue = generateHashValue();
+}
+
+const char* Board::validatePackedBoard(const PackedBoard& packedBoard) {
+    uint64_t occupancy;
+    std::memcpy(&occupancy, packedBoard.occupancy, sizeof(occupancy));
+
+    Bitboard occupied = occupancy;
+    if(occupied.popcount() > 32)
+        return "More than 32 pieces";
+
+    // Lege die Bitboards der Figuren an, ohne das Schachbrett zu verändern
+    Bitboard pieceBitboards[15] = {};
+    Bitboard remaining = occupied;
+    int index = 0;
+    while(remaining) {
+        int square = remaining.popFSB();
+        int piece = (packedBoard.pieces[index / 2] >> ((index % 2) * 4)) & 0xF;
+        index++;
+
+        if(TYPEOF(piece) < PAWN || TYPEOF(piece) > KING)
+            return "Invalid piece code";
+
+        pieceBitboards[piece].setBit(square);
+    }
+
+    if(pieceBitboards[WHITE_KING].popcount() != 1 || pieceBitboards[BLACK_KING].popcount() != 1)
+        return "There must be exactly one white and one black king";
+
+    if(packedBoard.sideAndCastling >> 5)
+        return "Unused bits are set";
+
+    int side = (packedBoard.sideAndCastling & 1) ? BLACK : WHITE;
+    int castlingPermission = (packedBoard.sideAndCastling >> 1) & 0xF;
+
+    // Jedes Rochaderecht setzt den König und den Turm auf ihren Ausgangsfeldern voraus
+    if((castlingPermission & (WHITE_KINGSIDE_CASTLE | WHITE_QUEENSIDE_CASTLE)) && !pieceBitboards[WHITE_KING].getBit(E1))
+        return "White may castle, but the king is not on e1";
+
+    if((castlingPermission & (BLACK_KINGSIDE_CASTLE | BLACK_QUEENSIDE_CASTLE)) && !pieceBitboards[BLACK_KING].getBit(E8))
+        return "Black may castle, but the king is not on e8";
+
+    if(((castlingPermission & WHITE_KINGSIDE_CASTLE) && !pieceBitboards[WHITE_ROOK].getBit(H1)) ||
+       ((castlingPermission & WHITE_QUEENSIDE_CASTLE) && !pieceBitboards[WHITE_ROOK].getBit(A1)) ||
+       ((castlingPermission & BLACK_KINGSIDE_CASTLE) && !pieceBitboards[BLACK_ROOK].getBit(H8)) ||
+       ((castlingPermission & BLACK_QUEENSIDE_CASTLE) && !pieceBitboards[BLACK_ROOK].getBit(A8)))
+        return "Castling permission without a rook in the corner";
+
+    int enPassantSquare = packedBoard.enPassantSquare;
+    if(enPassantSquare != NO_SQ) {
+        if(enPassantSquare > H8)
+            return "En Passant square is not on the board";
+
+        if(SQ2R(enPassantSquare) != (side == WHITE ? RANK_6 : RANK_3))
+            return "En Passant square is not on rank 3 or 6";
+    }
+
+    // Der König der Seite, die nicht am Zug ist, darf nicht im Schach stehen
+    int otherSide = side ^ COLOR_MASK;
+    int kingSquare = pieceBitboards[otherSide | KING].getFSB();
+
+    if((diagonalAttackBitboard(kingSquare, occupied) & (pieceBitboards[side | BISHOP] | pieceBitboards[side | QUEEN])) ||
+       (horizontalAttackBitboard(kingSquare, occupied) & (pieceBitboards[side | ROOK] | pieceBitboards[side | QUEEN])) ||
+       (knightAttackBitboard(kingSquare) & pieceBitboards[side | KNIGHT]) ||
+       (pawnAttackBitboard(kingSquare, otherSide) & pieceBitboards[side | PAWN]) ||
+       (kingAttackBitboard(kingSquare) & pieceBitboards[side | KING]))
+        return "King of player not moving is in check";
+
+    return nullptr;
+}
+
+void Board::copyPosition(const Board& other) {
+    if(this == &other)
+        return;
+
+    // Kopiere den Positionszustand
+    static_cast<BoardState&>(*this) = other.getState();
+    checkInfoValid = false;
+    checkSquaresValid = false;
+
+    // Übernehme nur den relevanten Teil der Zughistorie
+    size_t numEntries = std::min(other.moveHistory.size(), (size_t)fiftyMoveRule + 1);
+    moveHistory.assign(other.moveHistory.end() - numEntries, numEntries);
+}
+
 bool Board::operator==(const Board& b) const {
     for(size_t i = 0; i < 15; i++)
         if(pieceBitboard[i] != b.pieceBitboard[i])
@@ -632,14 +750,38 @@ bool Board::isMoveLegal(Move move) {
         }
     }
 
-    // Überprüfe, ob der Zug den eigenen König in Schach setzt/lässt
-    makeMove(move);
+    // Die Felder einer Rochade wurden bereits vollständig überprüft
+    if(move.isCastle())
+        return true;
+
+    // En Passant entfernt zwei Figuren von einem Rang,
+    // deshalb wird die Stellung nach dem Zug betrachtet
+    if(move.isEnPassant()) {
+        makeMove(move);
+
+        bool isCheck = squareAttacked(pieceBitboard[side | KING].getFSB(), otherSide);
+
+        undoMove();
+
+        return !isCheck;
+    }
+
+    // Ein König darf nicht auf ein angegriffenes Feld ziehen,
+    // dabei darf er selbst keine Angriffe blockieren
+    if(TYPEOF(pieces[origin]) == KING)
+        return !squareAttacked(destination, otherSide, pieceBitboard[ALL_PIECES] | pieceBitboard[otherSide | KING]);
+
+    // Überprüfe, ob der Zug den eigenen König im Schach lässt
+    const CheckInfo& info = getCheckInfo(false);
 
-    bool isCheck = squareAttacked(pieceBitboard[side | KING].getFSB(), otherSide);
+    if(info.numCheckers > 1)
+        return false;
 
-    undoMove();
+    if(info.numCheckers == 1 && !info.checkMask.getBit(destination))
+        return false;
 
-    return !isCheck;
+    // Gefesselte Figuren dürfen ihren Fesselungsstrahl nicht verlassen
+    return !info.pinned.getBit(origin) || info.getPinRay(origin).getBit(destination);
 }
 
 bool Board::isCheck() const {
@@ -647,6 +789,8 @@ bool Board::isCheck() const {
 }
 
 void Board::makeMove(Move m) {
+    PROFILE_SCOPE(Profiler::MAKE_MOVE);
+
     int origin = m.getOrigin();
     int destination = m.getDestination();
     int pieceType = pieces[origin];
@@ -656,8 +800,11 @@ void Board::makeMove(Move m) {
     if(m.isEnPassant())
         capturedPieceType = pieces[enPassantCaptureSq];
 
+    checkInfoValid = false;
+    checkSquaresValid = false;
+
     // Speichere den Zustand des Spielfeldes, um den Zug später wieder rückgängig machen zu können
-    MoveHistoryEntry entry(m);
+    MoveHistoryEntry& entry = moveHistory.push(m);
     entry.capturedPiece = capturedPieceType;
     entry.castlingPermission = castlingPermission;
     entry.enPassantSquare = enPassantSquare;
@@ -667,8 +814,6 @@ void Board::makeMove(Move m) {
     memcpy(entry.pieceBitboard, pieceBitboard, sizeof(Bitboard) * 15);
     memcpy(entry.attackBitboard, attackBitboard, sizeof(Bitboard) * 15);
 
-    moveHistory.push_back(entry);
-
     // Zug ausführen
 
     // Spezialfall: Nullzug
@@ -871,6 +1016,8 @@ void Board::makeMove(Move m) {
 }
 
 void Board::undoMove() {
+    PROFILE_SCOPE(Profiler::UNDO_MOVE);
+
     MoveHistoryEntry& moveEntry = moveHistory.back();
     Move move = moveEntry.move;
 
@@ -879,6 +1026,9 @@ void Board::undoMove() {
     int pieceType = pieces[destination];
     int capturedPieceType = moveEntry.capturedPiece;
 
+    checkInfoValid = false;
+    checkSquaresValid = false;
+
     // Mache den Spielzustand rückgängig
     age--;
     side ^= COLOR_MASK;
@@ -892,7 +1042,7 @@ void Board::undoMove() {
     
     // Spezialfall: Nullzug
     if(move.isNullMove()) {
-        moveHistory.pop_back();
+        moveHistory.pop();
         return;
     }
 
@@ -927,7 +1077,7 @@ void Board::undoMove() {
     if(move.isEnPassant())
         pieces[enPassantCaptureSq] = capturedPieceType;
 
-    moveHistory.pop_back();
+    moveHistory.pop();
 }
 
 bool Board::squareAttacked(int sq, int ownSide) const {
@@ -1181,47 +1331,157 @@ void Board::updateAttackBitboards(int side, Bitboard updatedSquares, int capture
     attackBitboard[ALL_PIECES] = attackBitboard[WHITE] | attackBitboard[BLACK];
 }
 
-void Board::generatePinnedPiecesBitboards(int side, Bitboard& pinnedPiecesBitboard,
-                                          int* pinnedPiecesDirection) const {
+Bitboard Board::findSliderBlockers(int kingSquare, Bitboard diagonalSliders, Bitboard straightSliders,
+                                   Bitboard candidates, Array<Bitboard, 8>& rays) const {
+
+    Bitboard occupied = pieceBitboard[ALL_PIECES] | pieceBitboard[WHITE_KING] | pieceBitboard[BLACK_KING];
+    Bitboard kingBitboard = Bitboard(1ULL << kingSquare);
+    Bitboard blockers;
+
+    // Langschrittfiguren, die den König auf einem leeren Brett angreifen würden
+    Bitboard diagonalSnipers = diagonalAttackBitboard(kingSquare, Bitboard(0ULL)) & diagonalSliders;
+    Bitboard straightSnipers = horizontalAttackBitboard(kingSquare, Bitboard(0ULL)) & straightSliders;
+
+    // Die Verbindungsfelder zwischen König und Langschrittfigur ergeben sich
+    // aus der Schnittmenge der Angriffe beider Felder aufeinander
+    while(diagonalSnipers) {
+        int sq = diagonalSnipers.popFSB();
+        Bitboard between = diagonalAttackBitboard(kingSquare, Bitboard(1ULL << sq)) &
+                           diagonalAttackBitboard(sq, kingBitboard);
+
+        Bitboard piecesBetween = between & occupied;
+        if(piecesBetween.popcount() == 1 && (piecesBetween & candidates)) {
+            blockers |= piecesBetween;
+            rays.push_back(between | Bitboard(1ULL << sq));
+        }
+    }
+
+    while(straightSnipers) {
+        int sq = straightSnipers.popFSB();
+        Bitboard between = horizontalAttackBitboard(kingSquare, Bitboard(1ULL << sq)) &
+                           horizontalAttackBitboard(sq, kingBitboard);
 
+        Bitboard piecesBetween = between & occupied;
+        if(piecesBetween.popcount() == 1 && (piecesBetween & candidates)) {
+            blockers |= piecesBetween;
+            rays.push_back(between | Bitboard(1ULL << sq));
+        }
+    }
+
+    return blockers;
+}
+
+void Board::computeCheckInfo() const {
+    int otherSide = side ^ COLOR_MASK;
     int kingSquare = pieceBitboard[side | KING].getFSB();
+
+    checkInfo.checkers = Bitboard(0ULL);
+    checkInfo.checkMask = Bitboard(0ULL);
+    checkInfo.numCheckers = 0;
+    checkInfo.pinRays.clear();
+
+    // Angreifer des eigenen Königs
+    if(isCheck()) {
+        Bitboard occupied = pieceBitboard[ALL_PIECES] | pieceBitboard[WHITE_KING] | pieceBitboard[BLACK_KING];
+        checkInfo.numCheckers = numSquareAttackers(kingSquare, otherSide, occupied, checkInfo.checkMask);
+        checkInfo.checkers = checkInfo.checkMask & pieceBitboard[otherSide];
+    }
+
+    // Fesselungen an den eigenen König
+    checkInfo.pinned = findSliderBlockers(kingSquare,
+                                          pieceBitboard[otherSide | BISHOP] | pieceBitboard[otherSide | QUEEN],
+                                          pieceBitboard[otherSide | ROOK] | pieceBitboard[otherSide | QUEEN],
+                                          pieceBitboard[side], checkInfo.pinRays);
+}
+
+void Board::computeCheckSquares() const {
     int otherSide = side ^ COLOR_MASK;
-    Bitboard enemyPiecesPlusKing = pieceBitboard[otherSide] | pieceBitboard[otherSide | KING];
+    int enemyKingSquare = pieceBitboard[otherSide | KING].getFSB();
+    Bitboard occupied = pieceBitboard[ALL_PIECES] | pieceBitboard[WHITE_KING] | pieceBitboard[BLACK_KING];
+
+    checkInfo.discoveryRays.clear();
+
+    // Kandidaten für Abzugsschachs (der eigene König eingeschlossen)
+    checkInfo.discoveredCheckCandidates = findSliderBlockers(enemyKingSquare,
+                                          pieceBitboard[side | BISHOP] | pieceBitboard[side | QUEEN],
+                                          pieceBitboard[side | ROOK] | pieceBitboard[side | QUEEN],
+                                          pieceBitboard[side] | pieceBitboard[side | KING], checkInfo.discoveryRays);
+
+    // Felder, von denen aus eine eigene Figur den gegnerischen König angreifen würde
+    Bitboard diagonalChecks = diagonalAttackBitboard(enemyKingSquare, occupied);
+    Bitboard straightChecks = horizontalAttackBitboard(enemyKingSquare, occupied);
+
+    checkInfo.checkSquares[EMPTY] = Bitboard(0ULL);
+    checkInfo.checkSquares[PAWN] = pawnAttackBitboard(enemyKingSquare, otherSide);
+    checkInfo.checkSquares[KNIGHT] = knightAttackBitboard(enemyKingSquare);
+    checkInfo.checkSquares[BISHOP] = diagonalChecks;
+    checkInfo.checkSquares[ROOK] = straightChecks;
+    checkInfo.checkSquares[QUEEN] = diagonalChecks | straightChecks;
+    checkInfo.checkSquares[KING] = Bitboard(0ULL);
+}
 
-    Bitboard ownPieces = pieceBitboard[side];
+bool Board::givesCheck(Move move) const {
+    if(move.isNullMove())
+        return false;
 
-    // Diagonale Angriffe
-    int diagonalPins[4];
-    int diagonalPinDirections[4];
-
-    int numDiagonalPins = getDiagonallyPinnedToSquare(kingSquare,
-                              ownPieces,
-                              pieceBitboard[otherSide | QUEEN] | pieceBitboard[otherSide | BISHOP],
-                              enemyPiecesPlusKing,
-                              diagonalPins,
-                              diagonalPinDirections);
-    
-    // Waaagerechte Angriffe
-    int straightPins[4];
-    int straightPinDirections[4];
-
-    int numStraightPins = getHorizontallyPinnedToSquare(kingSquare,
-                              ownPieces,
-                              pieceBitboard[otherSide | QUEEN] | pieceBitboard[otherSide | ROOK],
-                              enemyPiecesPlusKing,
-                              straightPins,
-                              straightPinDirections);
-    
-    // Pins zusammenfassen
-    for(int i = 0; i < numDiagonalPins; i++) {
-        pinnedPiecesBitboard.setBit(diagonalPins[i]);
-        pinnedPiecesDirection[diagonalPins[i]] = diagonalPinDirections[i];
+    const CheckInfo& info = getCheckInfo();
+
+    int origin = move.getOrigin();
+    int destination = move.getDestination();
+    int otherSide = side ^ COLOR_MASK;
+    int enemyKingSquare = pieceBitboard[otherSide | KING].getFSB();
+
+    // Rochaden und En Passant verändern mehrere Felder,
+    // deshalb wird die Stellung nach dem Zug direkt betrachtet
+    if(move.isCastle() || move.isEnPassant()) {
+        Bitboard occupied = pieceBitboard[ALL_PIECES] | pieceBitboard[WHITE_KING] | pieceBitboard[BLACK_KING];
+        Bitboard diagonalSliders = pieceBitboard[side | BISHOP] | pieceBitboard[side | QUEEN];
+        Bitboard straightSliders = pieceBitboard[side | ROOK] | pieceBitboard[side | QUEEN];
+
+        occupied.clearBit(origin);
+        occupied.setBit(destination);
+
+        if(move.isEnPassant()) {
+            if(info.checkSquares[PAWN].getBit(destination))
+                return true;
+
+            occupied.clearBit(destination + (side == WHITE ? SOUTH : NORTH));
+        } else {
+            int rookOrigin = move.isKingsideCastle() ? origin + 3 : origin - 4;
+            int rookDestination = move.isKingsideCastle() ? origin + 1 : origin - 1;
+
+            occupied.clearBit(rookOrigin);
+            occupied.setBit(rookDestination);
+            straightSliders.clearBit(rookOrigin);
+            straightSliders.setBit(rookDestination);
+        }
+
+        return (diagonalAttackBitboard(enemyKingSquare, occupied) & diagonalSliders) ||
+               (horizontalAttackBitboard(enemyKingSquare, occupied) & straightSliders);
     }
 
-    for(int i = 0; i < numStraightPins; i++) {
-        pinnedPiecesBitboard.setBit(straightPins[i]);
-        pinnedPiecesDirection[straightPins[i]] = straightPinDirections[i];
+    // Abzugsschach
+    if(info.discoveredCheckCandidates.getBit(origin) && !info.getDiscoveryRay(origin).getBit(destination))
+        return true;
+
+    // Direktes Schach
+    if(move.isPromotion()) {
+        // Das Ausgangsfeld der Bauernaufwertung wird frei
+        Bitboard occupied = pieceBitboard[ALL_PIECES] | pieceBitboard[WHITE_KING] | pieceBitboard[BLACK_KING];
+        occupied.clearBit(origin);
+
+        if(move.isPromotionKnight())
+            return info.checkSquares[KNIGHT].getBit(destination);
+
+        if((move.isPromotionBishop() || move.isPromotionQueen()) &&
+           diagonalAttackBitboard(destination, occupied).getBit(enemyKingSquare))
+            return true;
+
+        return (move.isPromotionRook() || move.isPromotionQueen()) &&
+               horizontalAttackBitboard(destination, occupied).getBit(enemyKingSquare);
     }
+
+    return info.checkSquares[TYPEOF(pieces[origin])].getBit(destination);
 }
 
 Array<Move, 256> Board::generateLegalMoves() const noexcept {
@@ -1231,26 +1491,12 @@ Array<Move, 256> Board::generateLegalMoves() const noexcept {
 }
 
 void Board::generateLegalMoves(Array<Move, 256>& legalMoves) const noexcept {
-    Bitboard attackingRays, pinnedPieces;
-    int numAttackers = 0;
-    Array<int, 64> pinDirections;
-    pinDirections.resize(64);
-
-    if(side == WHITE) {
-        if(isCheck())
-            numAttackers = numSquareAttackers(pieceBitboard[WHITE_KING].getFSB(), BLACK, pieceBitboard[ALL_PIECES] | pieceBitboard[BLACK_KING], attackingRays);
-        
-        generatePinnedPiecesBitboards(WHITE, pinnedPieces, pinDirections);
-
-        Movegen::generateLegalMoves<WHITE>(*this, legalMoves, numAttackers, attackingRays, pinnedPieces, pinDirections);
-    } else {
-        if(isCheck())
-            numAttackers = numSquareAttackers(pieceBitboard[BLACK_KING].getFSB(), WHITE, pieceBitboard[ALL_PIECES] | pieceBitboard[WHITE_KING], attackingRays);
-        
-        generatePinnedPiecesBitboards(BLACK, pinnedPieces, pinDirections);
+    PROFILE_SCOPE(Profiler::MOVEGEN);
 
-        Movegen::generateLegalMoves<BLACK>(*this, legalMoves, numAttackers, attackingRays, pinnedPieces, pinDirections);
-    }
+    if(side == WHITE)
+        Movegen::generateLegalMoves<WHITE>(*this, legalMoves, getCheckInfo(false));
+    else
+        Movegen::generateLegalMoves<BLACK>(*this, legalMoves, getCheckInfo(false));
 }
 
 Array<Move, 256> Board::generateLegalCaptures() const noexcept {
@@ -1260,26 +1506,12 @@ Array<Move, 256> Board::generateLegalCaptures() const noexcept {
 }
 
 void Board::generateLegalCaptures(Array<Move, 256>& legalCaptures) const noexcept {
-    Bitboard attackingRays, pinnedPieces;
-    int numAttackers = 0;
-    Array<int, 64> pinDirections;
-    pinDirections.resize(64);
+    PROFILE_SCOPE(Profiler::MOVEGEN);
 
-    if(side == WHITE) {
-        if(isCheck())
-            numAttackers = numSquareAttackers(pieceBitboard[WHITE_KING].getFSB(), BLACK, pieceBitboard[ALL_PIECES] | pieceBitboard[BLACK_KING], attackingRays);
-        
-        generatePinnedPiecesBitboards(WHITE, pinnedPieces, pinDirections);
-
-        Movegen::generateLegalCaptures<WHITE>(*this, legalCaptures, numAttackers, attackingRays, pinnedPieces, pinDirections);
-    } else {
-        if(isCheck())
-            numAttackers = numSquareAttackers(pieceBitboard[BLACK_KING].getFSB(), WHITE, pieceBitboard[ALL_PIECES] | pieceBitboard[WHITE_KING], attackingRays);
-        
-        generatePinnedPiecesBitboards(BLACK, pinnedPieces, pinDirections);
-
-        Movegen::generateLegalCaptures<BLACK>(*this, legalCaptures, numAttackers, attackingRays, pinnedPieces, pinDirections);
-    }
+    if(side == WHITE)
+        Movegen::generateLegalCaptures<WHITE>(*this, legalCaptures, getCheckInfo(false));
+    else
+        Movegen::generateLegalCaptures<BLACK>(*this, legalCaptures, getCheckInfo(false));
 }
 
 std::string Board::toFEN() const {
@@ -1400,6 +1632,29 @@ std::string Board::toFEN() const {
     return fen;
 }
 
+PackedBoard Board::toPackedBoard() const {
+    PackedBoard packedBoard{};
+
+    uint64_t occupancy = 0;
+    int index = 0;
+    for(int square = A1; square <= H8; square++) {
+        if(pieces[square] == EMPTY)
+            continue;
+
+        occupancy |= 1ULL << square;
+        packedBoard.pieces[index / 2] |= pieces[square] << ((index % 2) * 4);
+        index++;
+    }
+
+    std::memcpy(packedBoard.occupancy, &occupancy, sizeof(occupancy));
+
+    packedBoard.sideAndCastling = (side == BLACK ? 1 : 0) | (castlingPermission << 1);
+    packedBoard.enPassantSquare = enPassantSquare;
+    packedBoard.fiftyMoveRule = std::min(fiftyMoveRule, 255);
+
+    return packedBoard;
+}
+
 std::string Board::toPGN(const PGNData& data) const {
     std::stringstream pgn;
     std::string fenOverwrite = "";
@@ -1443,7 +1698,7 @@ std::string Board::toPGN(const PGNData& data) const {
     if(!white)
         pgn << std::to_string(halfMoves / 2 + 1) << ". ... ";
 
-    for(MoveHistoryEntry entry : moveHistory) {
+    for(const MoveHistoryEntry& entry : moveHistory) {
         if(white)
             pgn << std::to_string(halfMoves / 2 + 1) << ". ";
 
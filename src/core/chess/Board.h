@@ -3,6 +3,8 @@
 
 #include "core/chess/BoardDefinitions.h"
 #include "core/chess/Move.h"
+#include "core/chess/MoveHistory.h"
+#include "core/chess/PackedBoard.h"
 #include "core/utils/Array.h"
 #include "core/utils/Bitboard.h"
 
@@ -13,91 +15,9 @@
 #include <string>
 #include <sstream>
 #include <tuple>
+#include <type_traits>
 #include <vector>
 
-/**
- * @brief Enthält alle notwendigen Informationen um einen Zug rückgängig zu machen.
- */
-class MoveHistoryEntry {
-    public:
-        /**
-         * @brief Speichert den Typ der geschlagenen Figur.
-         */
-        int capturedPiece;
-
-        /**
-         * @brief Speichert alle möglichen Rochaden vor diesem Zug.
-         */
-        int castlingPermission;
-
-        /**
-         * @brief Speichert die Position eines möglichen En Passant Zuges vor diesem Zug(wenn möglich).
-         */
-        int enPassantSquare;
-
-        /**
-         * @brief Der 50-Zug Counter vor diesem Zug.
-         */
-        int fiftyMoveRule;
-
-        /**
-         * @brief Speichert den Hashwert vor diesem Zug.
-         */
-        uint64_t hashValue;
-
-        /**
-         * @brief Speichert alle individuellen Figurenbitboards vor diesem Zug.
-        */
-        Bitboard pieceBitboard[15];
-
-        /**
-         * @brief Speichert die Angriffsbitboards der Figuren vor diesem Zug.
-         */
-        Bitboard attackBitboard[15];
-
-        /**
-         * @brief Der Zug der rückgängig gemacht werden soll.
-         */
-        Move move;
-
-        /**
-         * @brief Erstellt einen neuen MoveHistoryEntry.
-         * @param move Der Zug der rückgängig gemacht werden soll.
-         * @param capturedPiece Speichert den Typ der geschlagenen Figur.
-         * @param castlePermission Speichert alle möglichen Rochaden vor diesem Zug.
-         * @param enPassantSquare Speichert die Position eines möglichen En Passant Zuges vor diesem Zug(wenn möglich).
-         * @param fiftyMoveRule Der 50-Zug Counter vor diesem Zug.
-         * @param hashValue Speichert den Hashwert vor diesem Zug.
-         * @param whitePiecesBitboard Speichert das weiße Figurenbitboard vor diesem Zug.
-         * @param blackPiecesBitboard Speichert das schwarze Figurenbitboard vor diesem Zug.
-         * @param pieceBitboards Speichert alle individuellen Figurenbitboards vor diesem Zug.
-         * @param whiteAttackBitboard Speichert das weiße Angriffsbitboard vor diesem Zug.
-         * @param blackAttackBitboard Speichert das schwarze Angriffsbitboard vor diesem Zug.
-         * @param pieceAttackBitboards Speichert die Angriffsbitboards der Figuren vor diesem Zug.
-         */
-        constexpr MoveHistoryEntry(Move move, int capturedPiece, int castlePermission,
-                        int enPassantSquare, int fiftyMoveRule, uint64_t hashValue,
-                        Bitboard pieceBitboards[15], Bitboard attackBitboards[15]) {
-            this->move = move;
-            this->capturedPiece = capturedPiece;
-            this->castlingPermission = castlePermission;
-            this->enPassantSquare = enPassantSquare;
-            this->fiftyMoveRule = fiftyMoveRule;
-            this->hashValue = hashValue;
-
-            std::copy(pieceBitboards, pieceBitboards + 15, this->pieceBitboard);
-            std::copy(attackBitboards, attackBitboards + 15, this->attackBitboard);
-        }
-
-        /**
-         * @brief Erstellt einen neuen MoveHistoryEntry.
-         * @param move Der Zug der rückgängig gemacht werden soll.
-         */
-        constexpr MoveHistoryEntry(Move move) {
-            this->move = move;
-        }
-};
-
 /**
  * @brief Enthält Meta-Informationen eines PGN-Strings.
  */
@@ -171,107 +91,195 @@ inline std::ostream& operator<<(std::ostream& os, const PGNData& data) {
 }
 
 /**
- * @brief Stellt ein Schachbrett dar.
- * Die Klasse Board stellt ein Schachbrett dar und enthält Methoden zur Zuggeneration.
+ * @brief Der Zustand einer Position ohne Zughistorie.
+ * Die Struktur ist trivial kopierbar und benötigt keinen Speicher auf dem Heap,
+ * sodass eine Position mit einem einfachen memcpy kopiert werden kann.
+ * Der Standardwert ist die Grundstellung (ohne Hashwert).
  */
-class alignas(64) Board {
-    friend class Movegen;
-    
-    private:
-         /**
-          * @brief Stellt das Schachbrett in 8x8 Notation dar.
-          */
-        int pieces[64] = {
-            WHITE_ROOK, WHITE_KNIGHT, WHITE_BISHOP, WHITE_QUEEN, WHITE_KING, WHITE_BISHOP, WHITE_KNIGHT, WHITE_ROOK,
-            WHITE_PAWN,   WHITE_PAWN,   WHITE_PAWN,  WHITE_PAWN, WHITE_PAWN,   WHITE_PAWN,   WHITE_PAWN, WHITE_PAWN,
-                 EMPTY,        EMPTY,        EMPTY,       EMPTY,      EMPTY,        EMPTY,        EMPTY,      EMPTY,
-                 EMPTY,        EMPTY,        EMPTY,       EMPTY,      EMPTY,        EMPTY,        EMPTY,      EMPTY,
-                 EMPTY,        EMPTY,        EMPTY,       EMPTY,      EMPTY,        EMPTY,        EMPTY,      EMPTY,
-                 EMPTY,        EMPTY,        EMPTY,       EMPTY,      EMPTY,        EMPTY,        EMPTY,      EMPTY,
-            BLACK_PAWN,   BLACK_PAWN,   BLACK_PAWN,  BLACK_PAWN, BLACK_PAWN,   BLACK_PAWN,   BLACK_PAWN, BLACK_PAWN,
-            BLACK_ROOK, BLACK_KNIGHT, BLACK_BISHOP, BLACK_QUEEN, BLACK_KING, BLACK_BISHOP, BLACK_KNIGHT, BLACK_ROOK
-        };
+struct BoardState {
+    /**
+     * @brief Stellt das Schachbrett in 8x8 Notation dar.
+     */
+    int pieces[64] = {
+        WHITE_ROOK, WHITE_KNIGHT, WHITE_BISHOP, WHITE_QUEEN, WHITE_KING, WHITE_BISHOP, WHITE_KNIGHT, WHITE_ROOK,
+        WHITE_PAWN,   WHITE_PAWN,   WHITE_PAWN,  WHITE_PAWN, WHITE_PAWN,   WHITE_PAWN,   WHITE_PAWN, WHITE_PAWN,
+             EMPTY,        EMPTY,        EMPTY,       EMPTY,      EMPTY,        EMPTY,        EMPTY,      EMPTY,
+             EMPTY,        EMPTY,        EMPTY,       EMPTY,      EMPTY,        EMPTY,        EMPTY,      EMPTY,
+             EMPTY,        EMPTY,        EMPTY,       EMPTY,      EMPTY,        EMPTY,        EMPTY,      EMPTY,
+             EMPTY,        EMPTY,        EMPTY,       EMPTY,      EMPTY,        EMPTY,        EMPTY,      EMPTY,
+        BLACK_PAWN,   BLACK_PAWN,   BLACK_PAWN,  BLACK_PAWN, BLACK_PAWN,   BLACK_PAWN,   BLACK_PAWN, BLACK_PAWN,
+        BLACK_ROOK, BLACK_KNIGHT, BLACK_BISHOP, BLACK_QUEEN, BLACK_KING, BLACK_BISHOP, BLACK_KNIGHT, BLACK_ROOK
+    };
 
-        /**
-         * @brief Speichert Belegbitboards für alle Figurentypen und Farben.
-         */
-        Bitboard pieceBitboard[15] = {
-            0xffefULL,
-            0xff00ULL,
-            0x42ULL,
-            0x24ULL,
-            0x81ULL,
-            0x8ULL,
-            0x10ULL,
-            0xefff00000000ffefULL,
-            0xefff000000000000ULL,
-            0xff000000000000ULL,
-            0x4200000000000000ULL,
-            0x2400000000000000ULL,
-            0x8100000000000000ULL,
-            0x800000000000000ULL,
-            0x1000000000000000ULL
-        };
+    /**
+     * @brief Speichert Belegbitboards für alle Figurentypen und Farben.
+     */
+    Bitboard pieceBitboard[15] = {
+        0xffefULL,
+        0xff00ULL,
+        0x42ULL,
+        0x24ULL,
+        0x81ULL,
+        0x8ULL,
+        0x10ULL,
+        0xefff00000000ffefULL,
+        0xefff000000000000ULL,
+        0xff000000000000ULL,
+        0x4200000000000000ULL,
+        0x2400000000000000ULL,
+        0x8100000000000000ULL,
+        0x800000000000000ULL,
+        0x1000000000000000ULL
+    };
 
-        /**
-         * @brief Speichert alle Felder, die ein Figurentyp angreift(In Pseudo-Legalen Zügen).
-         */
-        Bitboard attackBitboard[15] = {
-            0xffff7eULL,
-            0xff0000ULL,
-            0xa51800ULL,
-            0x5a00ULL,
-            0x8142ULL,
-            0x1c14ULL,
-            0x3828ULL,
-            0x7effff0000ffff7eULL,
-            0x7effff0000000000ULL,
-            0xff0000000000ULL,
-            0x18a50000000000ULL,
-            0x5a000000000000ULL,
-            0x4281000000000000ULL,
-            0x141c000000000000ULL,
-            0x2838000000000000ULL
-        };
+    /**
+     * @brief Speichert alle Felder, die ein Figurentyp angreift(In Pseudo-Legalen Zügen).
+     */
+    Bitboard attackBitboard[15] = {
+        0xffff7eULL,
+        0xff0000ULL,
+        0xa51800ULL,
+        0x5a00ULL,
+        0x8142ULL,
+        0x1c14ULL,
+        0x3828ULL,
+        0x7effff0000ffff7eULL,
+        0x7effff0000000000ULL,
+        0xff0000000000ULL,
+        0x18a50000000000ULL,
+        0x5a000000000000ULL,
+        0x4281000000000000ULL,
+        0x141c000000000000ULL,
+        0x2838000000000000ULL
+    };
 
-        /**
-         * @brief Speichert die Farbe, die am Zug ist.
-         */
-        int side = WHITE;
+    /**
+     * @brief Speichert die Farbe, die am Zug ist.
+     */
+    int side = WHITE;
 
-        /**
-         * @brief Speichert den Index des Feldes, auf dem ein Bauer En Passant geschlagen werden kann(wenn vorhanden).
-         */
-        int enPassantSquare = NO_SQ;
+    /**
+     * @brief Speichert den Index des Feldes, auf dem ein Bauer En Passant geschlagen werden kann(wenn vorhanden).
+     */
+    int enPassantSquare = NO_SQ;
 
-        /**
-         * @brief Speichert die Anzahl der Halbzüge, die seit dem letzten Bauer- oder Schlagzug vergangen sind.
-         */
-        int fiftyMoveRule = 0;
+    /**
+     * @brief Speichert die Anzahl der Halbzüge, die seit dem letzten Bauer- oder Schlagzug vergangen sind.
+     */
+    int fiftyMoveRule = 0;
 
-        /**
-         * @brief Speichert alle noch offenen Rochaden.
-         */
-        int castlingPermission = WHITE_KINGSIDE_CASTLE  |
-                                 WHITE_QUEENSIDE_CASTLE |
-                                 BLACK_KINGSIDE_CASTLE  |
-                                 BLACK_QUEENSIDE_CASTLE;
+    /**
+     * @brief Speichert alle noch offenen Rochaden.
+     */
+    int castlingPermission = WHITE_KINGSIDE_CASTLE  |
+                             WHITE_QUEENSIDE_CASTLE |
+                             BLACK_KINGSIDE_CASTLE  |
+                             BLACK_QUEENSIDE_CASTLE;
 
-        /**
-         * @brief Ein Zobristhash des Schachbretts.
-         * https://www.chessprogramming.org/Zobrist_Hashing
-         */
-        uint64_t hashValue;
+    /**
+     * @brief Ein Zobristhash des Schachbretts.
+     * https://www.chessprogramming.org/Zobrist_Hashing
+     */
+    uint64_t hashValue = 0;
 
-        /**
-         * @brief Speichert alle gespielten Züge und notwendige Informationen um diesen effizient rückgängig zu machen.
-         */
-        std::vector<MoveHistoryEntry> moveHistory;
+    /**
+     * @brief Speichert die Anzahl der Halbzüge, die seit dem Anfang des Spiels vergangen sind.
+     */
+    unsigned int age = 0;
+};
+
+static_assert(std::is_trivially_copyable_v<BoardState>);
 
+/**
+ * @brief Enthält die Schach- und Fesselungsinformationen einer Position
+ * aus Sicht der Seite, die am Zug ist. Die Informationen werden bei Bedarf
+ * berechnet und im Schachbrett zwischengespeichert, bis die Position
+ * verändert wird. So teilen sich Zuggenerator, Legalitätsprüfung, SEE
+ * und Suche dieselbe Berechnung.
+ */
+struct CheckInfo {
+    /**
+     * @brief Die gegnerischen Figuren, die den eigenen König angreifen.
+     */
+    Bitboard checkers;
+
+    /**
+     * @brief Die Felder, auf die eine Figur ziehen muss, um ein einfaches Schach
+     * aufzuheben (die angreifende Figur und die Verbindungsfelder zum König).
+     */
+    Bitboard checkMask;
+
+    /**
+     * @brief Die Anzahl der angreifenden Figuren.
+     */
+    int numCheckers = 0;
+
+    /**
+     * @brief Die eigenen Figuren, die an den eigenen König gefesselt sind.
+     */
+    Bitboard pinned;
+
+    /**
+     * @brief Die Fesselungsstrahlen. Ein Strahl enthält alle Felder vom eigenen König
+     * (ausgeschlossen) bis zur fesselnden Figur (eingeschlossen). Eine gefesselte Figur
+     * darf nur auf Felder ihres Strahls ziehen.
+     */
+    Array<Bitboard, 8> pinRays;
+
+    /**
+     * @brief Die eigenen Figuren, die als einzige Figur zwischen einer eigenen
+     * Langschrittfigur und dem gegnerischen König stehen (Abzugsschach).
+     * Dieses und die folgenden Felder werden nur mit Board::getCheckInfo(true) berechnet.
+     */
+    Bitboard discoveredCheckCandidates;
+
+    /**
+     * @brief Die Strahlen der Abzugsschachs vom gegnerischen König (ausgeschlossen)
+     * bis zur eigenen Langschrittfigur (eingeschlossen).
+     */
+    Array<Bitboard, 8> discoveryRays;
+
+    /**
+     * @brief Die Felder, von denen aus eine eigene Figur eines Figurentyps
+     * den gegnerischen König angreifen würde.
+     */
+    Bitboard checkSquares[KING + 1];
+
+    /**
+     * @brief Gibt den Fesselungsstrahl einer gefesselten Figur zurück.
+     */
+    inline Bitboard getPinRay(int sq) const {
+        for(Bitboard ray : pinRays)
+            if(ray.getBit(sq))
+                return ray;
+
+        return Bitboard::ONES;
+    }
+
+    /**
+     * @brief Gibt den Strahl zurück, den eine Figur für ein Abzugsschach verlassen muss.
+     */
+    inline Bitboard getDiscoveryRay(int sq) const {
+        for(Bitboard ray : discoveryRays)
+            if(ray.getBit(sq))
+                return ray;
+
+        return Bitboard::ONES;
+    }
+};
+
+/**
+ * @brief Stellt ein Schachbrett dar.
+ * Die Klasse Board stellt ein Schachbrett dar und enthält Methoden zur Zuggeneration.
+ */
+class alignas(64) Board : private BoardState {
+    friend class Movegen;
+    
+    private:
         /**
-         * @brief Speichert die Anzahl der Halbzüge, die seit dem Anfang des Spiels vergangen sind.
+         * @brief Speichert alle gespielten Züge und notwendige Informationen um diesen effizient rückgängig zu machen.
          */
-        unsigned int age = 0;
+        MoveHistory moveHistory;
 
         /**
          * @brief Generiert einen Zobrist-Hash für das aktuelle Schachbrett.
@@ -305,15 +313,37 @@ class alignas(64) Board {
         void updateAttackBitboards(int side, Bitboard updatedSquares, int capturedPiece, bool wasPromotion);
 
         /**
-         * @brief Generiert ein Bitboard, das alle Felder enthält, auf denen sich gefesselte Figuren befinden.
-         * Außerdem wird die Richtung, aus der die Figuren gefesselt sind, in einem 64 int großen Array gespeichert.
+         * @brief Die zwischengespeicherten Schach- und Fesselungsinformationen.
+         * Sind nur gültig, wenn checkInfoValid gesetzt ist.
+         */
+        mutable CheckInfo checkInfo;
+        mutable bool checkInfoValid = false;
+        mutable bool checkSquaresValid = false;
+
+        /**
+         * @brief Berechnet die Angreifer und Fesselungen des eigenen Königs.
+         */
+        void computeCheckInfo() const;
+
+        /**
+         * @brief Berechnet die Kandidaten für Abzugsschachs und die Schachfelder
+         * für jeden Figurentyp.
+         */
+        void computeCheckSquares() const;
+
+        /**
+         * @brief Findet alle Figuren, die als einzige Figur zwischen einem König
+         * und einer Langschrittfigur stehen.
          * 
-         * @param side Die Seite, für die gefesselte Figuren gefunden werden sollen.
-         * @param pinnedPiecesBitboard Das Bitboard, das alle gefesselten Figuren enthält.
-         * @param pinnedPiecesDirection Das Array, in dem die Richtung, aus der die Figuren gefesselt sind, gespeichert wird(muss mind. 8 groß sein).
+         * @param kingSquare Das Feld des Königs.
+         * @param diagonalSliders Die Langschrittfiguren, die diagonal angreifen.
+         * @param straightSliders Die Langschrittfiguren, die gradlinig angreifen.
+         * @param candidates Die Figuren, die berücksichtigt werden sollen.
+         * @param rays Die Strahlen vom König (ausgeschlossen) bis zur Langschrittfigur (eingeschlossen) für jede gefundene Figur.
+         * @return Die gefundenen Figuren.
          */
-        void generatePinnedPiecesBitboards(int side, Bitboard& pinnedPiecesBitboard,
-                                           int* pinnedPiecesDirection) const;
+        Bitboard findSliderBlockers(int kingSquare, Bitboard diagonalSliders, Bitboard straightSliders,
+                                    Bitboard candidates, Array<Bitboard, 8>& rays) const;
 
     public:
         /**
@@ -327,6 +357,56 @@ class alignas(64) Board {
          */
         Board(std::string fen);
 
+        /**
+         * @brief Erstellt ein Schachbrett aus einem Positionszustand ohne Zughistorie.
+         * Dabei wird kein Speicher reserviert.
+         * 
+         * @param state Der Positionszustand.
+         */
+        explicit Board(const BoardState& state) : BoardState(state) {}
+
+        /**
+         * @brief Erstellt ein Schachbrett aus einer gepackten Position ohne Zughistorie.
+         * 
+         * @param packedBoard Die gepackte Position.
+         * @throws std::invalid_argument Wenn die Position ungültig ist (siehe validatePackedBoard).
+         */
+        explicit Board(const PackedBoard& packedBoard);
+
+        /**
+         * @brief Überprüft, ob eine gepackte Position gültig ist, ohne ein Schachbrett
+         * zu erstellen: Höchstens 32 Figuren mit gültigen Figurcodes, genau ein König
+         * pro Seite, passende Rochaderechte und En-Passant-Feld und der König
+         * der Seite, die nicht am Zug ist, steht nicht im Schach.
+         * 
+         * @return nullptr, wenn die Position gültig ist, ansonsten eine Beschreibung des Fehlers.
+         */
+        static const char* validatePackedBoard(const PackedBoard& packedBoard);
+
+        /**
+         * @brief Erstellt ein Schachbrett aus einem Positionszustand, dessen
+         * Zughistorie in einem Speicherbereich des Aufrufers abgelegt wird.
+         * Der Speicherbereich muss das Schachbrett (und alle Kopien, die
+         * nicht erneut zugewiesen wurden) überleben.
+         * 
+         * @param state Der Positionszustand.
+         * @param historyArena Der Speicherbereich für die Zughistorie.
+         * @param historyCapacity Die Anzahl der Einträge, die in den Speicherbereich passen.
+         */
+        Board(const BoardState& state, MoveHistoryEntry* historyArena, size_t historyCapacity)
+            : BoardState(state), moveHistory(historyArena, historyCapacity) {}
+
+        /**
+         * @brief Kopiert die Position eines anderen Schachbretts. Von dessen
+         * Zughistorie werden nur die Einträge übernommen, die für die Erkennung
+         * von Stellungswiederholungen notwendig sind (seit dem letzten Bauern-
+         * oder Schlagzug), mindestens aber der letzte Zug.
+         * Der Speicher der eigenen Zughistorie wird dabei wiederverwendet.
+         * 
+         * @param other Das andere Schachbrett.
+         */
+        void copyPosition(const Board& other);
+
         /**
          * @brief Liest aus einem Inputstream ein Schachbrett in PGN-Notation.
          * Der Inputstream wird sich nach dem Lesen am Ende des PGN-Strings befinden.
@@ -387,6 +467,35 @@ class alignas(64) Board {
          */
         bool isCheck() const;
 
+        /**
+         * @brief Gibt die Schach- und Fesselungsinformationen der aktuellen Position zurück.
+         * Diese werden beim ersten Aufruf nach einer Veränderung der Position berechnet.
+         * 
+         * @param withCheckSquares Gibt an, ob auch die Kandidaten für Abzugsschachs und die
+         * Schachfelder benötigt werden. Der Zuggenerator benötigt nur die Angreifer und Fesselungen.
+         */
+        inline const CheckInfo& getCheckInfo(bool withCheckSquares = true) const {
+            if(!checkInfoValid) {
+                computeCheckInfo();
+                checkInfoValid = true;
+            }
+
+            if(withCheckSquares && !checkSquaresValid) {
+                computeCheckSquares();
+                checkSquaresValid = true;
+            }
+
+            return checkInfo;
+        }
+
+        /**
+         * @brief Überprüft, ob ein legaler Zug den Gegner in Schach setzt,
+         * ohne den Zug auszuführen.
+         * 
+         * @param move Der Zug.
+         */
+        bool givesCheck(Move move) const;
+
         /**
          * @brief Generiert alle legalen Züge.
          * Legale Züge sind Züge, die auf dem Schachbrett möglich sind und den eigenen König nicht im Schach lassen.
@@ -428,6 +537,12 @@ class alignas(64) Board {
          */
         std::string toFEN() const;
 
+        /**
+         * @brief Packt die aktuelle Stellung in ein kompaktes Binärformat.
+         * Die Zughistorie und die Anzahl der gespielten Züge gehen dabei verloren.
+         */
+        PackedBoard toPackedBoard() const;
+
         /**
          * @brief Wandelt das Spiel in einen PGN-String um.
          * 
@@ -496,11 +611,16 @@ class alignas(64) Board {
          */
         constexpr int getCastlingPermission() const { return castlingPermission; };
 
+        /**
+         * @brief Gibt den Positionszustand (ohne Zughistorie) zurück.
+         */
+        constexpr const BoardState& getState() const { return *this; };
+
         /**
          * @brief Gibt en letzten gespielten Zug zurück.
          */
         inline Move getLastMove() const { 
-            if(moveHistory.size() > 0)
+            if(!moveHistory.empty())
                 return moveHistory.back().move; 
             else
                 return Move();
@@ -513,7 +633,7 @@ class alignas(64) Board {
             return moveHistory.back();
         };
 
-        constexpr const std::vector<MoveHistoryEntry>& getMoveHistory() const { return moveHistory; };
+        constexpr const MoveHistory& getMoveHistory() const { return moveHistory; };
 
         /**
          * @brief Gibt alle Positionen eines bestimmten Figurentyps oder einer Farbe zurück.
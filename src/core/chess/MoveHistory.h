@@ -0,0 +1,258 @@
+#ifndef MOVE_HISTORY_H
+#define MOVE_HISTORY_H
+
+#include "core/chess/Move.h"
+#include "core/utils/Bitboard.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdint.h>
+#include <type_traits>
+
+/**
+ * @brief Enthält alle notwendigen Informationen um einen Zug rückgängig zu machen.
+ */
+class MoveHistoryEntry {
+    public:
+        /**
+         * @brief Speichert den Typ der geschlagenen Figur.
+         */
+        int capturedPiece;
+
+        /**
+         * @brief Speichert alle möglichen Rochaden vor diesem Zug.
+         */
+        int castlingPermission;
+
+        /**
+         * @brief Speichert die Position eines möglichen En Passant Zuges vor diesem Zug(wenn möglich).
+         */
+        int enPassantSquare;
+
+        /**
+         * @brief Der 50-Zug Counter vor diesem Zug.
+         */
+        int fiftyMoveRule;
+
+        /**
+         * @brief Speichert den Hashwert vor diesem Zug.
+         */
+        uint64_t hashValue;
+
+        /**
+         * @brief Speichert alle individuellen Figurenbitboards vor diesem Zug.
+        */
+        Bitboard pieceBitboard[15];
+
+        /**
+         * @brief Speichert die Angriffsbitboards der Figuren vor diesem Zug.
+         */
+        Bitboard attackBitboard[15];
+
+        /**
+         * @brief Der Zug der rückgängig gemacht werden soll.
+         */
+        Move move;
+
+        MoveHistoryEntry() = default;
+
+        /**
+         * @brief Erstellt einen neuen MoveHistoryEntry.
+         * @param move Der Zug der rückgängig gemacht werden soll.
+         * @param capturedPiece Speichert den Typ der geschlagenen Figur.
+         * @param castlePermission Speichert alle möglichen Rochaden vor diesem Zug.
+         * @param enPassantSquare Speichert die Position eines möglichen En Passant Zuges vor diesem Zug(wenn möglich).
+         * @param fiftyMoveRule Der 50-Zug Counter vor diesem Zug.
+         * @param hashValue Speichert den Hashwert vor diesem Zug.
+         * @param pieceBitboards Speichert alle individuellen Figurenbitboards vor diesem Zug.
+         * @param pieceAttackBitboards Speichert die Angriffsbitboards der Figuren vor diesem Zug.
+         */
+        constexpr MoveHistoryEntry(Move move, int capturedPiece, int castlePermission,
+                        int enPassantSquare, int fiftyMoveRule, uint64_t hashValue,
+                        Bitboard pieceBitboards[15], Bitboard attackBitboards[15]) {
+            this->move = move;
+            this->capturedPiece = capturedPiece;
+            this->castlingPermission = castlePermission;
+            this->enPassantSquare = enPassantSquare;
+            this->fiftyMoveRule = fiftyMoveRule;
+            this->hashValue = hashValue;
+
+            std::copy(pieceBitboards, pieceBitboards + 15, this->pieceBitboard);
+            std::copy(attackBitboards, attackBitboards + 15, this->attackBitboard);
+        }
+
+        /**
+         * @brief Erstellt einen neuen MoveHistoryEntry.
+         * @param move Der Zug der rückgängig gemacht werden soll.
+         */
+        constexpr MoveHistoryEntry(Move move) {
+            this->move = move;
+        }
+};
+
+static_assert(std::is_trivially_copyable_v<MoveHistoryEntry>);
+
+/**
+ * @brief Ein Stack von MoveHistoryEntry-Objekten, der die Zughistorie eines Schachbretts speichert.
+ *
+ * Im Gegensatz zu einem std::vector wird beim Erstellen oder Kopieren einer leeren
+ * Historie kein Speicher reserviert. Der Speicher wird erst beim ersten Zug angefordert
+ * und bei einer Zuweisung wiederverwendet, solange die Kapazität ausreicht.
+ * Optional kann der Aufrufer einen eigenen Speicherbereich (Arena) übergeben,
+ * z.B. ein Array auf dem Stack. Die Arena gehört weiterhin dem Aufrufer und muss
+ * die Historie überleben. Reicht ihre Kapazität nicht aus, wird die Historie
+ * in einen eigenen Speicherbereich umgezogen.
+ */
+class MoveHistory {
+    private:
+        /**
+         * @brief Die minimale Kapazität eines selbst reservierten Speicherbereichs.
+         */
+        static constexpr uint32_t MIN_CAPACITY = 64;
+
+        MoveHistoryEntry* entries = nullptr;
+        uint32_t numEntries = 0;
+        uint32_t capacity = 0;
+
+        /**
+         * @brief Gibt an, ob der Speicherbereich von dieser Historie
+         * reserviert wurde (und wieder freigegeben werden muss).
+         */
+        bool ownsEntries = false;
+
+        /**
+         * @brief Zieht die Historie in einen eigenen Speicherbereich mit
+         * mindestens der angegebenen Kapazität um.
+         */
+        inline void reallocate(uint32_t minCapacity) {
+            uint32_t newCapacity = std::max({minCapacity, 2 * capacity, MIN_CAPACITY});
+            MoveHistoryEntry* newEntries = new MoveHistoryEntry[newCapacity];
+
+            if(numEntries > 0)
+                memcpy(newEntries, entries, sizeof(MoveHistoryEntry) * numEntries);
+
+            if(ownsEntries)
+                delete[] entries;
+
+            entries = newEntries;
+            capacity = newCapacity;
+            ownsEntries = true;
+        }
+
+    public:
+        /**
+         * @brief Erstellt eine leere Historie ohne Speicherbereich.
+         */
+        constexpr MoveHistory() = default;
+
+        /**
+         * @brief Erstellt eine leere Historie, die den Speicherbereich
+         * des Aufrufers verwendet.
+         *
+         * @param arena Der Speicherbereich.
+         * @param capacity Die Anzahl der Einträge, die in den Speicherbereich passen.
+         */
+        constexpr MoveHistory(MoveHistoryEntry* arena, size_t capacity)
+            : entries(arena), capacity(capacity) {}
+
+        inline MoveHistory(const MoveHistory& other) {
+            assign(other.begin(), other.size());
+        }
+
+        inline MoveHistory(MoveHistory&& other) noexcept
+            : entries(other.entries), numEntries(other.numEntries),
+              capacity(other.capacity), ownsEntries(other.ownsEntries) {
+            other.entries = nullptr;
+            other.numEntries = 0;
+            other.capacity = 0;
+            other.ownsEntries = false;
+        }
+
+        inline ~MoveHistory() {
+            if(ownsEntries)
+                delete[] entries;
+        }
+
+        inline MoveHistory& operator=(const MoveHistory& other) {
+            if(this != &other)
+                assign(other.begin(), other.size());
+
+            return *this;
+        }
+
+        inline MoveHistory& operator=(MoveHistory&& other) noexcept {
+            if(this != &other) {
+                if(ownsEntries)
+                    delete[] entries;
+
+                entries = other.entries;
+                numEntries = other.numEntries;
+                capacity = other.capacity;
+                ownsEntries = other.ownsEntries;
+
+                other.entries = nullptr;
+                other.numEntries = 0;
+                other.capacity = 0;
+                other.ownsEntries = false;
+            }
+
+            return *this;
+        }
+
+        /**
+         * @brief Ersetzt den Inhalt der Historie durch die gegebenen Einträge.
+         * Der vorhandene Speicherbereich wird wiederverwendet, wenn er groß genug ist.
+         */
+        inline void assign(const MoveHistoryEntry* first, size_t count) {
+            numEntries = 0;
+
+            if(count > capacity)
+                reallocate(count);
+
+            if(count > 0)
+                memcpy(entries, first, sizeof(MoveHistoryEntry) * count);
+
+            numEntries = count;
+        }
+
+        /**
+         * @brief Legt einen neuen Eintrag auf den Stack und gibt eine Referenz darauf zurück.
+         * Die Referenz bleibt bis zum nächsten Aufruf von push() gültig.
+         *
+         * @param move Der Zug des neuen Eintrags.
+         */
+        inline MoveHistoryEntry& push(Move move) {
+            if(numEntries == capacity)
+                reallocate(numEntries + 1);
+
+            MoveHistoryEntry& entry = entries[numEntries++];
+            entry.move = move;
+            return entry;
+        }
+
+        /**
+         * @brief Entfernt den obersten Eintrag.
+         */
+        constexpr void pop() { numEntries--; }
+
+        /**
+         * @brief Entfernt alle Einträge, behält aber den Speicherbereich.
+         */
+        constexpr void clear() { numEntries = 0; }
+
+        constexpr size_t size() const { return numEntries; }
+        constexpr bool empty() const { return numEntries == 0; }
+
+        constexpr MoveHistoryEntry& back() { return entries[numEntries - 1]; }
+        constexpr const MoveHistoryEntry& back() const { return entries[numEntries - 1]; }
+
+        constexpr MoveHistoryEntry& operator[](size_t index) { return entries[index]; }
+        constexpr const MoveHistoryEntry& operator[](size_t index) const { return entries[index]; }
+
+        constexpr MoveHistoryEntry* begin() { return entries; }
+        constexpr const MoveHistoryEntry* begin() const { return entries; }
+        constexpr MoveHistoryEntry* end() { return entries + numEntries; }
+        constexpr const MoveHistoryEntry* end() const { return entries + numEntries; }
+};
+
+#endif
\ No newline at end of file
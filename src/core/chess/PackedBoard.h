@@ -0,0 +1,47 @@
+#ifndef PACKED_BOARD_H
+#define PACKED_BOARD_H
+
+#include <stdint.h>
+#include <type_traits>
+
+/**
+ * @brief Eine kompakte, binär speicherbare Darstellung einer Position (27 Bytes).
+ * Enthält keine Zughistorie und keine Anzahl der gespielten Züge.
+ *
+ * Die Figuren werden in aufsteigender Reihenfolge der belegten Felder
+ * gespeichert, zwei Figuren pro Byte (die erste Figur im unteren Nibble).
+ * Da eine Figur aus Farbe und Typ besteht (z.B. BLACK_QUEEN = 8 | 5),
+ * passt sie genau in ein Nibble.
+ */
+struct PackedBoard {
+    /**
+     * @brief Das Bitboard aller belegten Felder in Little-Endian-Reihenfolge.
+     */
+    uint8_t occupancy[8];
+
+    /**
+     * @brief Die Figuren auf den belegten Feldern, nibbleweise gepackt.
+     */
+    uint8_t pieces[16];
+
+    /**
+     * @brief Bit 0: Die Farbe am Zug (1 = Schwarz).
+     * Bits 1-4: Die noch möglichen Rochaden.
+     */
+    uint8_t sideAndCastling;
+
+    /**
+     * @brief Das En Passant Feld oder NO_SQ.
+     */
+    uint8_t enPassantSquare;
+
+    /**
+     * @brief Die Anzahl der Halbzüge seit dem letzten Bauer- oder Schlagzug (gekappt auf 255).
+     */
+    uint8_t fiftyMoveRule;
+};
+
+static_assert(sizeof(PackedBoard) == 27);
+static_assert(std::is_trivially_copyable_v<PackedBoard>);
+
+#endif
\ No newline at end of file
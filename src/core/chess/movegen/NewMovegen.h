@@ -9,51 +9,42 @@
  * legale (Schlag-)Züge für eine gegebene Stellung zu generieren.
  */
 class Movegen {
-    struct PrecomputedInfo {
-        Bitboard pinnedPieces;
-        Bitboard attackingRays;
-        const Array<int, 64>& pinDirections;
-        int numAttackers;
-    };
-
     public:
         template <int color>
         static void generateLegalMoves(const Board& board, Array<Move, 256>& moves,
-                                int numAttackers, Bitboard attackingRays,
-                                Bitboard pinnedPieces, const Array<int, 64>& pinDirections) noexcept;
+                                       const CheckInfo& checkInfo) noexcept;
 
         template <int color>
         static void generateLegalCaptures(const Board& board, Array<Move, 256>& moves,
-                                int numAttackers, Bitboard attackingRays,
-                                Bitboard pinnedPieces, const Array<int, 64>& pinDirections) noexcept;
+                                          const CheckInfo& checkInfo) noexcept;
 
     private:
         template <int color, bool checkEnPassant>
-        static inline void generatePawnMoves(const Board& board, Array<Move, 256>& moves, const PrecomputedInfo& precomputedInfo) noexcept;
+        static inline void generatePawnMoves(const Board& board, Array<Move, 256>& moves, const CheckInfo& checkInfo) noexcept;
 
         template <int color>
-        static inline void generateKnightMoves(const Board& board, Array<Move, 256>& moves, const PrecomputedInfo& precomputedInfo) noexcept;
+        static inline void generateKnightMoves(const Board& board, Array<Move, 256>& moves, const CheckInfo& checkInfo) noexcept;
 
         template <int color>
-        static inline void generateDiagonalSlidingMoves(const Board& board, Array<Move, 256>& moves, const PrecomputedInfo& precomputedInfo) noexcept;
+        static inline void generateDiagonalSlidingMoves(const Board& board, Array<Move, 256>& moves, const CheckInfo& checkInfo) noexcept;
 
         template <int color>
-        static inline void generateHorizontalSlidingMoves(const Board& board, Array<Move, 256>& moves, const PrecomputedInfo& precomputedInfo) noexcept;
+        static inline void generateHorizontalSlidingMoves(const Board& board, Array<Move, 256>& moves, const CheckInfo& checkInfo) noexcept;
 
         template <int color>
         static inline void generateKingMoves(const Board& board, Array<Move, 256>& moves) noexcept;
 
         template <int color, bool checkEnPassant>
-        static inline void generatePawnCaptures(const Board& board, Array<Move, 256>& moves, const PrecomputedInfo& precomputedInfo) noexcept;
+        static inline void generatePawnCaptures(const Board& board, Array<Move, 256>& moves, const CheckInfo& checkInfo) noexcept;
 
         template <int color>
-        static inline void generateKnightCaptures(const Board& board, Array<Move, 256>& moves, const PrecomputedInfo& precomputedInfo) noexcept;
+        static inline void generateKnightCaptures(const Board& board, Array<Move, 256>& moves, const CheckInfo& checkInfo) noexcept;
 
         template <int color>
-        static inline void generateDiagonalSlidingCaptures(const Board& board, Array<Move, 256>& moves, const PrecomputedInfo& precomputedInfo) noexcept;
+        static inline void generateDiagonalSlidingCaptures(const Board& board, Array<Move, 256>& moves, const CheckInfo& checkInfo) noexcept;
 
         template <int color>
-        static inline void generateHorizontalSlidingCaptures(const Board& board, Array<Move, 256>& moves, const PrecomputedInfo& precomputedInfo) noexcept;
+        static inline void generateHorizontalSlidingCaptures(const Board& board, Array<Move, 256>& moves, const CheckInfo& checkInfo) noexcept;
 
         template <int color>
         static inline void generateKingCaptures(const Board& board, Array<Move, 256>& moves) noexcept;
@@ -61,21 +52,18 @@ class Movegen {
 
 template <int color>
 void Movegen::generateLegalMoves(const Board& board, Array<Move, 256>& moves,
-                                 int numAttackers, Bitboard attackingRays,
-                                 Bitboard pinnedPieces, const Array<int, 64>& pinDirections) noexcept {
-
-    PrecomputedInfo info = {pinnedPieces, attackingRays, pinDirections, numAttackers};
+                                 const CheckInfo& checkInfo) noexcept {
 
-    if(numAttackers < 2) {
+    if(checkInfo.numCheckers < 2) {
         bool checkEnPassant = board.getEnPassantSquare() != NO_SQ;
         if(checkEnPassant)
-            generatePawnMoves<color, true>(board, moves, info);
+            generatePawnMoves<color, true>(board, moves, checkInfo);
         else
-            generatePawnMoves<color, false>(board, moves, info);
+            generatePawnMoves<color, false>(board, moves, checkInfo);
         
-        generateKnightMoves<color>(board, moves, info);
-        generateDiagonalSlidingMoves<color>(board, moves, info);
-        generateHorizontalSlidingMoves<color>(board, moves, info);
+        generateKnightMoves<color>(board, moves, checkInfo);
+        generateDiagonalSlidingMoves<color>(board, moves, checkInfo);
+        generateHorizontalSlidingMoves<color>(board, moves, checkInfo);
     }
 
     generateKingMoves<color>(board, moves);
@@ -83,28 +71,25 @@ void Movegen::generateLegalMoves(const Board& board, Array<Move, 256>& moves,
 
 template <int color>
 void Movegen::generateLegalCaptures(const Board& board, Array<Move, 256>& moves,
-                                    int numAttackers, Bitboard attackingRays,
-                                    Bitboard pinnedPieces, const Array<int, 64>& pinDirections) noexcept {
+                                    const CheckInfo& checkInfo) noexcept {
 
-    PrecomputedInfo info = {pinnedPieces, attackingRays, pinDirections, numAttackers};
-
-    if(numAttackers < 2) {
+    if(checkInfo.numCheckers < 2) {
         bool checkEnPassant = board.getEnPassantSquare() != NO_SQ;
         if(checkEnPassant)
-            generatePawnCaptures<color, true>(board, moves, info);
+            generatePawnCaptures<color, true>(board, moves, checkInfo);
         else
-            generatePawnCaptures<color, true>(board, moves, info);
+            generatePawnCaptures<color, false>(board, moves, checkInfo);
         
-        generateKnightCaptures<color>(board, moves, info);
-        generateDiagonalSlidingCaptures<color>(board, moves, info);
-        generateHorizontalSlidingCaptures<color>(board, moves, info);
+        generateKnightCaptures<color>(board, moves, checkInfo);
+        generateDiagonalSlidingCaptures<color>(board, moves, checkInfo);
+        generateHorizontalSlidingCaptures<color>(board, moves, checkInfo);
     }
 
     generateKingCaptures<color>(board, moves);
 }
 
 template <int color, bool checkEnPassant>
-inline void Movegen::generatePawnMoves(const Board& board, Array<Move, 256>& moves, const PrecomputedInfo& precomputedInfo) noexcept {
+inline void Movegen::generatePawnMoves(const Board& board, Array<Move, 256>& moves, const CheckInfo& checkInfo) noexcept {
     constexpr int pawnPiece = color == WHITE ? WHITE_PAWN : BLACK_PAWN;
     constexpr int forw = color == WHITE ? NORTH : SOUTH;
     constexpr int forw2 = color == WHITE ? 2 * NORTH : 2 * SOUTH;
@@ -118,7 +103,7 @@ inline void Movegen::generatePawnMoves(const Board& board, Array<Move, 256>& mov
     Bitboard pawns = board.getPieceBitboard(pawnPiece);
 
     // Wenn der eigene König von genau einer Figur angegriffen wird, kann der Bauer den Angreifer schlagen oder sich dazwischen stellen
-    if(precomputedInfo.numAttackers == 1) {
+    if(checkInfo.numCheckers == 1) {
         while(pawns) {
             int sq = pawns.popFSB();
             int rank = SQ2R(sq);
@@ -126,7 +111,7 @@ inline void Movegen::generatePawnMoves(const Board& board, Array<Move, 256>& mov
             int forw2Sq = sq + forw2;
 
             // Wenn der Bauer gefesselt ist, kann er sich nicht bewegen
-            if(precomputedInfo.pinnedPieces.getBit(sq))
+            if(checkInfo.pinned.getBit(sq))
                 continue;
 
             if constexpr(checkEnPassant) {
@@ -138,13 +123,13 @@ inline void Movegen::generatePawnMoves(const Board& board, Array<Move, 256>& mov
                     Bitboard enPasSqBB = Bitboard(1ULL << enPasSq);
 
                     if((pawnAttackBitboard(sq, ownColor) & captureSqBB) &&
-                    (captureSqBB | enPasSqBB) & precomputedInfo.attackingRays)
+                    (captureSqBB | enPasSqBB) & checkInfo.checkMask)
                         moves.push_back(Move(sq, captureSq, MOVE_EN_PASSANT));
                 }
             }
 
             // Der Bauer könnte sich dazwischen stellen
-            if(precomputedInfo.attackingRays.getBit(forwSq) &&
+            if(checkInfo.checkMask.getBit(forwSq) &&
                board.pieces[forwSq] == EMPTY) {
 
                 if(rank == promotionRank) {
@@ -155,7 +140,7 @@ inline void Movegen::generatePawnMoves(const Board& board, Array<Move, 256>& mov
                 } else
                     moves.push_back(Move(sq, forwSq, MOVE_QUIET));
             } else if(rank == startingRank &&
-                      precomputedInfo.attackingRays.getBit(forw2Sq) &&
+                      checkInfo.checkMask.getBit(forw2Sq) &&
                       board.pieces[forwSq] == EMPTY &&
                         board.pieces[forw2Sq] == EMPTY) {
 
@@ -164,7 +149,7 @@ inline void Movegen::generatePawnMoves(const Board& board, Array<Move, 256>& mov
 
             // Der Bauer könnte den Angreifer schlagen
             Bitboard pawnAttacks = pawnAttackBitboard(sq, ownColor) &
-                                   precomputedInfo.attackingRays &
+                                   checkInfo.checkMask &
                                    enemyPieces;
 
             // Es kann maximal einen Angreifer geben, also ist das hier sicher
@@ -186,7 +171,7 @@ inline void Movegen::generatePawnMoves(const Board& board, Array<Move, 256>& mov
             int forwSq = sq + forw;
             int forw2Sq = sq + forw2;
 
-            bool isPinned = precomputedInfo.pinnedPieces.getBit(sq);
+            bool isPinned = checkInfo.pinned.getBit(sq);
 
             if constexpr(checkEnPassant) {
                 // En-Passant
@@ -198,12 +183,10 @@ inline void Movegen::generatePawnMoves(const Board& board, Array<Move, 256>& mov
                     // Es kann maximal ein En-Passant pro Zug geben, also ist das hier sicher
                     if(enPassantCaptures) {
                         int enPasSq = enPassantCaptures.getFSB();
-                        int captureDir = std::abs(enPasSq - sq);
                         
                         if(isPinned) {
-                            // Überprüfe, ob der Zug entlang der Pin-Richtung verläuft
-                            if(captureDir == precomputedInfo.pinDirections[sq] ||
-                            captureDir == -precomputedInfo.pinDirections[sq])
+                            // Überprüfe, ob der Zug entlang des Fesselungsstrahls verläuft
+                            if(checkInfo.getPinRay(sq).getBit(enPasSq))
                                 moves.push_back(Move(sq, enPasSq, MOVE_EN_PASSANT));
                         } else {
                             // En-Passant entfernt zwei Figuren von einem
@@ -243,18 +226,14 @@ inline void Movegen::generatePawnMoves(const Board& board, Array<Move, 256>& mov
             // den Angreifer schlagen oder nach vorne ziehen
             // (wenn die Fesselrichtung vertikal ist)
             if(isPinned) {
+                // Der Bauer kann nur die fesselnde Figur schlagen
+                Bitboard pinRay = checkInfo.getPinRay(sq);
                 Bitboard pawnAttacks = pawnAttackBitboard(sq, ownColor) &
-                                       enemyPieces;
+                                       enemyPieces & pinRay;
 
                 // Es kann maximal einen Angreifer geben, also ist das hier sicher
                 while(pawnAttacks) {
                     int captureSq = pawnAttacks.popFSB();
-                    int captureDir = std::abs(captureSq - sq);
-
-                    // Überprüfe, ob der Zug nicht entlang der Pin-Richtung verläuft
-                    if(captureDir != precomputedInfo.pinDirections[sq] &&
-                       captureDir != -precomputedInfo.pinDirections[sq])
-                        continue;
 
                     if(rank == promotionRank) {
                         moves.push_back(Move(sq, captureSq, MOVE_CAPTURE | MOVE_PROMOTION_QUEEN));
@@ -266,8 +245,7 @@ inline void Movegen::generatePawnMoves(const Board& board, Array<Move, 256>& mov
                 }
 
                 // Überprüfe, ob der Bauer nach vorne ziehen kann
-                if(precomputedInfo.pinDirections[sq] == NORTH ||
-                   precomputedInfo.pinDirections[sq] == SOUTH) {
+                if(pinRay.getBit(forwSq)) {
                     if(board.pieces[forwSq] == EMPTY) {
                         if(rank == promotionRank) {
                             moves.push_back(Move(sq, forwSq, MOVE_PROMOTION_QUEEN));
@@ -318,7 +296,7 @@ inline void Movegen::generatePawnMoves(const Board& board, Array<Move, 256>& mov
 }
 
 template <int color>
-inline void Movegen::generateKnightMoves(const Board& board, Array<Move, 256>& moves, const PrecomputedInfo& precomputedInfo) noexcept {
+inline void Movegen::generateKnightMoves(const Board& board, Array<Move, 256>& moves, const CheckInfo& checkInfo) noexcept {
     constexpr int knightPiece = color == WHITE ? WHITE_KNIGHT : BLACK_KNIGHT;
     Bitboard ownPieces = color == WHITE ?
         board.pieceBitboard[WHITE] : board.pieceBitboard[BLACK];
@@ -331,15 +309,15 @@ inline void Movegen::generateKnightMoves(const Board& board, Array<Move, 256>& m
         int sq = knights.popFSB();
 
         // Wenn der Springer gefesselt ist, kann er sich nicht bewegen
-        if(precomputedInfo.pinnedPieces.getBit(sq))
+        if(checkInfo.pinned.getBit(sq))
             continue;
 
         Bitboard knightAttacks = knightAttackBitboard(sq) & ~(ownPieces | ownKing);
 
         // Wenn es einen Angreifer gibt, muss der Springer ihn schlagen
         // oder sich dazwischen stellen
-        if(precomputedInfo.numAttackers == 1)
-            knightAttacks &= precomputedInfo.attackingRays;
+        if(checkInfo.numCheckers == 1)
+            knightAttacks &= checkInfo.checkMask;
         
         while(knightAttacks) {
             int captureSq = knightAttacks.popFSB();
@@ -353,7 +331,7 @@ inline void Movegen::generateKnightMoves(const Board& board, Array<Move, 256>& m
 }
 
 template <int color>
-inline void Movegen::generateDiagonalSlidingMoves(const Board& board, Array<Move, 256>& moves, const PrecomputedInfo& precomputedInfo) noexcept {
+inline void Movegen::generateDiagonalSlidingMoves(const Board& board, Array<Move, 256>& moves, const CheckInfo& checkInfo) noexcept {
     constexpr int bishopPiece = color == WHITE ? WHITE_BISHOP : BLACK_BISHOP;
     constexpr int queenPiece = color == WHITE ? WHITE_QUEEN : BLACK_QUEEN;
     Bitboard ownPieces = color == WHITE ?
@@ -364,18 +342,18 @@ inline void Movegen::generateDiagonalSlidingMoves(const Board& board, Array<Move
     Bitboard diagSlidingPieces = board.getPieceBitboard(bishopPiece) |
                                  board.getPieceBitboard(queenPiece);
 
-    if(precomputedInfo.numAttackers == 1) {
+    if(checkInfo.numCheckers == 1) {
         while(diagSlidingPieces) {
             int sq = diagSlidingPieces.popFSB();
 
             // Wenn die Figur gefesselt ist, kann sie sich nicht bewegen
-            if(precomputedInfo.pinnedPieces.getBit(sq))
+            if(checkInfo.pinned.getBit(sq))
                 continue;
 
             Bitboard attacks = diagonalAttackBitboard(sq,
                                 board.pieceBitboard[ALL_PIECES] | ownKing)
                                 & ~(ownPieces | ownKing)
-                                & precomputedInfo.attackingRays;
+                                & checkInfo.checkMask;
 
             while(attacks) {
                 int captureSq = attacks.popFSB();
@@ -393,18 +371,9 @@ inline void Movegen::generateDiagonalSlidingMoves(const Board& board, Array<Move
             Bitboard attacks = Bitboard::ONES;
 
             // Wenn die Figur gefesselt ist, kann sie sich nur
-            // entlang der Pin-Richtung bewegen
-            if(precomputedInfo.pinnedPieces.getBit(sq)) {
-                int pinDir = precomputedInfo.pinDirections[sq];
-                if(pinDir == NORTH_WEST || pinDir == SOUTH_EAST)
-                    attacks = (Magics::bishopAttackTopLeftMask(sq) |
-                               Magics::bishopAttackBottomRightMask(sq));
-                else if(pinDir == NORTH_EAST || pinDir == SOUTH_WEST)
-                    attacks = (Magics::bishopAttackTopRightMask(sq) |
-                               Magics::bishopAttackBottomLeftMask(sq));
-                else
-                    continue;
-            }
+            // entlang des Fesselungsstrahls bewegen
+            if(checkInfo.pinned.getBit(sq))
+                attacks = checkInfo.getPinRay(sq);
 
             attacks &= diagonalAttackBitboard(sq,
                         board.pieceBitboard[ALL_PIECES] | ownKing)
@@ -423,7 +392,7 @@ inline void Movegen::generateDiagonalSlidingMoves(const Board& board, Array<Move
 }
 
 template <int color>
-inline void Movegen::generateHorizontalSlidingMoves(const Board& board, Array<Move, 256>& moves, const PrecomputedInfo& precomputedInfo) noexcept {
+inline void Movegen::generateHorizontalSlidingMoves(const Board& board, Array<Move, 256>& moves, const CheckInfo& checkInfo) noexcept {
     constexpr int rookPiece = color == WHITE ? WHITE_ROOK : BLACK_ROOK;
     constexpr int queenPiece = color == WHITE ? WHITE_QUEEN : BLACK_QUEEN;
     Bitboard ownPieces = color == WHITE ?
@@ -434,18 +403,18 @@ inline void Movegen::generateHorizontalSlidingMoves(const Board& board, Array<Mo
     Bitboard horSlidingPieces = board.getPieceBitboard(rookPiece) |
                                 board.getPieceBitboard(queenPiece);
 
-    if(precomputedInfo.numAttackers == 1) {
+    if(checkInfo.numCheckers == 1) {
         while(horSlidingPieces) {
             int sq = horSlidingPieces.popFSB();
 
             // Wenn die Figur gefesselt ist, kann sie sich nicht bewegen
-            if(precomputedInfo.pinnedPieces.getBit(sq))
+            if(checkInfo.pinned.getBit(sq))
                 continue;
 
             Bitboard attacks = horizontalAttackBitboard(sq,
                                 board.pieceBitboard[ALL_PIECES] | ownKing)
                                 & ~(ownPieces | ownKing)
-                                & precomputedInfo.attackingRays;
+                                & checkInfo.checkMask;
 
             while(attacks) {
                 int captureSq = attacks.popFSB();
@@ -463,18 +432,9 @@ inline void Movegen::generateHorizontalSlidingMoves(const Board& board, Array<Mo
             Bitboard attacks = Bitboard::ONES;
 
             // Wenn die Figur gefesselt ist, kann sie sich nur
-            // entlang der Pin-Richtung bewegen
-            if(precomputedInfo.pinnedPieces.getBit(sq)) {
-                int pinDir = precomputedInfo.pinDirections[sq];
-                if(pinDir == NORTH || pinDir == SOUTH)
-                    attacks = (Magics::rookAttackTopMask(sq) |
-                               Magics::rookAttackBottomMask(sq));
-                else if(pinDir == EAST || pinDir == WEST)
-                    attacks = (Magics::rookAttackRightMask(sq) |
-                               Magics::rookAttackLeftMask(sq));
-                else
-                    continue;
-            }
+            // entlang des Fesselungsstrahls bewegen
+            if(checkInfo.pinned.getBit(sq))
+                attacks = checkInfo.getPinRay(sq);
 
             attacks &= horizontalAttackBitboard(sq,
                         board.pieceBitboard[ALL_PIECES] | ownKing)
@@ -575,7 +535,7 @@ inline void Movegen::generateKingMoves(const Board& board, Array<Move, 256>& mov
 }
 
 template <int color, bool checkEnPassant>
-inline void Movegen::generatePawnCaptures(const Board& board, Array<Move, 256>& moves, const PrecomputedInfo& precomputedInfo) noexcept {
+inline void Movegen::generatePawnCaptures(const Board& board, Array<Move, 256>& moves, const CheckInfo& checkInfo) noexcept {
     constexpr int pawnPiece = color == WHITE ? WHITE_PAWN : BLACK_PAWN;
     constexpr int forw = color == WHITE ? NORTH : SOUTH;
     constexpr int promotionRank = color == WHITE ? RANK_7 : RANK_2;
@@ -587,13 +547,13 @@ inline void Movegen::generatePawnCaptures(const Board& board, Array<Move, 256>&
     Bitboard pawns = board.getPieceBitboard(pawnPiece);
 
     // Wenn der eigene König von genau einer Figur angegriffen wird, kann der Bauer den Angreifer schlagen oder sich dazwischen stellen
-    if(precomputedInfo.numAttackers == 1) {
+    if(checkInfo.numCheckers == 1) {
         while(pawns) {
             int sq = pawns.popFSB();
             int rank = SQ2R(sq);
 
             // Wenn der Bauer gefesselt ist, kann er sich nicht bewegen
-            if(precomputedInfo.pinnedPieces.getBit(sq))
+            if(checkInfo.pinned.getBit(sq))
                 continue;
 
             if constexpr(checkEnPassant) {
@@ -605,14 +565,14 @@ inline void Movegen::generatePawnCaptures(const Board& board, Array<Move, 256>&
                     Bitboard enPasSqBB = Bitboard(1ULL << enPasSq);
 
                     if((pawnAttackBitboard(sq, ownColor) & captureSqBB) &&
-                    (captureSqBB | enPasSqBB) & precomputedInfo.attackingRays)
+                    (captureSqBB | enPasSqBB) & checkInfo.checkMask)
                         moves.push_back(Move(sq, captureSq, MOVE_EN_PASSANT));
                 }
             }
 
             // Der Bauer könnte den Angreifer schlagen
             Bitboard pawnAttacks = pawnAttackBitboard(sq, ownColor) &
-                                   precomputedInfo.attackingRays &
+                                   checkInfo.checkMask &
                                    enemyPieces;
 
             // Es kann maximal einen Angreifer geben, also ist das hier sicher
@@ -632,7 +592,7 @@ inline void Movegen::generatePawnCaptures(const Board& board, Array<Move, 256>&
             int sq = pawns.popFSB();
             int rank = SQ2R(sq);
 
-            bool isPinned = precomputedInfo.pinnedPieces.getBit(sq);
+            bool isPinned = checkInfo.pinned.getBit(sq);
 
             // En-Passant
             if constexpr(checkEnPassant) {
@@ -644,12 +604,10 @@ inline void Movegen::generatePawnCaptures(const Board& board, Array<Move, 256>&
                     // Es kann maximal ein En-Passant pro Zug geben, also ist das hier sicher
                     if(enPassantCaptures) {
                         int enPasSq = enPassantCaptures.getFSB();
-                        int captureDir = std::abs(enPasSq - sq);
                         
                         if(isPinned) {
-                            // Überprüfe, ob der Zug entlang der Pin-Richtung verläuft
-                            if(captureDir == precomputedInfo.pinDirections[sq] ||
-                            captureDir == -precomputedInfo.pinDirections[sq])
+                            // Überprüfe, ob der Zug entlang des Fesselungsstrahls verläuft
+                            if(checkInfo.getPinRay(sq).getBit(enPasSq))
                                 moves.push_back(Move(sq, enPasSq, MOVE_EN_PASSANT));
                         } else {
                             // En-Passant entfernt zwei Figuren von einem
@@ -688,18 +646,14 @@ inline void Movegen::generatePawnCaptures(const Board& board, Array<Move, 256>&
             // den Angreifer schlagen oder nach vorne ziehen
             // (wenn die Fesselrichtung vertikal ist)
             if(isPinned) {
+                // Der Bauer kann nur die fesselnde Figur schlagen
+                Bitboard pinRay = checkInfo.getPinRay(sq);
                 Bitboard pawnAttacks = pawnAttackBitboard(sq, ownColor) &
-                                       enemyPieces;
+                                       enemyPieces & pinRay;
 
                 // Es kann maximal einen Angreifer geben, also ist das hier sicher
                 while(pawnAttacks) {
                     int captureSq = pawnAttacks.popFSB();
-                    int captureDir = std::abs(captureSq - sq);
-
-                    // Überprüfe, ob der Zug nicht entlang der Pin-Richtung verläuft
-                    if(captureDir != precomputedInfo.pinDirections[sq] &&
-                       captureDir != -precomputedInfo.pinDirections[sq])
-                        continue;
 
                     if(rank == promotionRank) {
                         moves.push_back(Move(sq, captureSq, MOVE_CAPTURE | MOVE_PROMOTION_QUEEN));
@@ -731,7 +685,7 @@ inline void Movegen::generatePawnCaptures(const Board& board, Array<Move, 256>&
 }
 
 template <int color>
-inline void Movegen::generateKnightCaptures(const Board& board, Array<Move, 256>& moves, const PrecomputedInfo& precomputedInfo) noexcept {
+inline void Movegen::generateKnightCaptures(const Board& board, Array<Move, 256>& moves, const CheckInfo& checkInfo) noexcept {
     constexpr int knightPiece = color == WHITE ? WHITE_KNIGHT : BLACK_KNIGHT;
     Bitboard enemyPieces = color == WHITE ?
         board.pieceBitboard[BLACK] : board.pieceBitboard[WHITE];
@@ -742,14 +696,14 @@ inline void Movegen::generateKnightCaptures(const Board& board, Array<Move, 256>
         int sq = knights.popFSB();
 
         // Wenn der Springer gefesselt ist, kann er sich nicht bewegen
-        if(precomputedInfo.pinnedPieces.getBit(sq))
+        if(checkInfo.pinned.getBit(sq))
             continue;
 
         Bitboard knightAttacks = knightAttackBitboard(sq) & enemyPieces;
 
         // Wenn es einen Angreifer gibt, muss der Springer ihn schlagen
-        if(precomputedInfo.numAttackers == 1)
-            knightAttacks &= precomputedInfo.attackingRays;
+        if(checkInfo.numCheckers == 1)
+            knightAttacks &= checkInfo.checkMask;
         
         while(knightAttacks) {
             int captureSq = knightAttacks.popFSB();
@@ -759,7 +713,7 @@ inline void Movegen::generateKnightCaptures(const Board& board, Array<Move, 256>
 }
 
 template <int color>
-inline void Movegen::generateDiagonalSlidingCaptures(const Board& board, Array<Move, 256>& moves, const PrecomputedInfo& precomputedInfo) noexcept {
+inline void Movegen::generateDiagonalSlidingCaptures(const Board& board, Array<Move, 256>& moves, const CheckInfo& checkInfo) noexcept {
     constexpr int bishopPiece = color == WHITE ? WHITE_BISHOP : BLACK_BISHOP;
     constexpr int queenPiece = color == WHITE ? WHITE_QUEEN : BLACK_QUEEN;
     Bitboard ownKing = color == WHITE ?
@@ -770,18 +724,18 @@ inline void Movegen::generateDiagonalSlidingCaptures(const Board& board, Array<M
     Bitboard diagSlidingPieces = board.getPieceBitboard(bishopPiece) |
                                  board.getPieceBitboard(queenPiece);
 
-    if(precomputedInfo.numAttackers == 1) {
+    if(checkInfo.numCheckers == 1) {
         while(diagSlidingPieces) {
             int sq = diagSlidingPieces.popFSB();
 
             // Wenn die Figur gefesselt ist, kann sie sich nicht bewegen
-            if(precomputedInfo.pinnedPieces.getBit(sq))
+            if(checkInfo.pinned.getBit(sq))
                 continue;
 
             Bitboard attacks = diagonalAttackBitboard(sq,
                                 board.pieceBitboard[ALL_PIECES] | ownKing)
                                 & enemyPieces
-                                & precomputedInfo.attackingRays;
+                                & checkInfo.checkMask;
 
             while(attacks) {
                 int captureSq = attacks.popFSB();
@@ -795,18 +749,9 @@ inline void Movegen::generateDiagonalSlidingCaptures(const Board& board, Array<M
             Bitboard attacks = Bitboard::ONES;
 
             // Wenn die Figur gefesselt ist, kann sie sich nur
-            // entlang der Pin-Richtung bewegen
-            if(precomputedInfo.pinnedPieces.getBit(sq)) {
-                int pinDir = precomputedInfo.pinDirections[sq];
-                if(pinDir == NORTH_WEST || pinDir == SOUTH_EAST)
-                    attacks = (Magics::bishopAttackTopLeftMask(sq) |
-                               Magics::bishopAttackBottomRightMask(sq));
-                else if(pinDir == NORTH_EAST || pinDir == SOUTH_WEST)
-                    attacks = (Magics::bishopAttackTopRightMask(sq) |
-                               Magics::bishopAttackBottomLeftMask(sq));
-                else
-                    continue;
-            }
+            // entlang des Fesselungsstrahls bewegen
+            if(checkInfo.pinned.getBit(sq))
+                attacks = checkInfo.getPinRay(sq);
 
             attacks &= diagonalAttackBitboard(sq,
                         board.pieceBitboard[ALL_PIECES] | ownKing)
@@ -821,7 +766,7 @@ inline void Movegen::generateDiagonalSlidingCaptures(const Board& board, Array<M
 }
 
 template <int color>
-inline void Movegen::generateHorizontalSlidingCaptures(const Board& board, Array<Move, 256>& moves, const PrecomputedInfo& precomputedInfo) noexcept {
+inline void Movegen::generateHorizontalSlidingCaptures(const Board& board, Array<Move, 256>& moves, const CheckInfo& checkInfo) noexcept {
     constexpr int rookPiece = color == WHITE ? WHITE_ROOK : BLACK_ROOK;
     constexpr int queenPiece = color == WHITE ? WHITE_QUEEN : BLACK_QUEEN;
     Bitboard ownKing = color == WHITE ?
@@ -832,18 +777,18 @@ inline void Movegen::generateHorizontalSlidingCaptures(const Board& board, Array
     Bitboard horSlidingPieces = board.getPieceBitboard(rookPiece) |
                                 board.getPieceBitboard(queenPiece);
 
-    if(precomputedInfo.numAttackers == 1) {
+    if(checkInfo.numCheckers == 1) {
         while(horSlidingPieces) {
             int sq = horSlidingPieces.popFSB();
 
             // Wenn die Figur gefesselt ist, kann sie sich nicht bewegen
-            if(precomputedInfo.pinnedPieces.getBit(sq))
+            if(checkInfo.pinned.getBit(sq))
                 continue;
 
             Bitboard attacks = horizontalAttackBitboard(sq,
                                 board.pieceBitboard[ALL_PIECES] | ownKing)
                                 & enemyPieces
-                                & precomputedInfo.attackingRays;
+                                & checkInfo.checkMask;
 
             while(attacks) {
                 int captureSq = attacks.popFSB();
@@ -857,18 +802,9 @@ inline void Movegen::generateHorizontalSlidingCaptures(const Board& board, Array
             Bitboard attacks = Bitboard::ONES;
 
             // Wenn die Figur gefesselt ist, kann sie sich nur
-            // entlang der Pin-Richtung bewegen
-            if(precomputedInfo.pinnedPieces.getBit(sq)) {
-                int pinDir = precomputedInfo.pinDirections[sq];
-                if(pinDir == NORTH || pinDir == SOUTH)
-                    attacks = (Magics::rookAttackTopMask(sq) |
-                               Magics::rookAttackBottomMask(sq));
-                else if(pinDir == EAST || pinDir == WEST)
-                    attacks = (Magics::rookAttackRightMask(sq) |
-                               Magics::rookAttackLeftMask(sq));
-                else
-                    continue;
-            }
+            // entlang des Fesselungsstrahls bewegen
+            if(checkInfo.pinned.getBit(sq))
+                attacks = checkInfo.getPinRay(sq);
 
             attacks &= horizontalAttackBitboard(sq,
                         board.pieceBitboard[ALL_PIECES] | ownKing)
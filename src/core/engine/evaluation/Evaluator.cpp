@@ -23,28 +23,41 @@ int Evaluator::getSmallestAttacker(int to, int side) {
 
     if(!board.getAttackBitboard(side).getBit(to))
         return NO_SQ;
+
+    // Figuren, die an den eigenen König gefesselt sind,
+    // dürfen nur entlang ihres Fesselungsstrahls schlagen
+    Bitboard allowedAttackers = Bitboard::ONES;
+    if(side == board.getSideToMove()) {
+        const CheckInfo& checkInfo = board.getCheckInfo(false);
+        Bitboard pinned = checkInfo.pinned;
+        while(pinned) {
+            int sq = pinned.popFSB();
+            if(!checkInfo.getPinRay(sq).getBit(to))
+                allowedAttackers.clearBit(sq);
+        }
+    }
     
-    Bitboard pawnAttackers = pawnAttackBitboard(to, otherSide) & board.getPieceBitboard(side | PAWN);
+    Bitboard pawnAttackers = pawnAttackBitboard(to, otherSide) & board.getPieceBitboard(side | PAWN) & allowedAttackers;
     if(pawnAttackers)
         return pawnAttackers.getFSB();
 
-    Bitboard knightAttackers = knightAttackBitboard(to) & board.getPieceBitboard(side | KNIGHT);
+    Bitboard knightAttackers = knightAttackBitboard(to) & board.getPieceBitboard(side | KNIGHT) & allowedAttackers;
     if(knightAttackers)
         return knightAttackers.getFSB();
 
     Bitboard bishopAttackers = diagonalAttackBitboard(to, board.getPieceBitboard() | board.getPieceBitboard(side | KING))
-                                                        & board.getPieceBitboard(side | BISHOP);
+                                                        & board.getPieceBitboard(side | BISHOP) & allowedAttackers;
     if(bishopAttackers)
         return bishopAttackers.getFSB();
 
     Bitboard rookAttackers = horizontalAttackBitboard(to, board.getPieceBitboard() | board.getPieceBitboard(side | KING))
-                                                        & board.getPieceBitboard(side | ROOK);
+                                                        & board.getPieceBitboard(side | ROOK) & allowedAttackers;
     if(rookAttackers)
         return rookAttackers.getFSB();
 
     Bitboard queenAttackers = (diagonalAttackBitboard(to, board.getPieceBitboard() | board.getPieceBitboard(side | KING))
                                 | horizontalAttackBitboard(to, board.getPieceBitboard() | board.getPieceBitboard(side | KING)))
-                                & board.getPieceBitboard(side | QUEEN);
+                                & board.getPieceBitboard(side | QUEEN) & allowedAttackers;
     if(queenAttackers)
         return queenAttackers.getFSB();
     
@@ -213,6 +226,8 @@ bool Evaluator::isWrongBishopAndRookPawnEndgame() {
 }
 
 int Evaluator::evaluateMoveSEE(Move m, AtomicU64& nodes) {
+    PROFILE_SCOPE(Profiler::SEE);
+
     int moveScore = 0;
 
     if(m.isPromotion()) {
@@ -237,6 +252,8 @@ int Evaluator::evaluateMoveSEE(Move m, AtomicU64& nodes) {
 }
 
 bool Evaluator::isSEEGreaterEqual(Move m, int threshold, AtomicU64& nodes) {
+    PROFILE_SCOPE(Profiler::SEE);
+
     int movedPieceValue = SIMPLE_PIECE_VALUE[TYPEOF(board.pieceAt(m.getOrigin()))];
 
     if(m.isPromotion()) {
@@ -3,6 +3,7 @@
 
 #include "core/chess/Board.h"
 #include "core/utils/Atomic.h"
+#include "core/utils/Profiler.h"
 
 #define UNUSED(x) (void)(x)
 
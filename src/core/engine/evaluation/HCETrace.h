@@ -0,0 +1,151 @@
+#ifndef HCE_TRACE_H
+#define HCE_TRACE_H
+
+#include "core/utils/hce/HCEParameters.h"
+
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @brief Zeichnet während einer Bewertung durch den HandcraftedEvaluator auf,
+ * mit welchem Koeffizienten jeder Parameter in die Mittel- und Endspielbewertung
+ * eingeht. Daraus wird die Ableitung der Bewertung nach allen Parametern bestimmt,
+ * ohne die Bewertung für jeden Parameter erneut auszuführen.
+ *
+ * Die meisten Terme der Bewertung sind linear in den Parametern. Für die nichtlinearen
+ * Terme (Königssicherheit, Remis-Bestrafung, 50-Züge-Regel) wird die lokale Steigung
+ * am aktuellen Parametersatz verwendet. Die Spezialbewertungen für Endspiele ohne
+ * Bauern werden als konstant betrachtet.
+ *
+ * Eine Aufzeichnung ist nur für die Position gültig, mit der der Evaluator
+ * erstellt wurde. Züge auf dem Brett werden nicht verfolgt.
+ */
+class HCETrace {
+    public:
+        /**
+         * @brief Die Kanäle, in die die Koeffizienten geschrieben werden.
+         */
+        enum Channel {
+            POSITION, // Material, Positionstabellen und Bauernstruktur (beim Erstellen des Evaluators)
+            SCORE, // Alle weiteren Terme der Bewertung
+            DRAW_PENALTY, // Die Remis-Bestrafung der führenden Seite
+            WHITE_ATTACK, // Das Angriffsgewicht von Weiß auf den schwarzen König
+            BLACK_ATTACK, // Das Angriffsgewicht von Schwarz auf den weißen König
+            NUM_CHANNELS
+        };
+
+        /**
+         * @brief Die Ableitung der Bewertung nach einem Parameter.
+         */
+        struct Coefficient {
+            uint32_t index;
+            float value;
+        };
+
+    private:
+        std::vector<float> mg[NUM_CHANNELS];
+        std::vector<float> eg[NUM_CHANNELS];
+
+        std::vector<uint32_t> touchedIndices;
+        std::vector<bool> isTouched;
+
+        std::vector<Coefficient> gradient;
+
+        inline void touch(size_t index) {
+            if(!isTouched[index]) {
+                isTouched[index] = true;
+                touchedIndices.push_back(index);
+            }
+        }
+
+    public:
+        HCETrace() : isTouched(HCEParameters::size(), false) {
+            for(size_t c = 0; c < NUM_CHANNELS; c++) {
+                mg[c].assign(HCEParameters::size(), 0.0f);
+                eg[c].assign(HCEParameters::size(), 0.0f);
+            }
+        }
+
+        /**
+         * @brief Verwirft alle Aufzeichnungen.
+         */
+        inline void clear() {
+            for(uint32_t index : touchedIndices) {
+                for(size_t c = 0; c < NUM_CHANNELS; c++)
+                    mg[c][index] = eg[c][index] = 0.0f;
+
+                isTouched[index] = false;
+            }
+
+            touchedIndices.clear();
+            gradient.clear();
+        }
+
+        /**
+         * @brief Verwirft die Aufzeichnungen aller Kanäle außer POSITION.
+         * Wird vor jeder Bewertung aufgerufen.
+         */
+        inline void beginEvaluation() {
+            for(uint32_t index : touchedIndices)
+                for(size_t c = SCORE; c < NUM_CHANNELS; c++)
+                    mg[c][index] = eg[c][index] = 0.0f;
+
+            gradient.clear();
+        }
+
+        /**
+         * @brief Addiert die Koeffizienten eines Parameters in einem Kanal.
+         */
+        inline void add(Channel channel, size_t index, double mgCoefficient, double egCoefficient) {
+            touch(index);
+            mg[channel][index] += mgCoefficient;
+            eg[channel][index] += egCoefficient;
+        }
+
+        /**
+         * @brief Überträgt die Koeffizienten eines Kanals skaliert in einen anderen Kanal
+         * und leert den Quellkanal. Wird für Terme verwendet, die erst nach einer
+         * nichtlinearen Funktion in die Bewertung eingehen.
+         */
+        inline void fold(Channel source, Channel target, double mgScale, double egScale) {
+            for(uint32_t index : touchedIndices) {
+                mg[target][index] += mgScale * mg[source][index];
+                eg[target][index] += egScale * eg[source][index];
+                mg[source][index] = eg[source][index] = 0.0f;
+            }
+        }
+
+        /**
+         * @brief Berechnet die Ableitung der Bewertung nach allen Parametern
+         * aus den Ableitungen der Bewertung nach den einzelnen Kanälen.
+         *
+         * @param scoreMG Die Ableitung nach der Mittelspielbewertung (POSITION und SCORE).
+         * @param scoreEG Die Ableitung nach der Endspielbewertung (POSITION und SCORE).
+         * @param penaltyMG Die Ableitung nach der Mittelspiel-Remis-Bestrafung.
+         * @param penaltyEG Die Ableitung nach der Endspiel-Remis-Bestrafung.
+         */
+        inline void finalize(double scoreMG, double scoreEG, double penaltyMG, double penaltyEG) {
+            gradient.clear();
+
+            for(uint32_t index : touchedIndices) {
+                double value = scoreMG * (mg[POSITION][index] + mg[SCORE][index]) +
+                               scoreEG * (eg[POSITION][index] + eg[SCORE][index]) +
+                               penaltyMG * mg[DRAW_PENALTY][index] +
+                               penaltyEG * eg[DRAW_PENALTY][index];
+
+                if(value != 0.0)
+                    gradient.push_back({index, (float)value});
+            }
+        }
+
+        /**
+         * @brief Die Ableitung der letzten Bewertung nach den Parametern,
+         * die in die Bewertung eingegangen sind. Ist leer, wenn die Bewertung
+         * nicht von den Parametern abhängt.
+         */
+        inline const std::vector<Coefficient>& getGradient() const {
+            return gradient;
+        }
+};
+
+#endif
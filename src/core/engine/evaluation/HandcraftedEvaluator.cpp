@@ -3,7 +3,10 @@
 
 #include <cmath>
 
-void HandcraftedEvaluator::updateBeforeMove(Move m) {
+template<bool Traced>
+void BasicHandcraftedEvaluator<Traced>::updateBeforeMove(Move m) {
+    PROFILE_SCOPE(Profiler::EVALUATE_UPDATE);
+
     evaluationHistory.push_back(evaluationVars);
 
     if(m.isNullMove())
@@ -156,7 +159,10 @@ void HandcraftedEvaluator::updateBeforeMove(Move m) {
     evaluationVars.phase = std::clamp(evaluationVars.phase, 0.0, 1.0); // phase auf [0, 1] begrenzen
 }
 
-void HandcraftedEvaluator::updateAfterMove() {
+template<bool Traced>
+void BasicHandcraftedEvaluator<Traced>::updateAfterMove() {
+    PROFILE_SCOPE(Profiler::EVALUATE_UPDATE);
+
     Move m = board.getLastMove();
 
     if(m.isNullMove())
@@ -171,12 +177,16 @@ void HandcraftedEvaluator::updateAfterMove() {
         calculatePawnScore();
 }
 
-void HandcraftedEvaluator::updateBeforeUndo() {
+template<bool Traced>
+void BasicHandcraftedEvaluator<Traced>::updateBeforeUndo() {
+    PROFILE_SCOPE(Profiler::EVALUATE_UPDATE);
+
     evaluationVars = evaluationHistory.back();
     evaluationHistory.pop_back();
 }
 
-void HandcraftedEvaluator::calculateMaterialScore() {
+template<bool Traced>
+void BasicHandcraftedEvaluator<Traced>::calculateMaterialScore() {
     Score psqtScore{0, 0};
     int pieceScore = 0;
 
@@ -187,20 +197,25 @@ void HandcraftedEvaluator::calculateMaterialScore() {
 
         // lineare Terme
         pieceScore += hceParams.getLinearPieceValue(piece) * (numWhitePieces - numBlackPieces);
+        traceParameter(HCETrace::POSITION, hceParams.getLinearPieceValue(piece), numWhitePieces - numBlackPieces, numWhitePieces - numBlackPieces);
 
         // quadratische Terme
-        pieceScore += hceParams.getQuadraticPieceValue(piece) * (numWhitePieces * numWhitePieces - numBlackPieces * numBlackPieces);
+        int quadraticDiff = numWhitePieces * numWhitePieces - numBlackPieces * numBlackPieces;
+        pieceScore += hceParams.getQuadraticPieceValue(piece) * quadraticDiff;
+        traceParameter(HCETrace::POSITION, hceParams.getQuadraticPieceValue(piece), quadraticDiff, quadraticDiff);
 
         // gemischte Terme
         for(int otherPiece = PAWN; otherPiece < piece; otherPiece++) {
-            int crossedPieceValue = hceParams.getCrossedPieceValue(piece, otherPiece);
-            pieceScore += crossedPieceValue * (numWhitePieces * board.getPieceBitboard(WHITE | otherPiece).popcount() -
-                                               numBlackPieces * board.getPieceBitboard(BLACK | otherPiece).popcount());
+            int crossedDiff = numWhitePieces * board.getPieceBitboard(WHITE | otherPiece).popcount() -
+                              numBlackPieces * board.getPieceBitboard(BLACK | otherPiece).popcount();
+            pieceScore += hceParams.getCrossedPieceValue(piece, otherPiece) * crossedDiff;
+            traceParameter(HCETrace::POSITION, hceParams.getCrossedPieceValue(piece, otherPiece), crossedDiff, crossedDiff);
 
             // Materialungleichgewicht
-            int imbalanceValue = hceParams.getPieceImbalanceValue(piece, otherPiece);
-            pieceScore += imbalanceValue * (numWhitePieces * board.getPieceBitboard(BLACK | otherPiece).popcount() -
-                                            numBlackPieces * board.getPieceBitboard(WHITE | otherPiece).popcount());
+            int imbalanceDiff = numWhitePieces * board.getPieceBitboard(BLACK | otherPiece).popcount() -
+                                numBlackPieces * board.getPieceBitboard(WHITE | otherPiece).popcount();
+            pieceScore += hceParams.getPieceImbalanceValue(piece, otherPiece) * imbalanceDiff;
+            traceParameter(HCETrace::POSITION, hceParams.getPieceImbalanceValue(piece, otherPiece), imbalanceDiff, imbalanceDiff);
         }
     }
 
@@ -211,6 +226,7 @@ void HandcraftedEvaluator::calculateMaterialScore() {
             int square = pieceBB.popFSB();
             psqtScore.mg += hceParams.getMGPSQT(piece, square);
             psqtScore.eg += hceParams.getEGPSQT(piece, square);
+            traceScore(HCETrace::POSITION, hceParams.getMGPSQTParameter(piece, square), hceParams.getEGPSQTParameter(piece, square), 1);
         }
 
         pieceBB = board.getPieceBitboard(BLACK | piece);
@@ -222,13 +238,15 @@ void HandcraftedEvaluator::calculateMaterialScore() {
 
             psqtScore.mg -= hceParams.getMGPSQT(piece, square);
             psqtScore.eg -= hceParams.getEGPSQT(piece, square);
+            traceScore(HCETrace::POSITION, hceParams.getMGPSQTParameter(piece, square), hceParams.getEGPSQTParameter(piece, square), -1);
         }
     }
 
     evaluationVars.materialScore = psqtScore + Score{pieceScore, pieceScore};
 }
 
-void HandcraftedEvaluator::calculatePawnScore() {
+template<bool Traced>
+void BasicHandcraftedEvaluator<Traced>::calculatePawnScore() {
     Score score{0, 0};
 
     Bitboard whitePawns = board.getPieceBitboard(WHITE_PAWN);
@@ -247,6 +265,7 @@ void HandcraftedEvaluator::calculatePawnScore() {
         int file = Square::fileOf(temp.popFSB());
         score.mg += hceParams.getMGDoubledPawnPenalty(file);
         score.eg += hceParams.getEGDoubledPawnPenalty(file);
+        traceScore(HCETrace::POSITION, hceParams.getMGDoubledPawnPenalty(file), hceParams.getEGDoubledPawnPenalty(file), 1);
     }
 
     Bitboard doubledBlackPawns = blackPawns.shiftNorth().extrudeNorth() & blackPawns;
@@ -255,6 +274,7 @@ void HandcraftedEvaluator::calculatePawnScore() {
         int file = Square::fileOf(temp.popFSB());
         score.mg -= hceParams.getMGDoubledPawnPenalty(file);
         score.eg -= hceParams.getEGDoubledPawnPenalty(file);
+        traceScore(HCETrace::POSITION, hceParams.getMGDoubledPawnPenalty(file), hceParams.getEGDoubledPawnPenalty(file), -1);
     }
 
     // Isolierte Bauern
@@ -263,6 +283,7 @@ void HandcraftedEvaluator::calculatePawnScore() {
         int file = Square::fileOf(isolatedWhitePawns.popFSB());
         score.mg += hceParams.getMGIsolatedPawnPenalty(file);
         score.eg += hceParams.getEGIsolatedPawnPenalty(file);
+        traceScore(HCETrace::POSITION, hceParams.getMGIsolatedPawnPenalty(file), hceParams.getEGIsolatedPawnPenalty(file), 1);
     }
 
     Bitboard isolatedBlackPawns = ~blackPawnsWestEast.extrudeVertically() & blackPawns;
@@ -270,6 +291,7 @@ void HandcraftedEvaluator::calculatePawnScore() {
         int file = Square::fileOf(isolatedBlackPawns.popFSB());
         score.mg -= hceParams.getMGIsolatedPawnPenalty(file);
         score.eg -= hceParams.getEGIsolatedPawnPenalty(file);
+        traceScore(HCETrace::POSITION, hceParams.getMGIsolatedPawnPenalty(file), hceParams.getEGIsolatedPawnPenalty(file), -1);
     }
 
     // Rückständige Bauern
@@ -282,6 +304,7 @@ void HandcraftedEvaluator::calculatePawnScore() {
         int rank = Square::rankOf(temp.popFSB());
         score.mg += hceParams.getMGBackwardPawnPenalty(rank);
         score.eg += hceParams.getEGBackwardPawnPenalty(rank);
+        traceScore(HCETrace::POSITION, hceParams.getMGBackwardPawnPenalty(rank), hceParams.getEGBackwardPawnPenalty(rank), 1);
     }
 
     temp = backwardBlackPawns;
@@ -289,6 +312,7 @@ void HandcraftedEvaluator::calculatePawnScore() {
         int rank = Square::rankOf(Square::flipY(temp.popFSB()));
         score.mg -= hceParams.getMGBackwardPawnPenalty(rank);
         score.eg -= hceParams.getEGBackwardPawnPenalty(rank);
+        traceScore(HCETrace::POSITION, hceParams.getMGBackwardPawnPenalty(rank), hceParams.getEGBackwardPawnPenalty(rank), -1);
     }
 
     // Verbundene Bauern
@@ -298,6 +322,7 @@ void HandcraftedEvaluator::calculatePawnScore() {
         int rank = Square::rankOf(temp.popFSB());
         score.mg += hceParams.getMGConnectedPawnBonus(rank);
         score.eg += hceParams.getEGConnectedPawnBonus(rank);
+        traceScore(HCETrace::POSITION, hceParams.getMGConnectedPawnBonus(rank), hceParams.getEGConnectedPawnBonus(rank), 1);
     }
 
     Bitboard connectedBlackPawns = (blackPawnsWestEast | blackPawnsWestEast.shiftSouth() | blackPawnsWestEast.shiftNorth()) & blackPawns;
@@ -306,6 +331,7 @@ void HandcraftedEvaluator::calculatePawnScore() {
         int rank = Square::rankOf(Square::flipY(temp.popFSB()));
         score.mg -= hceParams.getMGConnectedPawnBonus(rank);
         score.eg -= hceParams.getEGConnectedPawnBonus(rank);
+        traceScore(HCETrace::POSITION, hceParams.getMGConnectedPawnBonus(rank), hceParams.getEGConnectedPawnBonus(rank), -1);
     }
 
     // Freibauern
@@ -315,6 +341,7 @@ void HandcraftedEvaluator::calculatePawnScore() {
         int rank = Square::rankOf(whitePassedPawns.popFSB());
         score.mg += hceParams.getMGPassedPawnBonus(rank);
         score.eg += hceParams.getEGPassedPawnBonus(rank);
+        traceScore(HCETrace::POSITION, hceParams.getMGPassedPawnBonus(rank), hceParams.getEGPassedPawnBonus(rank), 1);
     }
 
     Bitboard blackPassedPawns = blackPawns & ~doubledBlackPawns & ~((whitePawns | whitePawnAttacks).extrudeNorth());
@@ -323,6 +350,7 @@ void HandcraftedEvaluator::calculatePawnScore() {
         int rank = Square::rankOf(Square::flipY(blackPassedPawns.popFSB()));
         score.mg -= hceParams.getMGPassedPawnBonus(rank);
         score.eg -= hceParams.getEGPassedPawnBonus(rank);
+        traceScore(HCETrace::POSITION, hceParams.getMGPassedPawnBonus(rank), hceParams.getEGPassedPawnBonus(rank), -1);
     }
 
     // Verbundene Freibauern
@@ -331,6 +359,7 @@ void HandcraftedEvaluator::calculatePawnScore() {
         int rank = Square::rankOf(connectedWhitePassedPawns.popFSB());
         score.mg -= hceParams.getMGConnectedPassedPawnBonus(rank);
         score.eg -= hceParams.getEGConnectedPassedPawnBonus(rank);
+        traceScore(HCETrace::POSITION, hceParams.getMGConnectedPassedPawnBonus(rank), hceParams.getEGConnectedPassedPawnBonus(rank), -1);
     }
 
     Bitboard connectedBlackPassedPawns = evaluationVars.blackPassedPawns & connectedBlackPawns;
@@ -338,6 +367,7 @@ void HandcraftedEvaluator::calculatePawnScore() {
         int rank = Square::rankOf(connectedBlackPassedPawns.popFSB());
         score.mg += hceParams.getMGConnectedPassedPawnBonus(rank);
         score.eg += hceParams.getEGConnectedPassedPawnBonus(rank);
+        traceScore(HCETrace::POSITION, hceParams.getMGConnectedPassedPawnBonus(rank), hceParams.getEGConnectedPassedPawnBonus(rank), 1);
     }
 
     // Freibauerkandidaten
@@ -360,6 +390,7 @@ void HandcraftedEvaluator::calculatePawnScore() {
             evaluationVars.whiteCandidatePassedPawns |= sq;
             int rank = Square::rankOf(sq.getFSB());
             score += Score{hceParams.getMGCandidatePassedPawnBonus(rank), hceParams.getEGCandidatePassedPawnBonus(rank)};
+            traceScore(HCETrace::POSITION, hceParams.getMGCandidatePassedPawnBonus(rank), hceParams.getEGCandidatePassedPawnBonus(rank), 1);
         }
     }
 
@@ -373,6 +404,7 @@ void HandcraftedEvaluator::calculatePawnScore() {
             evaluationVars.blackCandidatePassedPawns |= sq;
             int rank = Square::rankOf(Square::flipY(sq.getFSB()));
             score -= Score{hceParams.getMGCandidatePassedPawnBonus(rank), hceParams.getEGCandidatePassedPawnBonus(rank)};
+            traceScore(HCETrace::POSITION, hceParams.getMGCandidatePassedPawnBonus(rank), hceParams.getEGCandidatePassedPawnBonus(rank), -1);
         }
     }
 
@@ -395,10 +427,14 @@ void HandcraftedEvaluator::calculatePawnScore() {
     score.mg += hceParams.getMGCenterOutpostBonus() * (whiteCenterOutposts.popcount() - blackCenterOutposts.popcount()) +
                 hceParams.getMGEdgeOutpostBonus() * (whiteEdgeOutposts.popcount() - blackEdgeOutposts.popcount());
 
+    traceParameter(HCETrace::POSITION, hceParams.getMGCenterOutpostBonus(), whiteCenterOutposts.popcount() - blackCenterOutposts.popcount(), 0);
+    traceParameter(HCETrace::POSITION, hceParams.getMGEdgeOutpostBonus(), whiteEdgeOutposts.popcount() - blackEdgeOutposts.popcount(), 0);
+
     evaluationVars.pawnScore = score;
 }
 
-void HandcraftedEvaluator::calculateGamePhase() {
+template<bool Traced>
+void BasicHandcraftedEvaluator<Traced>::calculateGamePhase() {
     evaluationVars.phaseWeight = TOTAL_WEIGHT;
 
     evaluationVars.phaseWeight -= board.getPieceBitboard(WHITE_PAWN).popcount() * PAWN_WEIGHT;
@@ -417,11 +453,27 @@ void HandcraftedEvaluator::calculateGamePhase() {
     evaluationVars.phase = std::clamp(evaluationVars.phase, 0.0, 1.0); // phase auf [0, 1] begrenzen
 }
 
-Score HandcraftedEvaluator::calculateKingSafetyScore() {
+template<bool Traced>
+Score BasicHandcraftedEvaluator<Traced>::calculateKingSafetyScore() {
     return evaluateKingAttackZone();
 }
 
-Score HandcraftedEvaluator::evaluateKingAttackZone() {
+template<bool Traced>
+int BasicHandcraftedEvaluator<Traced>::kingAttackSlope(int attackWeight) {
+    constexpr int maxAttackWeight = sizeof(kingAttackBonus) / sizeof(kingAttackBonus[0]) - 1;
+
+    // Außerhalb der Tabelle wird das Angriffsgewicht abgeschnitten
+    if(attackWeight < 0 || attackWeight > maxAttackWeight)
+        return 0;
+
+    if(attackWeight == maxAttackWeight)
+        return kingAttackBonus[maxAttackWeight] - kingAttackBonus[maxAttackWeight - 1];
+
+    return kingAttackBonus[attackWeight + 1] - kingAttackBonus[attackWeight];
+}
+
+template<bool Traced>
+Score BasicHandcraftedEvaluator<Traced>::evaluateKingAttackZone() {
     int whiteKingSquare = board.getKingSquare(WHITE);
     int blackKingSquare = board.getKingSquare(BLACK);
 
@@ -444,12 +496,15 @@ Score HandcraftedEvaluator::evaluateKingAttackZone() {
         Bitboard attacks = attackBitboard & blackKingZone;
         whiteMGAttackWeight += attacks.popcount() * hceParams.getMGAttackWeight(KNIGHT);
         whiteEGAttackWeight += attacks.popcount() * hceParams.getEGAttackWeight(KNIGHT);
+        traceScore(HCETrace::WHITE_ATTACK, hceParams.getMGAttackWeight(KNIGHT), hceParams.getEGAttackWeight(KNIGHT), attacks.popcount());
         Bitboard undefendedAttacks = attacks & ~defendedSquares;
         whiteMGAttackWeight += undefendedAttacks.popcount() * hceParams.getMGUndefendedAttackWeight(KNIGHT);
         whiteEGAttackWeight += undefendedAttacks.popcount() * hceParams.getEGUndefendedAttackWeight(KNIGHT);
+        traceScore(HCETrace::WHITE_ATTACK, hceParams.getMGUndefendedAttackWeight(KNIGHT), hceParams.getEGUndefendedAttackWeight(KNIGHT), undefendedAttacks.popcount());
         Bitboard defenses = attackBitboard & whiteKingZone;
         blackMGAttackWeight -= defenses.popcount() * hceParams.getMGDefenseWeight(KNIGHT);
         blackEGAttackWeight -= defenses.popcount() * hceParams.getEGDefenseWeight(KNIGHT);
+        traceScore(HCETrace::BLACK_ATTACK, hceParams.getMGDefenseWeight(KNIGHT), hceParams.getEGDefenseWeight(KNIGHT), -defenses.popcount());
     }
 
     Bitboard whiteBishops = board.getPieceBitboard(WHITE_BISHOP);
@@ -461,12 +516,15 @@ Score HandcraftedEvaluator::evaluateKingAttackZone() {
         Bitboard attacks = attackBitboard & blackKingZone;
         whiteMGAttackWeight += attacks.popcount() * hceParams.getMGAttackWeight(BISHOP);
         whiteEGAttackWeight += attacks.popcount() * hceParams.getEGAttackWeight(BISHOP);
+        traceScore(HCETrace::WHITE_ATTACK, hceParams.getMGAttackWeight(BISHOP), hceParams.getEGAttackWeight(BISHOP), attacks.popcount());
         Bitboard undefendedAttacks = attacks & ~defendedSquares;
         whiteMGAttackWeight += undefendedAttacks.popcount() * hceParams.getMGUndefendedAttackWeight(BISHOP);
         whiteEGAttackWeight += undefendedAttacks.popcount() * hceParams.getEGUndefendedAttackWeight(BISHOP);
+        traceScore(HCETrace::WHITE_ATTACK, hceParams.getMGUndefendedAttackWeight(BISHOP), hceParams.getEGUndefendedAttackWeight(BISHOP), undefendedAttacks.popcount());
         Bitboard defenses = attackBitboard & whiteKingZone;
         blackMGAttackWeight -= defenses.popcount() * hceParams.getMGDefenseWeight(BISHOP);
         blackEGAttackWeight -= defenses.popcount() * hceParams.getEGDefenseWeight(BISHOP);
+        traceScore(HCETrace::BLACK_ATTACK, hceParams.getMGDefenseWeight(BISHOP), hceParams.getEGDefenseWeight(BISHOP), -defenses.popcount());
     }
 
     Bitboard whiteRooks = board.getPieceBitboard(WHITE_ROOK);
@@ -478,12 +536,15 @@ Score HandcraftedEvaluator::evaluateKingAttackZone() {
         Bitboard attacks = attackBitboard & blackKingZone;
         whiteMGAttackWeight += attacks.popcount() * hceParams.getMGAttackWeight(ROOK);
         whiteEGAttackWeight += attacks.popcount() * hceParams.getEGAttackWeight(ROOK);
+        traceScore(HCETrace::WHITE_ATTACK, hceParams.getMGAttackWeight(ROOK), hceParams.getEGAttackWeight(ROOK), attacks.popcount());
         Bitboard undefendedAttacks = attacks & ~defendedSquares;
         whiteMGAttackWeight += undefendedAttacks.popcount() * hceParams.getMGUndefendedAttackWeight(ROOK);
         whiteEGAttackWeight += undefendedAttacks.popcount() * hceParams.getEGUndefendedAttackWeight(ROOK);
+        traceScore(HCETrace::WHITE_ATTACK, hceParams.getMGUndefendedAttackWeight(ROOK), hceParams.getEGUndefendedAttackWeight(ROOK), undefendedAttacks.popcount());
         Bitboard defenses = attackBitboard & whiteKingZone;
         blackMGAttackWeight -= defenses.popcount() * hceParams.getMGDefenseWeight(ROOK);
         blackEGAttackWeight -= defenses.popcount() * hceParams.getEGDefenseWeight(ROOK);
+        traceScore(HCETrace::BLACK_ATTACK, hceParams.getMGDefenseWeight(ROOK), hceParams.getEGDefenseWeight(ROOK), -defenses.popcount());
     }
 
     Bitboard whiteQueens = board.getPieceBitboard(WHITE_QUEEN);
@@ -496,12 +557,15 @@ Score HandcraftedEvaluator::evaluateKingAttackZone() {
         Bitboard attacks = attackBitboard & blackKingZone;
         whiteMGAttackWeight += attacks.popcount() * hceParams.getMGAttackWeight(QUEEN);
         whiteEGAttackWeight += attacks.popcount() * hceParams.getEGAttackWeight(QUEEN);
+        traceScore(HCETrace::WHITE_ATTACK, hceParams.getMGAttackWeight(QUEEN), hceParams.getEGAttackWeight(QUEEN), attacks.popcount());
         Bitboard undefendedAttacks = attacks & ~defendedSquares;
         whiteMGAttackWeight += undefendedAttacks.popcount() * hceParams.getMGUndefendedAttackWeight(QUEEN);
         whiteEGAttackWeight += undefendedAttacks.popcount() * hceParams.getEGUndefendedAttackWeight(QUEEN);
+        traceScore(HCETrace::WHITE_ATTACK, hceParams.getMGUndefendedAttackWeight(QUEEN), hceParams.getEGUndefendedAttackWeight(QUEEN), undefendedAttacks.popcount());
         Bitboard defenses = attackBitboard & whiteKingZone;
         blackMGAttackWeight -= defenses.popcount() * hceParams.getMGDefenseWeight(QUEEN);
         blackEGAttackWeight -= defenses.popcount() * hceParams.getEGDefenseWeight(QUEEN);
+        traceScore(HCETrace::BLACK_ATTACK, hceParams.getMGDefenseWeight(QUEEN), hceParams.getEGDefenseWeight(QUEEN), -defenses.popcount());
     }
 
     // Überprüfe auf sichere Züge, die den König in Schach setzen
@@ -512,6 +576,7 @@ Score HandcraftedEvaluator::evaluateKingAttackZone() {
     if(safeKnightCheckMoves) {
         whiteMGAttackWeight += hceParams.getMGSafeCheckWeight(KNIGHT);
         whiteEGAttackWeight += hceParams.getEGSafeCheckWeight(KNIGHT);
+        traceScore(HCETrace::WHITE_ATTACK, hceParams.getMGSafeCheckWeight(KNIGHT), hceParams.getEGSafeCheckWeight(KNIGHT), 1);
     }
 
     Bitboard safeBishopCheckMoves = diagonalAttackBitboard(blackKingSquare, occupied) & (board.getAttackBitboard(WHITE_BISHOP) |
@@ -519,6 +584,7 @@ Score HandcraftedEvaluator::evaluateKingAttackZone() {
     if(safeBishopCheckMoves) {
         whiteMGAttackWeight += hceParams.getMGSafeCheckWeight(BISHOP);
         whiteEGAttackWeight += hceParams.getEGSafeCheckWeight(BISHOP);
+        traceScore(HCETrace::WHITE_ATTACK, hceParams.getMGSafeCheckWeight(BISHOP), hceParams.getEGSafeCheckWeight(BISHOP), 1);
     }
 
     Bitboard safeRookCheckMoves = horizontalAttackBitboard(blackKingSquare, occupied) & (board.getAttackBitboard(WHITE_ROOK) |
@@ -526,6 +592,7 @@ Score HandcraftedEvaluator::evaluateKingAttackZone() {
     if(safeRookCheckMoves) {
         whiteMGAttackWeight += hceParams.getMGSafeCheckWeight(ROOK);
         whiteEGAttackWeight += hceParams.getEGSafeCheckWeight(ROOK);
+        traceScore(HCETrace::WHITE_ATTACK, hceParams.getMGSafeCheckWeight(ROOK), hceParams.getEGSafeCheckWeight(ROOK), 1);
     }
 
     Bitboard safeQueenCheckMoves = (diagonalAttackBitboard(blackKingSquare, occupied) | horizontalAttackBitboard(blackKingSquare, occupied)) &
@@ -533,6 +600,7 @@ Score HandcraftedEvaluator::evaluateKingAttackZone() {
     if(safeQueenCheckMoves) {
         whiteMGAttackWeight += hceParams.getMGSafeCheckWeight(QUEEN);
         whiteEGAttackWeight += hceParams.getEGSafeCheckWeight(QUEEN);
+        traceScore(HCETrace::WHITE_ATTACK, hceParams.getMGSafeCheckWeight(QUEEN), hceParams.getEGSafeCheckWeight(QUEEN), 1);
     }
 
     bool safeQueenContactCheck = false;
@@ -569,6 +637,7 @@ Score HandcraftedEvaluator::evaluateKingAttackZone() {
     if(safeQueenContactCheck) {
         whiteMGAttackWeight += hceParams.getMGSafeContactCheckWeight(QUEEN);
         whiteEGAttackWeight += hceParams.getEGSafeContactCheckWeight(QUEEN);
+        traceScore(HCETrace::WHITE_ATTACK, hceParams.getMGSafeContactCheckWeight(QUEEN), hceParams.getEGSafeContactCheckWeight(QUEEN), 1);
     } else {
         // Überprüfe auf sichere Turm-Kontakt-Schachzüge
         Bitboard rookContact = rookContactSquares[blackKingSquare] & (board.getAttackBitboard(WHITE_ROOK) |
@@ -579,6 +648,7 @@ Score HandcraftedEvaluator::evaluateKingAttackZone() {
         if(coveredSquares & rookContact) {
             whiteMGAttackWeight += hceParams.getMGSafeContactCheckWeight(ROOK);
             whiteEGAttackWeight += hceParams.getEGSafeContactCheckWeight(ROOK);
+            traceScore(HCETrace::WHITE_ATTACK, hceParams.getMGSafeContactCheckWeight(ROOK), hceParams.getEGSafeContactCheckWeight(ROOK), 1);
         } else {
             // Überprüfe, ob der Turm durch einen X-Ray Angriff gedeckt ist
             while(rookContact) {
@@ -591,12 +661,14 @@ Score HandcraftedEvaluator::evaluateKingAttackZone() {
                 if(attackers.popcount() > 1) {
                     whiteMGAttackWeight += hceParams.getMGSafeContactCheckWeight(ROOK);
                     whiteEGAttackWeight += hceParams.getEGSafeContactCheckWeight(ROOK);
+                    traceScore(HCETrace::WHITE_ATTACK, hceParams.getMGSafeContactCheckWeight(ROOK), hceParams.getEGSafeContactCheckWeight(ROOK), 1);
                     break;
                 } else {
                     attacks = horizontalAttackBitboard(sq, occupied ^ attackers);
                     if(attacks & coveringPieces) {
                         whiteMGAttackWeight += hceParams.getMGSafeContactCheckWeight(ROOK);
                         whiteEGAttackWeight += hceParams.getEGSafeContactCheckWeight(ROOK);
+                        traceScore(HCETrace::WHITE_ATTACK, hceParams.getMGSafeContactCheckWeight(ROOK), hceParams.getEGSafeContactCheckWeight(ROOK), 1);
                         break;
                     }
                 }
@@ -620,10 +692,12 @@ Score HandcraftedEvaluator::evaluateKingAttackZone() {
             case QUEEN:
                 whiteMGAttackWeight += hceParams.getMGSkeweredByWeight(QUEEN);
                 whiteEGAttackWeight += hceParams.getEGSkeweredByWeight(QUEEN);
+                traceScore(HCETrace::WHITE_ATTACK, hceParams.getMGSkeweredByWeight(QUEEN), hceParams.getEGSkeweredByWeight(QUEEN), 1);
                 break;
             case BISHOP:
                 whiteMGAttackWeight += hceParams.getMGSkeweredByWeight(BISHOP);
                 whiteEGAttackWeight += hceParams.getEGSkeweredByWeight(BISHOP);
+                traceScore(HCETrace::WHITE_ATTACK, hceParams.getMGSkeweredByWeight(BISHOP), hceParams.getEGSkeweredByWeight(BISHOP), 1);
                 break;
         }
     }
@@ -641,10 +715,12 @@ Score HandcraftedEvaluator::evaluateKingAttackZone() {
             case QUEEN:
                 whiteMGAttackWeight += hceParams.getMGSkeweredByWeight(QUEEN);
                 whiteEGAttackWeight += hceParams.getEGSkeweredByWeight(QUEEN);
+                traceScore(HCETrace::WHITE_ATTACK, hceParams.getMGSkeweredByWeight(QUEEN), hceParams.getEGSkeweredByWeight(QUEEN), 1);
                 break;
             case ROOK:
                 whiteMGAttackWeight += hceParams.getMGSkeweredByWeight(ROOK);
                 whiteEGAttackWeight += hceParams.getEGSkeweredByWeight(ROOK);
+                traceScore(HCETrace::WHITE_ATTACK, hceParams.getMGSkeweredByWeight(ROOK), hceParams.getEGSkeweredByWeight(ROOK), 1);
                 break;
         }
     }
@@ -659,12 +735,15 @@ Score HandcraftedEvaluator::evaluateKingAttackZone() {
         Bitboard attacks = attackBitboard & whiteKingZone;
         blackMGAttackWeight += attacks.popcount() * hceParams.getMGAttackWeight(KNIGHT);
         blackEGAttackWeight += attacks.popcount() * hceParams.getEGAttackWeight(KNIGHT);
+        traceScore(HCETrace::BLACK_ATTACK, hceParams.getMGAttackWeight(KNIGHT), hceParams.getEGAttackWeight(KNIGHT), attacks.popcount());
         Bitboard undefendedAttacks = attacks & ~defendedSquares;
         blackMGAttackWeight += undefendedAttacks.popcount() * hceParams.getMGUndefendedAttackWeight(KNIGHT);
         blackEGAttackWeight += undefendedAttacks.popcount() * hceParams.getEGUndefendedAttackWeight(KNIGHT);
+        traceScore(HCETrace::BLACK_ATTACK, hceParams.getMGUndefendedAttackWeight(KNIGHT), hceParams.getEGUndefendedAttackWeight(KNIGHT), undefendedAttacks.popcount());
         Bitboard defenses = attackBitboard & blackKingZone;
         whiteMGAttackWeight -= defenses.popcount() * hceParams.getMGDefenseWeight(KNIGHT);
         whiteEGAttackWeight -= defenses.popcount() * hceParams.getEGDefenseWeight(KNIGHT);
+        traceScore(HCETrace::WHITE_ATTACK, hceParams.getMGDefenseWeight(KNIGHT), hceParams.getEGDefenseWeight(KNIGHT), -defenses.popcount());
     }
 
     Bitboard blackBishops = board.getPieceBitboard(BLACK_BISHOP);
@@ -676,12 +755,15 @@ Score HandcraftedEvaluator::evaluateKingAttackZone() {
         Bitboard attacks = attackBitboard & whiteKingZone;
         blackMGAttackWeight += attacks.popcount() * hceParams.getMGAttackWeight(BISHOP);
         blackEGAttackWeight += attacks.popcount() * hceParams.getEGAttackWeight(BISHOP);
+        traceScore(HCETrace::BLACK_ATTACK, hceParams.getMGAttackWeight(BISHOP), hceParams.getEGAttackWeight(BISHOP), attacks.popcount());
         Bitboard undefendedAttacks = attacks & ~defendedSquares;
         blackMGAttackWeight += undefendedAttacks.popcount() * hceParams.getMGUndefendedAttackWeight(BISHOP);
         blackEGAttackWeight += undefendedAttacks.popcount() * hceParams.getEGUndefendedAttackWeight(BISHOP);
+        traceScore(HCETrace::BLACK_ATTACK, hceParams.getMGUndefendedAttackWeight(BISHOP), hceParams.getEGUndefendedAttackWeight(BISHOP), undefendedAttacks.popcount());
         Bitboard defenses = attackBitboard & blackKingZone;
         whiteMGAttackWeight -= defenses.popcount() * hceParams.getMGDefenseWeight(BISHOP);
         whiteEGAttackWeight -= defenses.popcount() * hceParams.getEGDefenseWeight(BISHOP);
+        traceScore(HCETrace::WHITE_ATTACK, hceParams.getMGDefenseWeight(BISHOP), hceParams.getEGDefenseWeight(BISHOP), -defenses.popcount());
     }
 
     Bitboard blackRooks = board.getPieceBitboard(BLACK_ROOK);
@@ -693,12 +775,15 @@ Score HandcraftedEvaluator::evaluateKingAttackZone() {
         Bitboard attacks = attackBitboard & whiteKingZone;
         blackMGAttackWeight += attacks.popcount() * hceParams.getMGAttackWeight(ROOK);
         blackEGAttackWeight += attacks.popcount() * hceParams.getEGAttackWeight(ROOK);
+        traceScore(HCETrace::BLACK_ATTACK, hceParams.getMGAttackWeight(ROOK), hceParams.getEGAttackWeight(ROOK), attacks.popcount());
         Bitboard undefendedAttacks = attacks & ~defendedSquares;
         blackMGAttackWeight += undefendedAttacks.popcount() * hceParams.getMGUndefendedAttackWeight(ROOK);
         blackEGAttackWeight += undefendedAttacks.popcount() * hceParams.getEGUndefendedAttackWeight(ROOK);
+        traceScore(HCETrace::BLACK_ATTACK, hceParams.getMGUndefendedAttackWeight(ROOK), hceParams.getEGUndefendedAttackWeight(ROOK), undefendedAttacks.popcount());
         Bitboard defenses = attackBitboard & blackKingZone;
         whiteMGAttackWeight -= defenses.popcount() * hceParams.getMGDefenseWeight(ROOK);
         whiteEGAttackWeight -= defenses.popcount() * hceParams.getEGDefenseWeight(ROOK);
+        traceScore(HCETrace::WHITE_ATTACK, hceParams.getMGDefenseWeight(ROOK), hceParams.getEGDefenseWeight(ROOK), -defenses.popcount());
     }
 
     Bitboard blackQueens = board.getPieceBitboard(BLACK_QUEEN);
@@ -711,12 +796,15 @@ Score HandcraftedEvaluator::evaluateKingAttackZone() {
         Bitboard attacks = attackBitboard & whiteKingZone;
         blackMGAttackWeight += attacks.popcount() * hceParams.getMGAttackWeight(QUEEN);
         blackEGAttackWeight += attacks.popcount() * hceParams.getEGAttackWeight(QUEEN);
+        traceScore(HCETrace::BLACK_ATTACK, hceParams.getMGAttackWeight(QUEEN), hceParams.getEGAttackWeight(QUEEN), attacks.popcount());
         Bitboard undefendedAttacks = attacks & ~defendedSquares;
         blackMGAttackWeight += undefendedAttacks.popcount() * hceParams.getMGUndefendedAttackWeight(QUEEN);
         blackEGAttackWeight += undefendedAttacks.popcount() * hceParams.getEGUndefendedAttackWeight(QUEEN);
+        traceScore(HCETrace::BLACK_ATTACK, hceParams.getMGUndefendedAttackWeight(QUEEN), hceParams.getEGUndefendedAttackWeight(QUEEN), undefendedAttacks.popcount());
         Bitboard defenses = attackBitboard & blackKingZone;
         whiteMGAttackWeight -= defenses.popcount() * hceParams.getMGDefenseWeight(QUEEN);
         whiteEGAttackWeight -= defenses.popcount() * hceParams.getEGDefenseWeight(QUEEN);
+        traceScore(HCETrace::WHITE_ATTACK, hceParams.getMGDefenseWeight(QUEEN), hceParams.getEGDefenseWeight(QUEEN), -defenses.popcount());
     }
 
     // Überprüfe auf sichere Züge, die den König in Schach setzen
@@ -727,6 +815,7 @@ Score HandcraftedEvaluator::evaluateKingAttackZone() {
     if(safeKnightCheckMoves) {
         blackMGAttackWeight += hceParams.getMGSafeCheckWeight(KNIGHT);
         blackEGAttackWeight += hceParams.getEGSafeCheckWeight(KNIGHT);
+        traceScore(HCETrace::BLACK_ATTACK, hceParams.getMGSafeCheckWeight(KNIGHT), hceParams.getEGSafeCheckWeight(KNIGHT), 1);
     }
 
     safeBishopCheckMoves = diagonalAttackBitboard(whiteKingSquare, occupied) & (board.getAttackBitboard(BLACK_BISHOP) |
@@ -734,6 +823,7 @@ Score HandcraftedEvaluator::evaluateKingAttackZone() {
     if(safeBishopCheckMoves) {
         blackMGAttackWeight += hceParams.getMGSafeCheckWeight(BISHOP);
         blackEGAttackWeight += hceParams.getEGSafeCheckWeight(BISHOP);
+        traceScore(HCETrace::BLACK_ATTACK, hceParams.getMGSafeCheckWeight(BISHOP), hceParams.getEGSafeCheckWeight(BISHOP), 1);
     }
 
     safeRookCheckMoves = horizontalAttackBitboard(whiteKingSquare, occupied) & (board.getAttackBitboard(BLACK_ROOK) |
@@ -741,6 +831,7 @@ Score HandcraftedEvaluator::evaluateKingAttackZone() {
     if(safeRookCheckMoves) {
         blackMGAttackWeight += hceParams.getMGSafeCheckWeight(ROOK);
         blackEGAttackWeight += hceParams.getEGSafeCheckWeight(ROOK);
+        traceScore(HCETrace::BLACK_ATTACK, hceParams.getMGSafeCheckWeight(ROOK), hceParams.getEGSafeCheckWeight(ROOK), 1);
     }
 
     safeQueenCheckMoves = (diagonalAttackBitboard(whiteKingSquare, occupied) | horizontalAttackBitboard(whiteKingSquare, occupied)) &
@@ -748,6 +839,7 @@ Score HandcraftedEvaluator::evaluateKingAttackZone() {
     if(safeQueenCheckMoves) {
         blackMGAttackWeight += hceParams.getMGSafeCheckWeight(QUEEN);
         blackEGAttackWeight += hceParams.getEGSafeCheckWeight(QUEEN);
+        traceScore(HCETrace::BLACK_ATTACK, hceParams.getMGSafeCheckWeight(QUEEN), hceParams.getEGSafeCheckWeight(QUEEN), 1);
     }
 
     safeQueenContactCheck = false;
@@ -783,6 +875,7 @@ Score HandcraftedEvaluator::evaluateKingAttackZone() {
     if(safeQueenContactCheck) {
         blackMGAttackWeight += hceParams.getMGSafeContactCheckWeight(QUEEN);
         blackEGAttackWeight += hceParams.getEGSafeContactCheckWeight(QUEEN);
+        traceScore(HCETrace::BLACK_ATTACK, hceParams.getMGSafeContactCheckWeight(QUEEN), hceParams.getEGSafeContactCheckWeight(QUEEN), 1);
     } else {
         // Überprüfe auf sichere Turm-Kontakt-Schachzüge
         Bitboard rookContact = rookContactSquares[whiteKingSquare] & (board.getAttackBitboard(BLACK_ROOK) |
@@ -793,6 +886,7 @@ Score HandcraftedEvaluator::evaluateKingAttackZone() {
         if(coveredSquares & rookContact) {
             blackMGAttackWeight += hceParams.getMGSafeContactCheckWeight(ROOK);
             blackEGAttackWeight += hceParams.getEGSafeContactCheckWeight(ROOK);
+            traceScore(HCETrace::BLACK_ATTACK, hceParams.getMGSafeContactCheckWeight(ROOK), hceParams.getEGSafeContactCheckWeight(ROOK), 1);
         } else {
             // Überprüfe, ob der Turm durch einen X-Ray Angriff gedeckt ist
             while(rookContact) {
@@ -805,12 +899,14 @@ Score HandcraftedEvaluator::evaluateKingAttackZone() {
                 if(attackers.popcount() > 1) {
                     blackMGAttackWeight += hceParams.getMGSafeContactCheckWeight(ROOK);
                     blackEGAttackWeight += hceParams.getEGSafeContactCheckWeight(ROOK);
+                    traceScore(HCETrace::BLACK_ATTACK, hceParams.getMGSafeContactCheckWeight(ROOK), hceParams.getEGSafeContactCheckWeight(ROOK), 1);
                     break;
                 } else {
                     attacks = horizontalAttackBitboard(sq, occupied ^ attackers);
                     if(attacks & coveringPieces) {
                         blackMGAttackWeight += hceParams.getMGSafeContactCheckWeight(ROOK);
                         blackEGAttackWeight += hceParams.getEGSafeContactCheckWeight(ROOK);
+                        traceScore(HCETrace::BLACK_ATTACK, hceParams.getMGSafeContactCheckWeight(ROOK), hceParams.getEGSafeContactCheckWeight(ROOK), 1);
                         break;
                     }
                 }
@@ -834,10 +930,12 @@ Score HandcraftedEvaluator::evaluateKingAttackZone() {
             case QUEEN:
                 blackMGAttackWeight += hceParams.getMGSkeweredByWeight(QUEEN);
                 blackEGAttackWeight += hceParams.getEGSkeweredByWeight(QUEEN);
+                traceScore(HCETrace::BLACK_ATTACK, hceParams.getMGSkeweredByWeight(QUEEN), hceParams.getEGSkeweredByWeight(QUEEN), 1);
                 break;
             case BISHOP:
                 blackMGAttackWeight += hceParams.getMGSkeweredByWeight(BISHOP);
                 blackEGAttackWeight += hceParams.getEGSkeweredByWeight(BISHOP);
+                traceScore(HCETrace::BLACK_ATTACK, hceParams.getMGSkeweredByWeight(BISHOP), hceParams.getEGSkeweredByWeight(BISHOP), 1);
                 break;
         }
     }
@@ -855,10 +953,12 @@ Score HandcraftedEvaluator::evaluateKingAttackZone() {
             case QUEEN:
                 blackMGAttackWeight += hceParams.getMGSkeweredByWeight(QUEEN);
                 blackEGAttackWeight += hceParams.getEGSkeweredByWeight(QUEEN);
+                traceScore(HCETrace::BLACK_ATTACK, hceParams.getMGSkeweredByWeight(QUEEN), hceParams.getEGSkeweredByWeight(QUEEN), 1);
                 break;
             case ROOK:
                 blackMGAttackWeight += hceParams.getMGSkeweredByWeight(ROOK);
                 blackEGAttackWeight += hceParams.getEGSkeweredByWeight(ROOK);
+                traceScore(HCETrace::BLACK_ATTACK, hceParams.getMGSkeweredByWeight(ROOK), hceParams.getEGSkeweredByWeight(ROOK), 1);
                 break;
         }
     }
@@ -882,6 +982,12 @@ Score HandcraftedEvaluator::evaluateKingAttackZone() {
     whiteMGAttackWeight += hceParams.getMGKingOpenFileWeight(blackOpenFiles);
     blackMGAttackWeight += hceParams.getMGKingOpenFileWeight(whiteOpenFiles);
 
+    if(blackOpenFiles > 0)
+        traceParameter(HCETrace::WHITE_ATTACK, hceParams.mgKingOpenFileWeight[blackOpenFiles - 1], 1, 0);
+
+    if(whiteOpenFiles > 0)
+        traceParameter(HCETrace::BLACK_ATTACK, hceParams.mgKingOpenFileWeight[whiteOpenFiles - 1], 1, 0);
+
     // Bauernsturm
 
     Bitboard whitePawnStorm = pawnStormMask[BLACK / COLOR_MASK][blackKingSquare] & whitePawns & ~evaluationVars.whiteImmobilePawns & blackPawns.shiftSouthWestEast().extrudeSouth();
@@ -890,11 +996,13 @@ Score HandcraftedEvaluator::evaluateKingAttackZone() {
     while(whitePawnStorm) {
         int rank = Square::rankOf(whitePawnStorm.popFSB());
         whiteMGAttackWeight += hceParams.getMGPawnStormWeight(rank);
+        traceParameter(HCETrace::WHITE_ATTACK, hceParams.getMGPawnStormWeight(rank), 1, 0);
     }
 
     while(blackPawnStorm) {
         int rank = Square::rankOf(Square::flipY(blackPawnStorm.popFSB()));
         blackMGAttackWeight += hceParams.getMGPawnStormWeight(rank);
+        traceParameter(HCETrace::BLACK_ATTACK, hceParams.getMGPawnStormWeight(rank), 1, 0);
     }
 
     // Bauernschild
@@ -911,6 +1019,19 @@ Score HandcraftedEvaluator::evaluateKingAttackZone() {
     whiteMGAttackWeight -= hceParams.getMGPawnShieldSizeWeight(whitePawnShieldSize);
     blackMGAttackWeight -= hceParams.getMGPawnShieldSizeWeight(blackPawnShieldSize);
 
+    if(whitePawnShieldSize > 0)
+        traceParameter(HCETrace::WHITE_ATTACK, hceParams.mgPawnShieldSizeWeight[whitePawnShieldSize - 1], -1, 0);
+
+    if(blackPawnShieldSize > 0)
+        traceParameter(HCETrace::BLACK_ATTACK, hceParams.mgPawnShieldSizeWeight[blackPawnShieldSize - 1], -1, 0);
+
+    // Der Bonus für die Königssicherheit wird aus einer Tabelle gelesen,
+    // die Ableitung nach den Angriffsgewichten ist die Steigung der Tabelle
+    if constexpr(Traced) {
+        trace->fold(HCETrace::WHITE_ATTACK, HCETrace::SCORE, kingAttackSlope(whiteMGAttackWeight), kingAttackSlope(whiteEGAttackWeight));
+        trace->fold(HCETrace::BLACK_ATTACK, HCETrace::SCORE, -kingAttackSlope(blackMGAttackWeight), -kingAttackSlope(blackEGAttackWeight));
+    }
+
     whiteMGAttackWeight = std::clamp(whiteMGAttackWeight, 0, (int)(sizeof(kingAttackBonus) / sizeof(kingAttackBonus[0]) - 1));
     whiteEGAttackWeight = std::clamp(whiteEGAttackWeight, 0, (int)(sizeof(kingAttackBonus) / sizeof(kingAttackBonus[0]) - 1));
     blackMGAttackWeight = std::clamp(blackMGAttackWeight, 0, (int)(sizeof(kingAttackBonus) / sizeof(kingAttackBonus[0]) - 1));
@@ -922,14 +1043,16 @@ Score HandcraftedEvaluator::evaluateKingAttackZone() {
     };
 }
 
-Score HandcraftedEvaluator::calculatePieceScore() {
+template<bool Traced>
+Score BasicHandcraftedEvaluator<Traced>::calculatePieceScore() {
     return evaluateAttackedPieces() + evaluatePinnedPieces() + evaluateSpace() + evaluatePieceMobility() +
            evaluateMinorPiecesOnStrongSquares() + evaluateBadBishops() + evaluateRooksOnOpenFiles() +
            evaluateRooksBehindPassedPawns() + evaluateBlockedPassedPawns() + evaluateKingPawnProximity() +
            evaluateRuleOfTheSquare();
 }
 
-Score HandcraftedEvaluator::evaluateAttackedPieces() {
+template<bool Traced>
+Score BasicHandcraftedEvaluator<Traced>::evaluateAttackedPieces() {
     Score score{0, 0};
 
     Bitboard whitePawnAttacks = board.getAttackBitboard(WHITE_PAWN);
@@ -949,6 +1072,8 @@ Score HandcraftedEvaluator::evaluateAttackedPieces() {
         attackDiff * hceParams.getEGAttackByMinorPieceBonus(PAWN)
     };
 
+    traceScore(HCETrace::SCORE, hceParams.getMGAttackByMinorPieceBonus(PAWN), hceParams.getEGAttackByMinorPieceBonus(PAWN), attackDiff);
+
     attackDiff = (board.getPieceBitboard(BLACK_PAWN) & ~blackPawnAttacks & whiteRookAttacks).popcount() -
                  (board.getPieceBitboard(WHITE_PAWN) & ~whitePawnAttacks & blackRookAttacks).popcount();
 
@@ -957,6 +1082,8 @@ Score HandcraftedEvaluator::evaluateAttackedPieces() {
         attackDiff * hceParams.getEGAttackByRookBonus(PAWN)
     };
 
+    traceScore(HCETrace::SCORE, hceParams.getMGAttackByRookBonus(PAWN), hceParams.getEGAttackByRookBonus(PAWN), attackDiff);
+
     attackDiff = (board.getPieceBitboard(BLACK_KNIGHT) & whiteMinorPieceAttacks).popcount() -
                  (board.getPieceBitboard(WHITE_KNIGHT) & blackMinorPieceAttacks).popcount();
 
@@ -965,6 +1092,8 @@ Score HandcraftedEvaluator::evaluateAttackedPieces() {
         attackDiff * hceParams.getEGAttackByMinorPieceBonus(KNIGHT)
     };
 
+    traceScore(HCETrace::SCORE, hceParams.getMGAttackByMinorPieceBonus(KNIGHT), hceParams.getEGAttackByMinorPieceBonus(KNIGHT), attackDiff);
+
     attackDiff = (board.getPieceBitboard(BLACK_KNIGHT) & ~blackPawnAttacks & whiteRookAttacks).popcount() -
                  (board.getPieceBitboard(WHITE_KNIGHT) & ~whitePawnAttacks & blackRookAttacks).popcount();
 
@@ -973,6 +1102,8 @@ Score HandcraftedEvaluator::evaluateAttackedPieces() {
         attackDiff * hceParams.getEGAttackByRookBonus(KNIGHT)
     };
 
+    traceScore(HCETrace::SCORE, hceParams.getMGAttackByRookBonus(KNIGHT), hceParams.getEGAttackByRookBonus(KNIGHT), attackDiff);
+
     attackDiff = (board.getPieceBitboard(BLACK_BISHOP) & whiteMinorPieceAttacks).popcount() -
                  (board.getPieceBitboard(WHITE_BISHOP) & blackMinorPieceAttacks).popcount();
 
@@ -981,6 +1112,8 @@ Score HandcraftedEvaluator::evaluateAttackedPieces() {
         attackDiff * hceParams.getEGAttackByMinorPieceBonus(BISHOP)
     };
 
+    traceScore(HCETrace::SCORE, hceParams.getMGAttackByMinorPieceBonus(BISHOP), hceParams.getEGAttackByMinorPieceBonus(BISHOP), attackDiff);
+
     attackDiff = (board.getPieceBitboard(BLACK_BISHOP) & ~blackPawnAttacks & whiteRookAttacks).popcount() -
                  (board.getPieceBitboard(WHITE_BISHOP) & ~whitePawnAttacks & blackRookAttacks).popcount();
 
@@ -989,6 +1122,8 @@ Score HandcraftedEvaluator::evaluateAttackedPieces() {
         attackDiff * hceParams.getEGAttackByRookBonus(BISHOP)
     };
 
+    traceScore(HCETrace::SCORE, hceParams.getMGAttackByRookBonus(BISHOP), hceParams.getEGAttackByRookBonus(BISHOP), attackDiff);
+
     attackDiff = (board.getPieceBitboard(BLACK_ROOK) & whiteMinorPieceAttacks).popcount() -
                  (board.getPieceBitboard(WHITE_ROOK) & blackMinorPieceAttacks).popcount();
 
@@ -997,6 +1132,8 @@ Score HandcraftedEvaluator::evaluateAttackedPieces() {
         attackDiff * hceParams.getEGAttackByMinorPieceBonus(ROOK)
     };
 
+    traceScore(HCETrace::SCORE, hceParams.getMGAttackByMinorPieceBonus(ROOK), hceParams.getEGAttackByMinorPieceBonus(ROOK), attackDiff);
+
     attackDiff = (board.getPieceBitboard(BLACK_ROOK) & whiteRookAttacks).popcount() -
                  (board.getPieceBitboard(WHITE_ROOK) & blackRookAttacks).popcount();
 
@@ -1005,6 +1142,8 @@ Score HandcraftedEvaluator::evaluateAttackedPieces() {
         attackDiff * hceParams.getEGAttackByRookBonus(ROOK)
     };
 
+    traceScore(HCETrace::SCORE, hceParams.getMGAttackByRookBonus(ROOK), hceParams.getEGAttackByRookBonus(ROOK), attackDiff);
+
     attackDiff = (board.getPieceBitboard(BLACK_QUEEN) & whiteMinorPieceAttacks).popcount() -
                  (board.getPieceBitboard(WHITE_QUEEN) & blackMinorPieceAttacks).popcount();
 
@@ -1013,6 +1152,8 @@ Score HandcraftedEvaluator::evaluateAttackedPieces() {
         attackDiff * hceParams.getEGAttackByMinorPieceBonus(QUEEN)
     };
 
+    traceScore(HCETrace::SCORE, hceParams.getMGAttackByMinorPieceBonus(QUEEN), hceParams.getEGAttackByMinorPieceBonus(QUEEN), attackDiff);
+
     attackDiff = (board.getPieceBitboard(BLACK_QUEEN) & whiteRookAttacks).popcount() -
                  (board.getPieceBitboard(WHITE_QUEEN) & blackRookAttacks).popcount();
 
@@ -1021,10 +1162,13 @@ Score HandcraftedEvaluator::evaluateAttackedPieces() {
         attackDiff * hceParams.getEGAttackByRookBonus(QUEEN)
     };
 
+    traceScore(HCETrace::SCORE, hceParams.getMGAttackByRookBonus(QUEEN), hceParams.getEGAttackByRookBonus(QUEEN), attackDiff);
+
     return score;
 }
 
-Score HandcraftedEvaluator::evaluatePinnedPieces() {
+template<bool Traced>
+Score BasicHandcraftedEvaluator<Traced>::evaluatePinnedPieces() {
     Score score{0, 0};
 
     int whitePins = 0;
@@ -1142,6 +1286,8 @@ Score HandcraftedEvaluator::evaluatePinnedPieces() {
         (whitePins - blackPins) * hceParams.getEGPinnedPieceBonus()
     };
 
+    traceScore(HCETrace::SCORE, hceParams.getMGPinnedPieceBonus(), hceParams.getEGPinnedPieceBonus(), (whitePins - blackPins));
+
     int whiteSkewers = 0;
     int blackSkewers = 0;
 
@@ -1246,10 +1392,13 @@ Score HandcraftedEvaluator::evaluatePinnedPieces() {
         (whiteSkewers - blackSkewers) * hceParams.getEGSkeweredPieceBonus()
     };
 
+    traceScore(HCETrace::SCORE, hceParams.getMGSkeweredPieceBonus(), hceParams.getEGSkeweredPieceBonus(), (whiteSkewers - blackSkewers));
+
     return score;
 }
 
-Score HandcraftedEvaluator::evaluateSpace() {
+template<bool Traced>
+Score BasicHandcraftedEvaluator<Traced>::evaluateSpace() {
     Bitboard whitePawnAttacks = board.getAttackBitboard(WHITE_PAWN);
     Bitboard blackPawnAttacks = board.getAttackBitboard(BLACK_PAWN);
 
@@ -1260,6 +1409,8 @@ Score HandcraftedEvaluator::evaluateSpace() {
     int spaceDiff = (whiteSafeSquares.popcount() + (whiteSafeSquares & fileCtoFRank2to5).popcount()) -
                     (blackSafeSquares.popcount() + (blackSafeSquares & fileCtoFRank4to7).popcount());
 
+    traceScore(HCETrace::SCORE, hceParams.getMGSpaceBonus(), hceParams.getEGSpaceBonus(), spaceDiff);
+
     return Score{
         spaceDiff * hceParams.getMGSpaceBonus(),
         spaceDiff * hceParams.getEGSpaceBonus()
@@ -1274,7 +1425,8 @@ constexpr double signedSqrt(double value) {
     return value < 0.0 ? -std::sqrt(-value) : std::sqrt(value);
 }
 
-Score HandcraftedEvaluator::evaluatePieceMobility() {
+template<bool Traced>
+Score BasicHandcraftedEvaluator<Traced>::evaluatePieceMobility() {
     Score score{0, 0};
 
     Bitboard whiteBlockedPawns = board.getPieceBitboard(WHITE_PAWN) & (board.getPieceBitboard(BLACK) | board.getPieceBitboard(BLACK_KING)).shiftSouth();
@@ -1292,12 +1444,17 @@ Score HandcraftedEvaluator::evaluatePieceMobility() {
         Bitboard attacks = knightAttackBitboard(sq) & ~whiteNotReachableSquares;
         int numAttacks = attacks.popcount();
 
-        if(numAttacks == 0)
+        if(numAttacks == 0) {
             score += {hceParams.getMGPieceNoMobilityPenalty(KNIGHT), hceParams.getEGPieceNoMobilityPenalty(KNIGHT)};
-        else {
+            traceScore(HCETrace::SCORE, hceParams.getMGPieceNoMobilityPenalty(KNIGHT), hceParams.getEGPieceNoMobilityPenalty(KNIGHT), 1);
+        } else {
             score += {(int)signedSqrt(numAttacks * (int32_t)signedSquare(hceParams.getMGPieceMobilityBonus(KNIGHT))),
                       (int)signedSqrt(numAttacks * (int32_t)signedSquare(hceParams.getEGPieceMobilityBonus(KNIGHT)))};
             score.eg += (bool)(attacks & passedPawnTrajectories) * hceParams.getEGAttackOnPassedPawnPathBonus();
+
+            // signedSqrt(n * signedSquare(x)) = sqrt(n) * x
+            traceScore(HCETrace::SCORE, hceParams.getMGPieceMobilityBonus(KNIGHT), hceParams.getEGPieceMobilityBonus(KNIGHT), std::sqrt(numAttacks));
+            traceParameter(HCETrace::SCORE, hceParams.getEGAttackOnPassedPawnPathBonus(), 0, (bool)(attacks & passedPawnTrajectories));
         }
     }
 
@@ -1307,12 +1464,16 @@ Score HandcraftedEvaluator::evaluatePieceMobility() {
         Bitboard attacks = knightAttackBitboard(sq) & ~blackNotReachableSquares;
         int numAttacks = attacks.popcount();
 
-        if(numAttacks == 0)
+        if(numAttacks == 0) {
             score -= {hceParams.getMGPieceNoMobilityPenalty(KNIGHT), hceParams.getEGPieceNoMobilityPenalty(KNIGHT)};
-        else {
+            traceScore(HCETrace::SCORE, hceParams.getMGPieceNoMobilityPenalty(KNIGHT), hceParams.getEGPieceNoMobilityPenalty(KNIGHT), -1);
+        } else {
             score -= {(int)signedSqrt(numAttacks * (int32_t)signedSquare(hceParams.getMGPieceMobilityBonus(KNIGHT))),
                       (int)signedSqrt(numAttacks * (int32_t)signedSquare(hceParams.getEGPieceMobilityBonus(KNIGHT)))};
             score.eg -= (bool)(attacks & passedPawnTrajectories) * hceParams.getEGAttackOnPassedPawnPathBonus();
+
+            traceScore(HCETrace::SCORE, hceParams.getMGPieceMobilityBonus(KNIGHT), hceParams.getEGPieceMobilityBonus(KNIGHT), -std::sqrt(numAttacks));
+            traceParameter(HCETrace::SCORE, hceParams.getEGAttackOnPassedPawnPathBonus(), 0, -(bool)(attacks & passedPawnTrajectories));
         }
     }
 
@@ -1322,12 +1483,16 @@ Score HandcraftedEvaluator::evaluatePieceMobility() {
         Bitboard attacks = diagonalAttackBitboard(sq, board.getPieceBitboard() | board.getPieceBitboard(WHITE_KING)) & ~whiteNotReachableSquares;
         int numAttacks = attacks.popcount();
 
-        if(numAttacks == 0)
+        if(numAttacks == 0) {
             score += {hceParams.getMGPieceNoMobilityPenalty(BISHOP), hceParams.getEGPieceNoMobilityPenalty(BISHOP)};
-        else {
+            traceScore(HCETrace::SCORE, hceParams.getMGPieceNoMobilityPenalty(BISHOP), hceParams.getEGPieceNoMobilityPenalty(BISHOP), 1);
+        } else {
             score += {(int)signedSqrt(numAttacks * (int32_t)signedSquare(hceParams.getMGPieceMobilityBonus(BISHOP))),
                       (int)signedSqrt(numAttacks * (int32_t)signedSquare(hceParams.getEGPieceMobilityBonus(BISHOP)))};
             score.eg += (bool)(attacks & passedPawnTrajectories) * hceParams.getEGAttackOnPassedPawnPathBonus();
+
+            traceScore(HCETrace::SCORE, hceParams.getMGPieceMobilityBonus(BISHOP), hceParams.getEGPieceMobilityBonus(BISHOP), std::sqrt(numAttacks));
+            traceParameter(HCETrace::SCORE, hceParams.getEGAttackOnPassedPawnPathBonus(), 0, (bool)(attacks & passedPawnTrajectories));
         }
     }
 
@@ -1337,12 +1502,16 @@ Score HandcraftedEvaluator::evaluatePieceMobility() {
         Bitboard attacks = diagonalAttackBitboard(sq, board.getPieceBitboard() | board.getPieceBitboard(BLACK_KING)) & ~blackNotReachableSquares;
         int numAttacks = attacks.popcount();
 
-        if(numAttacks == 0)
+        if(numAttacks == 0) {
             score -= {hceParams.getMGPieceNoMobilityPenalty(BISHOP), hceParams.getEGPieceNoMobilityPenalty(BISHOP)};
-        else {
+            traceScore(HCETrace::SCORE, hceParams.getMGPieceNoMobilityPenalty(BISHOP), hceParams.getEGPieceNoMobilityPenalty(BISHOP), -1);
+        } else {
             score -= {(int)signedSqrt(numAttacks * (int32_t)signedSquare(hceParams.getMGPieceMobilityBonus(BISHOP))),
                       (int)signedSqrt(numAttacks * (int32_t)signedSquare(hceParams.getEGPieceMobilityBonus(BISHOP)))};
             score.eg -= (bool)(attacks & passedPawnTrajectories) * hceParams.getEGAttackOnPassedPawnPathBonus();
+
+            traceScore(HCETrace::SCORE, hceParams.getMGPieceMobilityBonus(BISHOP), hceParams.getEGPieceMobilityBonus(BISHOP), -std::sqrt(numAttacks));
+            traceParameter(HCETrace::SCORE, hceParams.getEGAttackOnPassedPawnPathBonus(), 0, -(bool)(attacks & passedPawnTrajectories));
         }
     }
 
@@ -1355,12 +1524,16 @@ Score HandcraftedEvaluator::evaluatePieceMobility() {
         Bitboard attacks = horizontalAttackBitboard(sq, board.getPieceBitboard() | board.getPieceBitboard(WHITE_KING)) & ~whiteNotReachableSquares;
         int numAttacks = attacks.popcount();
 
-        if(numAttacks == 0)
+        if(numAttacks == 0) {
             score += {hceParams.getMGPieceNoMobilityPenalty(ROOK), hceParams.getEGPieceNoMobilityPenalty(ROOK)};
-        else {
+            traceScore(HCETrace::SCORE, hceParams.getMGPieceNoMobilityPenalty(ROOK), hceParams.getEGPieceNoMobilityPenalty(ROOK), 1);
+        } else {
             score += {(int)signedSqrt(numAttacks * (int32_t)signedSquare(hceParams.getMGPieceMobilityBonus(ROOK))),
                       (int)signedSqrt(numAttacks * (int32_t)signedSquare(hceParams.getEGPieceMobilityBonus(ROOK)))};
             score.eg += (bool)(attacks & passedPawnTrajectories) * hceParams.getEGAttackOnPassedPawnPathBonus();
+
+            traceScore(HCETrace::SCORE, hceParams.getMGPieceMobilityBonus(ROOK), hceParams.getEGPieceMobilityBonus(ROOK), std::sqrt(numAttacks));
+            traceParameter(HCETrace::SCORE, hceParams.getEGAttackOnPassedPawnPathBonus(), 0, (bool)(attacks & passedPawnTrajectories));
         }
     }
 
@@ -1370,12 +1543,16 @@ Score HandcraftedEvaluator::evaluatePieceMobility() {
         Bitboard attacks = horizontalAttackBitboard(sq, board.getPieceBitboard() | board.getPieceBitboard(BLACK_KING)) & ~blackNotReachableSquares;
         int numAttacks = attacks.popcount();
 
-        if(numAttacks == 0)
+        if(numAttacks == 0) {
             score -= {hceParams.getMGPieceNoMobilityPenalty(ROOK), hceParams.getEGPieceNoMobilityPenalty(ROOK)};
-        else {
+            traceScore(HCETrace::SCORE, hceParams.getMGPieceNoMobilityPenalty(ROOK), hceParams.getEGPieceNoMobilityPenalty(ROOK), -1);
+        } else {
             score -= {(int)signedSqrt(numAttacks * (int32_t)signedSquare(hceParams.getMGPieceMobilityBonus(ROOK))),
                       (int)signedSqrt(numAttacks * (int32_t)signedSquare(hceParams.getEGPieceMobilityBonus(ROOK)))};
             score.eg -= (bool)(attacks & passedPawnTrajectories) * hceParams.getEGAttackOnPassedPawnPathBonus();
+
+            traceScore(HCETrace::SCORE, hceParams.getMGPieceMobilityBonus(ROOK), hceParams.getEGPieceMobilityBonus(ROOK), -std::sqrt(numAttacks));
+            traceParameter(HCETrace::SCORE, hceParams.getEGAttackOnPassedPawnPathBonus(), 0, -(bool)(attacks & passedPawnTrajectories));
         }
     }
 
@@ -1389,12 +1566,16 @@ Score HandcraftedEvaluator::evaluatePieceMobility() {
                             horizontalAttackBitboard(sq, board.getPieceBitboard() | board.getPieceBitboard(WHITE_KING))) & ~whiteNotReachableSquares;
         int numAttacks = attacks.popcount();
 
-        if(numAttacks == 0)
+        if(numAttacks == 0) {
             score += {hceParams.getMGPieceNoMobilityPenalty(QUEEN), hceParams.getEGPieceNoMobilityPenalty(QUEEN)};
-        else {
+            traceScore(HCETrace::SCORE, hceParams.getMGPieceNoMobilityPenalty(QUEEN), hceParams.getEGPieceNoMobilityPenalty(QUEEN), 1);
+        } else {
             score += {(int)signedSqrt(numAttacks * (int32_t)signedSquare(hceParams.getMGPieceMobilityBonus(QUEEN))),
                       (int)signedSqrt(numAttacks * (int32_t)signedSquare(hceParams.getEGPieceMobilityBonus(QUEEN)))};
             score.eg += (attacks & passedPawnTrajectories).popcount() * hceParams.getEGAttackOnPassedPawnPathBonus();
+
+            traceScore(HCETrace::SCORE, hceParams.getMGPieceMobilityBonus(QUEEN), hceParams.getEGPieceMobilityBonus(QUEEN), std::sqrt(numAttacks));
+            traceParameter(HCETrace::SCORE, hceParams.getEGAttackOnPassedPawnPathBonus(), 0, (attacks & passedPawnTrajectories).popcount());
         }
     }
 
@@ -1405,19 +1586,24 @@ Score HandcraftedEvaluator::evaluatePieceMobility() {
                             horizontalAttackBitboard(sq, board.getPieceBitboard() | board.getPieceBitboard(BLACK_KING))) & ~blackNotReachableSquares;
         int numAttacks = attacks.popcount();
 
-        if(numAttacks == 0)
+        if(numAttacks == 0) {
             score -= {hceParams.getMGPieceNoMobilityPenalty(QUEEN), hceParams.getEGPieceNoMobilityPenalty(QUEEN)};
-        else {
+            traceScore(HCETrace::SCORE, hceParams.getMGPieceNoMobilityPenalty(QUEEN), hceParams.getEGPieceNoMobilityPenalty(QUEEN), -1);
+        } else {
             score -= {(int)signedSqrt(numAttacks * (int32_t)signedSquare(hceParams.getMGPieceMobilityBonus(QUEEN))),
                       (int)signedSqrt(numAttacks * (int32_t)signedSquare(hceParams.getEGPieceMobilityBonus(QUEEN)))};
             score.eg -= (bool)(attacks & passedPawnTrajectories) * hceParams.getEGAttackOnPassedPawnPathBonus();
+
+            traceScore(HCETrace::SCORE, hceParams.getMGPieceMobilityBonus(QUEEN), hceParams.getEGPieceMobilityBonus(QUEEN), -std::sqrt(numAttacks));
+            traceParameter(HCETrace::SCORE, hceParams.getEGAttackOnPassedPawnPathBonus(), 0, -(bool)(attacks & passedPawnTrajectories));
         }
     }
 
     return score;
 }
 
-Score HandcraftedEvaluator::evaluateMinorPiecesOnStrongSquares() {
+template<bool Traced>
+Score BasicHandcraftedEvaluator<Traced>::evaluateMinorPiecesOnStrongSquares() {
     Bitboard whiteKnights = board.getPieceBitboard(WHITE_KNIGHT);
     Bitboard blackKnights = board.getPieceBitboard(BLACK_KNIGHT);
     Bitboard whiteBishops = board.getPieceBitboard(WHITE_BISHOP);
@@ -1436,6 +1622,11 @@ Score HandcraftedEvaluator::evaluateMinorPiecesOnStrongSquares() {
     int numWhiteBishopsOnEdgeOutposts = (whiteBishops & whiteEdgeOutposts).popcount();
     int numBlackBishopsOnEdgeOutposts = (blackBishops & blackEdgeOutposts).popcount();
 
+    traceParameter(HCETrace::SCORE, hceParams.getMGKnightOnCenterOutpostBonus(), numWhiteKnightsOnCenterOutposts - numBlackKnightsOnCenterOutposts, 0);
+    traceParameter(HCETrace::SCORE, hceParams.getMGKnightOnEdgeOutpostBonus(), numWhiteKnightsOnEdgeOutposts - numBlackKnightsOnEdgeOutposts, 0);
+    traceParameter(HCETrace::SCORE, hceParams.getMGBishopOnCenterOutpostBonus(), numWhiteBishopsOnCenterOutposts - numBlackBishopsOnCenterOutposts, 0);
+    traceParameter(HCETrace::SCORE, hceParams.getMGBishopOnEdgeOutpostBonus(), numWhiteBishopsOnEdgeOutposts - numBlackBishopsOnEdgeOutposts, 0);
+
     return {
         hceParams.getMGKnightOnCenterOutpostBonus() * (numWhiteKnightsOnCenterOutposts - numBlackKnightsOnCenterOutposts) +
         hceParams.getMGKnightOnEdgeOutpostBonus() * (numWhiteKnightsOnEdgeOutposts - numBlackKnightsOnEdgeOutposts) +
@@ -1444,7 +1635,8 @@ Score HandcraftedEvaluator::evaluateMinorPiecesOnStrongSquares() {
     0};
 }
 
-Score HandcraftedEvaluator::evaluateBadBishops() {
+template<bool Traced>
+Score BasicHandcraftedEvaluator<Traced>::evaluateBadBishops() {
     Bitboard whiteBishops = board.getPieceBitboard(WHITE_BISHOP);
     Bitboard blackBishops = board.getPieceBitboard(BLACK_BISHOP);
 
@@ -1476,6 +1668,7 @@ Score HandcraftedEvaluator::evaluateBadBishops() {
         bishopBadness[WHITE / COLOR_MASK][isLightSquare] = std::max(bishopBadness[WHITE / COLOR_MASK][isLightSquare], badness);
 
         score += Score{hceParams.getMGBadBishopPenalty(), hceParams.getEGBadBishopPenalty()} * badness;
+        traceScore(HCETrace::SCORE, hceParams.getMGBadBishopPenalty(), hceParams.getEGBadBishopPenalty(), badness);
     }
 
     while(blackBishops) {
@@ -1490,6 +1683,7 @@ Score HandcraftedEvaluator::evaluateBadBishops() {
         bishopBadness[BLACK / COLOR_MASK][isLightSquare] = std::max(bishopBadness[BLACK / COLOR_MASK][isLightSquare], badness);
 
         score -= Score{hceParams.getMGBadBishopPenalty(), hceParams.getEGBadBishopPenalty()} * badness;
+        traceScore(HCETrace::SCORE, hceParams.getMGBadBishopPenalty(), hceParams.getEGBadBishopPenalty(), -badness);
     }
 
     // Apply bonus for bishop badness inequality
@@ -1508,10 +1702,13 @@ Score HandcraftedEvaluator::evaluateBadBishops() {
         hceParams.getEGBishopDominanceBonus() * (lightSquareBadnessDiff + darkSquareBadnessDiff)
     };
 
+    traceScore(HCETrace::SCORE, hceParams.getMGBishopDominanceBonus(), hceParams.getEGBishopDominanceBonus(), lightSquareBadnessDiff + darkSquareBadnessDiff);
+
     return score;
 }
 
-Score HandcraftedEvaluator::evaluateRooksOnOpenFiles() {
+template<bool Traced>
+Score BasicHandcraftedEvaluator<Traced>::evaluateRooksOnOpenFiles() {
     Bitboard whiteRooks = board.getPieceBitboard(WHITE_ROOK);
     Bitboard blackRooks = board.getPieceBitboard(BLACK_ROOK);
 
@@ -1534,13 +1731,19 @@ Score HandcraftedEvaluator::evaluateRooksOnOpenFiles() {
     int doubledWhiteRooksOnSemiOpenFiles = (doubledWhiteRooks & whiteSemiOpenFiles).popcount();
     int doubledBlackRooksOnSemiOpenFiles = (doubledBlackRooks & blackSemiOpenFiles).popcount();
 
+    traceParameter(HCETrace::SCORE, hceParams.getMGRookOnOpenFileBonus(), numWhiteRooksOnOpenFiles - numBlackRooksOnOpenFiles, 0);
+    traceParameter(HCETrace::SCORE, hceParams.getMGRookOnSemiOpenFileBonus(), numWhiteRooksOnSemiOpenFiles - numBlackRooksOnSemiOpenFiles, 0);
+    traceParameter(HCETrace::SCORE, hceParams.getMGDoubledRooksOnOpenFileBonus(), doubledWhiteRooksOnOpenFiles - doubledBlackRooksOnOpenFiles, 0);
+    traceParameter(HCETrace::SCORE, hceParams.getMGDoubledRooksOnSemiOpenFileBonus(), doubledWhiteRooksOnSemiOpenFiles - doubledBlackRooksOnSemiOpenFiles, 0);
+
     return {hceParams.getMGRookOnOpenFileBonus() * (numWhiteRooksOnOpenFiles - numBlackRooksOnOpenFiles) +
             hceParams.getMGRookOnSemiOpenFileBonus() * (numWhiteRooksOnSemiOpenFiles - numBlackRooksOnSemiOpenFiles) +
             hceParams.getMGDoubledRooksOnOpenFileBonus() * (doubledWhiteRooksOnOpenFiles - doubledBlackRooksOnOpenFiles) +
             hceParams.getMGDoubledRooksOnSemiOpenFileBonus() * (doubledWhiteRooksOnSemiOpenFiles - doubledBlackRooksOnSemiOpenFiles), 0};
 }
 
-Score HandcraftedEvaluator::evaluateRooksBehindPassedPawns() {
+template<bool Traced>
+Score BasicHandcraftedEvaluator<Traced>::evaluateRooksBehindPassedPawns() {
     Bitboard whiteRooks = board.getPieceBitboard(WHITE_ROOK);
     Bitboard blackRooks = board.getPieceBitboard(BLACK_ROOK);
 
@@ -1557,17 +1760,20 @@ Score HandcraftedEvaluator::evaluateRooksBehindPassedPawns() {
     while(whiteCandidates) {
         int sq = whiteCandidates.popFSB();
         score.eg += !(fileFacingEnemy[WHITE / COLOR_MASK][sq] & whiteLinesBehindPassedPawns & occupancy) * hceParams.getEGRookBehindPassedPawnBonus();
+        traceParameter(HCETrace::SCORE, hceParams.getEGRookBehindPassedPawnBonus(), 0, !(fileFacingEnemy[WHITE / COLOR_MASK][sq] & whiteLinesBehindPassedPawns & occupancy));
     }
 
     while(blackCandidates) {
         int sq = blackCandidates.popFSB();
         score.eg -= !(fileFacingEnemy[BLACK / COLOR_MASK][sq] & blackLinesBehindPassedPawns & occupancy) * hceParams.getEGRookBehindPassedPawnBonus();
+        traceParameter(HCETrace::SCORE, hceParams.getEGRookBehindPassedPawnBonus(), 0, -!(fileFacingEnemy[BLACK / COLOR_MASK][sq] & blackLinesBehindPassedPawns & occupancy));
     }
 
     return score;
 }
 
-Score HandcraftedEvaluator::evaluateBlockedPassedPawns() {
+template<bool Traced>
+Score BasicHandcraftedEvaluator<Traced>::evaluateBlockedPassedPawns() {
     Bitboard whitePassedPawns = evaluationVars.whitePassedPawns;
     Bitboard blackPassedPawns = evaluationVars.blackPassedPawns;
 
@@ -1583,16 +1789,20 @@ Score HandcraftedEvaluator::evaluateBlockedPassedPawns() {
         int sq = whitePassedPawns.popFSB();
         Bitboard pathToPromotion = fileFacingEnemy[WHITE / COLOR_MASK][sq];
 
-        if(blackPieces & pathToPromotion)
+        if(blackPieces & pathToPromotion) {
             score.eg -= hceParams.getEGBlockedEnemyPassedPawnBonus();
+            traceParameter(HCETrace::SCORE, hceParams.getEGBlockedEnemyPassedPawnBonus(), 0, -1);
+        }
     }
 
     while(blackPassedPawns) {
         int sq = blackPassedPawns.popFSB();
         Bitboard pathToPromotion = fileFacingEnemy[BLACK / COLOR_MASK][sq];
 
-        if(whitePieces & pathToPromotion)
+        if(whitePieces & pathToPromotion) {
             score.eg += hceParams.getEGBlockedEnemyPassedPawnBonus();
+            traceParameter(HCETrace::SCORE, hceParams.getEGBlockedEnemyPassedPawnBonus(), 0, 1);
+        }
     }
 
     return score;
@@ -1607,7 +1817,8 @@ int kingDistance(int sq1, int sq2) {
     return std::max(std::abs(file1 - file2), std::abs(rank1 - rank2));
 }
 
-Score HandcraftedEvaluator::evaluateKingPawnProximity() {
+template<bool Traced>
+Score BasicHandcraftedEvaluator<Traced>::evaluateKingPawnProximity() {
     Score score = {0, 0};
 
     int whiteKingSquare = board.getKingSquare(WHITE);
@@ -1625,19 +1836,23 @@ Score HandcraftedEvaluator::evaluateKingPawnProximity() {
         if(passedPawns.getBit(sq)) {
             score.eg += (7 - whiteKingDist) * hceParams.getEGKingProximityPassedPawnWeight();
             score.eg -= (7 - blackKingDist) * hceParams.getEGKingProximityPassedPawnWeight();
+            traceParameter(HCETrace::SCORE, hceParams.getEGKingProximityPassedPawnWeight(), 0, blackKingDist - whiteKingDist);
         } else if(backwardPawns.getBit(sq)) {
             score.eg += (7 - whiteKingDist) * hceParams.getEGKingProximityBackwardPawnWeight();
             score.eg -= (7 - blackKingDist) * hceParams.getEGKingProximityBackwardPawnWeight();
+            traceParameter(HCETrace::SCORE, hceParams.getEGKingProximityBackwardPawnWeight(), 0, blackKingDist - whiteKingDist);
         } else {
             score.eg += (7 - whiteKingDist) * hceParams.getEGKingProximityPawnWeight();
             score.eg -= (7 - blackKingDist) * hceParams.getEGKingProximityPawnWeight();
+            traceParameter(HCETrace::SCORE, hceParams.getEGKingProximityPawnWeight(), 0, blackKingDist - whiteKingDist);
         }
     }
 
     return score;
 }
 
-Score HandcraftedEvaluator::evaluateRuleOfTheSquare() {
+template<bool Traced>
+Score BasicHandcraftedEvaluator<Traced>::evaluateRuleOfTheSquare() {
     Bitboard pawns = board.getPieceBitboard(WHITE_PAWN) | board.getPieceBitboard(BLACK_PAWN);
     Bitboard allPieces = board.getPieceBitboard();
 
@@ -1660,6 +1875,7 @@ Score HandcraftedEvaluator::evaluateRuleOfTheSquare() {
 
             if(std::max(std::abs(blackKingRank - rank), std::abs(blackKingFile - file)) - (sideToMove == BLACK) > RANK_8 - rank) {
                 score += Score{hceParams.getRuleOfTheSquareBonus(), hceParams.getRuleOfTheSquareBonus()};
+                traceParameter(HCETrace::SCORE, hceParams.getRuleOfTheSquareBonus(), 1, 1);
                 break;
             }
         }
@@ -1678,6 +1894,7 @@ Score HandcraftedEvaluator::evaluateRuleOfTheSquare() {
 
             if(std::max(std::abs(whiteKingRank - rank), std::abs(whiteKingFile - file)) - (sideToMove == WHITE) > rank - RANK_1) {
                 score -= Score{hceParams.getRuleOfTheSquareBonus(), hceParams.getRuleOfTheSquareBonus()};
+                traceParameter(HCETrace::SCORE, hceParams.getRuleOfTheSquareBonus(), -1, -1);
                 break;
             }
         }
@@ -1688,8 +1905,10 @@ Score HandcraftedEvaluator::evaluateRuleOfTheSquare() {
     return {0, 0};
 }
 
-Score HandcraftedEvaluator::getDrawPenalty(int side) {
+template<bool Traced>
+Score BasicHandcraftedEvaluator<Traced>::getDrawPenalty(int side) {
     Score penalty{hceParams.getMGDefaultWinnablePenalty(), hceParams.getEGDefaultWinnablePenalty()};
+    traceScore(HCETrace::DRAW_PENALTY, hceParams.getMGDefaultWinnablePenalty(), hceParams.getEGDefaultWinnablePenalty(), 1);
 
     int otherSide = side ^ COLOR_MASK;
 
@@ -1697,18 +1916,21 @@ Score HandcraftedEvaluator::getDrawPenalty(int side) {
     Bitboard otherPawns = board.getPieceBitboard(otherSide | PAWN);
     Bitboard pawns = ourPawns | otherPawns;
 
-    if(pawns == board.getPieceBitboard())
+    if(pawns == board.getPieceBitboard()) {
         penalty.eg += hceParams.getKingAndPawnEndgameWinnableBonus();
-    else {
+        traceParameter(HCETrace::DRAW_PENALTY, hceParams.getKingAndPawnEndgameWinnableBonus(), 0, 1);
+    } else {
         if(isOppositeColorBishop()) {
             penalty.mg += hceParams.getMGOppositeColorBishopsWinnablePenalty();
             penalty.eg += hceParams.getEGOppositeColorBishopsWinnablePenalty();
+            traceScore(HCETrace::DRAW_PENALTY, hceParams.getMGOppositeColorBishopsWinnablePenalty(), hceParams.getEGOppositeColorBishopsWinnablePenalty(), 1);
 
             // Spezialfall: Die Läufer sind die einzigen verbliebenen Figuren,
             // die keine Bauern sind.
             if((board.getPieceBitboard(WHITE_BISHOP) | board.getPieceBitboard(BLACK_BISHOP) |
                 pawns) == board.getPieceBitboard()) {
                 penalty.eg += hceParams.getOppositeColorBishopsEndgameWinnablePenalty();
+                traceParameter(HCETrace::DRAW_PENALTY, hceParams.getOppositeColorBishopsEndgameWinnablePenalty(), 0, 1);
             }
         }
 
@@ -1721,6 +1943,7 @@ Score HandcraftedEvaluator::getDrawPenalty(int side) {
             if(whiteMinorPieces.popcount() == blackMinorPieces.popcount() && whiteMinorPieces.popcount() <= 1 &&
             (whiteMinorPieces | blackMinorPieces | pawns | ourRooks | otherRooks) == board.getPieceBitboard()) {
                 penalty.eg += hceParams.getRookEndgameWinnablePenalty();
+                traceParameter(HCETrace::DRAW_PENALTY, hceParams.getRookEndgameWinnablePenalty(), 0, 1);
             }
         }
     }
@@ -1728,6 +1951,7 @@ Score HandcraftedEvaluator::getDrawPenalty(int side) {
     int numPawns = pawns.popcount();
     penalty.mg += hceParams.getMGPawnWinnableBonus() * numPawns;
     penalty.eg += hceParams.getEGPawnWinnableBonus() * numPawns;
+    traceScore(HCETrace::DRAW_PENALTY, hceParams.getMGPawnWinnableBonus(), hceParams.getEGPawnWinnableBonus(), numPawns);
 
     int numPassedOrCandidatePawns;
     if(side == WHITE) {
@@ -1735,22 +1959,26 @@ Score HandcraftedEvaluator::getDrawPenalty(int side) {
         if(Square::rankOf(board.getWhiteKingSquare()) >= RANK_5) {
             penalty.mg += hceParams.getKingInfiltrationWinnableBonus();
             penalty.eg += hceParams.getKingInfiltrationWinnableBonus();
+            traceParameter(HCETrace::DRAW_PENALTY, hceParams.getKingInfiltrationWinnableBonus(), 1, 1);
         }
     } else {
         numPassedOrCandidatePawns = (evaluationVars.blackPassedPawns | evaluationVars.blackCandidatePassedPawns).popcount();
         if(Square::rankOf(board.getBlackKingSquare()) <= RANK_4) {
             penalty.mg += hceParams.getKingInfiltrationWinnableBonus();
             penalty.eg += hceParams.getKingInfiltrationWinnableBonus();
+            traceParameter(HCETrace::DRAW_PENALTY, hceParams.getKingInfiltrationWinnableBonus(), 1, 1);
         }
     }
 
     penalty.mg += hceParams.getMGPassedPawnWinnableBonus() * numPassedOrCandidatePawns;
     penalty.eg += hceParams.getEGPassedPawnWinnableBonus() * numPassedOrCandidatePawns;
+    traceScore(HCETrace::DRAW_PENALTY, hceParams.getMGPassedPawnWinnableBonus(), hceParams.getEGPassedPawnWinnableBonus(), numPassedOrCandidatePawns);
 
     return Score{std::min(penalty.mg, 0), std::min(penalty.eg, 0)};
 }
 
-bool HandcraftedEvaluator::isWinnable(int side) {
+template<bool Traced>
+bool BasicHandcraftedEvaluator<Traced>::isWinnable(int side) {
     if(board.getPieceBitboard(side | PAWN))
         return true;
 
@@ -1776,7 +2004,8 @@ bool HandcraftedEvaluator::isWinnable(int side) {
     return false;
 }
 
-bool HandcraftedEvaluator::isOppositeColorBishop() {
+template<bool Traced>
+bool BasicHandcraftedEvaluator<Traced>::isOppositeColorBishop() {
     Bitboard whiteBishops = board.getPieceBitboard(WHITE_BISHOP);
     Bitboard blackBishops = board.getPieceBitboard(BLACK_BISHOP);
 
@@ -1784,7 +2013,8 @@ bool HandcraftedEvaluator::isOppositeColorBishop() {
            (bool)(whiteBishops & lightSquares) != (bool)(blackBishops & lightSquares);
 }
 
-bool HandcraftedEvaluator::isDrawnKRPKREndgame() {
+template<bool Traced>
+bool BasicHandcraftedEvaluator<Traced>::isDrawnKRPKREndgame() {
     Bitboard whitePawns = board.getPieceBitboard(WHITE_PAWN);
     Bitboard blackPawns = board.getPieceBitboard(BLACK_PAWN);
     Bitboard whiteKings = board.getPieceBitboard(WHITE_KING);
@@ -1797,7 +2027,8 @@ bool HandcraftedEvaluator::isDrawnKRPKREndgame() {
         return blackPawns.shiftSouth().extrudeSouth() & whiteKings;
 }
 
-bool HandcraftedEvaluator::isDrawnSinglePawnEndgame() {
+template<bool Traced>
+bool BasicHandcraftedEvaluator<Traced>::isDrawnSinglePawnEndgame() {
     Bitboard whitePawns = board.getPieceBitboard(WHITE_PAWN);
     Bitboard blackPawns = board.getPieceBitboard(BLACK_PAWN);
     Bitboard whiteRooks = board.getPieceBitboard(WHITE_ROOK);
@@ -1854,7 +2085,8 @@ bool HandcraftedEvaluator::isDrawnSinglePawnEndgame() {
     return false;
 }
 
-int HandcraftedEvaluator::evaluateKNBKEndgame(int b, int k) {
+template<bool Traced>
+int BasicHandcraftedEvaluator<Traced>::evaluateKNBKEndgame(int b, int k) {
     int evaluation = std::abs(evaluationVars.materialScore.eg);
 
     b = b < 0 ? -1 : 0;
@@ -1865,7 +2097,8 @@ int HandcraftedEvaluator::evaluateKNBKEndgame(int b, int k) {
     return evaluation + hceParams.getMopupBaseBonus();
 }
 
-int HandcraftedEvaluator::evaluateWinningNoPawnsEndgame(int k) {
+template<bool Traced>
+int BasicHandcraftedEvaluator<Traced>::evaluateWinningNoPawnsEndgame(int k) {
     int evaluation = std::abs(evaluationVars.materialScore.eg);
 
     int file = SQ2F(k);
@@ -1878,4 +2111,7 @@ int HandcraftedEvaluator::evaluateWinningNoPawnsEndgame(int k) {
     evaluation += manhattanDistToCenter * hceParams.getMopupProgressBonus();
 
     return evaluation + hceParams.getMopupBaseBonus();
-}
\ No newline at end of file
+}
+
+template class BasicHandcraftedEvaluator<false>;
+template class BasicHandcraftedEvaluator<true>;
\ No newline at end of file
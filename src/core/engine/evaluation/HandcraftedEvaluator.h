@@ -3,12 +3,22 @@
 
 #include "core/engine/evaluation/EvaluationDefinitons.h"
 #include "core/engine/evaluation/Evaluator.h"
+#include "core/engine/evaluation/HCETrace.h"
 #include "core/engine/search/SearchDefinitions.h"
 #include "core/utils/hce/HCEParameters.h"
 
 #include <vector>
 
-class HandcraftedEvaluator: public Evaluator {
+/**
+ * @brief Die handgeschriebene Bewertungsfunktion.
+ *
+ * @tparam Traced Gibt an, ob die Koeffizienten aller Parameter in der Bewertung
+ * aufgezeichnet werden (siehe HCETrace). Die Aufzeichnung verlangsamt die Bewertung
+ * und ist nur für das Tuning gedacht. Die Engine verwendet HandcraftedEvaluator,
+ * in dem der Code für die Aufzeichnung nicht enthalten ist.
+ */
+template<bool Traced>
+class BasicHandcraftedEvaluator: public Evaluator {
     private:
         struct EvaluationVariables {
             Score materialScore; // Bewertung des Materials und der Figurentabellen
@@ -29,6 +39,11 @@ class HandcraftedEvaluator: public Evaluator {
 
         const HCEParameters& hceParams;
 
+        /**
+         * @brief Zeichnet die Koeffizienten der Parameter auf (nur mit Traced, sonst nullptr).
+         */
+        HCETrace* trace = nullptr;
+
         EvaluationVariables evaluationVars;
 
         std::vector<EvaluationVariables> evaluationHistory;
@@ -63,18 +78,60 @@ class HandcraftedEvaluator: public Evaluator {
         int evaluateKNBKEndgame(int ownBishopSq, int oppKingSq);
         int evaluateWinningNoPawnsEndgame(int oppKingSq);
 
-    public:
-        HandcraftedEvaluator(Board& b, const HCEParameters& hceParams) : Evaluator(b), hceParams(hceParams) {
+        /**
+         * @brief Zeichnet den Koeffizienten eines Parameters in der
+         * Mittel- und Endspielbewertung auf, falls die Bewertung verfolgt wird.
+         */
+        inline void traceParameter(HCETrace::Channel channel, const int16_t& parameter, double mgCoefficient, double egCoefficient) {
+            if constexpr(Traced)
+                trace->add(channel, hceParams.indexOf(&parameter), mgCoefficient, egCoefficient);
+        }
+
+        /**
+         * @brief Zeichnet ein Paar aus Mittel- und Endspielparameter auf,
+         * die mit demselben Koeffizienten in die Bewertung eingehen.
+         */
+        inline void traceScore(HCETrace::Channel channel, const int16_t& mgParameter, const int16_t& egParameter, double coefficient) {
+            traceParameter(channel, mgParameter, coefficient, 0.0);
+            traceParameter(channel, egParameter, 0.0, coefficient);
+        }
+
+        /**
+         * @brief Die Steigung von kingAttackBonus an einem (nicht begrenzten) Angriffsgewicht.
+         */
+        static int kingAttackSlope(int attackWeight);
+
+        inline void init() {
             evaluationHistory.reserve(MAX_PLY);
 
+            if constexpr(Traced)
+                trace->clear();
+
             calculateMaterialScore();
             calculatePawnScore();
             calculateGamePhase();
+        }
+
+    public:
+        BasicHandcraftedEvaluator(Board& b, const HCEParameters& hceParams) requires(!Traced) : Evaluator(b), hceParams(hceParams) {
+            init();
         };
 
-        HandcraftedEvaluator(Board& b) : HandcraftedEvaluator(b, HCE_PARAMS) {};
+        BasicHandcraftedEvaluator(Board& b) requires(!Traced) : BasicHandcraftedEvaluator(b, HCE_PARAMS) {};
+
+        /**
+         * @param trace Die Aufzeichnung, in die die Koeffizienten aller Parameter geschrieben werden.
+         */
+        BasicHandcraftedEvaluator(Board& b, const HCEParameters& hceParams, HCETrace& trace) requires(Traced) : Evaluator(b), hceParams(hceParams), trace(&trace) {
+            init();
+        };
 
         inline int evaluate() override {
+            PROFILE_SCOPE(Profiler::EVALUATE);
+
+            if constexpr(Traced)
+                trace->beginEvaluation();
+
             int numWhitePawns = board.getPieceBitboard(WHITE_PAWN).popcount();
             int numBlackPawns = board.getPieceBitboard(BLACK_PAWN).popcount();
             int numPawns = numWhitePawns + numBlackPawns;
@@ -157,6 +214,8 @@ class HandcraftedEvaluator: public Evaluator {
             Score score = (evaluationVars.materialScore + evaluationVars.pawnScore + pieceScore + kingSafetyScore +
                            Score{hceParams.getMGTempoBonus(), hceParams.getEGTempoBonus()} * (board.getSideToMove() == WHITE ? 1 : -1));
 
+            traceScore(HCETrace::SCORE, hceParams.getMGTempoBonus(), hceParams.getEGTempoBonus(), board.getSideToMove() == WHITE ? 1 : -1);
+
             int evaluation = ((1.0 - evaluationVars.phase) * score.mg + evaluationVars.phase * score.eg) *
                               (board.getSideToMove() == WHITE ? 1 : -1);
 
@@ -168,23 +227,56 @@ class HandcraftedEvaluator: public Evaluator {
 
             int linearDrawPenalty = std::min(drawPenalty, std::max(std::abs(evaluation) - DRAW_PENALTY_EXP_THRESHOLD, 0));
             int exponentialDrawPenalty = 0;
-            if(drawPenalty > linearDrawPenalty)
-                exponentialDrawPenalty = std::round(DRAW_PENALTY_EXP_THRESHOLD -
-                            std::exp((linearDrawPenalty - drawPenalty) * (1.0 / (double)DRAW_PENALTY_EXP_THRESHOLD)) * DRAW_PENALTY_EXP_THRESHOLD);
+
+            // Ableitungen der Bewertung nach der Bewertung vor und der Remis-Bestrafung
+            double evaluationDerivative = 1.0;
+            double drawPenaltyDerivative = -evaluationSign;
+
+            if(drawPenalty > linearDrawPenalty) {
+                double decay = std::exp((linearDrawPenalty - drawPenalty) * (1.0 / (double)DRAW_PENALTY_EXP_THRESHOLD));
+                exponentialDrawPenalty = std::round(DRAW_PENALTY_EXP_THRESHOLD - decay * DRAW_PENALTY_EXP_THRESHOLD);
+
+                drawPenaltyDerivative = -evaluationSign * decay;
+                if(linearDrawPenalty > 0)
+                    evaluationDerivative = decay;
+            }
 
             evaluation -= evaluationSign * (linearDrawPenalty + exponentialDrawPenalty);
 
             // Skaliere die Bewertung in Richtung 0, wenn wir uns der 50-Züge-Regel annähern.
             // (Starte erst nach 10 Zügen, damit die Bewertung nicht zu früh verzerrt wird.)
+            double fiftyMoveScale = 1.0;
             int fiftyMoveCounter = board.getFiftyMoveCounter();
-            if(fiftyMoveCounter > 20)
+            if(fiftyMoveCounter > 20) {
                 evaluation = evaluation * (100 - fiftyMoveCounter) / 80;
+                fiftyMoveScale = (100 - fiftyMoveCounter) / 80.0;
+            }
 
-            if(!isWinnable(board.getSideToMove()))
-                evaluation = std::min(evaluation, DRAW_SCORE);
+            bool isBounded = false;
 
-            if(!isWinnable(board.getSideToMove() ^ COLOR_MASK))
-                evaluation = std::max(evaluation, -DRAW_SCORE);
+            if(evaluation > DRAW_SCORE && !isWinnable(board.getSideToMove())) {
+                evaluation = DRAW_SCORE;
+                isBounded = true;
+            }
+
+            if(evaluation < -DRAW_SCORE && !isWinnable(board.getSideToMove() ^ COLOR_MASK)) {
+                evaluation = -DRAW_SCORE;
+                isBounded = true;
+            }
+
+            if constexpr(Traced) {
+                if(!isBounded) {
+                    double sideToMoveSign = board.getSideToMove() == WHITE ? 1.0 : -1.0;
+                    double scoreScale = evaluationDerivative * sideToMoveSign * fiftyMoveScale;
+
+                    // Die Remis-Bestrafung ist auf Werte <= 0 begrenzt und geht negiert ein
+                    double penaltyScale = -drawPenaltyDerivative * fiftyMoveScale;
+
+                    trace->finalize(scoreScale * (1.0 - evaluationVars.phase), scoreScale * evaluationVars.phase,
+                                    drawPenaltyScore.mg != 0 ? penaltyScale * (1.0 - evaluationVars.phase) : 0.0,
+                                    drawPenaltyScore.eg != 0 ? penaltyScale * evaluationVars.phase : 0.0);
+                }
+            }
 
             return evaluation;
         }
@@ -202,6 +294,9 @@ class HandcraftedEvaluator: public Evaluator {
 
             evaluationHistory.clear();
 
+            if constexpr(Traced)
+                trace->clear();
+
             calculateMaterialScore();
             calculatePawnScore();
             calculateGamePhase();
@@ -447,4 +542,10 @@ class HandcraftedEvaluator: public Evaluator {
         };
 };
 
+extern template class BasicHandcraftedEvaluator<false>;
+extern template class BasicHandcraftedEvaluator<true>;
+
+using HandcraftedEvaluator = BasicHandcraftedEvaluator<false>;
+using TracedHandcraftedEvaluator = BasicHandcraftedEvaluator<true>;
+
 #endif
\ No newline at end of file
@@ -22,14 +22,17 @@ class NNUEEvaluator: public Evaluator {
         ~NNUEEvaluator() {}
 
         inline int evaluate() override {
+            PROFILE_SCOPE(Profiler::EVALUATE);
             return networkInstance.evaluate(board.getSideToMove());
         }
 
         inline void updateAfterMove() override {
+            PROFILE_SCOPE(Profiler::EVALUATE_UPDATE);
             networkInstance.updateAfterMove(board);
         }
 
         inline void updateBeforeUndo() override {
+            PROFILE_SCOPE(Profiler::EVALUATE_UPDATE);
             networkInstance.undoMove();
         }
 
@@ -8,30 +8,29 @@
 
 void PVSEngine::helperThreadLoop(size_t instanceIdx) {
     #if not defined(DISABLE_THREADS)
-        int score;
-
-        do {
-            // Warte auf die Bedingungsvariable
-            std::unique_lock<std::mutex> lock(cvMutex);
-            cv.wait(lock, [&]() { return !threadSleepFlag.load(); });
-
-            // Der Thread ist jetzt beschäftigt
-            numThreadsBusy.fetch_add(1);
-            lock.unlock();
+        // Hole die Instanz, die der Thread ausführen soll
+        PVSSearchInstance* instance = instances[instanceIdx];
+        int prevScore = 0;
+
+        // Jeder Helper-Thread führt eine eigene iterative Tiefensuche durch.
+        // Die Threads synchronisieren sich nur über die Transpositionstabelle
+        // und die RootMoveTable, sie werden zwischen den Iterationen nicht angehalten.
+        for(int depth = 1; depth < MAX_PLY && !threadSleepFlag.load(); depth++) {
+            int alpha = MIN_SCORE, beta = MAX_SCORE;
 
-            // Hole die Instanz, die der Thread ausführen soll
-            PVSSearchInstance* instance = instances[instanceIdx];
+            if(depth > 1) {
+                alpha = prevScore - std::abs(prevScore) * PVSEngine::ASPIRATION_WINDOW_SCORE_FACTOR - PVSEngine::ASPIRATION_WINDOW;
+                beta = prevScore + std::abs(prevScore) * PVSEngine::ASPIRATION_WINDOW_SCORE_FACTOR + PVSEngine::ASPIRATION_WINDOW;
 
-            // Kopiere die aktuellen Suchparameter in lokale Variablen
-            int depth = currentDepth;
-            int alpha = currentAlpha;
-            int beta = currentBeta;
+                instance->setBestRootMoveHint(instance->getPV()[0]);
+            }
 
-            score = instance->pvs(depth, 0, alpha, beta, PV_NODE);
+            instance->resetSelectiveDepth();
+            int score = instance->pvs(depth, 0, alpha, beta, PV_NODE);
 
             bool alphaAlreadyWidened = false, betaAlreadyWidened = false;
 
-            while(score <= alpha || score >= beta) {
+            while((score <= alpha || score >= beta) && !threadSleepFlag.load()) {
                 if(score <= alpha) {
                     if(alphaAlreadyWidened)
                         alpha = MIN_SCORE;
@@ -51,35 +50,50 @@ void PVSEngine::helperThreadLoop(size_t instanceIdx) {
                 score = instance->pvs(depth, 0, alpha, beta, PV_NODE);
             }
 
-            // Der Thread ist fertig und wartet auf die nächste Suche
-            cvMutex.lock();
-            numThreadsBusy.fetch_sub(1);
-            cvMutex.unlock();
-            cvMain.notify_one();
+            // Abgebrochene Iterationen werden nicht veröffentlicht
+            if(threadSleepFlag.load() && depth > 1)
+                break;
 
-        } while(!exitSearch.load());
+            prevScore = score;
+            rootMoveTable.publishThreadResult(instanceIdx + 1, depth, instance->getPVScore(),
+                                              instance->getSelectiveDepth(), instance->getPV());
+        }
     #else
-        UNUSED(instance);
+        UNUSED(instanceIdx);
+    #endif
+}
+
+PVSSearchInstance* PVSEngine::createInstance(std::function<void()> checkupFunction) {
+    #if defined(USE_HCE)
+        // Erstelle eine Instanz mit HCE-Parametern
+        return new PVSSearchInstance(board, *hceParams, getTranspositionTable(), threadSleepFlag, startTime,
+                                     stopTime, nodesSearched, checkupFunction);
+    #else
+        return new PVSSearchInstance(board, *nnueNetwork, getTranspositionTable(), threadSleepFlag, startTime,
+                                     stopTime, nodesSearched, checkupFunction);
     #endif
 }
 
 void PVSEngine::createHelperInstances(size_t numThreads) {
     #if not defined(DISABLE_THREADS)
-        for(size_t i = 0; i < numThreads; i++) {
-            #if defined(USE_HCE)
-            // Erstelle eine Hilfsinstanz mit HCE-Parametern
-            instances.push_back(new PVSSearchInstance(board, hceParams, transpositionTable, threadSleepFlag, startTime,
-                                                      stopTime, nodesSearched, nullptr));
-            #else
-            // Erstelle eine Hilfsinstanz
-            instances.push_back(new PVSSearchInstance(board, transpositionTable, threadSleepFlag, startTime,
-                                                      stopTime, nodesSearched, nullptr));
-            #endif
+        // Gebe überzählige Instanzen frei, falls die Anzahl
+        // der Threads seit der letzten Suche verringert wurde.
+        while(instances.size() > numThreads) {
+            delete instances.back();
+            instances.pop_back();
+        }
 
-            instances[i]->setMainThread(false);
+        // Setze die bereits existierenden Instanzen zurück.
+        for(PVSSearchInstance* instance : instances)
+            instance->reset(board);
 
-            // Erstelle einen Hilfsthread
-            threads.push_back(std::thread(&PVSEngine::helperThreadLoop, this, i));
+        // Erstelle fehlende Hilfsinstanzen.
+        while(instances.size() < numThreads)
+            instances.push_back(createInstance(nullptr));
+
+        for(size_t i = 0; i < numThreads; i++) {
+            instances[i]->setMainThread(false);
+            instances[i]->setRootMoveTable(&rootMoveTable);
         }
     #else
         UNUSED(numThreads);
@@ -87,74 +101,69 @@ void PVSEngine::createHelperInstances(size_t numThreads) {
 }
 
 void PVSEngine::destroyHelperInstances() {
-    #if not defined(DISABLE_THREADS)
-        // Wenn die Threads noch laufen, stoppe sie
-        if(!exitSearch.load()) {
-            exitSearch.store(true);
-
-            cvMutex.lock();
-            threadSleepFlag.store(false);
-            cvMutex.unlock();
-            cv.notify_all();
-        }
+    // Breche die Suche der Hilfsthreads ab.
+    threadSleepFlag.store(true);
 
+    #if not defined(DISABLE_THREADS)
         // Joine alle Hilfsthreads
         for(std::thread& thread : threads)
             thread.join();
 
         threads.clear();
+    #endif
+}
 
+void PVSEngine::releaseInstances() {
+    #if not defined(DISABLE_THREADS)
         for(PVSSearchInstance* instance : instances)
             delete instance;
 
         instances.clear();
     #endif
+
+    delete mainInstance;
+    mainInstance = nullptr;
 }
 
-void PVSEngine::startHelperThreads(int depth, int alpha, int beta, const Array<Move, 256>& searchMoves) {
-    #if not defined(DISABLE_THREADS)
-        currentDepth = depth;
-        currentAlpha = alpha;
-        currentBeta = beta;
+void PVSEngine::searchCheckup() {
+    // Die Knotenanzahl wird bei jedem Aufruf und nicht nur
+    // im Checkup-Intervall überprüft, damit kurze Suchen
+    // (z.B. go nodes 1000) nicht unnötig lange laufen.
+    if(nodesSearched.load() >= nodeLimit) {
+        stop();
+        return;
+    }
 
-        // Bereite die Hilfsinstanzen für die nächste Suche vor
-        for(PVSSearchInstance* instance : instances) {
-            instance->resetSelectiveDepth();
-            instance->setSearchMoves(searchMoves);
-        }
+    if(isCheckupTime()) {
+        lastCheckupTime = std::chrono::system_clock::now();
 
-        // Wecke alle Hilfsthreads auf
-        cvMutex.lock();
-        threadSleepFlag.store(false);
-        cvMutex.unlock();
-        cv.notify_all();
-    #else
-        UNUSED(depth);
-        UNUSED(alpha);
-        UNUSED(beta);
-        UNUSED(searchMoves);
+        // Die Zeit ist abgelaufen (und es wurde mindestens Tiefe 1 erreicht)
+        if(lastCheckupTime >= stopTime.load() && maxDepthReached > 0 && !isPondering.load())
+            stop();
 
-        threadSleepFlag.store(false);
-    #endif
+        // Mindestens alle 2 Sekunden die Ausgabe aktualisieren
+        if(uciOutput && lastCheckupTime >= lastOutputTime + std::chrono::milliseconds(MAX_TIME_BETWEEN_OUTPUTS))
+            outputNodesInfo();
+        
+        if(checkupCallback)
+            checkupCallback();
+    }
 }
 
-void PVSEngine::pauseHelperThreads() {
-    #if not defined(DISABLE_THREADS)
-        threadSleepFlag.store(true);
+void PVSEngine::startHelperThreads(const Array<Move, 256>& searchMoves) {
+    threadSleepFlag.store(false);
 
-        // Warte, bis alle Hilfsthreads zurückgekehrt sind
-        std::unique_lock<std::mutex> lock(cvMutex);
-        cvMain.wait(lock, [&]() { return numThreadsBusy.load() == 0; });
-        lock.unlock();
+    #if not defined(DISABLE_THREADS)
+        // Bereite die Hilfsinstanzen auf die Suche vor und starte die Hilfsthreads
+        for(size_t i = 0; i < instances.size(); i++) {
+            instances[i]->setSearchMoves(searchMoves);
+            threads.push_back(std::thread(&PVSEngine::helperThreadLoop, this, i));
+        }
     #else
-        threadSleepFlag.store(true);
+        UNUSED(searchMoves);
     #endif
 }
 
-int threadValue(PVSSearchInstance* instance, int worstScore) {
-    return (instance->getPVScore() - worstScore + 10) * (instance->getPV().size() > 0);
-}
-
 void PVSEngine::outputSearchInfo() {
     // Bestimme die textuelle Repräsentation der Bewertung.
     // Mattbewertungen werden in der Form "mate x" ausgegeben,
@@ -180,7 +189,7 @@ void PVSEngine::outputSearchInfo() {
     // Gebe die Informationen zur Suche aus.
     std::cout << "info depth " << maxDepthReached << " seldepth " << selectiveDepth << " score " << scoreStr << " nodes " << nodesSearched.load() <<
                  " time " << timeElapsed.count() << " nps " << (uint64_t)(nodesSearched.load() / (timeElapsed.count() / 1000.0)) <<
-                 " hashfull " << (unsigned int)((double)transpositionTable.getEntriesWritten() / (double)transpositionTable.getCapacity() * 1000.0) <<
+                 " hashfull " << (unsigned int)((double)getHashTableSize() / (double)getHashTableCapacity() * 1000.0) <<
                  " pv ";
 
     // Gebe die Hauptvariante aus.
@@ -199,7 +208,7 @@ void PVSEngine::outputNodesInfo() {
     // und wie voll die Transpositionstabelle ist, aus.
     std::cout << "info nodes " << nodesSearched.load() << " time " << timeElapsed.count() << " nps " <<
                  (uint64_t)(nodesSearched.load() / (timeElapsed.count() / 1000.0)) <<
-                 " hashfull " << (unsigned int)((double)transpositionTable.getEntriesWritten() / (double)transpositionTable.getCapacity() * 1000.0) << std::endl;
+                 " hashfull " << (unsigned int)((double)getHashTableSize() / (double)getHashTableCapacity() * 1000.0) << std::endl;
 
     lastOutputTime = std::chrono::system_clock::now();
 }
@@ -231,27 +240,30 @@ void PVSEngine::search(const UCI::SearchParams& params) {
     // Setze die Flags und Variablen für die Suche zurück.
     exitSearch.store(false);
     searching.store(true);
-    isTimeControlled = params.useWBTime;
     isPondering.store(params.ponder);
     nodesSearched.store(0);
     maxDepthReached = 0;
-    clearPVHistory();
+    maxRootAge = std::max(maxRootAge, board.getAge());
     variations.clear();
 
-    #if not defined(DISABLE_THREADS)
-        numThreadsBusy.store(0);
+    #if defined(USE_PROFILER)
+        // Bei UCI-Ausgabe wird jede Suche einzeln gemessen,
+        // sonst (z.B. in bench) misst der Aufrufer.
+        if(uciOutput)
+            Profiler::reset();
     #endif
 
-    // Bestimme die Start- und Stopzeit der Suche.
-    startTime.store(std::chrono::system_clock::now());
-    calculateTimeLimits(params);
-    stopTime.store(startTime.load() + timeMax);
-    lastOutputTime = startTime.load();
-
     // Generiere die Liste der legalen Züge in der aktuellen Position.
     Array<Move, 256> legalMoves;
     board.generateLegalMoves(legalMoves);
 
+    // Bestimme die Start- und Stopzeit der Suche.
+    startTime.store(std::chrono::system_clock::now());
+    timeManager.start(params, board.getSideToMove(), legalMoves.size(),
+                      UCI::options["Move Overhead"].getValue<int>());
+    stopTime.store(startTime.load() + std::chrono::milliseconds(timeManager.getHardLimit()));
+    lastOutputTime = startTime.load();
+
     // Wenn keine legalen Züge vorhanden sind,
     // gebe den Nullzug aus und beende die Suche.
     if(legalMoves.size() == 0) {
@@ -262,45 +274,58 @@ void PVSEngine::search(const UCI::SearchParams& params) {
 
     // Die Funktion, die in regelmäßigen Abständen aufgerufen wird,
     // um zu überprüfen, ob die Suche abgebrochen werden soll.
-    std::function<void()> checkupFunction = [&]() {
-        if(isCheckupTime()) {
-            lastCheckupTime = std::chrono::system_clock::now();
-
-            if((lastCheckupTime >= stopTime.load() && maxDepthReached > 0) || // Die Zeit ist abgelaufen (und es wurde mindestens Tiefe 1 erreicht)
-               nodesSearched.load() >= params.nodes) // Die Knotenanzahl wurde erreicht
-                stop();
-
-            // Mindestens alle 2 Sekunden die Ausgabe aktualisieren
-            if(uciOutput && lastCheckupTime >= lastOutputTime + std::chrono::milliseconds(MAX_TIME_BETWEEN_OUTPUTS))
-                outputNodesInfo();
-            
-            if(checkupCallback)
-                checkupCallback();
-        }
-    };
+    // Das Lambda fängt nur this ein, damit std::function
+    // keinen Speicher auf dem Heap reservieren muss.
+    nodeLimit = params.nodes;
+    std::function<void()> checkupFunction = [this]() { searchCheckup(); };
+
+    // Erstelle die Hauptinstanz bei der ersten Suche bzw.
+    // setze sie bei allen weiteren Suchen nur zurück.
+    if(mainInstance == nullptr)
+        mainInstance = createInstance(checkupFunction);
+    else {
+        mainInstance->reset(board);
+        mainInstance->setCheckupFunction(checkupFunction);
+    }
 
-    // Erstelle die Hauptinstanz, die die Suche durchführt.
-    #if defined(USE_HCE)
-        // Erstelle die Hauptinstanz mit HCE-Parametern für das Tuning
-        mainInstance = new PVSSearchInstance(board, hceParams, transpositionTable, threadSleepFlag, startTime,
-                                             stopTime, nodesSearched, checkupFunction);
+    // Bestimme die Anzahl der Threads und die Multi-PV-Einstellung.
+    #if not defined(DISABLE_THREADS)
+        size_t numThreads = searchThreads > 0 ? searchThreads : UCI::options["Threads"].getValue<size_t>();
     #else
-        mainInstance = new PVSSearchInstance(board, transpositionTable, threadSleepFlag, startTime,
-                                             stopTime, nodesSearched, checkupFunction);
+        size_t numThreads = 1;
     #endif
-    
+
+    size_t numPVs = searchPVs > 0 ? searchPVs : UCI::options["MultiPV"].getValue<size_t>();
+
     mainInstance->setMainThread(true);
+    mainInstance->setRootMoveTable(&rootMoveTable);
+    mainInstance->setSearchThreadsAndPVs(numThreads, numPVs);
 
     // Erstelle die Hilfsinstanzen, die die Hauptinstanz unterstützen.
-    size_t numAdditionalInstances = UCI::options["Threads"].getValue<size_t>() - 1;
+    size_t numAdditionalInstances = numThreads - 1;
     createHelperInstances(numAdditionalInstances);
 
-    // Bestimme die Multi-PV-Einstellung.
-    size_t multiPV = UCI::options["MultiPV"].getValue<size_t>();
-    multiPV = std::min(multiPV, legalMoves.size());
+    #if not defined(DISABLE_THREADS)
+        for(PVSSearchInstance* instance : instances)
+            instance->setSearchThreadsAndPVs(numThreads, numPVs);
+    #endif
+
+    // Bereite die Tabelle für die Ergebnisse im Wurzelknoten vor.
+    #if not defined(DISABLE_THREADS)
+        rootMoveTable.init(legalMoves, instances.size() + 1);
+    #else
+        rootMoveTable.init(legalMoves, 1);
+    #endif
+
+    // Begrenze die Anzahl der Varianten auf die Anzahl der Züge.
+    size_t multiPV = std::min(numPVs, legalMoves.size());
     if(params.searchmoves.size() > 0)
         multiPV = std::min(multiPV, params.searchmoves.size());
 
+    // Starte die Hilfsthreads. Sie durchsuchen immer alle erlaubten
+    // Züge im Wurzelknoten, auch im Multi-PV-Modus.
+    startHelperThreads(params.searchmoves.size() > 0 ? params.searchmoves : legalMoves);
+
     /**
      * Iterative Tiefensuche:
      * Starte die Suche mit einer Tiefe von 1 und erhöhe die Tiefe
@@ -332,16 +357,9 @@ void PVSEngine::search(const UCI::SearchParams& params) {
                 alpha = prevScore - std::abs(prevScore) * ASPIRATION_WINDOW_SCORE_FACTOR - ASPIRATION_WINDOW;
                 beta = prevScore + std::abs(prevScore) * ASPIRATION_WINDOW_SCORE_FACTOR + ASPIRATION_WINDOW;
 
-                Move hashMove = prevVariations[pv].moves[0];
-                mainInstance->setBestRootMoveHint(hashMove);
-
-                for(size_t i = 0; i < numAdditionalInstances; i++)
-                    instances[i]->setBestRootMoveHint(hashMove);
+                mainInstance->setBestRootMoveHint(prevVariations[pv].moves[0]);
             }
 
-            // Starte die Hilfsthreads.
-            startHelperThreads(depth, alpha, beta, searchMoves);
-
             // Initialisiere die Hauptinstanz für diesen Durchlauf.
             mainInstance->resetSelectiveDepth();
             mainInstance->setSearchMoves(searchMoves);
@@ -371,65 +389,30 @@ void PVSEngine::search(const UCI::SearchParams& params) {
                 score = mainInstance->pvs(depth, 0, alpha, beta, PV_NODE);
             }
 
-            // Stoppe die Hilfsthreads.
-            pauseHelperThreads();
-
-            // Bestimme die Hauptvariante durch Voting.
-            int voteMap[64][64] = {0};
+            // Bestimme die Hauptvariante. Ohne Multi-PV stimmen alle Threads
+            // über ihre zuletzt veröffentlichten Ergebnisse ab, ohne dafür
+            // angehalten zu werden. Im Multi-PV-Modus wird nur die
+            // Hauptinstanz betrachtet, weil die Hilfsthreads immer
+            // den gesamten Wurzelknoten durchsuchen.
+            RootSearchResult result;
+            bool voted = false;
 
-            // Bestimme die schlechteste Bewertung.
-            int worstScore = mainInstance->getPVScore();
-            voteMap[mainInstance->getPV()[0].getOrigin()][mainInstance->getPV()[0].getDestination()] = 0;
-            for(size_t i = 0; i < numAdditionalInstances; i++) {
-                worstScore = std::min(worstScore, instances[i]->getPVScore());
-                voteMap[instances[i]->getPV()[0].getOrigin()][instances[i]->getPV()[0].getDestination()] = 0;
-            }
+            if(pv == 0) {
+                rootMoveTable.publishThreadResult(0, depth, mainInstance->getPVScore(),
+                                                  mainInstance->getSelectiveDepth(), mainInstance->getPV());
 
-            // Fülle die Voting-Map.
-            voteMap[mainInstance->getPV()[0].getOrigin()][mainInstance->getPV()[0].getDestination()] = threadValue(mainInstance, worstScore);
-            for(size_t i = 0; i < numAdditionalInstances; i++)
-                voteMap[instances[i]->getPV()[0].getOrigin()][instances[i]->getPV()[0].getDestination()] += threadValue(instances[i], worstScore);
-
-            // Bestimme die beste Instanz.
-            int bestInstanceIdx = -1;
-            int voteMapPeak = voteMap[mainInstance->getPV()[0].getOrigin()][mainInstance->getPV()[0].getDestination()];
-            int bestPVScore = mainInstance->getPVScore();
-            for(size_t i = 0; i < numAdditionalInstances; i++) {
-                int pvScore = instances[i]->getPVScore();
-                if(isMateScore(pvScore) || isMateScore(bestPVScore)) {
-                    // Wähle immer das schnellste Matt für uns
-                    // oder das langsamste Matt gegen uns.
-                    if(pvScore > bestPVScore) {
-                        bestInstanceIdx = i;
-                        bestPVScore = pvScore;
-                    }
-                } else {
-                    // Verwende sonst die Voting-Heuristik.
-                    int voteScore = voteMap[instances[i]->getPV()[0].getOrigin()][instances[i]->getPV()[0].getDestination()];
-                    PVSSearchInstance* bestInstance = bestInstanceIdx != -1 ? instances[bestInstanceIdx] : mainInstance;
-                    if(voteScore > voteMapPeak ||
-                      (voteScore == voteMapPeak && threadValue(instances[i], worstScore) > threadValue(bestInstance, worstScore))) {
-                        bestInstanceIdx = i;
-                        voteMapPeak = voteScore;
-                        bestPVScore = pvScore;
-                    }
-                }
+                if(multiPV == 1)
+                    voted = rootMoveTable.vote(result);
             }
 
-            // Tausche die Hauptinstanz mit der besten Instanz aus.
-            if(bestInstanceIdx != -1) {
-                PVSSearchInstance* bestInstance = instances[bestInstanceIdx];
-                instances[bestInstanceIdx] = mainInstance;
-                instances[bestInstanceIdx]->setMainThread(false);
-                instances[bestInstanceIdx]->setCheckupFunction(nullptr);
-                mainInstance = bestInstance;
-                mainInstance->setMainThread(true);
-                mainInstance->setCheckupFunction(checkupFunction);
+            if(!voted) {
+                result.score = mainInstance->getPVScore();
+                result.pv = mainInstance->getPV();
             }
 
             // Speichere die Hauptvariante und die Bewertung.
             std::vector<Move> pvMoves;
-            for(Move move : mainInstance->getPV())
+            for(Move move : result.pv)
                 pvMoves.push_back(move);
 
             Move bestMove = pvMoves[0];
@@ -442,14 +425,14 @@ void PVSEngine::search(const UCI::SearchParams& params) {
                     if(variations.size() < multiPV) {
                         variations.push_back({
                             pvMoves,
-                            mainInstance->getPVScore(),
+                            result.score,
                             depth,
                             getSelectiveDepth()
                         });
                     } else {
                         variations[i - 1] = {
                             pvMoves,
-                            mainInstance->getPVScore(),
+                            result.score,
                             depth,
                             getSelectiveDepth()
                         };
@@ -457,7 +440,7 @@ void PVSEngine::search(const UCI::SearchParams& params) {
                 } else if(variations[i].moves.front() == bestMove) {
                     variations[i] = {
                         pvMoves,
-                        mainInstance->getPVScore(),
+                        result.score,
                         depth,
                         getSelectiveDepth()
                     };
@@ -490,16 +473,6 @@ void PVSEngine::search(const UCI::SearchParams& params) {
         // Wir haben eine Tiefe vollständig durchsucht.
         maxDepthReached = depth;
 
-        // Aktualisiere die PV-Historie für
-        // die dynamische Zeitkontrolle.
-        if(pvHistory.size() == 5)
-            pvHistory.shiftLeft(0);
-
-        pvHistory.push_back({
-            getBestMove(),
-            (int16_t)getBestMoveScore()
-        });
-
         if(uciOutput) {
             // Im Multi-PV-Modus werden Informationen zu den
             // einzelnen Varianten ausgegeben.
@@ -513,7 +486,7 @@ void PVSEngine::search(const UCI::SearchParams& params) {
 
         // Sagt die dynamische Zeitkontrolle, dass die Suche
         // abgebrochen werden soll?
-        if(!isPondering.load() && !extendSearch(isTimeControlled))
+        if(!extendSearch())
             break;
 
         // Soll die Suche aufgrund anderer Kriterien abgebrochen werden?
@@ -522,11 +495,19 @@ void PVSEngine::search(const UCI::SearchParams& params) {
             break;
     }
 
-    // Gebe alle Hilfsinstanzen frei.
+    // Beende alle Hilfsthreads. Die Suchinstanzen bleiben
+    // für die nächste Suche erhalten.
     destroyHelperInstances();
 
-    // Gebe die Hauptinstanz frei.
-    delete mainInstance;
+    #if defined(SEARCH_STATS)
+        // Fasse die Statistiken aller Suchinstanzen zusammen.
+        statistics = mainInstance->getStatistics();
+
+        #if not defined(DISABLE_THREADS)
+            for(size_t i = 0; i < numAdditionalInstances; i++)
+                statistics += instances[i]->getStatistics();
+        #endif
+    #endif
 
     // Wir suchen nicht mehr.
     searching.store(false);
@@ -535,6 +516,10 @@ void PVSEngine::search(const UCI::SearchParams& params) {
         // Finale Ausgabe der Suchinformationen.
         outputSearchInfo();
 
+        #if defined(USE_PROFILER)
+            Profiler::print(std::cout, nodesSearched.load());
+        #endif
+
         std::cout << "\n" << "bestmove " << getBestMove().toString();
 
         if(UCI::options["Ponder"].getValue<bool>()) {
@@ -550,89 +535,23 @@ void PVSEngine::search(const UCI::SearchParams& params) {
     std::stable_sort(variations.begin(), variations.end(), std::greater<Variation>());
 }
 
-void PVSEngine::calculateTimeLimits(const UCI::SearchParams& params) {
-    if(params.useMovetime) {
-        // Wir sollen eine feste Zeit suchen.
-        timeMin = std::chrono::milliseconds(params.movetime);
-        timeMax = std::chrono::milliseconds(params.movetime);
-    } else if(params.useWBTime) {
-        // Wir sollen mit dynamischer Zeitkontrolle suchen.
-
-        // Berechne die minimale und maximale Zeit, die die Suche dauern soll.
-        uint32_t time = board.getSideToMove() == WHITE ? params.wtime : params.btime;
-        size_t numLegalMoves = board.generateLegalMoves().size();
-
-        double oneThirtiethOfTime = time * 0.0333;
-        double oneFourthOfTime = time * 0.25;
-
-        uint32_t minTime = oneThirtiethOfTime - oneThirtiethOfTime * std::exp(-0.05  * numLegalMoves);
-        uint32_t maxTime = oneFourthOfTime - oneFourthOfTime * std::exp(-0.05  * numLegalMoves);
-
-        timeMin = std::chrono::milliseconds(minTime);
-        timeMax = std::chrono::milliseconds(maxTime);
-    } else {
-        // Keine Zeitkontrolle.
-        timeMin = std::chrono::milliseconds(std::numeric_limits<uint32_t>::max());
-        timeMax = std::chrono::milliseconds(std::numeric_limits<uint32_t>::max());
-    }
-}
-
-bool PVSEngine::extendSearch(bool isTimeControlled) {
+bool PVSEngine::extendSearch() {
     if(maxDepthReached < 1)
         return true;
 
     if(exitSearch.load())
         return false;
 
-    std::chrono::milliseconds timeElapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - startTime.load());
-
-    // Überprüfe, ob wir außerhalb [timeMin, timeMax] liegen.
-    if(timeElapsed >= timeMax)
-        return false;
-    else if(timeElapsed < timeMin || !isTimeControlled)
-        return true;
-
-    // Bestimme die Varianz der Bewertungen der letzten 5 Tiefen
-    // und wie häufig sich der beste Zug geändert hat.
-    int meanScore = 0;
-    for(MoveScorePair& pair : pvHistory)
-        meanScore += pair.score;
+    // Übergebe die Ergebnisse der Iteration an die Zeitkontrolle.
+    Move bestMove = getBestMove();
+    timeManager.update(maxDepthReached, bestMove, getBestMoveScore(),
+                       rootMoveTable.getNodeShare(bestMove), rootMoveTable.getAverageDepth());
 
-    if(pvHistory.size() > 0)
-        meanScore /= pvHistory.size();
-
-    int scoreVariance = 0;
-    for(MoveScorePair& pair : pvHistory)
-        scoreVariance += (pair.score - meanScore) *
-                         (pair.score - meanScore);
-
-    if(pvHistory.size() > 1)
-        scoreVariance /= pvHistory.size() - 1;
-
-    int bestMoveChanges = 0;
-
-    for(size_t i = 0; i < pvHistory.size() - 1; i++)
-        if(pvHistory[i].move != pvHistory[i + 1].move)
-            bestMoveChanges++;
-
-    // Bestimme, wie weit wir zwischen timeMin und timeMax liegen.
-    double timeFactor = (double)(timeElapsed.count() - timeMin.count()) /
-                        (double)(timeMax.count() - timeMin.count());
-
-    timeFactor = std::clamp(timeFactor, 0.0, 1.0);
-
-    // Überprüfe, ob die Suche verlängert werden soll.
-    if(bestMoveChanges >= 4)
-        return true;
-
-    if(bestMoveChanges >= 3 && scoreVariance >= 40 * 40 * timeFactor)
-        return true;
-
-    if(bestMoveChanges >= 2 && scoreVariance >= 60 * 60 * timeFactor)
-        return true;
+    std::chrono::milliseconds timeElapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - startTime.load());
 
-    if(bestMoveChanges >= 1 && scoreVariance >= 80 * 80 * timeFactor)
-        return true;
+    if(debugOutput && uciOutput)
+        timeManager.printDecision(std::cout, timeElapsed);
 
-    return false;
+    // Während des Ponderns wird die Suche nicht durch die Zeitkontrolle beendet.
+    return isPondering.load() || !timeManager.shouldStop(timeElapsed);
 }
\ No newline at end of file
@@ -5,17 +5,18 @@
 #include <chrono>
 
 #if not defined(DISABLE_THREADS)
-    #include <condition_variable>
-    #include <mutex>
     #include <thread>
 #endif
 
 #include "core/engine/search/PVSSearchInstance.h"
+#include "core/engine/search/RootMoveTable.h"
 #include "core/engine/search/SearchDefinitions.h"
+#include "core/engine/search/TimeManager.h"
 #include "core/engine/search/Variation.h"
 #include "core/engine/evaluation/Evaluator.h"
 
 #include "core/utils/Atomic.h"
+#include "core/utils/Profiler.h"
 #include "core/utils/tables/TranspositionTable.h"
 
 #include "uci/UCI.h"
@@ -34,12 +35,12 @@ class PVSEngine {
         /**
          * @brief Die HCE-Parameter, die für die Suche verwendet werden.
          */
-        const HCEParameters& hceParams;
+        const HCEParameters* hceParams;
         #else
         /**
          * @brief Das NNUE-Netzwerk, das für die Suche verwendet wird.
          */
-        const NNUE::Network& nnueNetwork;
+        const NNUE::Network* nnueNetwork;
         #endif
 
         /**
@@ -55,6 +56,25 @@ class PVSEngine {
          */
         TranspositionTable transpositionTable;
 
+        /**
+         * @brief Eine Transpositionstabelle, die mit anderen Engines geteilt
+         * wird. Wenn gesetzt, wird sie anstelle der eigenen Tabelle verwendet.
+         */
+        TranspositionTable* sharedTranspositionTable = nullptr;
+
+        /**
+         * @brief Gibt die Transpositionstabelle zurück, die verwendet wird.
+         */
+        inline TranspositionTable& getTranspositionTable() {
+            return sharedTranspositionTable ? *sharedTranspositionTable : transpositionTable;
+        }
+
+        /**
+         * @brief Das höchste Alter eines Spielfeldes, auf dem seit dem
+         * letzten Aufruf von newGame gesucht wurde.
+         */
+        unsigned int maxRootAge = 0;
+
         /**
          * Variablen für den regelmäßigen Checkup.
          */
@@ -74,59 +94,43 @@ class PVSEngine {
          * Variablen für die Zeitkontrolle.
          */
 
-        bool isTimeControlled = false;
         AtomicBool searching = false;
         AtomicBool isPondering = false;
         Atomic<std::chrono::system_clock::time_point> startTime;
         Atomic<std::chrono::system_clock::time_point> stopTime;
         std::chrono::system_clock::time_point lastOutputTime;
-        std::chrono::milliseconds timeMin;
-        std::chrono::milliseconds timeMax;
 
         /**
-         * @brief Die Anzahl der bisher durchsuchten Knoten.
-         * Diese Variable wird von allen Suchinstanzen geteilt.
+         * @brief Bestimmt die Zeitlimits der Suche und
+         * skaliert sie nach jeder Iteration.
          */
-        AtomicU64 nodesSearched = 0;
+        TimeManager timeManager;
 
         /**
-         * @brief Die maximale Suchtiefe, die bisher erreicht wurde.
+         * @brief Bestimmt, ob die Entscheidungen der Zeitkontrolle
+         * ausgegeben werden sollen (UCI-Befehl debug).
          */
-        int maxDepthReached = 0;
+        bool debugOutput = false;
 
         /**
-         * @brief Enthält den besten Zug und seine Bewertung
-         * der letzten Iterationen. Diese Informationen werden
-         * für die dynamische Zeitkontrolle verwendet.
-         */
-        Array<MoveScorePair, 5> pvHistory;
-
-        #if not defined(DISABLE_THREADS)
-        /**
-         * @brief Ein Mutex, der für die
-         * Bedingungsvariablen verwendet wird.
-         */
-        std::mutex cvMutex;
-
-        /**
-         * @brief Eine Bedingungsvariable, die verwendet
-         * wird, damit die Threads aufgeweckt werden können.
+         * @brief Die Anzahl der bisher durchsuchten Knoten.
+         * Diese Variable wird von allen Suchinstanzen geteilt.
          */
-        std::condition_variable cv;
+        AtomicU64 nodesSearched = 0;
 
         /**
-         * @brief Eine Bedingungsvariable, die verwendet wird,
-         * damit der Hauptthread aufgeweckt werden kann sobald
-         * alle Helper-Threads zurückgekehrt sind.
+         * @brief Die maximale Suchtiefe, die bisher erreicht wurde.
          */
-        std::condition_variable cvMain;
+        int maxDepthReached = 0;
 
         /**
-         * @brief Die dazugehörige Variable, die zählt,
-         * wie viele Helper-Threads noch laufen.
+         * @brief Die Tabelle, in die alle Suchinstanzen ihre Ergebnisse
+         * im Wurzelknoten veröffentlichen. Die Hauptinstanz liest daraus
+         * die Ergebnisse der Helper-Threads, ohne diese anzuhalten.
          */
-        std::atomic_size_t numThreadsBusy;
+        RootMoveTable rootMoveTable;
 
+        #if not defined(DISABLE_THREADS)
         /**
          * @brief Ein Vektor mit allen Threads, auf denen
          * eine Suchinstanz läuft. Die Instanz auf dem Hauptthread
@@ -140,15 +144,6 @@ class PVSEngine {
          * aufrufenden Thread.
          */
         std::vector<PVSSearchInstance*> instances;
-
-        /*
-         * Suchparameter für die zusätzlichen Suchinstanzen.
-         */
-
-        int currentDepth;
-        int currentAlpha;
-        int currentBeta;
-
         #endif
 
         /**
@@ -156,6 +151,14 @@ class PVSEngine {
          */
         PVSSearchInstance* mainInstance = nullptr;
 
+        #if defined(SEARCH_STATS)
+        /**
+         * @brief Die zusammengefassten Statistiken aller
+         * Suchinstanzen der letzten Suche.
+         */
+        SearchStatistics statistics;
+        #endif
+
         /**
          * @brief Bestimmt, ob die Ausgabe der Suchinformationen
          * nach dem UCI-Protokoll erfolgen soll.
@@ -163,42 +166,67 @@ class PVSEngine {
         bool uciOutput = true;
 
         /**
-         * @brief Die Funktion, die von den
-         * Helper-Threads ausgeführt wird.
+         * @brief Die Anzahl der Threads und der Varianten (Multi-PV) der Suche.
+         * Bei 0 wird der Wert der UCI-Option "Threads" bzw. "MultiPV" verwendet.
+         */
+        size_t searchThreads = 0;
+        size_t searchPVs = 0;
+
+        /**
+         * @brief Die Funktion, die von den Helper-Threads ausgeführt wird.
+         * Jeder Helper-Thread führt eine eigene iterative Tiefensuche durch
+         * und veröffentlicht nach jeder vollständigen Iteration sein Ergebnis
+         * in der RootMoveTable, bis die Suche beendet wird.
          */
         void helperThreadLoop(size_t instanceIdx);
 
         /**
-         * @brief Erstellt die zusätzlichen Suchinstanzen.
+         * @brief Erstellt eine neue Suchinstanz auf dem aktuellen Schachbrett.
          * 
-         * @param numInstances Die Anzahl der zu erstellenden Instanzen.
+         * @param checkupFunction Die Checkup-Funktion der Instanz.
+         */
+        PVSSearchInstance* createInstance(std::function<void()> checkupFunction);
+
+        /**
+         * @brief Stellt die zusätzlichen Suchinstanzen für die nächste
+         * Suche bereit. Instanzen aus vorherigen Suchen werden wiederverwendet
+         * und nur zurückgesetzt, neue Instanzen werden nur erstellt,
+         * wenn die Anzahl der Threads erhöht wurde.
+         * 
+         * @param numInstances Die Anzahl der benötigten Instanzen.
          */
         void createHelperInstances(size_t numInstances);
 
         /**
-         * @brief Zerstört die Helper-Threads und gibt die
-         * Speicherbereiche der Suchinstanzen frei.
+         * @brief Bricht die Suche der Helper-Threads ab und beendet sie.
+         * Die Suchinstanzen bleiben für die nächste Suche erhalten.
          */
         void destroyHelperInstances();
 
         /**
-         * @brief Übergibt Suchparameter an die zusätzlichen Suchinstanzen
-         * und startet sie. Wenn exitSearch auf true gesetzt ist,
-         * werden die Helper-Threads zurückgegeben.
-         * 
-         * @param depth Die Suchtiefe.
-         * @param alpha Der untere Wert des Suchfensters.
-         * @param beta Der obere Wert des Suchfensters.
-         * @param searchMoves Die, zu durchsuchenden, Züge.
+         * @brief Gibt die Speicherbereiche aller Suchinstanzen frei.
+         */
+        void releaseInstances();
+
+        /**
+         * @brief Die Knotenanzahl, nach der die aktuelle Suche abgebrochen wird.
          */
-        void startHelperThreads(int depth, int alpha, int beta, const Array<Move, 256>& searchMoves);
+        uint64_t nodeLimit = UINT64_MAX;
 
         /**
-         * @brief Pausiert alle Helper-Threads,
-         * d.h. die Threads werden in den Schlafmodus
-         * versetzt (nicht beendet!).
+         * @brief Die Checkup-Funktion der Hauptinstanz. Überprüft,
+         * ob die Suche abgebrochen werden soll, und aktualisiert die Ausgabe.
          */
-        void pauseHelperThreads();
+        void searchCheckup();
+
+        /**
+         * @brief Übergibt die Suchparameter an die zusätzlichen Suchinstanzen
+         * und startet die Helper-Threads. Die Threads laufen bis zum Ende
+         * der Suche und werden zwischen den Iterationen nicht angehalten.
+         * 
+         * @param searchMoves Die, zu durchsuchenden, Züge.
+         */
+        void startHelperThreads(const Array<Move, 256>& searchMoves);
 
         /**
          * Funktionen für die Ausgabe von Informationen
@@ -210,37 +238,16 @@ class PVSEngine {
         void outputMultiPVInfo(size_t pvIndex);
 
         /**
-         * @brief Bestimmte die Zeitlimits für die Suche.
+         * @brief Übergibt die Ergebnisse der letzten Iteration an die
+         * Zeitkontrolle und überprüft, ob eine weitere Iteration
+         * gestartet werden soll.
          */
-        void calculateTimeLimits(const UCI::SearchParams& params);
-
-        /**
-         * @brief Überprüft, ob die Suche abgebrochen werden soll.
-         * 
-         * @param isTimeControlled Gibt an, ob die Suche mit dynamischer
-         * Zeitkontrolle durchgeführt wird.
-         */
-        bool extendSearch(bool isTimeControlled);
+        bool extendSearch();
 
         inline bool isCheckupTime() {
             return std::chrono::system_clock::now() >= lastCheckupTime + checkupInterval;
         }
 
-        inline void updateStopFlag() {
-            if(std::chrono::system_clock::now() >= startTime.load() + timeMax &&
-               maxDepthReached > 0)
-               stop();
-        }
-
-        inline void checkup() {
-            lastCheckupTime = std::chrono::system_clock::now();
-
-            updateStopFlag();
-
-            if(checkupCallback)
-                checkupCallback();
-        }
-
     public:
         #if defined(USE_HCE)
         /**
@@ -255,7 +262,7 @@ class PVSEngine {
          * @param uciOutput Bestimmt, ob nach dem UCI-Protokoll ausgegeben werden soll.
          */
         PVSEngine(Board& board, uint64_t checkupInterval = 2, std::function<void()> checkupCallback = nullptr, bool uciOutput = true)
-                : board(board), hceParams(HCE_PARAMS), checkupInterval(checkupInterval), checkupCallback(checkupCallback), uciOutput(uciOutput) {}
+                : board(board), hceParams(&HCE_PARAMS), checkupInterval(checkupInterval), checkupCallback(checkupCallback), uciOutput(uciOutput) {}
 
         /**
          * @brief Konstruktor mit HCE-Parametern.
@@ -268,9 +275,12 @@ class PVSEngine {
          * werden soll. Wenn keine Funktion aufgerufen werden soll, kann dieser
          * Parameter weggelassen werden.
          * @param uciOutput Bestimmt, ob nach dem UCI-Protokoll ausgegeben werden soll.
+         * @param hashTableCapacity Die Kapazität der Transpositionstabelle.
          */
-        PVSEngine(Board& board, const HCEParameters& hceParams, uint64_t checkupInterval = 2, std::function<void()> checkupCallback = nullptr, bool uciOutput = true)
-                : board(board), hceParams(hceParams), checkupInterval(checkupInterval), checkupCallback(checkupCallback), uciOutput(uciOutput) {}
+        PVSEngine(Board& board, const HCEParameters& hceParams, uint64_t checkupInterval = 2, std::function<void()> checkupCallback = nullptr, bool uciOutput = true,
+                  size_t hashTableCapacity = TT_DEFAULT_CAPACITY)
+                : board(board), hceParams(&hceParams), transpositionTable(hashTableCapacity), checkupInterval(checkupInterval),
+                  checkupCallback(checkupCallback), uciOutput(uciOutput) {}
         #else
         /**
          * @brief Konstruktor
@@ -284,7 +294,7 @@ class PVSEngine {
          * @param uciOutput Bestimmt, ob nach dem UCI-Protokoll ausgegeben werden soll.
          */
         PVSEngine(Board& board, uint64_t checkupInterval = 2, std::function<void()> checkupCallback = nullptr, bool uciOutput = true)
-                : board(board), nnueNetwork(NNUE::DEFAULT_NETWORK), checkupInterval(checkupInterval), checkupCallback(checkupCallback), uciOutput(uciOutput) {}
+                : board(board), nnueNetwork(&NNUE::DEFAULT_NETWORK), checkupInterval(checkupInterval), checkupCallback(checkupCallback), uciOutput(uciOutput) {}
 
         /**
          * @brief Konstruktor mit NNUE-Parametern.
@@ -295,11 +305,18 @@ class PVSEngine {
          * @param checkupCallback Die Funktion, die bei jedem Checkup aufgerufen
          * werden soll. Wenn keine Funktion aufgerufen werden soll, kann dieser Parameter weggelassen werden.
          * @param uciOutput Bestimmt, ob nach dem UCI-Protokoll ausgegeben werden soll.
+         * @param hashTableCapacity Die Kapazität der Transpositionstabelle.
          */
-        PVSEngine(Board& board, const NNUE::Network& nnueParams, uint64_t checkupInterval = 2, std::function<void()> checkupCallback = nullptr, bool uciOutput = true)
-                : board(board), nnueNetwork(nnueParams), checkupInterval(checkupInterval), checkupCallback(checkupCallback), uciOutput(uciOutput) {}
+        PVSEngine(Board& board, const NNUE::Network& nnueParams, uint64_t checkupInterval = 2, std::function<void()> checkupCallback = nullptr, bool uciOutput = true,
+                  size_t hashTableCapacity = TT_DEFAULT_CAPACITY)
+                : board(board), nnueNetwork(&nnueParams), transpositionTable(hashTableCapacity), checkupInterval(checkupInterval),
+                  checkupCallback(checkupCallback), uciOutput(uciOutput) {}
         #endif
 
+        ~PVSEngine() {
+            releaseInstances();
+        }
+
         PVSEngine(const PVSEngine& other) = delete;
         PVSEngine& operator=(const PVSEngine& other) = delete;
 
@@ -322,14 +339,30 @@ class PVSEngine {
          * @brief Verändert die Kapazität der Transpositionstabelle.
          */
         inline void setHashTableCapacity(size_t capacity) {
-            transpositionTable.resize(capacity);
+            getTranspositionTable().resize(capacity);
+        }
+
+        /**
+         * @brief Verwendet eine Transpositionstabelle, die mit anderen Engines
+         * geteilt wird (nullptr: die eigene Tabelle). Die eigene Tabelle wird
+         * dabei verkleinert. Alle Methoden, die die Transpositionstabelle
+         * verändern, wirken sich dann auf alle Engines aus.
+         * Darf nur aufgerufen werden, wenn keine Suche läuft.
+         */
+        inline void setSharedHashTable(TranspositionTable* table) {
+            // Die Suchinstanzen speichern eine Referenz auf die Tabelle
+            releaseInstances();
+
+            sharedTranspositionTable = table;
+            if(table)
+                transpositionTable.resize(1);
         }
 
         /**
          * @brief Gibt die Kapazität der Transpositionstabelle zurück.
          */
         inline size_t getHashTableCapacity() {
-            return transpositionTable.getCapacity();
+            return getTranspositionTable().getCapacity();
         }
 
         /**
@@ -337,16 +370,52 @@ class PVSEngine {
          * Transpositionstabelle zurück.
          */
         inline size_t getHashTableSize() {
-            return transpositionTable.getEntriesWritten();
+            return getTranspositionTable().getEntriesWritten();
         }
 
         /**
          * @brief Löscht alle Einträge in der Transpositionstabelle.
          */
         inline void clearHashTable() {
-            transpositionTable.clear();
+            getTranspositionTable().clear();
+            maxRootAge = 0;
         }
 
+        /**
+         * @brief Bereitet die Engine auf eine neue Partie vor. Die Einträge der
+         * Transpositionstabelle werden über ihr Alter ungültig gemacht, anstatt
+         * die gesamte Tabelle zu überschreiben (siehe TranspositionTable::newGeneration).
+         */
+        inline void newGame() {
+            getTranspositionTable().newGeneration(maxRootAge);
+            maxRootAge = 0;
+        }
+
+        #if defined(USE_HCE)
+        /**
+         * @brief Setzt die HCE-Parameter, die für die Suche verwendet werden.
+         * Änderungen an den Parametern werden ab der nächsten Suche übernommen.
+         * Die Suchinstanzen werden nur neu erstellt, wenn sich das Objekt ändert.
+         */
+        inline void setParameters(const HCEParameters& hceParams) {
+            if(this->hceParams != &hceParams) {
+                releaseInstances();
+                this->hceParams = &hceParams;
+            }
+        }
+        #else
+        /**
+         * @brief Setzt das NNUE-Netzwerk, das für die Suche verwendet wird.
+         * Die Suchinstanzen werden nur neu erstellt, wenn sich das Netzwerk ändert.
+         */
+        inline void setParameters(const NNUE::Network& nnueNetwork) {
+            if(this->nnueNetwork != &nnueNetwork) {
+                releaseInstances();
+                this->nnueNetwork = &nnueNetwork;
+            }
+        }
+        #endif
+
         /**
          * @brief Setzt das Schachbrett, das betrachtet werden soll.
          */
@@ -365,10 +434,31 @@ class PVSEngine {
             this->uciOutput = uciOutput;
         }
 
+        /**
+         * @brief Setzt die Anzahl der Threads unabhängig von der UCI-Option "Threads"
+         * (0: Wert der UCI-Option). So können mehrere Engines im selben Prozess
+         * unterschiedlich konfiguriert werden.
+         */
+        inline void setNumThreads(size_t numThreads) {
+            this->searchThreads = numThreads;
+        }
+
+        /**
+         * @brief Setzt die Anzahl der Varianten unabhängig von der UCI-Option "MultiPV"
+         * (0: Wert der UCI-Option).
+         */
+        inline void setMultiPV(size_t multiPV) {
+            this->searchPVs = multiPV;
+        }
+
         inline void setPondering(bool isPondering) {
             this->isPondering.store(isPondering);
         }
 
+        inline void setDebugOutput(bool debugOutput) {
+            this->debugOutput = debugOutput;
+        }
+
         inline Board& getBoard() {
             return board;
         }
@@ -389,10 +479,28 @@ class PVSEngine {
             return variations.empty() ? std::vector<Move>() : variations[0].moves;
         }
 
+        /**
+         * @brief Gibt die Tabelle mit den Statistiken der Wurzelzüge zurück.
+         * Die Tabelle kann auch während der Suche gelesen werden.
+         */
+        inline const RootMoveTable& getRootMoveTable() const {
+            return rootMoveTable;
+        }
+
         inline uint64_t getNodesSearched() const {
             return nodesSearched.load();
         }
 
+        #if defined(SEARCH_STATS)
+        /**
+         * @brief Gibt die Statistiken der letzten Suche zurück.
+         * Die Statistiken werden erst am Ende der Suche zusammengefasst.
+         */
+        inline const SearchStatistics& getSearchStatistics() const {
+            return statistics;
+        }
+        #endif
+
         constexpr int getMaxDepthReached() const {
             return maxDepthReached;
         }
@@ -431,22 +539,13 @@ class PVSEngine {
         static constexpr uint64_t MAX_TIME_BETWEEN_OUTPUTS = 2000;
 
     private:
-        constexpr void clearPVHistory() {
-            pvHistory.clear();
-        }
-
         /**
          * @brief Bestimmt die tiefste Suchtiefe aller Instanzen.
+         * Die Helper-Threads werden dafür nicht angehalten, es werden
+         * nur ihre veröffentlichten Ergebnisse gelesen.
          */
         inline int getSelectiveDepth() {
-            int selDepth = mainInstance->getSelectiveDepth();
-
-            #if not defined(DISABLE_THREADS)
-            for(PVSSearchInstance* instance : instances)
-                selDepth = std::max(selDepth, instance->getSelectiveDepth());
-            #endif
-
-            return selDepth;
+            return std::max(mainInstance->getSelectiveDepth(), rootMoveTable.getSelectiveDepth());
         }
 };
 
@@ -4,7 +4,7 @@ int PVSSearchInstance::pvs(int depth, int ply, int alpha, int beta, unsigned int
     // Setze die momentane Suchtiefe, wenn wir uns im Wurzelknoten befinden.
     if(ply == 0) {
         currentSearchDepth = std::max(depth, 1);
-        rootAge = board.getAge();
+        rootAge = board.getAge() + transpositionTable.getAgeOffset();
     }
 
     // Führe die Checkup-Funktion regelmäßig aus.
@@ -27,7 +27,9 @@ int PVSSearchInstance::pvs(int depth, int ply, int alpha, int beta, unsigned int
     // Wir betrachten diesen Knoten.
     nodesSearched.fetch_add(1);
     localNodeCounter++;
+    instanceNodes++;
     selectiveDepth = std::max(selectiveDepth, (int)ply);
+    SEARCH_STAT(statistics.pvsNodes++);
 
     // Überprüfe, ob wir uns in einer Remisstellung befinden.
     if(ply > 0 && evaluator.isDraw()) {
@@ -52,6 +54,10 @@ int PVSSearchInstance::pvs(int depth, int ply, int alpha, int beta, unsigned int
     // die aktuelle Position.
     TranspositionTableEntry entry;
     bool entryExists = transpositionTable.probe(board.getHashValue(), entry);
+    SEARCH_STAT(int statDepth = SearchStatistics::depthIndex(depth));
+    SEARCH_STAT(statistics.ttProbes[statDepth]++);
+    SEARCH_STAT(statistics.ttHits[statDepth] += entryExists);
+
     if(entryExists && nodeType != PV_NODE && !skipHashMove) {
         // Ein Eintrag kann nur verwendet werden, wenn die eingetragene
         // Suchtiefe mindestens so groß ist wie unsere Suchtiefe.
@@ -60,20 +66,23 @@ int PVSSearchInstance::pvs(int depth, int ply, int alpha, int beta, unsigned int
             if(entry.type == TranspositionTableEntry::EXACT) {
                 // Der Eintrag speichert eine exakte Bewertung,
                 // d.h. er stammt aus einem PV-Knoten.
+                SEARCH_STAT(statistics.ttCutoffs[statDepth]++);
                 return denormalizedScore;
             } else if(entry.type == TranspositionTableEntry::LOWER_BOUND) {
                 // Der Eintrag speichert eine untere Schranke,
                 // d.h. er stammt aus einem Cut-Knoten.
-                if(denormalizedScore >= beta)
+                if(denormalizedScore >= beta) {
+                    SEARCH_STAT(statistics.ttCutoffs[statDepth]++);
                     return denormalizedScore;
-                else if(denormalizedScore > alpha)
+                } else if(denormalizedScore > alpha)
                     alpha = denormalizedScore;
             } else if(entry.type == TranspositionTableEntry::UPPER_BOUND) {
                 // Der Eintrag speichert eine obere Schranke,
                 // d.h. er stammt aus einem All-Knoten.
-                if(denormalizedScore <= alpha)
+                if(denormalizedScore <= alpha) {
+                    SEARCH_STAT(statistics.ttCutoffs[statDepth]++);
                     return denormalizedScore;
-                else if(denormalizedScore < beta)
+                } else if(denormalizedScore < beta)
                     beta = denormalizedScore;
             }
         }
@@ -82,9 +91,6 @@ int PVSSearchInstance::pvs(int depth, int ply, int alpha, int beta, unsigned int
     // Leere den Eintrag im Suchstack für den aktuellen Abstand zum Wurzelknoten.
     clearSearchStack(ply);
 
-    // Leere die Vergangenheitsbewertung für den aktuellen Abstand zum Wurzelknoten.
-    clearHistoryStack(ply + HISTORY_SCORE_LOOKAHEAD + 1);
-
     /**
      * Ermittele die vorläufige Bewertung der Position.
      * Die vorläufige Bewertung ist die eingetragene Bewertung
@@ -92,6 +98,7 @@ int PVSSearchInstance::pvs(int depth, int ply, int alpha, int beta, unsigned int
      * wenn kein Eintrag existiert.
      */
     searchStack[ply].preliminaryScore = entryExists ? entry.score : evaluator.evaluate();
+    SEARCH_STAT(statistics.evaluations += !entryExists);
 
     /**
      * Überprüfe, ob wir uns gegenüber dem letzten Zug verbessert haben.
@@ -124,6 +131,7 @@ int PVSSearchInstance::pvs(int depth, int ply, int alpha, int beta, unsigned int
         int depthReduction = calculateNullMoveReduction(depth, searchStack[ply].preliminaryScore, beta);
         if(depthReduction > 1 && depth - depthReduction > 0) {
             Move nullMove = Move::nullMove();
+            SEARCH_STAT(statistics.nullMoveSearches++);
 
             // Halte Evaluator und Brettstatus auch bei Nullzügen synchron.
             evaluator.updateBeforeMove(nullMove);
@@ -137,12 +145,16 @@ int PVSSearchInstance::pvs(int depth, int ply, int alpha, int beta, unsigned int
             evaluator.updateAfterUndo(nullMove);
 
             if(score >= beta) {
-                if(!verifyNullMove() || depth + 1 <= depthReduction)
+                if(!verifyNullMove() || depth + 1 <= depthReduction) {
+                    SEARCH_STAT(statistics.nullMoveCutoffs++);
                     return score;
+                }
 
                 score = pvs(depth - depthReduction + 1, ply, beta - 1, beta, CUT_NODE, NULL_MOVE_COOLDOWN, singularExtCooldown, false);
-                if(score >= beta)
+                if(score >= beta) {
+                    SEARCH_STAT(statistics.nullMoveCutoffs++);
                     return score;
+                }
             }
         }
     }
@@ -220,6 +232,8 @@ int PVSSearchInstance::pvs(int depth, int ply, int alpha, int beta, unsigned int
         move = pair.move;
         moveScore = pair.score;
 
+        uint64_t rootMoveNodes = instanceNodes;
+
         if(skipHashMove && move == searchStack[ply].hashMove) {
             moveCount++;
             continue;
@@ -241,37 +255,20 @@ int PVSSearchInstance::pvs(int depth, int ply, int alpha, int beta, unsigned int
             
             int preliminaryEval = searchStack[ply].preliminaryScore;
 
-            // Führe den Zug aus und informiere den Evaluator.
-            evaluator.updateBeforeMove(move);
-            board.makeMove(move);
-            evaluator.updateAfterMove();
-
-            bool isCheck = board.isCheck();
-
+            // Ob der Zug Schach gibt, wird ohne Ausführen des Zuges bestimmt.
             int futilityMargin = calculateFutilityMargin(depth);
-            if(!isCheck && preliminaryEval + futilityMargin < alpha) {
-                // Mache den Zug rückgängig und informiere den Evaluator.
-                evaluator.updateBeforeUndo();
-                board.undoMove();
-                evaluator.updateAfterUndo(move);
-
+            if(preliminaryEval + futilityMargin < alpha && !board.givesCheck(move)) {
                 if(moveCount == 0) {
                     bestScore = preliminaryEval;
                     bestMove = move;
                 }
 
+                SEARCH_STAT(statistics.futilityPrunes++);
                 moveCount++;
                 continue;
             }
-        } else {
-            // Führe den Zug aus und informiere den Evaluator.
-            evaluator.updateBeforeMove(move);
-            board.makeMove(move);
-            evaluator.updateAfterMove();
         }
 
-        int score;
-
         /**
          * Late Move Pruning:
          * Späte Züge in All-/Cut-Knoten mit geringer Tiefe, die den Gegner nicht in Schach setzen,
@@ -280,16 +277,20 @@ int PVSSearchInstance::pvs(int depth, int ply, int alpha, int beta, unsigned int
          * Als Failsafe wenden wir LMP nicht an, wenn wir im Schach stehen.
          */
         if(nodeType != PV_NODE && moveCount >= lmpCount &&
-           moveScore < KILLER_MOVE_SCORE && !isCheckEvasion && !board.isCheck()) {
-
-            evaluator.updateBeforeUndo();
-            board.undoMove();
-            evaluator.updateAfterUndo(move);
+           moveScore < KILLER_MOVE_SCORE && !isCheckEvasion && !board.givesCheck(move)) {
 
+            SEARCH_STAT(statistics.lmpPrunes++);
             moveCount++;
             continue;
         }
 
+        // Führe den Zug aus und informiere den Evaluator.
+        evaluator.updateBeforeMove(move);
+        board.makeMove(move);
+        evaluator.updateAfterMove();
+
+        int score;
+
         // Sage den Knotentyp des Kindknotens voraus.
         uint8_t childType = CUT_NODE;
         if(nodeType == PV_NODE && moveCount == 0)
@@ -350,6 +351,7 @@ int PVSSearchInstance::pvs(int depth, int ply, int alpha, int beta, unsigned int
                 reduction = reduction * (int32_t)normalizationFactor / (normalizationFactor + scoreDiff);
 
             reduction = std::max(reduction, 0);
+            SEARCH_STAT(statistics.reducedSearches += reduction > 0);
 
             score = -pvs(depth - 1 + extension - reduction, ply + 1, -alpha - 1, -alpha, childType, nullMoveCooldown - 1, singularExtCooldown - 1, isPlausibleLine && (moveCount < 3 || moveScore >= KILLER_MOVE_SCORE));
 
@@ -359,6 +361,9 @@ int PVSSearchInstance::pvs(int depth, int ply, int alpha, int beta, unsigned int
             // - oder die Bewertung liegt dieses Knotens innerhalb des Suchfensters
             //   liegt (< beta)
             if(score > alpha && (reduction > 0 || score < beta)) {
+                SEARCH_STAT(statistics.reducedReSearches += reduction > 0);
+                SEARCH_STAT(statistics.nullWindowReSearches += reduction == 0);
+
                 if(nodeType == PV_NODE)
                     childType = PV_NODE;
                 else
@@ -375,6 +380,10 @@ int PVSSearchInstance::pvs(int depth, int ply, int alpha, int beta, unsigned int
         board.undoMove();
         evaluator.updateAfterUndo(move);
 
+        // Verbuche die Knoten im Teilbaum des Wurzelzuges.
+        if(ply == 0 && rootMoveTable)
+            rootMoveTable->addNodes(move, instanceNodes - rootMoveNodes);
+
         // Prüfe, ob die Suche abgebrochen werden soll.
         if(stopFlag.load() && currentSearchDepth > 1)
             return 0;
@@ -384,6 +393,8 @@ int PVSSearchInstance::pvs(int depth, int ply, int alpha, int beta, unsigned int
             // Spiel nicht zulassen wird (weil er bereits eine bessere
             // Alternative hat). Daher können wir die Suche abbrechen.
             // => Beta-Schnitt oder Fail-High
+            SEARCH_STAT(statistics.betaCutoffs++);
+            SEARCH_STAT(statistics.firstMoveCutoffs += moveCount == 0);
 
             // Speichere Informationen zu diesem Knoten
             // in der Transpositionstabelle. Weil wir verfrüht abbrechen,
@@ -415,14 +426,14 @@ int PVSSearchInstance::pvs(int depth, int ply, int alpha, int beta, unsigned int
             }
 
             // Verbessere die relative Bewertung des Zuges
-            incrementHistoryScore(move, ply, depth);
+            updateHistoryScore(move, HistoryTables::calculateBonus(depth));
 
             return score;
         }
 
         // Verschlechtere die relative Bewertung des Zuges,
         // er führte nicht zu einem Beta-Schnitt.
-        decrementHistoryScore(move, ply, depth);
+        updateHistoryScore(move, -HistoryTables::calculateMalus(depth));
 
         if(score > bestScore) {
             // Der Zug ist der Beste, den wir bisher gefunden haben.
@@ -439,8 +450,14 @@ int PVSSearchInstance::pvs(int depth, int ply, int alpha, int beta, unsigned int
 
                 addPVMove(ply, move);
 
-                if(ply == 0)
+                if(ply == 0) {
                     pvScore = score;
+
+                    // Veröffentliche die exakte Bewertung des Wurzelzuges,
+                    // damit andere Threads sie sofort lesen können.
+                    if(rootMoveTable)
+                        rootMoveTable->publishRootMove(currentSearchDepth, score, selectiveDepth, pvTable[0]);
+                }
             }
         }
 
@@ -477,7 +494,7 @@ int PVSSearchInstance::pvs(int depth, int ply, int alpha, int beta, unsigned int
     if(ttEntryType == TranspositionTableEntry::EXACT) {
         // Wenn dieser Zug der beste Zug in einem PV-Knoten ist,
         // erhöhe seine relative Vergangenheitsbewertung.
-        incrementHistoryScore(bestMove, ply, depth);
+        updateHistoryScore(bestMove, HistoryTables::calculateBonus(depth));
 
         if(!bestMove.isCapture() && !bestMove.isPromotion()) {
             // Setze einen Eintrag in der Konterzug-Tabelle.
@@ -504,7 +521,9 @@ int PVSSearchInstance::quiescence(int ply, int alpha, int beta) {
     // Wir betrachten diesen Knoten.
     nodesSearched.fetch_add(1);
     localNodeCounter++;
+    instanceNodes++;
     selectiveDepth = std::max(selectiveDepth, (int)ply);
+    SEARCH_STAT(statistics.quiescenceNodes++);
 
     // Überprüfe, ob wir uns in einer Remisstellung befinden.
     if(evaluator.isDraw())
@@ -512,8 +531,10 @@ int PVSSearchInstance::quiescence(int ply, int alpha, int beta) {
 
     // Wenn die maximale Suchdistanz erreicht wurde,
     // gib die statische Bewertung zurück.
-    if(ply >= MAX_PLY || ply > currentSearchDepth * 3 + 2)
+    if(ply >= MAX_PLY || ply > currentSearchDepth * 3 + 2) {
+        SEARCH_STAT(statistics.evaluations++);
         return evaluator.evaluate();
+    }
 
     /**
      * Mate Distance Pruning (wie in der normalen Suche):
@@ -535,6 +556,7 @@ int PVSSearchInstance::quiescence(int ply, int alpha, int beta) {
     // In der Quieszenzsuche ist die vorläufige Bewertung die
     // statische Bewertung der Position.
     searchStack[ply].preliminaryScore = evaluator.evaluate();
+    SEARCH_STAT(statistics.evaluations++);
 
     // Wir betrachten in der Quieszenzsuche (außer wenn wir im Schach stehen)
     // nicht alle Züge. Wenn wir die Bewertung mit den Zügen, die wir betrachten,
@@ -862,17 +884,19 @@ void PVSSearchInstance::scoreMoves(const Array<Move, 256>& moves, int ply) {
             // Schlagzüge und Bauernumwandlungen werden mit
             // der Static Exchange Evaluation (SEE) bewertet.
             int seeEvaluation = evaluator.evaluateMoveSEE(move, nodesSearched);
+            SEARCH_STAT(statistics.seeCalls++);
 
             if(seeEvaluation >= 0) {
-                // Gute Schlagzüge
-                score = std::clamp(GOOD_CAPTURE_MOVES_NEUTRAL + seeEvaluation,
+                // Gute Schlagzüge. Bei gleicher SEE-Bewertung
+                // entscheidet die Capture History.
+                score = std::clamp(GOOD_CAPTURE_MOVES_NEUTRAL + seeEvaluation + getHistoryScore(move) / 64,
                                    GOOD_CAPTURE_MOVES_MIN,
                                    GOOD_CAPTURE_MOVES_MAX);
 
                 goodCaptures.insert_sorted(MoveScorePair(move, score), std::greater<MoveScorePair>());
             } else {
                 // Schlechte Schlagzüge
-                score = std::clamp(QUIET_MOVES_NEUTRAL + getHistoryScore(move, ply) + seeEvaluation,
+                score = std::clamp(QUIET_MOVES_NEUTRAL + getHistoryScore(move) / 8 + seeEvaluation,
                                    QUIET_MOVES_MIN,
                                    QUIET_MOVES_MAX);
 
@@ -889,7 +913,7 @@ void PVSSearchInstance::scoreMoves(const Array<Move, 256>& moves, int ply) {
                 killers.push_back(MoveScorePair(move, score));
             } else {
                 // Ruhige Züge. Gebe einen Bonus für den Konterzug.
-                score = std::clamp(QUIET_MOVES_NEUTRAL + getHistoryScore(move, ply) + (move == counterMove) * 300,
+                score = std::clamp(QUIET_MOVES_NEUTRAL + getHistoryScore(move) + (move == counterMove) * COUNTER_MOVE_BONUS,
                                    QUIET_MOVES_MIN,
                                    QUIET_MOVES_MAX); // Bewerte anhand der relativen Vergangenheitsbewertung
 
@@ -913,15 +937,16 @@ void PVSSearchInstance::scoreMovesForQuiescence(const Array<Move, 256>& moves, i
             // Schlagzüge und Bauernumwandlungen werden mit
             // der Static Exchange Evaluation (SEE) bewertet.
             int seeEvaluation = evaluator.evaluateMoveSEE(move, nodesSearched);
+            SEARCH_STAT(statistics.seeCalls++);
 
             if(seeEvaluation >= NEUTRAL_SCORE) {
                 // Gute Schlagzüge
-                score = std::clamp(GOOD_CAPTURE_MOVES_NEUTRAL + seeEvaluation,
+                score = std::clamp(GOOD_CAPTURE_MOVES_NEUTRAL + seeEvaluation + getHistoryScore(move) / 64,
                                     GOOD_CAPTURE_MOVES_MIN,
                                     GOOD_CAPTURE_MOVES_MAX);
             } else {
                 // Schlechte Schlagzüge
-                score = std::clamp(QUIET_MOVES_NEUTRAL + getHistoryScore(move, ply) + seeEvaluation,
+                score = std::clamp(QUIET_MOVES_NEUTRAL + getHistoryScore(move) / 8 + seeEvaluation,
                                    QUIET_MOVES_MIN,
                                    QUIET_MOVES_MAX);
             }
@@ -931,11 +956,53 @@ void PVSSearchInstance::scoreMovesForQuiescence(const Array<Move, 256>& moves, i
         } else {
             // Ruhige Züge werden anhand ihrer relativen Vergangenheitsbewertung
             // bewertet.
-            score = std::clamp(QUIET_MOVES_NEUTRAL + getHistoryScore(move, ply),
+            score = std::clamp(QUIET_MOVES_NEUTRAL + getHistoryScore(move),
                                QUIET_MOVES_MIN,
                                QUIET_MOVES_MAX);
         }
 
         searchStack[ply].moveScorePairs.insert_sorted(MoveScorePair(move, score), std::greater<MoveScorePair>());
     }
+}
+
+void PVSSearchInstance::reset(const Board& board) {
+    // Kopiere das Schachbrett in den bestehenden Speicher
+    // und initialisiere den Evaluator neu.
+    setBoard(board);
+
+    clearSearchState();
+}
+
+void PVSSearchInstance::clearSearchState() {
+    // Leere die Killerzüge und die Vergangenheitsbewertung.
+    for(int i = 0; i < MAX_PLY; i++) {
+        killerMoves[i][0] = Move::nullMove();
+        killerMoves[i][1] = Move::nullMove();
+    }
+
+    for(int i = 0; i < 2; i++)
+        for(int j = 0; j < 6; j++)
+            for(int k = 0; k < 64; k++)
+                counterMoveTable[i][j][k] = Move::nullMove();
+
+    history.clear();
+
+    #if defined(SEARCH_STATS)
+        statistics.clear();
+    #endif
+
+    // Leere die PV-Tabelle.
+    for(int i = 0; i < MAX_PLY; i++)
+        pvTable[i].clear();
+
+    // Setze die Suchvariablen zurück.
+    pvScore = 0;
+    rootAge = 0;
+    selectiveDepth = 0;
+    extensionsOnPath = 0;
+    localNodeCounter = 0;
+    instanceNodes = 0;
+    currentSearchDepth = 0;
+    searchMoves.clear();
+    bestRootMoveHint = Move::nullMove();
 }
\ No newline at end of file
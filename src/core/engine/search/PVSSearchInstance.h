@@ -5,9 +5,12 @@
 
 #include "core/engine/evaluation/HandcraftedEvaluator.h"
 #include "core/engine/evaluation/NNUEEvaluator.h"
+#include "core/engine/search/RootMoveTable.h"
 #include "core/engine/search/SearchDefinitions.h"
+#include "core/engine/search/SearchStatistics.h"
 
 #include "core/utils/Atomic.h"
+#include "core/utils/tables/HistoryTables.h"
 #include "core/utils/tables/TranspositionTable.h"
 
 #include "uci/Options.h"
@@ -33,10 +36,6 @@ class PVSSearchInstance {
             int16_t preliminaryScore = 0;
         };
 
-        struct HistoryStackEntry {
-            int32_t historyTable[64][64] = {0};
-        };
-
         Board board;
         #if defined(USE_HCE)
             HandcraftedEvaluator evaluator;
@@ -82,7 +81,8 @@ class PVSSearchInstance {
         int pvScore;
 
         /**
-         * @brief Das Alter des Spielfeldes an der Wurzel.
+         * @brief Das Alter des Spielfeldes an der Wurzel
+         * (inklusive des Versatzes der Transpositionstabelle).
          */
         unsigned int rootAge = 0;
 
@@ -128,6 +128,19 @@ class PVSSearchInstance {
         uint64_t localNodeCounter = 0;
         int currentSearchDepth = 0;
 
+        /**
+         * @brief Die Anzahl der Knoten, die nur diese Instanz während der
+         * aktuellen Suche betrachtet hat. Wird für die Knotenverteilung
+         * auf die Wurzelzüge verwendet.
+         */
+        uint64_t instanceNodes = 0;
+
+        /**
+         * @brief Die Tabelle, in die die Instanz die Ergebnisse
+         * im Wurzelknoten veröffentlicht (oder nullptr).
+         */
+        RootMoveTable* rootMoveTable = nullptr;
+
         /**
          * @brief Der Suchstapel, der von der Suchinstanz verwendet wird.
          * Der Suchstapel enthält alle Knoteninformationen, die von
@@ -136,11 +149,10 @@ class PVSSearchInstance {
         SearchStackEntry searchStack[MAX_PLY];
 
         /**
-         * @brief Der Historiestapel, der von der Suchinstanz verwendet wird.
-         * Der Historiestapel enthält Informationen über die Zughistorie
-         * und wird für die Zugvorsortierung verwendet.
+         * @brief Die Vergangenheitsbewertungen, die von der Suchinstanz
+         * für die Zugvorsortierung verwendet werden.
          */
-        std::vector<HistoryStackEntry> historyStack;
+        HistoryTables history;
 
         /**
          * @brief Die Liste der Züge, auf die sich die
@@ -151,15 +163,15 @@ class PVSSearchInstance {
 
         /**
          * @brief Speichert die Anzahl der Threads, die gleichzeitig
-         * den Spielbaum durchsuchen. Diese Variable wird automatisch
-         * im Konstruktor auf den Wert der UCI-Option "Threads" gesetzt.
+         * den Spielbaum durchsuchen. Diese Variable wird vor
+         * jeder Suche von der Engine gesetzt.
          */
         size_t numThreads = 1;
 
         /**
          * @brief Speichert die Anzahl der Varianten, die von der
-         * Suche konstruiert werden sollen. Diese Variable wird automatisch
-         * im Konstruktor auf den Wert der UCI-Option "MultiPV" gesetzt.
+         * Suche konstruiert werden sollen. Diese Variable wird vor
+         * jeder Suche von der Engine gesetzt.
          */
         size_t numPVs = 1;
 
@@ -174,6 +186,13 @@ class PVSSearchInstance {
          */
         Move bestRootMoveHint = Move::nullMove();
 
+        #if defined(SEARCH_STATS)
+        /**
+         * @brief Die Statistiken der aktuellen Suche dieser Instanz.
+         */
+        SearchStatistics statistics;
+        #endif
+
         /**
          * @brief Führt eine Quieszenzsuche durch. Die Quieszenzsuche
          * ist eine spezielle Form des Alpha-Beta-Algorithmus, die
@@ -268,6 +287,14 @@ class PVSSearchInstance {
          */
         void scoreMovesForQuiescence(const Array<Move, 256>& moves, int ply, int minSEEScore);
 
+        /**
+         * @brief Setzt alle Informationen zurück, die die Suchinstanz
+         * zwischen zwei Suchen gesammelt hat (Killerzüge, Konterzüge,
+         * Vergangenheitsbewertungen, PV-Tabelle, ...).
+         * Diese Methode reserviert keinen Speicher.
+         */
+        void clearSearchState();
+
     public:
 
         /**
@@ -280,29 +307,7 @@ class PVSSearchInstance {
             board(board), evaluator(this->board), transpositionTable(transpositionTable), stopFlag(stopFlag), startTime(startTime), 
             stopTime(stopTime), nodesSearched(nodesSearched), searchStack(), checkupFunction(checkupFunction) {
 
-            // Leere die Killerzüge und die Vergangenheitsbewertung.
-
-            for(int i = 0; i < MAX_PLY; i++) {
-                killerMoves[i][0] = Move::nullMove();
-                killerMoves[i][1] = Move::nullMove();
-            }
-
-            historyStack.resize(MAX_PLY);
-
-            for(int i = 0; i < 2; i++)
-                for(int j = 0; j < 6; j++)
-                    for(int k = 0; k < 64; k++)
-                        counterMoveTable[i][j][k] = Move::nullMove();
-
-            // Leere die PV-Tabelle.
-            for(int i = 0; i < MAX_PLY; i++)
-                pvTable[i].clear();
-
-            // Setze die Anzahl der Threads.
-            numThreads = UCI::options["Threads"].getValue<size_t>();
-
-            // Setze die Anzahl der Varianten.
-            numPVs = UCI::options["MultiPV"].getValue<size_t>();
+            clearSearchState();
         }
 
         #if defined(USE_HCE)
@@ -316,29 +321,7 @@ class PVSSearchInstance {
             board(board), evaluator(this->board, hceParams), transpositionTable(transpositionTable), stopFlag(stopFlag), startTime(startTime), 
             stopTime(stopTime), nodesSearched(nodesSearched), searchStack(), checkupFunction(checkupFunction) {
 
-            // Leere die Killerzüge und die Vergangenheitsbewertung.
-
-            for(int i = 0; i < MAX_PLY; i++) {
-                killerMoves[i][0] = Move::nullMove();
-                killerMoves[i][1] = Move::nullMove();
-            }
-
-            historyStack.resize(MAX_PLY);
-
-            for(int i = 0; i < 2; i++)
-                for(int j = 0; j < 6; j++)
-                    for(int k = 0; k < 64; k++)
-                        counterMoveTable[i][j][k] = Move::nullMove();
-
-            // Leere die PV-Tabelle.
-            for(int i = 0; i < MAX_PLY; i++)
-                pvTable[i].clear();
-
-            // Setze die Anzahl der Threads.
-            numThreads = UCI::options["Threads"].getValue<size_t>();
-
-            // Setze die Anzahl der Varianten.
-            numPVs = UCI::options["MultiPV"].getValue<size_t>();
+            clearSearchState();
         }
         #else
         /**
@@ -351,29 +334,7 @@ class PVSSearchInstance {
             board(board), evaluator(this->board, nnueParams), transpositionTable(transpositionTable), stopFlag(stopFlag), startTime(startTime), 
             stopTime(stopTime), nodesSearched(nodesSearched), searchStack(), checkupFunction(checkupFunction) {
 
-            // Leere die Killerzüge und die Vergangenheitsbewertung.
-
-            for(int i = 0; i < MAX_PLY; i++) {
-                killerMoves[i][0] = Move::nullMove();
-                killerMoves[i][1] = Move::nullMove();
-            }
-
-            historyStack.resize(MAX_PLY);
-
-            for(int i = 0; i < 2; i++)
-                for(int j = 0; j < 6; j++)
-                    for(int k = 0; k < 64; k++)
-                        counterMoveTable[i][j][k] = Move::nullMove();
-
-            // Leere die PV-Tabelle.
-            for(int i = 0; i < MAX_PLY; i++)
-                pvTable[i].clear();
-
-            // Setze die Anzahl der Threads.
-            numThreads = UCI::options["Threads"].getValue<size_t>();
-
-            // Setze die Anzahl der Varianten.
-            numPVs = UCI::options["MultiPV"].getValue<size_t>();
+            clearSearchState();
         }
         #endif
 
@@ -401,11 +362,23 @@ class PVSSearchInstance {
          */
         int pvs(int depth, int ply, int alpha, int beta, unsigned int nodeType, int nullMoveCooldown = 0, int singularExtCooldown = 0, bool isPlausibleLine = true, bool skipHashMove = false);
 
+        /**
+         * @brief Bereitet die Suchinstanz auf eine neue Suche in der
+         * gegebenen Position vor. Alle Informationen aus vorherigen Suchen
+         * werden verworfen, sodass sich die Instanz wie eine neu konstruierte
+         * Instanz verhält. Im Gegensatz zum Konstruktor wird dabei kein
+         * Speicher reserviert, weshalb Instanzen über viele (kurze) Suchen
+         * hinweg wiederverwendet werden sollten.
+         */
+        void reset(const Board& board);
+
         /**
          * @brief Setzt das Schachbrett auf eine neue Position.
          */
         inline void setBoard(const Board& board) {
-            this->board = board;
+            // Die Suche benötigt nur den Teil der Zughistorie,
+            // der für die Erkennung von Stellungswiederholungen relevant ist.
+            this->board.copyPosition(board);
             evaluator.setBoard(this->board);
         }
 
@@ -417,6 +390,22 @@ class PVSSearchInstance {
             this->isMainThread = isMainThread;
         }
 
+        /**
+         * @brief Setzt die Anzahl der Threads und der Varianten der Suche.
+         */
+        inline void setSearchThreadsAndPVs(size_t numThreads, size_t numPVs) {
+            this->numThreads = numThreads;
+            this->numPVs = numPVs;
+        }
+
+        /**
+         * @brief Setzt die Tabelle, in die die Instanz die Bewertungen
+         * und Knotenanzahlen der Wurzelzüge veröffentlicht.
+         */
+        inline void setRootMoveTable(RootMoveTable* rootMoveTable) {
+            this->rootMoveTable = rootMoveTable;
+        }
+
         /**
          * @brief Überprüft, ob die Stop-Flag gesetzt ist.
          */
@@ -456,6 +445,15 @@ class PVSSearchInstance {
             selectiveDepth = 0;
         }
 
+        #if defined(SEARCH_STATS)
+        /**
+         * @brief Gibt die Statistiken der aktuellen Suche dieser Instanz zurück.
+         */
+        inline const SearchStatistics& getStatistics() const {
+            return statistics;
+        }
+        #endif
+
         /**
          * @brief Gibt die Liste der Züge an, auf die sich die
          * Suchinstanz im Wurzelknoten beschränken soll.
@@ -502,15 +500,6 @@ class PVSSearchInstance {
             searchStack[ply].preliminaryScore = 0;
         }
 
-        constexpr void clearHistoryStack(int ply) {
-            if(ply >= MAX_PLY)
-                return;
-
-            for(int i = 0; i < 64; i++)
-                for(int j = 0; j < 64; j++)
-                    historyStack[ply].historyTable[i][j] = 0;
-        }
-
         constexpr void addKillerMove(int ply, Move move) {
             if(move != killerMoves[ply][1]) {
                 killerMoves[ply][0] = killerMoves[ply][1];
@@ -522,33 +511,61 @@ class PVSSearchInstance {
             return move == killerMoves[ply][0] || move == killerMoves[ply][1];
         }
 
-        static constexpr int HISTORY_SCORE_LOOKAHEAD = 10;
-        static constexpr int HISTORY_SCORE_LOOKBEHIND = 4;
-
-        inline void incrementHistoryScore(Move move, int ply, int depth) {
-            int32_t baselineIncrement = depth * depth * 2;
-            int lookahead = ply + HISTORY_SCORE_LOOKAHEAD;
-            for(int i = ply; i < std::min(MAX_PLY, lookahead + 1); i += 2)
-                historyStack[i].historyTable[move.getOrigin()][move.getDestination()] += baselineIncrement * (int32_t)(HISTORY_SCORE_LOOKAHEAD - i + lookahead) / HISTORY_SCORE_LOOKAHEAD;
+        /**
+         * @brief Bestimmt die Figur und das Zielfeld des letzten Zuges,
+         * damit die Continuation History adressiert werden kann.
+         * Gibt EMPTY als Figur zurück, wenn es keinen letzten Zug gibt.
+         */
+        inline void getPreviousMoveContext(int& prevPiece, int& prevDestination) {
+            Move previousMove = board.getLastMove();
+            prevPiece = EMPTY;
+            prevDestination = 0;
 
-            int lookbehind = ply - HISTORY_SCORE_LOOKBEHIND;
-            for(int i = ply - 2; i >= std::max(0, ply - HISTORY_SCORE_LOOKBEHIND); i -= 2)
-                historyStack[i].historyTable[move.getOrigin()][move.getDestination()] += baselineIncrement * (int32_t)(HISTORY_SCORE_LOOKBEHIND - lookbehind + i) / HISTORY_SCORE_LOOKBEHIND;
+            if(previousMove.exists()) {
+                prevDestination = previousMove.getDestination();
+                prevPiece = board.pieceAt(prevDestination);
+            }
         }
 
-        inline void decrementHistoryScore(Move move, int ply, int depth) {
-            int32_t baselineDecrement = depth * 2;
-            int lookahead = ply + HISTORY_SCORE_LOOKAHEAD;
-            for(int i = ply; i < std::min(MAX_PLY, lookahead + 1); i += 2)
-                historyStack[i].historyTable[move.getOrigin()][move.getDestination()] -= baselineDecrement * (int32_t)(HISTORY_SCORE_LOOKAHEAD - i + lookahead) / HISTORY_SCORE_LOOKAHEAD;
+        /**
+         * @brief Gibt die Vergangenheitsbewertung eines Zuges zurück.
+         * Schlagzüge werden über die Capture History, alle anderen
+         * Züge über die Butterfly und Continuation History bewertet.
+         */
+        inline int32_t getHistoryScore(Move move) {
+            int piece = board.pieceAt(move.getOrigin());
+
+            if(move.isCapture()) {
+                int capturedPieceType = move.isEnPassant() ? PAWN : TYPEOF(board.pieceAt(move.getDestination()));
+                return history.getCaptureScore(piece, move.getDestination(), capturedPieceType);
+            }
+
+            int prevPiece, prevDestination;
+            getPreviousMoveContext(prevPiece, prevDestination);
 
-            int lookbehind = ply - HISTORY_SCORE_LOOKBEHIND;
-            for(int i = ply - 2; i >= std::max(0, lookbehind); i -= 2)
-                historyStack[i].historyTable[move.getOrigin()][move.getDestination()] -= baselineDecrement * (int32_t)(HISTORY_SCORE_LOOKBEHIND - lookbehind + i) / HISTORY_SCORE_LOOKBEHIND;
+            return history.getQuietScore(board.getSideToMove(), piece, move, prevPiece, prevDestination);
         }
 
-        inline int32_t getHistoryScore(Move move, int ply) {
-            return historyStack[ply].historyTable[move.getOrigin()][move.getDestination()];
+        /**
+         * @brief Aktualisiert die Vergangenheitsbewertung eines Zuges.
+         * Muss in der Position vor dem Zug aufgerufen werden.
+         *
+         * @param move Der Zug.
+         * @param bonus Der Bonus (positiv) oder die Strafe (negativ).
+         */
+        inline void updateHistoryScore(Move move, int bonus) {
+            int piece = board.pieceAt(move.getOrigin());
+
+            if(move.isCapture()) {
+                int capturedPieceType = move.isEnPassant() ? PAWN : TYPEOF(board.pieceAt(move.getDestination()));
+                history.updateCapture(piece, move.getDestination(), capturedPieceType, bonus);
+                return;
+            }
+
+            int prevPiece, prevDestination;
+            getPreviousMoveContext(prevPiece, prevDestination);
+
+            history.updateQuiet(board.getSideToMove(), piece, move, prevPiece, prevDestination, bonus);
         }
 
         constexpr void setCounterMove(Move move, int side, int piece, int destination) {
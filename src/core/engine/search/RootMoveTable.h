@@ -0,0 +1,398 @@
+#ifndef ROOT_MOVE_TABLE_H
+#define ROOT_MOVE_TABLE_H
+
+#include "core/chess/Move.h"
+#include "core/engine/search/SearchDefinitions.h"
+
+#include "core/utils/Array.h"
+#include "core/utils/Atomic.h"
+
+#include <algorithm>
+#include <memory>
+#include <stdint.h>
+
+/**
+ * @brief Ein Suchergebnis, das aus einer RootMoveTable gelesen wurde.
+ */
+struct RootSearchResult {
+    int score = 0;
+    int depth = 0;
+    int selectiveDepth = 0;
+    Array<Move, MAX_PLY> pv;
+};
+
+/**
+ * @brief Ein Suchergebnis (Bewertung, Tiefe und Hauptvariante),
+ * das durch ein Seqlock geschützt wird. Beliebig viele Threads können
+ * das Ergebnis lesen, während ein anderer Thread es veröffentlicht,
+ * ohne dass einer der Threads blockiert wird.
+ *
+ * Die Sequenznummer ist ungerade, während ein Thread schreibt.
+ * Ein Leser wiederholt seinen Lesevorgang, bis er vor und nach dem
+ * Lesen die gleiche gerade Sequenznummer gesehen hat.
+ * Schreibende Threads warten aktiv, bis kein anderer Thread mehr schreibt.
+ * Da ein Schreibvorgang nur aus wenigen Speicherzugriffen besteht,
+ * ist die Wartezeit vernachlässigbar.
+ */
+class SeqlockedSearchResult {
+    private:
+        Atomic<uint32_t> sequence = 0;
+        Atomic<int32_t> score = 0;
+        Atomic<int32_t> depth = 0;
+        Atomic<int32_t> selectiveDepth = 0;
+        Atomic<uint32_t> pvLength = 0;
+        Atomic<uint16_t> pv[MAX_PLY];
+
+    public:
+        SeqlockedSearchResult() {
+            for(size_t i = 0; i < MAX_PLY; i++)
+                pv[i].store(0);
+        }
+
+        /**
+         * @brief Setzt das Ergebnis zurück. Darf nur aufgerufen werden,
+         * wenn kein anderer Thread auf das Ergebnis zugreift.
+         */
+        inline void clear() {
+            sequence.store(0);
+            score.store(0);
+            depth.store(0);
+            selectiveDepth.store(0);
+            pvLength.store(0);
+        }
+
+        /**
+         * @brief Gibt die Tiefe des zuletzt veröffentlichten Ergebnisses zurück.
+         * Diese Methode benötigt keinen konsistenten Lesevorgang.
+         */
+        inline int getDepth() const {
+            return depth.load();
+        }
+
+        /**
+         * @brief Veröffentlicht ein neues Ergebnis.
+         *
+         * @param onlyIfDeeper Gibt an, ob das Ergebnis verworfen werden soll, wenn es
+         * flacher als das bereits veröffentlichte Ergebnis ist. Der Vergleich findet
+         * innerhalb des Schreibvorgangs statt, sodass kein gleichzeitig schreibender
+         * Thread ein tieferes Ergebnis überschreiben kann.
+         * @return false, wenn das Ergebnis verworfen wurde.
+         */
+        inline bool publish(int depth, int score, int selectiveDepth, const Array<Move, MAX_PLY>& pv, bool onlyIfDeeper = false) {
+            uint32_t seq = sequence.load();
+            while((seq & 1) || !sequence.compare_exchange_weak(seq, seq + 1))
+                seq = sequence.load();
+
+            if(onlyIfDeeper && depth < this->depth.load()) {
+                // Es wurde nichts geschrieben, Leser müssen nicht wiederholen
+                sequence.store(seq);
+                return false;
+            }
+
+            this->score.store(score);
+            this->depth.store(depth);
+            this->selectiveDepth.store(selectiveDepth);
+            this->pvLength.store(pv.size());
+
+            for(size_t i = 0; i < pv.size(); i++)
+                this->pv[i].store(pv[i].getMove());
+
+            sequence.store(seq + 2);
+            return true;
+        }
+
+        /**
+         * @brief Liest das zuletzt veröffentlichte Ergebnis konsistent aus.
+         */
+        inline void read(RootSearchResult& result) const {
+            uint32_t seqBefore, seqAfter;
+
+            do {
+                seqBefore = sequence.load();
+                if(seqBefore & 1) {
+                    seqAfter = seqBefore + 1;
+                    continue;
+                }
+
+                result.score = score.load();
+                result.depth = depth.load();
+                result.selectiveDepth = selectiveDepth.load();
+
+                size_t length = std::min((size_t)pvLength.load(), (size_t)MAX_PLY);
+                result.pv.clear();
+                for(size_t i = 0; i < length; i++)
+                    result.pv.push_back(Move(pv[i].load()));
+
+                seqAfter = sequence.load();
+            } while(seqBefore != seqAfter);
+        }
+};
+
+/**
+ * @brief Eine Tabelle mit Statistiken zu allen Zügen im Wurzelknoten und den
+ * Ergebnissen aller Suchthreads. Alle Suchinstanzen veröffentlichen ihre
+ * Ergebnisse während der Suche in diese Tabelle, sodass die UCI-Ausgabe,
+ * das Voting der Threads, die Zeitkontrolle und MultiPV jederzeit
+ * darauf zugreifen können, ohne die Suche anzuhalten.
+ *
+ * Pro Wurzelzug werden die Bewertung, die Tiefe und die Hauptvariante
+ * der tiefsten exakten Bewertung, sowie die Anzahl der Knoten gespeichert,
+ * die alle Threads zusammen in diesem Teilbaum durchsucht haben.
+ * Pro Thread wird das Ergebnis der letzten vollständigen Iteration gespeichert.
+ */
+class RootMoveTable {
+    public:
+        static constexpr size_t MAX_ROOT_MOVES = 256;
+
+    private:
+        struct RootMoveEntry {
+            Move move;
+            SeqlockedSearchResult result;
+            Atomic<uint64_t> nodes = 0;
+        };
+
+        RootMoveEntry rootMoves[MAX_ROOT_MOVES];
+        size_t numRootMoves = 0;
+
+        std::unique_ptr<SeqlockedSearchResult[]> threadResults;
+        size_t numThreads = 0;
+
+        /**
+         * @brief Ein Zwischenspeicher für das Voting, damit
+         * während der Suche kein Speicher reserviert werden muss.
+         */
+        std::unique_ptr<RootSearchResult[]> votingResults;
+
+    public:
+        /**
+         * @brief Bereitet die Tabelle auf eine neue Suche vor. Speicher wird
+         * nur reserviert, wenn sich die Anzahl der Threads geändert hat.
+         * Darf nur aufgerufen werden, wenn kein Thread sucht.
+         *
+         * @param moves Die legalen Züge im Wurzelknoten.
+         * @param numThreads Die Anzahl der Suchthreads.
+         */
+        inline void init(const Array<Move, 256>& moves, size_t numThreads) {
+            numRootMoves = moves.size();
+            for(size_t i = 0; i < numRootMoves; i++) {
+                rootMoves[i].move = moves[i];
+                rootMoves[i].result.clear();
+                rootMoves[i].nodes.store(0);
+            }
+
+            if(numThreads != this->numThreads) {
+                threadResults = std::make_unique<SeqlockedSearchResult[]>(numThreads);
+                votingResults = std::make_unique<RootSearchResult[]>(numThreads);
+                this->numThreads = numThreads;
+            } else {
+                for(size_t i = 0; i < numThreads; i++)
+                    threadResults[i].clear();
+            }
+        }
+
+        /**
+         * @brief Gibt den Index eines Wurzelzuges zurück oder -1,
+         * wenn der Zug nicht in der Tabelle enthalten ist.
+         */
+        inline int indexOf(Move move) const {
+            for(size_t i = 0; i < numRootMoves; i++)
+                if(rootMoves[i].move == move)
+                    return i;
+
+            return -1;
+        }
+
+        /**
+         * @brief Addiert die Knoten, die in dem Teilbaum eines Wurzelzuges durchsucht wurden.
+         */
+        inline void addNodes(Move move, uint64_t nodes) {
+            int index = indexOf(move);
+            if(index >= 0)
+                rootMoves[index].nodes.fetch_add(nodes);
+        }
+
+        /**
+         * @brief Veröffentlicht eine exakte Bewertung eines Wurzelzuges. Ergebnisse, die
+         * flacher als das bereits veröffentlichte Ergebnis sind, werden verworfen.
+         *
+         * @param pv Die Hauptvariante, die mit dem Wurzelzug beginnt.
+         */
+        inline void publishRootMove(int depth, int score, int selectiveDepth, const Array<Move, MAX_PLY>& pv) {
+            if(pv.size() == 0)
+                return;
+
+            int index = indexOf(pv[0]);
+            if(index >= 0)
+                rootMoves[index].result.publish(depth, score, selectiveDepth, pv, true);
+        }
+
+        /**
+         * @brief Veröffentlicht das Ergebnis einer vollständigen Iteration eines Threads.
+         * Jeder Thread schreibt nur in seinen eigenen Eintrag.
+         *
+         * @param threadIdx Der Index des Threads (0 ist der Hauptthread).
+         */
+        inline void publishThreadResult(size_t threadIdx, int depth, int score, int selectiveDepth, const Array<Move, MAX_PLY>& pv) {
+            if(threadIdx < numThreads && pv.size() > 0)
+                threadResults[threadIdx].publish(depth, score, selectiveDepth, pv);
+        }
+
+        /**
+         * @brief Liest das Ergebnis der letzten vollständigen Iteration eines Threads.
+         */
+        inline void readThreadResult(size_t threadIdx, RootSearchResult& result) const {
+            threadResults[threadIdx].read(result);
+        }
+
+        /**
+         * @brief Liest das tiefste Ergebnis, das für einen Wurzelzug veröffentlicht wurde.
+         */
+        inline bool readRootMove(Move move, RootSearchResult& result) const {
+            int index = indexOf(move);
+            if(index < 0)
+                return false;
+
+            rootMoves[index].result.read(result);
+            return result.depth > 0;
+        }
+
+        /**
+         * @brief Gibt das Ergebnis des Wurzelzuges mit der größten Tiefe
+         * (und bei gleicher Tiefe mit der besten Bewertung) zurück.
+         */
+        inline bool readBestRootMove(RootSearchResult& result) const {
+            int bestIdx = -1, bestDepth = 0, bestScore = MIN_SCORE;
+
+            for(size_t i = 0; i < numRootMoves; i++) {
+                rootMoves[i].result.read(result);
+                if(result.depth > bestDepth || (result.depth == bestDepth && result.depth > 0 && result.score > bestScore)) {
+                    bestIdx = i;
+                    bestDepth = result.depth;
+                    bestScore = result.score;
+                }
+            }
+
+            if(bestIdx < 0)
+                return false;
+
+            rootMoves[bestIdx].result.read(result);
+            return true;
+        }
+
+        /**
+         * @brief Gibt die Anzahl der Knoten zurück, die alle Threads
+         * im Teilbaum eines Wurzelzuges durchsucht haben.
+         */
+        inline uint64_t getNodes(Move move) const {
+            int index = indexOf(move);
+            return index >= 0 ? rootMoves[index].nodes.load() : 0;
+        }
+
+        /**
+         * @brief Gibt den Anteil der Knoten im Teilbaum eines
+         * Wurzelzuges an allen Knoten im Wurzelknoten zurück.
+         */
+        inline double getNodeShare(Move move) const {
+            uint64_t totalNodes = 0;
+            for(size_t i = 0; i < numRootMoves; i++)
+                totalNodes += rootMoves[i].nodes.load();
+
+            return totalNodes > 0 ? (double)getNodes(move) / (double)totalNodes : 0.0;
+        }
+
+        /**
+         * @brief Gibt die durchschnittliche Tiefe der letzten
+         * vollständigen Iterationen aller Threads zurück.
+         */
+        inline double getAverageDepth() const {
+            if(numThreads == 0)
+                return 0.0;
+
+            double sum = 0.0;
+            for(size_t i = 0; i < numThreads; i++)
+                sum += threadResults[i].getDepth();
+
+            return sum / numThreads;
+        }
+
+        /**
+         * @brief Gibt die größte selektive Tiefe aller Threads zurück.
+         */
+        inline int getSelectiveDepth() const {
+            RootSearchResult result;
+            int selectiveDepth = 0;
+
+            for(size_t i = 0; i < numThreads; i++) {
+                threadResults[i].read(result);
+                selectiveDepth = std::max(selectiveDepth, result.selectiveDepth);
+            }
+
+            return selectiveDepth;
+        }
+
+        /**
+         * @brief Bestimmt durch ein Voting aller Threads das Ergebnis,
+         * das als Hauptvariante verwendet werden soll. Jeder Thread stimmt
+         * für den ersten Zug seiner letzten vollständigen Iteration, gewichtet
+         * mit seiner Bewertung und seiner Tiefe. Ergebnisse, die flacher als das
+         * Ergebnis des Hauptthreads sind, stimmen mit ab, werden aber nicht ausgewählt.
+         * Bei Mattbewertungen wird immer das schnellste Matt für uns
+         * bzw. das langsamste Matt gegen uns gewählt.
+         *
+         * @param result Das ausgewählte Ergebnis.
+         * @return false, wenn der Hauptthread noch kein Ergebnis veröffentlicht hat.
+         */
+        inline bool vote(RootSearchResult& result) const {
+            int votes[MAX_ROOT_MOVES] = {0};
+            int worstScore = MAX_SCORE;
+
+            for(size_t i = 0; i < numThreads; i++) {
+                threadResults[i].read(votingResults[i]);
+                if(votingResults[i].depth > 0)
+                    worstScore = std::min(worstScore, votingResults[i].score);
+            }
+
+            const RootSearchResult& mainResult = votingResults[0];
+            if(mainResult.depth == 0)
+                return false;
+
+            auto threadValue = [worstScore](const RootSearchResult& r) {
+                return (r.score - worstScore + 10) * r.depth;
+            };
+
+            for(size_t i = 0; i < numThreads; i++) {
+                const RootSearchResult& r = votingResults[i];
+                int index = r.depth > 0 ? indexOf(r.pv[0]) : -1;
+                if(index >= 0)
+                    votes[index] += threadValue(r);
+            }
+
+            size_t bestIdx = 0;
+            int voteMapPeak = votes[std::max(indexOf(mainResult.pv[0]), 0)];
+            int bestPVScore = mainResult.score;
+
+            for(size_t i = 1; i < numThreads; i++) {
+                const RootSearchResult& r = votingResults[i];
+                int index = r.depth > 0 ? indexOf(r.pv[0]) : -1;
+                if(index < 0 || r.depth < mainResult.depth)
+                    continue;
+
+                if(isMateScore(r.score) || isMateScore(bestPVScore)) {
+                    if(r.score > bestPVScore) {
+                        bestIdx = i;
+                        bestPVScore = r.score;
+                    }
+                } else if(votes[index] > voteMapPeak ||
+                         (votes[index] == voteMapPeak && threadValue(r) > threadValue(votingResults[bestIdx]))) {
+                    bestIdx = i;
+                    voteMapPeak = votes[index];
+                    bestPVScore = r.score;
+                }
+            }
+
+            result = votingResults[bestIdx];
+            return true;
+        }
+};
+
+#endif
\ No newline at end of file
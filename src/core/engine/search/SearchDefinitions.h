@@ -74,6 +74,12 @@ static constexpr int QUIET_MOVES_MIN = MIN_SCORE + 1;
 static constexpr int QUIET_MOVES_NEUTRAL = NEUTRAL_SCORE;
 static constexpr int QUIET_MOVES_MAX = KILLER_MOVE_SCORE - 1;
 
+/**
+ * @brief Der Bonus, den ein Konterzug zusätzlich zu
+ * seiner Vergangenheitsbewertung erhält.
+ */
+static constexpr int COUNTER_MOVE_BONUS = 1024;
+
 static_assert(MIN_SCORE < QUIET_MOVES_MIN);
 static_assert(QUIET_MOVES_MIN < QUIET_MOVES_NEUTRAL && QUIET_MOVES_NEUTRAL < QUIET_MOVES_MAX);
 static_assert(KILLER_MOVE_SCORE < GOOD_CAPTURE_MOVES_MIN);
@@ -0,0 +1,86 @@
+#include "core/engine/search/SearchStatistics.h"
+
+#include <iomanip>
+
+void SearchStatistics::clear() {
+    *this = SearchStatistics();
+}
+
+SearchStatistics& SearchStatistics::operator+=(const SearchStatistics& other) {
+    pvsNodes += other.pvsNodes;
+    quiescenceNodes += other.quiescenceNodes;
+
+    for(int i = 0; i < NUM_DEPTHS; i++) {
+        ttProbes[i] += other.ttProbes[i];
+        ttHits[i] += other.ttHits[i];
+        ttCutoffs[i] += other.ttCutoffs[i];
+    }
+
+    nullMoveSearches += other.nullMoveSearches;
+    nullMoveCutoffs += other.nullMoveCutoffs;
+
+    futilityPrunes += other.futilityPrunes;
+    lmpPrunes += other.lmpPrunes;
+
+    reducedSearches += other.reducedSearches;
+    reducedReSearches += other.reducedReSearches;
+    nullWindowReSearches += other.nullWindowReSearches;
+
+    betaCutoffs += other.betaCutoffs;
+    firstMoveCutoffs += other.firstMoveCutoffs;
+
+    evaluations += other.evaluations;
+    seeCalls += other.seeCalls;
+
+    return *this;
+}
+
+/**
+ * @brief Berechnet einen Anteil in Prozent (0, wenn total 0 ist).
+ */
+static double percent(uint64_t part, uint64_t total) {
+    return total > 0 ? 100.0 * part / total : 0.0;
+}
+
+void SearchStatistics::print(std::ostream& os) const {
+    uint64_t nodes = pvsNodes + quiescenceNodes;
+    uint64_t probes = 0, hits = 0, cutoffs = 0;
+    for(int i = 0; i < NUM_DEPTHS; i++) {
+        probes += ttProbes[i];
+        hits += ttHits[i];
+        cutoffs += ttCutoffs[i];
+    }
+
+    os << std::fixed << std::setprecision(1);
+
+    os << "info string nodes " << nodes << " pvs " << pvsNodes <<
+          " qsearch " << quiescenceNodes << " (" << percent(quiescenceNodes, nodes) << "%)\n";
+
+    os << "info string tt probes " << probes << " hits " << hits << " (" << percent(hits, probes) << "%)" <<
+          " cutoffs " << cutoffs << " (" << percent(cutoffs, probes) << "%)\n";
+
+    for(int i = 0; i < NUM_DEPTHS; i++) {
+        if(ttProbes[i] == 0)
+            continue;
+
+        os << "info string tt depth " << i << (i == NUM_DEPTHS - 1 ? "+" : "") <<
+              " probes " << ttProbes[i] << " hits " << percent(ttHits[i], ttProbes[i]) << "%" <<
+              " cutoffs " << percent(ttCutoffs[i], ttProbes[i]) << "%\n";
+    }
+
+    os << "info string nullmove searches " << nullMoveSearches << " cutoffs " << nullMoveCutoffs <<
+          " (" << percent(nullMoveCutoffs, nullMoveSearches) << "%)\n";
+
+    os << "info string pruned futility " << futilityPrunes << " lmp " << lmpPrunes << "\n";
+
+    os << "info string lmr searches " << reducedSearches << " re-searches " << reducedReSearches <<
+          " (" << percent(reducedReSearches, reducedSearches) << "%)" <<
+          " null window re-searches " << nullWindowReSearches << "\n";
+
+    os << "info string beta cutoffs " << betaCutoffs << " first move " << firstMoveCutoffs <<
+          " (" << percent(firstMoveCutoffs, betaCutoffs) << "%)\n";
+
+    os << "info string evaluations " << evaluations << " see " << seeCalls << std::endl;
+
+    os << std::defaultfloat << std::setprecision(6);
+}
\ No newline at end of file
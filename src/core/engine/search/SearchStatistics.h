@@ -0,0 +1,68 @@
+#ifndef SEARCH_STATISTICS_H
+#define SEARCH_STATISTICS_H
+
+#include <algorithm>
+#include <ostream>
+#include <stdint.h>
+
+/**
+ * @brief Zählt Ereignisse in der Suche nur, wenn mit SEARCH_STATS kompiliert
+ * wurde (make SEARCH_STATS=1). Ansonsten wird die Anweisung entfernt, die
+ * Zähler kosten in normalen Builds also nichts.
+ */
+#if defined(SEARCH_STATS)
+    #define SEARCH_STAT(statement) statement
+#else
+    #define SEARCH_STAT(statement)
+#endif
+
+/**
+ * @brief Die Statistiken einer Suchinstanz. Jede Instanz (bzw. jeder Thread)
+ * zählt in eigene Zähler, die am Ende der Suche zusammengeführt werden.
+ */
+struct SearchStatistics {
+    /**
+     * @brief Die Anzahl der Tiefen, für die die Zugriffe auf die
+     * Transpositionstabelle einzeln gezählt werden. Größere
+     * Tiefen werden in der letzten Tiefe zusammengefasst.
+     */
+    static constexpr int NUM_DEPTHS = 24;
+
+    uint64_t pvsNodes = 0;
+    uint64_t quiescenceNodes = 0;
+
+    uint64_t ttProbes[NUM_DEPTHS] = {};
+    uint64_t ttHits[NUM_DEPTHS] = {};
+    uint64_t ttCutoffs[NUM_DEPTHS] = {};
+
+    uint64_t nullMoveSearches = 0;
+    uint64_t nullMoveCutoffs = 0;
+
+    uint64_t futilityPrunes = 0;
+    uint64_t lmpPrunes = 0;
+
+    uint64_t reducedSearches = 0;
+    uint64_t reducedReSearches = 0;
+    uint64_t nullWindowReSearches = 0;
+
+    uint64_t betaCutoffs = 0;
+    uint64_t firstMoveCutoffs = 0;
+
+    uint64_t evaluations = 0;
+    uint64_t seeCalls = 0;
+
+    static inline int depthIndex(int depth) {
+        return std::clamp(depth, 0, NUM_DEPTHS - 1);
+    }
+
+    void clear();
+
+    SearchStatistics& operator+=(const SearchStatistics& other);
+
+    /**
+     * @brief Gibt die Statistiken als UCI-Informationen (info string) aus.
+     */
+    void print(std::ostream& os) const;
+};
+
+#endif
\ No newline at end of file
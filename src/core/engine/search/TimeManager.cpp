@@ -0,0 +1,113 @@
+#include "core/engine/search/TimeManager.h"
+#include "core/engine/search/SearchDefinitions.h"
+#include "core/chess/BoardDefinitions.h"
+
+#include <algorithm>
+#include <limits>
+
+void TimeManager::start(const UCI::SearchParams& params, int side, size_t numLegalMoves, int64_t moveOverhead) {
+    lastBestMove = Move();
+    numIterations = 0;
+    stableIterations = 0;
+    bestMoveChanges = 0.0;
+
+    nodeShareFactor = 1.0;
+    stabilityFactor = 1.0;
+    scoreTrendFactor = 1.0;
+    depthFactor = 1.0;
+
+    if(params.useMovetime) {
+        // Wir sollen eine feste Zeit suchen.
+        baseSoftLimit = params.movetime;
+        hardLimit = params.movetime;
+        isDynamic = false;
+    } else if(params.useWBTime) {
+        // Wir sollen mit dynamischer Zeitkontrolle suchen.
+        int64_t time = side == WHITE ? params.wtime : params.btime;
+        int64_t increment = side == WHITE ? params.winc : params.binc;
+
+        int movesToGo = DEFAULT_MOVES_TO_GO;
+        if(params.movestogo != std::numeric_limits<unsigned int>::max())
+            movesToGo = std::clamp((int)params.movestogo, 1, MAX_MOVES_TO_GO);
+
+        // Bestimme die Zeit, die für die nächsten movesToGo Züge zur Verfügung steht.
+        // Für jeden dieser Züge wird die Zeit für die Kommunikation mit der GUI reserviert.
+        int64_t remaining = std::max(time - moveOverhead, (int64_t)1);
+        int64_t available = time + increment * (movesToGo - 1) - moveOverhead * (movesToGo + 2);
+        available = std::max(available, (int64_t)1);
+
+        double softTime = (double)available / movesToGo;
+        softTime = std::min(softTime, MAX_SOFT_TIME_FRACTION * remaining);
+
+        double hardTime = std::min(softTime * HARD_LIMIT_FACTOR, MAX_HARD_TIME_FRACTION * remaining);
+        hardTime = std::max(hardTime, softTime);
+
+        baseSoftLimit = (int64_t)softTime;
+        hardLimit = (int64_t)hardTime;
+
+        // Wenn es nur einen legalen Zug gibt, reicht die erste Iteration.
+        if(numLegalMoves == 1)
+            baseSoftLimit = 0;
+
+        isDynamic = true;
+    } else {
+        // Keine Zeitkontrolle.
+        baseSoftLimit = std::numeric_limits<uint32_t>::max();
+        hardLimit = std::numeric_limits<uint32_t>::max();
+        isDynamic = false;
+    }
+
+    softLimit = baseSoftLimit;
+}
+
+void TimeManager::update(int depth, Move bestMove, int score, double nodeShare, double averageDepth) {
+    // Stabilität des besten Zuges. Ältere Wechsel des besten
+    // Zuges werden mit jeder Iteration schwächer gewichtet.
+    bestMoveChanges *= 0.6;
+
+    if(numIterations > 0 && bestMove != lastBestMove) {
+        bestMoveChanges += 1.0;
+        stableIterations = 0;
+    } else if(numIterations > 0) {
+        stableIterations++;
+    }
+
+    // Bewertungstrend gegenüber den letzten (bis zu) drei Iterationen.
+    int numPrevScores = std::min(numIterations, 3);
+    double scoreDrop = 0.0;
+    if(numPrevScores > 0) {
+        double meanScore = 0.0;
+        for(int i = 0; i < numPrevScores; i++)
+            meanScore += lastScores[i];
+
+        scoreDrop = meanScore / numPrevScores - score;
+    }
+
+    lastScores[2] = lastScores[1];
+    lastScores[1] = lastScores[0];
+    lastScores[0] = score;
+
+    lastBestMove = bestMove;
+    numIterations++;
+
+    // Bestimme die Skalierungsfaktoren.
+    nodeShareFactor = nodeShare > 0.0 ? std::clamp((1.52 - nodeShare) * 1.35, 0.5, 2.0) : 1.0;
+    stabilityFactor = std::clamp(1.0 + 0.5 * bestMoveChanges - 0.05 * std::min(stableIterations, 8), 0.6, 2.0);
+    scoreTrendFactor = isMateScore(score) ? 1.0 : std::clamp(1.0 + scoreDrop / 200.0, 0.8, 1.5);
+    depthFactor = std::clamp(1.0 - 0.05 * (averageDepth - depth), 0.9, 1.1);
+
+    if(!isDynamic || depth < MIN_SCALING_DEPTH) {
+        softLimit = baseSoftLimit;
+        return;
+    }
+
+    double scaledLimit = baseSoftLimit * nodeShareFactor * stabilityFactor * scoreTrendFactor * depthFactor;
+    softLimit = std::min((int64_t)scaledLimit, hardLimit);
+}
+
+void TimeManager::printDecision(std::ostream& os, std::chrono::milliseconds elapsed) const {
+    os << "info string time elapsed " << elapsed.count() << " soft " << softLimit << " base " << baseSoftLimit <<
+          " hard " << hardLimit << " nodeshare " << nodeShareFactor << " stability " << stabilityFactor <<
+          " trend " << scoreTrendFactor << " depth " << depthFactor <<
+          (shouldStop(elapsed) ? " stop" : " continue") << std::endl;
+}
\ No newline at end of file
@@ -0,0 +1,144 @@
+#ifndef TIME_MANAGER_H
+#define TIME_MANAGER_H
+
+#include "core/chess/Move.h"
+
+#include "uci/UCI.h"
+
+#include <chrono>
+#include <ostream>
+#include <stdint.h>
+
+/**
+ * @brief Bestimmt, wie lange eine Suche dauern darf.
+ *
+ * Zu Beginn der Suche werden aus der Bedenkzeit, dem Inkrement und
+ * der Anzahl der verbleibenden Züge ein weiches und ein hartes Zeitlimit
+ * berechnet. Das harte Limit wird nie überschritten und bricht die Suche
+ * auch mitten in einer Iteration ab. Das weiche Limit wird nach jeder
+ * vollständigen Iteration anhand der folgenden Größen neu skaliert:
+ *
+ * - Knotenanteil: Der Anteil der Knoten im Teilbaum des besten Zuges.
+ *   Ein hoher Anteil bedeutet, dass alle Alternativen schnell widerlegt wurden.
+ * - Stabilität: Wie viele Iterationen der beste Zug unverändert geblieben ist
+ *   bzw. wie oft er sich in den letzten Iterationen geändert hat.
+ * - Bewertungstrend: Ob die Bewertung gegenüber den letzten Iterationen fällt.
+ * - Durchschnittliche Tiefe: Ob die Helper-Threads bereits tiefer
+ *   als der Hauptthread gesucht haben.
+ *
+ * Ohne dynamische Zeitkontrolle (z.B. go movetime) sind beide Limits fest.
+ */
+class TimeManager {
+    private:
+        /**
+         * Die Zeitlimits der aktuellen Suche in Millisekunden.
+         */
+
+        int64_t baseSoftLimit = 0;
+        int64_t softLimit = 0;
+        int64_t hardLimit = 0;
+
+        /**
+         * @brief Gibt an, ob das weiche Limit nach jeder
+         * Iteration neu skaliert werden soll.
+         */
+        bool isDynamic = false;
+
+        /**
+         * Informationen über die bisherigen Iterationen.
+         */
+
+        Move lastBestMove;
+        int lastScores[3] = {0};
+        int numIterations = 0;
+        int stableIterations = 0;
+        double bestMoveChanges = 0.0;
+
+        /**
+         * Die Skalierungsfaktoren der letzten Iteration.
+         * Werden nur für die Ausgabe im Debug-Modus gespeichert.
+         */
+
+        double nodeShareFactor = 1.0;
+        double stabilityFactor = 1.0;
+        double scoreTrendFactor = 1.0;
+        double depthFactor = 1.0;
+
+    public:
+        /**
+         * @brief Wenn keine Anzahl an verbleibenden Zügen vorgegeben
+         * ist, wird mit dieser Anzahl gerechnet.
+         */
+        static constexpr int DEFAULT_MOVES_TO_GO = 30;
+
+        /**
+         * @brief Die maximale Anzahl an verbleibenden Zügen, mit der gerechnet wird.
+         */
+        static constexpr int MAX_MOVES_TO_GO = 50;
+
+        /**
+         * @brief Der maximale Anteil der verbleibenden Zeit, der
+         * für das weiche bzw. harte Limit verwendet werden darf.
+         */
+        static constexpr double MAX_SOFT_TIME_FRACTION = 0.5;
+        static constexpr double MAX_HARD_TIME_FRACTION = 0.8;
+
+        /**
+         * @brief Das harte Limit ist höchstens dieses Vielfache des weichen Limits.
+         */
+        static constexpr double HARD_LIMIT_FACTOR = 5.0;
+
+        /**
+         * @brief Ab dieser Tiefe wird das weiche Limit skaliert.
+         * In geringen Tiefen sind Knotenanteil und Stabilität nicht aussagekräftig.
+         */
+        static constexpr int MIN_SCALING_DEPTH = 5;
+
+        /**
+         * @brief Bereitet den Zeitmanager auf eine neue Suche vor.
+         *
+         * @param params Die Suchparameter.
+         * @param side Die Farbe, die am Zug ist.
+         * @param numLegalMoves Die Anzahl der legalen Züge in der Position.
+         * @param moveOverhead Die Zeit in Millisekunden, die pro Zug
+         * für die Kommunikation mit der GUI reserviert wird.
+         */
+        void start(const UCI::SearchParams& params, int side, size_t numLegalMoves, int64_t moveOverhead);
+
+        /**
+         * @brief Skaliert das weiche Limit nach einer vollständigen Iteration.
+         *
+         * @param depth Die Tiefe der Iteration.
+         * @param bestMove Der beste Zug der Iteration.
+         * @param score Die Bewertung des besten Zuges.
+         * @param nodeShare Der Anteil der Knoten im Teilbaum des besten Zuges.
+         * @param averageDepth Die durchschnittliche Tiefe aller Threads.
+         */
+        void update(int depth, Move bestMove, int score, double nodeShare, double averageDepth);
+
+        /**
+         * @brief Gibt an, ob nach der letzten Iteration keine
+         * weitere Iteration mehr gestartet werden soll.
+         *
+         * @param elapsed Die bisher verbrauchte Zeit.
+         */
+        inline bool shouldStop(std::chrono::milliseconds elapsed) const {
+            return elapsed.count() >= softLimit;
+        }
+
+        inline int64_t getSoftLimit() const {
+            return softLimit;
+        }
+
+        inline int64_t getHardLimit() const {
+            return hardLimit;
+        }
+
+        /**
+         * @brief Gibt die Entscheidung der letzten Iteration
+         * als UCI-Info-String aus.
+         */
+        void printDecision(std::ostream& os, std::chrono::milliseconds elapsed) const;
+};
+
+#endif
\ No newline at end of file
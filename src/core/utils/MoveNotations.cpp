@@ -358,4 +358,70 @@ std::vector<std::string> variationToFigurineAlgebraicNotation(const std::vector<
         board.undoMove();
 
     return result;
+}
+
+bool matchesUCINotation(Move m, std::string_view str) {
+    if(str.size() != 4 && str.size() != 5)
+        return false;
+
+    if(str[0] < 'a' || str[0] > 'h' || str[1] < '1' || str[1] > '8' ||
+       str[2] < 'a' || str[2] > 'h' || str[3] < '1' || str[3] > '8')
+        return false;
+
+    if(m.getOrigin() != FR2SQ(str[0] - 'a', str[1] - '1') ||
+       m.getDestination() != FR2SQ(str[2] - 'a', str[3] - '1'))
+        return false;
+
+    if(str.size() == 4)
+        return !m.isPromotion();
+
+    switch(str[4]) {
+        case 'n': return m.isPromotionKnight();
+        case 'b': return m.isPromotionBishop();
+        case 'r': return m.isPromotionRook();
+        case 'q': return m.isPromotionQueen();
+        default: return false;
+    }
+}
+
+Move fromUCINotation(std::string_view str, const Board& board) {
+    Array<Move, 256> legalMoves;
+    board.generateLegalMoves(legalMoves);
+
+    for(Move m : legalMoves)
+        if(matchesUCINotation(m, str))
+            return m;
+
+    return Move();
+}
+
+/**
+ * @brief Entfernt alle Zeichen aus einem Zug in Standard-Algebraischer Notation,
+ * die für die Identifikation des Zuges nicht notwendig sind.
+ */
+static std::string normalizeStandardAlgebraicNotation(std::string_view str) {
+    std::string result;
+    result.reserve(str.size());
+
+    for(char c : str) {
+        if(c == '+' || c == '#' || c == '!' || c == '?' || c == '=')
+            continue;
+
+        result += c == '0' ? 'O' : c;
+    }
+
+    return result;
+}
+
+Move fromStandardAlgebraicNotation(std::string_view str, Board& board) {
+    std::string normalized = normalizeStandardAlgebraicNotation(str);
+
+    Array<Move, 256> legalMoves;
+    board.generateLegalMoves(legalMoves);
+
+    for(Move m : legalMoves)
+        if(normalizeStandardAlgebraicNotation(toStandardAlgebraicNotation(m, board)) == normalized)
+            return m;
+
+    return Move();
 }
\ No newline at end of file
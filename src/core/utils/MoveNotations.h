@@ -5,6 +5,7 @@
 
 #include <ostream>
 #include <string>
+#include <string_view>
 
 /**
  * @brief Symbole für die Figuren. Die Indizes entsprechen den Werten der Piece-Enum-Klasse.
@@ -53,4 +54,30 @@ std::vector<std::string> variationToStandardAlgebraicNotation(const std::vector<
  */
 std::vector<std::string> variationToFigurineAlgebraicNotation(const std::vector<Move>& moves, Board& board, int customPly = -1);
 
+/**
+ * @brief Überprüft, ob ein Zug einem Zug in UCI-Notation (z.B. e2e4 oder e7e8q) entspricht.
+ * Verglichen werden Ausgangsfeld, Zielfeld und Umwandlungsfigur, ohne einen String zu erzeugen.
+ */
+bool matchesUCINotation(Move m, std::string_view str);
+
+/**
+ * @brief Sucht den legalen Zug, der einem Zug in UCI-Notation entspricht.
+ * 
+ * @param str Der Zug in UCI-Notation.
+ * @param board Das Spielfeld.
+ * @return Der legale Zug oder ein leerer Zug (Move()), wenn kein legaler Zug passt.
+ */
+Move fromUCINotation(std::string_view str, const Board& board);
+
+/**
+ * @brief Sucht den legalen Zug, der einem Zug in Standard-Algebraischer Notation entspricht.
+ * Schach- und Bewertungszeichen (+, #, !, ?), das Gleichheitszeichen bei Umwandlungen
+ * und Rochaden mit Nullen (0-0) werden toleriert.
+ * 
+ * @param str Der Zug in Standard-Algebraischer Notation.
+ * @param board Das Spielfeld.
+ * @return Der legale Zug oder ein leerer Zug (Move()), wenn kein legaler Zug passt.
+ */
+Move fromStandardAlgebraicNotation(std::string_view str, Board& board);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include "core/utils/Profiler.h"
+
+#if defined(USE_PROFILER)
+
+#include <algorithm>
+#include <iomanip>
+#include <vector>
+
+#if not defined(DISABLE_THREADS)
+    #include <mutex>
+#endif
+
+namespace {
+    constexpr const char* REGION_NAMES[Profiler::NUM_REGIONS] = {
+        "makemove", "undomove", "movegen", "evaluate", "evalupdate", "see", "ttprobe", "ttstore"
+    };
+
+    /**
+     * @brief Die Zähler aller laufenden Threads und
+     * die übernommenen Zähler beendeter Threads.
+     */
+    struct Registry {
+        std::vector<Profiler::ThreadCounters*> threads;
+        uint64_t retiredCycles[Profiler::NUM_REGIONS] = {};
+        uint64_t retiredCalls[Profiler::NUM_REGIONS] = {};
+        uint64_t startTimestamp = Profiler::readTimestamp();
+
+        #if not defined(DISABLE_THREADS)
+            std::mutex mutex;
+        #endif
+    };
+
+    Registry& getRegistry() {
+        static Registry registry;
+        return registry;
+    }
+
+    #if not defined(DISABLE_THREADS)
+        #define LOCK_REGISTRY(registry) std::lock_guard<std::mutex> lock(registry.mutex)
+    #else
+        #define LOCK_REGISTRY(registry)
+    #endif
+
+    /**
+     * @brief Schätzt die Takte, die eine leere Messung kostet.
+     */
+    uint64_t measureTimerOverhead() {
+        uint64_t overhead = UINT64_MAX;
+
+        for(int i = 0; i < 1000; i++) {
+            uint64_t start = Profiler::readTimestamp();
+            uint64_t end = Profiler::readTimestamp();
+            overhead = std::min(overhead, end - start);
+        }
+
+        return overhead;
+    }
+}
+
+thread_local Profiler::ThreadCounters Profiler::threadCounters;
+
+Profiler::ThreadCounters::ThreadCounters() {
+    Registry& registry = getRegistry();
+    LOCK_REGISTRY(registry);
+    registry.threads.push_back(this);
+}
+
+Profiler::ThreadCounters::~ThreadCounters() {
+    Registry& registry = getRegistry();
+    LOCK_REGISTRY(registry);
+
+    for(int i = 0; i < NUM_REGIONS; i++) {
+        registry.retiredCycles[i] += cycles[i];
+        registry.retiredCalls[i] += calls[i];
+    }
+
+    registry.threads.erase(std::find(registry.threads.begin(), registry.threads.end(), this));
+}
+
+void Profiler::reset() {
+    Registry& registry = getRegistry();
+    LOCK_REGISTRY(registry);
+
+    for(ThreadCounters* counters : registry.threads) {
+        std::fill(std::begin(counters->cycles), std::end(counters->cycles), 0);
+        std::fill(std::begin(counters->calls), std::end(counters->calls), 0);
+    }
+
+    std::fill(std::begin(registry.retiredCycles), std::end(registry.retiredCycles), 0);
+    std::fill(std::begin(registry.retiredCalls), std::end(registry.retiredCalls), 0);
+
+    registry.startTimestamp = readTimestamp();
+}
+
+void Profiler::print(std::ostream& os, uint64_t nodes) {
+    Registry& registry = getRegistry();
+    LOCK_REGISTRY(registry);
+
+    uint64_t elapsed = std::max(readTimestamp() - registry.startTimestamp, (uint64_t)1);
+    uint64_t overhead = measureTimerOverhead();
+
+    os << std::fixed << std::setprecision(1);
+    os << "info string profile elapsed " << elapsed / 1000000 << "M cycles, timer overhead " << overhead << " cycles\n";
+
+    for(int i = 0; i < NUM_REGIONS; i++) {
+        uint64_t cycles = registry.retiredCycles[i], calls = registry.retiredCalls[i];
+        for(const ThreadCounters* counters : registry.threads) {
+            cycles += counters->cycles[i];
+            calls += counters->calls[i];
+        }
+
+        if(calls == 0)
+            continue;
+
+        // Ziehe die geschätzten Kosten der Messung ab
+        cycles -= std::min(cycles, calls * overhead);
+
+        os << "info string profile " << std::left << std::setw(10) << REGION_NAMES[i] << std::right <<
+              " calls " << std::setw(11) << calls <<
+              " cycles/call " << std::setw(7) << (double)cycles / calls <<
+              " cycles/node " << std::setw(7) << (nodes > 0 ? (double)cycles / nodes : 0.0) <<
+              " time " << std::setw(5) << 100.0 * cycles / elapsed << "%\n";
+    }
+
+    os << std::defaultfloat << std::setprecision(6) << std::flush;
+}
+
+#endif
\ No newline at end of file
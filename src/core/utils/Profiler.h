@@ -0,0 +1,110 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <ostream>
+#include <stdint.h>
+
+#if defined(USE_PROFILER)
+    #if defined(__x86_64__) || defined(__i386__)
+        #include <x86intrin.h>
+    #else
+        #include <chrono>
+    #endif
+#endif
+
+/**
+ * @brief Misst die Dauer des restlichen Blocks, wenn mit USE_PROFILER
+ * kompiliert wurde (make profiler). Ansonsten wird das Makro entfernt
+ * und der Block bleibt unverändert.
+ */
+#if defined(USE_PROFILER)
+    #define PROFILE_SCOPE(region) Profiler::ScopedTimer profilerScopedTimer(region)
+#else
+    #define PROFILE_SCOPE(region)
+#endif
+
+/**
+ * @brief Ein einfacher Profiler für die heißen Abschnitte der Engine.
+ *
+ * Jeder Abschnitt wird mit dem Zeitstempelzähler (rdtsc) gemessen und die
+ * Takte und Aufrufe werden pro Thread gezählt. Die Abschnitte werden
+ * inklusive verschachtelter Abschnitte gemessen. Die Messung selbst kostet
+ * einige Takte, die bei der Ausgabe geschätzt und abgezogen werden.
+ */
+namespace Profiler {
+    enum Region {
+        MAKE_MOVE,
+        UNDO_MOVE,
+        MOVEGEN,
+        EVALUATE,
+        EVALUATE_UPDATE,
+        SEE,
+        TT_PROBE,
+        TT_STORE,
+        NUM_REGIONS
+    };
+
+    #if defined(USE_PROFILER)
+    /**
+     * @brief Die Zähler eines Threads. Die Zähler eines beendeten
+     * Threads werden in die gemeinsamen Zähler übernommen.
+     */
+    struct ThreadCounters {
+        uint64_t cycles[NUM_REGIONS] = {};
+        uint64_t calls[NUM_REGIONS] = {};
+
+        ThreadCounters();
+        ~ThreadCounters();
+    };
+
+    /**
+     * @brief Die Zähler des aktuellen Threads.
+     */
+    extern thread_local ThreadCounters threadCounters;
+
+    /**
+     * @brief Liest den Zeitstempelzähler. Auf Plattformen ohne
+     * rdtsc werden stattdessen Nanosekunden verwendet.
+     */
+    inline uint64_t readTimestamp() {
+        #if defined(__x86_64__) || defined(__i386__)
+            return __rdtsc();
+        #else
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        #endif
+    }
+
+    class ScopedTimer {
+        private:
+            Region region;
+            uint64_t start;
+
+        public:
+            inline ScopedTimer(Region region) : region(region), start(readTimestamp()) {}
+
+            inline ~ScopedTimer() {
+                uint64_t end = readTimestamp();
+                threadCounters.cycles[region] += end - start;
+                threadCounters.calls[region]++;
+            }
+    };
+
+    /**
+     * @brief Setzt die Zähler aller Threads zurück und beginnt eine neue Messung.
+     * Darf nur aufgerufen werden, wenn keine Suche läuft.
+     */
+    void reset();
+
+    /**
+     * @brief Gibt die Takte, Aufrufe und den Anteil an der Zeit seit
+     * dem letzten Aufruf von reset() für jeden Abschnitt als UCI-Informationen
+     * (info string) aus. Die Anteile werden über alle Threads summiert.
+     *
+     * @param nodes Die Anzahl der durchsuchten Knoten (für die Takte pro Knoten).
+     */
+    void print(std::ostream& os, uint64_t nodes);
+    #endif
+}
+
+#endif
\ No newline at end of file
@@ -64,8 +64,8 @@ int16_t HCEParameters::operator[](size_t index) const {
     return ((int16_t*)this)[index];
 }
 
-size_t HCEParameters::indexOf(int16_t* ptr) const {
-    return (size_t)(ptr - (int16_t*)this);
+size_t HCEParameters::indexOf(const int16_t* ptr) const {
+    return (size_t)(ptr - (const int16_t*)this);
 }
 
 bool HCEParameters::isParameterDead(size_t index) const {
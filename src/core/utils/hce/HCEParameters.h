@@ -334,7 +334,7 @@ class HCEParameters {
 
         int16_t& operator[](size_t index);
         int16_t operator[](size_t index) const;
-        size_t indexOf(int16_t* ptr) const;
+        size_t indexOf(const int16_t* ptr) const;
 
         static constexpr size_t size() { return (sizeof(HCEParameters) - sizeof(mgPSQT) - sizeof(egPSQT)) / sizeof(int16_t); }
 
@@ -351,17 +351,17 @@ class HCEParameters {
          */
         bool isOptimizable(size_t index) const;
 
-        inline int getLinearPieceValue(int piece) const { return pieceValues[piece - 1]; }
-        inline int getQuadraticPieceValue(int piece) const { return pieceValues[piece + 4]; }
+        inline const int16_t& getLinearPieceValue(int piece) const { return pieceValues[piece - 1]; }
+        inline const int16_t& getQuadraticPieceValue(int piece) const { return pieceValues[piece + 4]; }
 
-        inline int getCrossedPieceValue(int piece1, int piece2) const {
+        inline const int16_t& getCrossedPieceValue(int piece1, int piece2) const {
             int minPiece = std::min(piece1, piece2) - 1;
             int maxPiece = std::max(piece1, piece2) - 2;
 
             return pieceValues[10 + maxPiece * (maxPiece + 1) / 2 + minPiece];
         }
 
-        inline int getPieceImbalanceValue(int piece1, int piece2) const {
+        inline const int16_t& getPieceImbalanceValue(int piece1, int piece2) const {
             int minPiece = std::min(piece1, piece2) - 1;
             int maxPiece = std::max(piece1, piece2) - 2;
 
@@ -371,120 +371,138 @@ class HCEParameters {
         inline int getMGPSQT(int piece, int square) const { return mgPSQT[piece - 1][square]; }
         inline int getEGPSQT(int piece, int square) const { return egPSQT[piece - 1][square]; }
 
-        inline int getMGTempoBonus() const { return mgTempoBonus; }
-        inline int getEGTempoBonus() const { return egTempoBonus; }
+        /**
+         * @brief Gibt den gepackten Parameter zurück, aus dem der
+         * Eintrag der Positionstabelle entpackt wurde.
+         */
+        inline const int16_t& getMGPSQTParameter(int piece, int square) const {
+            if(piece == PAWN)
+                return mgPSQTPawn[square];
+
+            return mgPSQTPacked[piece - 2][(square >> 3) * 4 + (square & 4 ? (square & 7) ^ 7 : square & 7)];
+        }
+
+        inline const int16_t& getEGPSQTParameter(int piece, int square) const {
+            if(piece == PAWN)
+                return egPSQTPawn[square];
+
+            return egPSQTPacked[piece - 2][(square >> 3) * 4 + (square & 4 ? (square & 7) ^ 7 : square & 7)];
+        }
+
+        inline const int16_t& getMGTempoBonus() const { return mgTempoBonus; }
+        inline const int16_t& getEGTempoBonus() const { return egTempoBonus; }
 
-        inline int getMGAttackByMinorPieceBonus(int piece) const { return mgAttackByMinorPieceBonus[piece - 1]; }
-        inline int getMGAttackByRookBonus(int piece) const { return mgAttackByRookBonus[piece - 1]; }
-        inline int getEGAttackByMinorPieceBonus(int piece) const { return egAttackByMinorPieceBonus[piece - 1]; }
-        inline int getEGAttackByRookBonus(int piece) const { return egAttackByRookBonus[piece - 1]; }
+        inline const int16_t& getMGAttackByMinorPieceBonus(int piece) const { return mgAttackByMinorPieceBonus[piece - 1]; }
+        inline const int16_t& getMGAttackByRookBonus(int piece) const { return mgAttackByRookBonus[piece - 1]; }
+        inline const int16_t& getEGAttackByMinorPieceBonus(int piece) const { return egAttackByMinorPieceBonus[piece - 1]; }
+        inline const int16_t& getEGAttackByRookBonus(int piece) const { return egAttackByRookBonus[piece - 1]; }
 
-        inline int getMGPinnedPieceBonus() const { return mgPinnedPieceBonus; }
-        inline int getEGPinnedPieceBonus() const { return egPinnedPieceBonus; }
+        inline const int16_t& getMGPinnedPieceBonus() const { return mgPinnedPieceBonus; }
+        inline const int16_t& getEGPinnedPieceBonus() const { return egPinnedPieceBonus; }
 
-        inline int getMGSkeweredPieceBonus() const { return mgSkeweredPieceBonus; }
-        inline int getEGSkeweredPieceBonus() const { return egSkeweredPieceBonus; }
+        inline const int16_t& getMGSkeweredPieceBonus() const { return mgSkeweredPieceBonus; }
+        inline const int16_t& getEGSkeweredPieceBonus() const { return egSkeweredPieceBonus; }
 
-        inline int getMGConnectedPawnBonus(int rank) const { return mgConnectedPawnBonus[rank - 1]; }
-        inline int getEGConnectedPawnBonus(int rank) const { return egConnectedPawnBonus[rank - 1]; }
+        inline const int16_t& getMGConnectedPawnBonus(int rank) const { return mgConnectedPawnBonus[rank - 1]; }
+        inline const int16_t& getEGConnectedPawnBonus(int rank) const { return egConnectedPawnBonus[rank - 1]; }
 
-        inline int getMGDoubledPawnPenalty(int file) const { return mgDoubledPawnPenalty[file & 4 ? file ^ 7 : file]; }
-        inline int getEGDoubledPawnPenalty(int file) const { return egDoubledPawnPenalty[file & 4 ? file ^ 7 : file]; }
+        inline const int16_t& getMGDoubledPawnPenalty(int file) const { return mgDoubledPawnPenalty[file & 4 ? file ^ 7 : file]; }
+        inline const int16_t& getEGDoubledPawnPenalty(int file) const { return egDoubledPawnPenalty[file & 4 ? file ^ 7 : file]; }
 
-        inline int getMGIsolatedPawnPenalty(int file) const { return mgIsolatedPawnPenalty[file & 4 ? file ^ 7 : file]; }
-        inline int getEGIsolatedPawnPenalty(int file) const { return egIsolatedPawnPenalty[file & 4 ? file ^ 7 : file]; }
+        inline const int16_t& getMGIsolatedPawnPenalty(int file) const { return mgIsolatedPawnPenalty[file & 4 ? file ^ 7 : file]; }
+        inline const int16_t& getEGIsolatedPawnPenalty(int file) const { return egIsolatedPawnPenalty[file & 4 ? file ^ 7 : file]; }
 
-        inline int getMGBackwardPawnPenalty(int rank) const { return mgBackwardPawnPenalty[rank - 1]; }
-        inline int getEGBackwardPawnPenalty(int rank) const { return egBackwardPawnPenalty[rank - 1]; }
+        inline const int16_t& getMGBackwardPawnPenalty(int rank) const { return mgBackwardPawnPenalty[rank - 1]; }
+        inline const int16_t& getEGBackwardPawnPenalty(int rank) const { return egBackwardPawnPenalty[rank - 1]; }
 
-        inline int getMGPassedPawnBonus(int rank) const { return mgPassedPawnBonus[rank - 1]; }
-        inline int getEGPassedPawnBonus(int rank) const { return egPassedPawnBonus[rank - 1]; }
+        inline const int16_t& getMGPassedPawnBonus(int rank) const { return mgPassedPawnBonus[rank - 1]; }
+        inline const int16_t& getEGPassedPawnBonus(int rank) const { return egPassedPawnBonus[rank - 1]; }
 
-        inline int getMGCandidatePassedPawnBonus(int rank) const { return mgCandidatePassedPawnBonus[rank - 1]; }
-        inline int getEGCandidatePassedPawnBonus(int rank) const { return egCandidatePassedPawnBonus[rank - 1]; }
+        inline const int16_t& getMGCandidatePassedPawnBonus(int rank) const { return mgCandidatePassedPawnBonus[rank - 1]; }
+        inline const int16_t& getEGCandidatePassedPawnBonus(int rank) const { return egCandidatePassedPawnBonus[rank - 1]; }
 
-        inline int getMGConnectedPassedPawnBonus(int rank) const { return mgConnectedPassedPawnBonus[rank - 1]; }
-        inline int getEGConnectedPassedPawnBonus(int rank) const { return egConnectedPassedPawnBonus[rank - 1]; }
+        inline const int16_t& getMGConnectedPassedPawnBonus(int rank) const { return mgConnectedPassedPawnBonus[rank - 1]; }
+        inline const int16_t& getEGConnectedPassedPawnBonus(int rank) const { return egConnectedPassedPawnBonus[rank - 1]; }
 
-        inline int getMGCenterOutpostBonus() const { return mgCenterOutpostBonus; }
-        inline int getMGEdgeOutpostBonus() const { return mgEdgeOutpostBonus; }
+        inline const int16_t& getMGCenterOutpostBonus() const { return mgCenterOutpostBonus; }
+        inline const int16_t& getMGEdgeOutpostBonus() const { return mgEdgeOutpostBonus; }
 
-        inline int getMGAttackWeight(int piece) const { return mgAttackWeight[piece - 2]; }
-        inline int getEGAttackWeight(int piece) const { return egAttackWeight[piece - 2]; }
-        inline int getMGUndefendedAttackWeight(int piece) const { return mgUndefendedAttackWeight[piece - 2]; }
-        inline int getEGUndefendedAttackWeight(int piece) const { return egUndefendedAttackWeight[piece - 2]; }
-        inline int getMGSafeCheckWeight(int piece) const { return mgSafeCheckWeight[piece - 2]; }
-        inline int getEGSafeCheckWeight(int piece) const { return egSafeCheckWeight[piece - 2]; }
-        inline int getMGSafeContactCheckWeight(int piece) const { return mgSafeContactCheckWeight[piece - 4]; }
-        inline int getEGSafeContactCheckWeight(int piece) const { return egSafeContactCheckWeight[piece - 4]; }
-        inline int getMGSkeweredByWeight(int piece) const { return mgSkeweredByWeight[piece - 3]; }
-        inline int getEGSkeweredByWeight(int piece) const { return egSkeweredByWeight[piece - 3]; }
-        inline int getMGDefenseWeight(int piece) const { return mgDefenseWeight[piece - 2]; }
-        inline int getEGDefenseWeight(int piece) const { return egDefenseWeight[piece - 2]; }
+        inline const int16_t& getMGAttackWeight(int piece) const { return mgAttackWeight[piece - 2]; }
+        inline const int16_t& getEGAttackWeight(int piece) const { return egAttackWeight[piece - 2]; }
+        inline const int16_t& getMGUndefendedAttackWeight(int piece) const { return mgUndefendedAttackWeight[piece - 2]; }
+        inline const int16_t& getEGUndefendedAttackWeight(int piece) const { return egUndefendedAttackWeight[piece - 2]; }
+        inline const int16_t& getMGSafeCheckWeight(int piece) const { return mgSafeCheckWeight[piece - 2]; }
+        inline const int16_t& getEGSafeCheckWeight(int piece) const { return egSafeCheckWeight[piece - 2]; }
+        inline const int16_t& getMGSafeContactCheckWeight(int piece) const { return mgSafeContactCheckWeight[piece - 4]; }
+        inline const int16_t& getEGSafeContactCheckWeight(int piece) const { return egSafeContactCheckWeight[piece - 4]; }
+        inline const int16_t& getMGSkeweredByWeight(int piece) const { return mgSkeweredByWeight[piece - 3]; }
+        inline const int16_t& getEGSkeweredByWeight(int piece) const { return egSkeweredByWeight[piece - 3]; }
+        inline const int16_t& getMGDefenseWeight(int piece) const { return mgDefenseWeight[piece - 2]; }
+        inline const int16_t& getEGDefenseWeight(int piece) const { return egDefenseWeight[piece - 2]; }
 
         inline int getMGPawnShieldSizeWeight(int size) const { return size == 0 ? 0 : mgPawnShieldSizeWeight[size - 1]; }
         inline int getMGKingOpenFileWeight(int numFiles) const { return numFiles == 0 ? 0 : mgKingOpenFileWeight[numFiles - 1]; }
-        inline int getMGPawnStormWeight(int rank) const { return mgPawnStormWeight[rank - 1]; }
+        inline const int16_t& getMGPawnStormWeight(int rank) const { return mgPawnStormWeight[rank - 1]; }
 
-        inline int getMGSpaceBonus() const { return mgSpaceBonus; }
-        inline int getEGSpaceBonus() const { return egSpaceBonus; }
+        inline const int16_t& getMGSpaceBonus() const { return mgSpaceBonus; }
+        inline const int16_t& getEGSpaceBonus() const { return egSpaceBonus; }
 
-        inline int getMGPieceMobilityBonus(int piece) const { return mgPieceMobilityBonus[piece - 2]; }
-        inline int getEGPieceMobilityBonus(int piece) const { return egPieceMobilityBonus[piece - 2]; }
+        inline const int16_t& getMGPieceMobilityBonus(int piece) const { return mgPieceMobilityBonus[piece - 2]; }
+        inline const int16_t& getEGPieceMobilityBonus(int piece) const { return egPieceMobilityBonus[piece - 2]; }
 
-        inline int getMGPieceNoMobilityPenalty(int piece) const { return mgPieceNoMobilityPenalty[piece - 2]; }
-        inline int getEGPieceNoMobilityPenalty(int piece) const { return egPieceNoMobilityPenalty[piece - 2]; }
+        inline const int16_t& getMGPieceNoMobilityPenalty(int piece) const { return mgPieceNoMobilityPenalty[piece - 2]; }
+        inline const int16_t& getEGPieceNoMobilityPenalty(int piece) const { return egPieceNoMobilityPenalty[piece - 2]; }
 
-        inline int getMGKnightOnCenterOutpostBonus() const { return mgKnightOnCenterOutpostBonus; }
-        inline int getMGKnightOnEdgeOutpostBonus() const { return mgKnightOnEdgeOutpostBonus; }
-        inline int getMGBishopOnCenterOutpostBonus() const { return mgBishopOnCenterOutpostBonus; }
-        inline int getMGBishopOnEdgeOutpostBonus() const { return mgBishopOnEdgeOutpostBonus; }
+        inline const int16_t& getMGKnightOnCenterOutpostBonus() const { return mgKnightOnCenterOutpostBonus; }
+        inline const int16_t& getMGKnightOnEdgeOutpostBonus() const { return mgKnightOnEdgeOutpostBonus; }
+        inline const int16_t& getMGBishopOnCenterOutpostBonus() const { return mgBishopOnCenterOutpostBonus; }
+        inline const int16_t& getMGBishopOnEdgeOutpostBonus() const { return mgBishopOnEdgeOutpostBonus; }
 
-        inline int getMGBadBishopPenalty() const { return mgBadBishopPenalty; }
-        inline int getEGBadBishopPenalty() const { return egBadBishopPenalty; }
+        inline const int16_t& getMGBadBishopPenalty() const { return mgBadBishopPenalty; }
+        inline const int16_t& getEGBadBishopPenalty() const { return egBadBishopPenalty; }
 
-        inline int getMGBishopDominanceBonus() const { return mgBishopDominanceBonus; }
-        inline int getEGBishopDominanceBonus() const { return egBishopDominanceBonus; }
+        inline const int16_t& getMGBishopDominanceBonus() const { return mgBishopDominanceBonus; }
+        inline const int16_t& getEGBishopDominanceBonus() const { return egBishopDominanceBonus; }
 
-        inline int getMGRookOnOpenFileBonus() const { return mgRookOnOpenFileBonus; }
-        inline int getMGRookOnSemiOpenFileBonus() const { return mgRookOnSemiOpenFileBonus; }
+        inline const int16_t& getMGRookOnOpenFileBonus() const { return mgRookOnOpenFileBonus; }
+        inline const int16_t& getMGRookOnSemiOpenFileBonus() const { return mgRookOnSemiOpenFileBonus; }
 
-        inline int getMGDoubledRooksOnOpenFileBonus() const { return mgDoubledRooksOnOpenFileBonus; }
-        inline int getMGDoubledRooksOnSemiOpenFileBonus() const { return mgDoubledRooksOnSemiOpenFileBonus; }
+        inline const int16_t& getMGDoubledRooksOnOpenFileBonus() const { return mgDoubledRooksOnOpenFileBonus; }
+        inline const int16_t& getMGDoubledRooksOnSemiOpenFileBonus() const { return mgDoubledRooksOnSemiOpenFileBonus; }
 
-        inline int getEGRookBehindPassedPawnBonus() const { return egRookBehindPassedPawnBonus; }
-        inline int getEGBlockedEnemyPassedPawnBonus() const { return egBlockedEnemyPassedPawnBonus; }
+        inline const int16_t& getEGRookBehindPassedPawnBonus() const { return egRookBehindPassedPawnBonus; }
+        inline const int16_t& getEGBlockedEnemyPassedPawnBonus() const { return egBlockedEnemyPassedPawnBonus; }
 
-        inline int getEGAttackOnPassedPawnPathBonus() const { return egAttackOnPassedPawnPathBonus; }
+        inline const int16_t& getEGAttackOnPassedPawnPathBonus() const { return egAttackOnPassedPawnPathBonus; }
 
-        inline int getEGKingProximityPawnWeight() const { return egKingProximityPawnWeight; }
-        inline int getEGKingProximityBackwardPawnWeight() const { return egKingProximityBackwardPawnWeight; }
-        inline int getEGKingProximityPassedPawnWeight() const { return egKingProximityPassedPawnWeight; }
+        inline const int16_t& getEGKingProximityPawnWeight() const { return egKingProximityPawnWeight; }
+        inline const int16_t& getEGKingProximityBackwardPawnWeight() const { return egKingProximityBackwardPawnWeight; }
+        inline const int16_t& getEGKingProximityPassedPawnWeight() const { return egKingProximityPassedPawnWeight; }
 
-        inline int getRuleOfTheSquareBonus() const { return ruleOfTheSquareBonus; }
+        inline const int16_t& getRuleOfTheSquareBonus() const { return ruleOfTheSquareBonus; }
 
-        inline int getOppositeColorBishopsEndgameWinnablePenalty() const { return oppositeColorBishopsEndgameWinnablePenalty; }
+        inline const int16_t& getOppositeColorBishopsEndgameWinnablePenalty() const { return oppositeColorBishopsEndgameWinnablePenalty; }
 
-        inline int getMGOppositeColorBishopsWinnablePenalty() const { return mgOppositeColorBishopsWinnablePenalty; }
-        inline int getEGOppositeColorBishopsWinnablePenalty() const { return egOppositeColorBishopsWinnablePenalty; }
+        inline const int16_t& getMGOppositeColorBishopsWinnablePenalty() const { return mgOppositeColorBishopsWinnablePenalty; }
+        inline const int16_t& getEGOppositeColorBishopsWinnablePenalty() const { return egOppositeColorBishopsWinnablePenalty; }
 
-        inline int getRookEndgameWinnablePenalty() const { return rookEndgameWinnablePenalty; }
+        inline const int16_t& getRookEndgameWinnablePenalty() const { return rookEndgameWinnablePenalty; }
 
-        inline int getMGDefaultWinnablePenalty() const { return mgDefaultWinnablePenalty; }
-        inline int getEGDefaultWinnablePenalty() const { return egDefaultWinnablePenalty; }
+        inline const int16_t& getMGDefaultWinnablePenalty() const { return mgDefaultWinnablePenalty; }
+        inline const int16_t& getEGDefaultWinnablePenalty() const { return egDefaultWinnablePenalty; }
 
-        inline int getKingAndPawnEndgameWinnableBonus() const { return kingAndPawnEndgameWinnableBonus; }
+        inline const int16_t& getKingAndPawnEndgameWinnableBonus() const { return kingAndPawnEndgameWinnableBonus; }
 
-        inline int getMGPawnWinnableBonus() const { return mgPawnWinnableBonus; }
-        inline int getEGPawnWinnableBonus() const { return egPawnWinnableBonus; }
+        inline const int16_t& getMGPawnWinnableBonus() const { return mgPawnWinnableBonus; }
+        inline const int16_t& getEGPawnWinnableBonus() const { return egPawnWinnableBonus; }
 
-        inline int getMGPassedPawnWinnableBonus() const { return mgPassedPawnWinnableBonus; }
-        inline int getEGPassedPawnWinnableBonus() const { return egPassedPawnWinnableBonus; }
+        inline const int16_t& getMGPassedPawnWinnableBonus() const { return mgPassedPawnWinnableBonus; }
+        inline const int16_t& getEGPassedPawnWinnableBonus() const { return egPassedPawnWinnableBonus; }
 
-        inline int getKingInfiltrationWinnableBonus() const { return kingInfiltrationWinnableBonus; }
+        inline const int16_t& getKingInfiltrationWinnableBonus() const { return kingInfiltrationWinnableBonus; }
 
-        inline int getMopupBaseBonus() const { return egMopupBaseBonus; }
-        inline int getMopupProgressBonus() const { return egMopupProgressBonus; }
+        inline const int16_t& getMopupBaseBonus() const { return egMopupBaseBonus; }
+        inline const int16_t& getMopupProgressBonus() const { return egMopupProgressBonus; }
 };
 
 extern HCEParameters HCE_PARAMS;
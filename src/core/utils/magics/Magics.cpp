@@ -1,86 +1,204 @@
 #include "core/utils/magics/Magics.h"
-#include "core/utils/magics/MagicsFinder.h"
 
 #include <bit>
-#include <cstdalign>
-#include <iostream>
-
-alignas(64) uint64_t Magics::rookAttacks[102400];
-alignas(64) uint64_t Magics::bishopAttacks[5248];
-
-uint64_t Magics::rookAttackPtrs[64];
-uint64_t Magics::bishopAttackPtrs[64];
-
-uint64_t Magics::rookAttacksTopMask[64];
-uint64_t Magics::rookAttacksRightMask[64];
-uint64_t Magics::rookAttacksBottomMask[64];
-uint64_t Magics::rookAttacksLeftMask[64];
-
-uint64_t Magics::bishopAttacksTopLeftMask[64];
-uint64_t Magics::bishopAttacksTopRightMask[64];
-uint64_t Magics::bishopAttacksBottomLeftMask[64];
-uint64_t Magics::bishopAttacksBottomRightMask[64];
-
-void Magics::initializeMagics() {
-    // Fülle die Turm-Tabellen
-    uint64_t rookAttackPtr = 0;
-    for(int sq = 0; sq < 64; sq++) {
-        // Zeigertabelle
-        rookAttackPtrs[sq] = rookAttackPtr;
-
-        // Fülle die Zugtabellen
-        uint64_t occupied = MagicNumbers::rookMasks[sq];
-        int shift = MagicNumbers::rookShifts[sq];
-        uint64_t magic = MagicNumbers::rookMagics[sq];
-        int numOccupancies = 1 << std::popcount(occupied);
-        uint64_t* occupancies = new uint64_t[numOccupancies];
-        MagicsFinder::generateAllOccupancyCombinations(occupied, occupancies);
-
-        for(int i = 0; i < numOccupancies; i++) {
-            uint64_t index = (occupancies[i] * magic) >> shift;
-            rookAttacks[rookAttackPtr + index] = MagicsFinder::rookAttackMask(sq, occupancies[i]);
-        }
 
-        // Inkrementiere den Zeiger
-        rookAttackPtr += numOccupancies;
+/**
+ * Alle Tabellen werden zur Kompilierzeit berechnet. Jede Tabelle hat einen eigenen
+ * Initialisierer, damit keine einzelne Auswertung das Limit des Compilers für
+ * constexpr-Operationen (GCC: -fconstexpr-ops-limit) erreicht.
+ */
+
+namespace {
+    /**
+     * @brief Berechnet für jedes Feld alle Felder in eine Richtung bis zum Rand des Spielfelds.
+     *
+     * @param fileDelta Die Änderung der Linie pro Schritt.
+     * @param rankDelta Die Änderung der Reihe pro Schritt.
+     */
+    constexpr std::array<uint64_t, 64> generateRays(int fileDelta, int rankDelta) {
+        std::array<uint64_t, 64> rays{};
+
+        for(int sq = 0; sq < 64; sq++)
+            for(int file = sq % 8 + fileDelta, rank = sq / 8 + rankDelta;
+                file >= 0 && file < 8 && rank >= 0 && rank < 8;
+                file += fileDelta, rank += rankDelta)
+                rays[sq] |= 1ULL << (rank * 8 + file);
+
+        return rays;
+    }
+
+    constexpr std::array<uint64_t, 64> ROOK_TOP_RAYS = generateRays(0, 1);
+    constexpr std::array<uint64_t, 64> ROOK_RIGHT_RAYS = generateRays(1, 0);
+    constexpr std::array<uint64_t, 64> ROOK_BOTTOM_RAYS = generateRays(0, -1);
+    constexpr std::array<uint64_t, 64> ROOK_LEFT_RAYS = generateRays(-1, 0);
+
+    constexpr std::array<uint64_t, 64> BISHOP_TOP_LEFT_RAYS = generateRays(-1, 1);
+    constexpr std::array<uint64_t, 64> BISHOP_TOP_RIGHT_RAYS = generateRays(1, 1);
+    constexpr std::array<uint64_t, 64> BISHOP_BOTTOM_LEFT_RAYS = generateRays(-1, -1);
+    constexpr std::array<uint64_t, 64> BISHOP_BOTTOM_RIGHT_RAYS = generateRays(1, -1);
+
+    /**
+     * @brief Berechnet die Angriffe entlang einer Linie (zwei entgegengesetzte Richtungen)
+     * mit einer bestimmten Belegung. Die Felder hinter der ersten Blockade werden
+     * mit dem Strahl der Blockade entfernt.
+     *
+     * @param positiveRays Die Strahlen in die Richtung zu höheren Feldern.
+     * @param negativeRays Die Strahlen in die Richtung zu niedrigeren Feldern.
+     */
+    constexpr uint64_t lineAttacks(const std::array<uint64_t, 64>& positiveRays,
+                                   const std::array<uint64_t, 64>& negativeRays, int sq, uint64_t occupied) {
+        uint64_t attacks = positiveRays[sq] | negativeRays[sq];
+
+        if(uint64_t blockers = positiveRays[sq] & occupied)
+            attacks ^= positiveRays[__builtin_ctzll(blockers)];
+
+        if(uint64_t blockers = negativeRays[sq] & occupied)
+            attacks ^= negativeRays[63 - __builtin_clzll(blockers)];
+
+        return attacks;
+    }
+
+    /**
+     * @brief Extrahiert die Bits von x an den Stellen der Maske (wie PEXT).
+     */
+    constexpr uint64_t extractBits(uint64_t x, uint64_t mask) {
+        uint64_t result = 0ULL;
 
-        // Fülle die Richtungsmasken
-        rookAttacksTopMask[sq] = MagicsFinder::rookAttackTopMask(sq);
-        rookAttacksRightMask[sq] = MagicsFinder::rookAttackRightMask(sq);
-        rookAttacksBottomMask[sq] = MagicsFinder::rookAttackBottomMask(sq);
-        rookAttacksLeftMask[sq] = MagicsFinder::rookAttackLeftMask(sq);
+        for(uint64_t bit = 1ULL; mask; mask &= mask - 1, bit <<= 1)
+            if(x & mask & -mask)
+                result |= bit;
 
-        delete[] occupancies;
+        return result;
     }
 
-    // Fülle die Läufer-Tabellen
-    uint64_t bishopAttackPtr = 0;
-    for(int sq = 0; sq < 64; sq++) {
-        // Zeigertabelle
-        bishopAttackPtrs[sq] = bishopAttackPtr;
-
-        // Fülle die Zugtabellen
-        uint64_t occupied = MagicNumbers::bishopMasks[sq];
-        int shift = MagicNumbers::bishopShifts[sq];
-        uint64_t magic = MagicNumbers::bishopMagics[sq];
-        int numOccupancies = 1 << std::popcount(occupied);
-        uint64_t* occupancies = new uint64_t[numOccupancies];
-        MagicsFinder::generateAllOccupancyCombinations(occupied, occupancies);
-
-        for(int i = 0; i < numOccupancies; i++) {
-            uint64_t index = (occupancies[i] * magic) >> shift;
-            bishopAttacks[bishopAttackPtr + index] = MagicsFinder::bishopAttackMask(sq, occupancies[i]);
+    /**
+     * @brief Alle Belegungen einer Linie (Teil der Maske eines Feldes)
+     * mit ihren Angriffen und ihrem Anteil am PEXT-Index.
+     */
+    struct LineOccupancies {
+        uint64_t occupied[64];
+        uint64_t attacks[64];
+        uint64_t pextIndex[64];
+        int size;
+    };
+
+    constexpr LineOccupancies generateLineOccupancies(const std::array<uint64_t, 64>& positiveRays,
+                                                      const std::array<uint64_t, 64>& negativeRays,
+                                                      int sq, uint64_t mask) {
+        LineOccupancies line{};
+        uint64_t lineMask = mask & (positiveRays[sq] | negativeRays[sq]);
+        uint64_t occupied = 0ULL;
+
+        // Zähle alle Belegungen mit dem Carry-Rippler-Trick auf
+        do {
+            line.occupied[line.size] = occupied;
+            line.attacks[line.size] = lineAttacks(positiveRays, negativeRays, sq, occupied);
+            line.pextIndex[line.size] = extractBits(occupied, mask);
+            line.size++;
+
+            occupied = (occupied - lineMask) & lineMask;
+        } while(occupied);
+
+        return line;
+    }
+
+    /**
+     * @brief Berechnet die Daten aller Felder für Magic Bitboards. Die Einträge
+     * eines Feldes beginnen in beiden Backends beim selben Offset.
+     */
+    template <bool isRook>
+    constexpr std::array<MagicEntry, 64> generateMagicEntries() {
+        std::array<MagicEntry, 64> entries{};
+        uint64_t offset = 0;
+
+        for(int sq = 0; sq < 64; sq++) {
+            if constexpr(isRook)
+                entries[sq] = {MagicNumbers::rookMasks[sq], MagicNumbers::rookMagics[sq],
+                               (uint64_t)MagicNumbers::rookShifts[sq], offset};
+            else
+                entries[sq] = {MagicNumbers::bishopMasks[sq], MagicNumbers::bishopMagics[sq],
+                               (uint64_t)MagicNumbers::bishopShifts[sq], offset};
+
+            offset += 1ULL << std::popcount(entries[sq].mask);
         }
 
-        // Inkrementiere den Zeiger
-        bishopAttackPtr += numOccupancies;
+        return entries;
+    }
 
-        // Fülle die Richtungsmasken
-        bishopAttacksTopLeftMask[sq] = MagicsFinder::bishopAttackTopLeftMask(sq);
-        bishopAttacksTopRightMask[sq] = MagicsFinder::bishopAttackTopRightMask(sq);
-        bishopAttacksBottomLeftMask[sq] = MagicsFinder::bishopAttackBottomLeftMask(sq);
-        bishopAttacksBottomRightMask[sq] = MagicsFinder::bishopAttackBottomRightMask(sq);
+    template <bool isRook>
+    constexpr std::array<PextEntry, 64> generatePextEntries() {
+        std::array<PextEntry, 64> entries{};
+        std::array<MagicEntry, 64> magicEntries = generateMagicEntries<isRook>();
 
-        delete[] occupancies;
+        for(int sq = 0; sq < 64; sq++)
+            entries[sq] = {magicEntries[sq].mask, magicEntries[sq].offset};
+
+        return entries;
     }
-}
\ No newline at end of file
+
+    /**
+     * @brief Füllt eine Angriffstabelle für Magic Bitboards oder PEXT.
+     *
+     * Die Maske eines Feldes besteht aus zwei Linien (Turm: vertikal und horizontal,
+     * Läufer: beide Diagonalen), deren Angriffe unabhängig voneinander sind. Die
+     * Belegungen jeder Linie werden einzeln aufgezählt und alle Kombinationen nur
+     * noch verodert. Das hält die Anzahl der Operationen bei der Auswertung zur
+     * Kompilierzeit klein. Da PEXT linear ist, setzt sich auch der PEXT-Index
+     * aus den Indizes der beiden Linien zusammen.
+     */
+    template <bool isRook, bool pext, size_t N>
+    constexpr std::array<uint64_t, N> generateAttacks() {
+        std::array<uint64_t, N> attacks{};
+        uint64_t* data = attacks.data();
+
+        std::array<MagicEntry, 64> entries = generateMagicEntries<isRook>();
+
+        for(int sq = 0; sq < 64; sq++) {
+            MagicEntry entry = entries[sq];
+            LineOccupancies first, second;
+
+            if constexpr(isRook) {
+                first = generateLineOccupancies(ROOK_TOP_RAYS, ROOK_BOTTOM_RAYS, sq, entry.mask);
+                second = generateLineOccupancies(ROOK_RIGHT_RAYS, ROOK_LEFT_RAYS, sq, entry.mask);
+            } else {
+                first = generateLineOccupancies(BISHOP_TOP_LEFT_RAYS, BISHOP_BOTTOM_RIGHT_RAYS, sq, entry.mask);
+                second = generateLineOccupancies(BISHOP_TOP_RIGHT_RAYS, BISHOP_BOTTOM_LEFT_RAYS, sq, entry.mask);
+            }
+
+            for(int i = 0; i < first.size; i++) {
+                for(int j = 0; j < second.size; j++) {
+                    uint64_t index = pext ? entry.offset + (first.pextIndex[i] | second.pextIndex[j])
+                                          : entry.index(first.occupied[i] | second.occupied[j]);
+
+                    data[index] = first.attacks[i] | second.attacks[j];
+                }
+            }
+        }
+
+        return attacks;
+    }
+}
+
+alignas(64) constinit const std::array<uint64_t, 102400> Magics::rookAttacks = generateAttacks<true, false, 102400>();
+alignas(64) constinit const std::array<uint64_t, 5248> Magics::bishopAttacks = generateAttacks<false, false, 5248>();
+
+alignas(64) constinit const std::array<MagicEntry, 64> Magics::rookMagics = generateMagicEntries<true>();
+alignas(64) constinit const std::array<MagicEntry, 64> Magics::bishopMagics = generateMagicEntries<false>();
+
+#if defined(__BMI2__)
+    alignas(64) constinit const std::array<uint64_t, 102400> Magics::rookPextAttacks = generateAttacks<true, true, 102400>();
+    alignas(64) constinit const std::array<uint64_t, 5248> Magics::bishopPextAttacks = generateAttacks<false, true, 5248>();
+
+    alignas(64) constinit const std::array<PextEntry, 64> Magics::rookPext = generatePextEntries<true>();
+    alignas(64) constinit const std::array<PextEntry, 64> Magics::bishopPext = generatePextEntries<false>();
+#endif
+
+constinit const std::array<uint64_t, 64> Magics::rookAttacksTopMask = ROOK_TOP_RAYS;
+constinit const std::array<uint64_t, 64> Magics::rookAttacksRightMask = ROOK_RIGHT_RAYS;
+constinit const std::array<uint64_t, 64> Magics::rookAttacksBottomMask = ROOK_BOTTOM_RAYS;
+constinit const std::array<uint64_t, 64> Magics::rookAttacksLeftMask = ROOK_LEFT_RAYS;
+
+constinit const std::array<uint64_t, 64> Magics::bishopAttacksTopLeftMask = BISHOP_TOP_LEFT_RAYS;
+constinit const std::array<uint64_t, 64> Magics::bishopAttacksTopRightMask = BISHOP_TOP_RIGHT_RAYS;
+constinit const std::array<uint64_t, 64> Magics::bishopAttacksBottomLeftMask = BISHOP_BOTTOM_LEFT_RAYS;
+constinit const std::array<uint64_t, 64> Magics::bishopAttacksBottomRightMask = BISHOP_BOTTOM_RIGHT_RAYS;
\ No newline at end of file
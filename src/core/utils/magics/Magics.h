@@ -3,46 +3,126 @@
 
 #include "core/utils/magics/Precomputed.h"
 
+#include <array>
 #include <stdint.h>
 #include <stdexcept>
 
+#if defined(__BMI2__)
+    #include <immintrin.h>
+#endif
+
+/**
+ * @brief Auswahl des Backends für die Angriffe von Läufern und Türmen.
+ *
+ * Mit BMI2 wird standardmäßig PEXT verwendet, außer auf AMD-Prozessoren
+ * vor Zen 3 (und Excavator), auf denen PEXT in Mikrocode ausgeführt wird
+ * und deutlich langsamer als eine Multiplikation ist. Mit USE_PEXT bzw.
+ * NO_PEXT kann die Auswahl erzwungen werden (make SLIDERS=pext|magic).
+ */
+#if defined(__BMI2__) && !defined(NO_PEXT) && \
+    (defined(USE_PEXT) || !(defined(__znver1__) || defined(__znver2__) || defined(__bdver4__)))
+    #define MAGICS_USE_PEXT
+#endif
+
+/**
+ * @brief Die Daten eines Feldes für den Lookup mit Magic Bitboards.
+ * Alle Werte liegen in einer Cache-Line, sodass ein Lookup nur
+ * diese und den Eintrag in der Angriffstabelle lädt.
+ */
+struct alignas(32) MagicEntry {
+    uint64_t mask;
+    uint64_t magic;
+    uint64_t shift;
+    uint64_t offset;
+
+    constexpr uint64_t index(uint64_t occupied) const noexcept {
+        return offset + (((occupied & mask) * magic) >> shift);
+    }
+};
+
+static_assert(sizeof(MagicEntry) == 32);
+
+/**
+ * @brief Die Daten eines Feldes für den Lookup mit PEXT.
+ * Der Index in die Angriffstabelle ergibt sich direkt aus den Bits
+ * der Belegung, die in der Maske gesetzt sind.
+ */
+struct PextEntry {
+    uint64_t mask;
+    uint64_t offset;
+};
+
+static_assert(sizeof(PextEntry) == 16);
+
+/**
+ * @brief Die Tabellen für die Angriffe von Läufern und Türmen.
+ *
+ * Alle Tabellen werden zur Kompilierzeit berechnet (siehe Magics.cpp)
+ * und liegen im schreibgeschützten Datensegment der ausführbaren Datei.
+ * Beim Start muss also nichts initialisiert werden und mehrere Prozesse
+ * teilen sich die Seiten über den Page Cache.
+ */
 class Magics {
     private:
-        static uint64_t rookAttacks[];
-        static uint64_t bishopAttacks[];
+        static const std::array<uint64_t, 102400> rookAttacks;
+        static const std::array<uint64_t, 5248> bishopAttacks;
+
+        static const std::array<MagicEntry, 64> rookMagics;
+        static const std::array<MagicEntry, 64> bishopMagics;
 
-        static uint64_t rookAttackPtrs[];
-        static uint64_t bishopAttackPtrs[];
+        #if defined(__BMI2__)
+            static const std::array<uint64_t, 102400> rookPextAttacks;
+            static const std::array<uint64_t, 5248> bishopPextAttacks;
 
-        static uint64_t rookAttacksTopMask[];
-        static uint64_t rookAttacksRightMask[];
-        static uint64_t rookAttacksBottomMask[];
-        static uint64_t rookAttacksLeftMask[];
+            static const std::array<PextEntry, 64> rookPext;
+            static const std::array<PextEntry, 64> bishopPext;
+        #endif
 
-        static uint64_t bishopAttacksTopLeftMask[];
-        static uint64_t bishopAttacksTopRightMask[];
-        static uint64_t bishopAttacksBottomLeftMask[];
-        static uint64_t bishopAttacksBottomRightMask[];
+        static const std::array<uint64_t, 64> rookAttacksTopMask;
+        static const std::array<uint64_t, 64> rookAttacksRightMask;
+        static const std::array<uint64_t, 64> rookAttacksBottomMask;
+        static const std::array<uint64_t, 64> rookAttacksLeftMask;
+
+        static const std::array<uint64_t, 64> bishopAttacksTopLeftMask;
+        static const std::array<uint64_t, 64> bishopAttacksTopRightMask;
+        static const std::array<uint64_t, 64> bishopAttacksBottomLeftMask;
+        static const std::array<uint64_t, 64> bishopAttacksBottomRightMask;
 
     public:
-        static void initializeMagics();
+        static inline uint64_t lookupRookAttacksMagic(int sq, uint64_t occupied) noexcept {
+            return rookAttacks[rookMagics[sq].index(occupied)];
+        }
+
+        static inline uint64_t lookupBishopAttacksMagic(int sq, uint64_t occupied) noexcept {
+            return bishopAttacks[bishopMagics[sq].index(occupied)];
+        }
+
+        #if defined(__BMI2__)
+            static inline uint64_t lookupRookAttacksPext(int sq, uint64_t occupied) noexcept {
+                const PextEntry& entry = rookPext[sq];
+                return rookPextAttacks[entry.offset + _pext_u64(occupied, entry.mask)];
+            }
+
+            static inline uint64_t lookupBishopAttacksPext(int sq, uint64_t occupied) noexcept {
+                const PextEntry& entry = bishopPext[sq];
+                return bishopPextAttacks[entry.offset + _pext_u64(occupied, entry.mask)];
+            }
+        #endif
 
         static inline uint64_t lookupRookAttacks(int sq, uint64_t occupied) noexcept {
-            uint64_t ptr = rookAttackPtrs[sq];
-            occupied &= MagicNumbers::rookMasks[sq];
-            int shift = MagicNumbers::rookShifts[sq];
-            uint64_t magic = MagicNumbers::rookMagics[sq];
-            uint64_t index = (occupied * magic) >> shift;
-            return rookAttacks[ptr + index];
+            #if defined(MAGICS_USE_PEXT)
+                return lookupRookAttacksPext(sq, occupied);
+            #else
+                return lookupRookAttacksMagic(sq, occupied);
+            #endif
         }
 
         static inline uint64_t lookupBishopAttacks(int sq, uint64_t occupied) noexcept {
-            uint64_t ptr = bishopAttackPtrs[sq];
-            occupied &= MagicNumbers::bishopMasks[sq];
-            int shift = MagicNumbers::bishopShifts[sq];
-            uint64_t magic = MagicNumbers::bishopMagics[sq];
-            uint64_t index = (occupied * magic) >> shift;
-            return bishopAttacks[ptr + index];
+            #if defined(MAGICS_USE_PEXT)
+                return lookupBishopAttacksPext(sq, occupied);
+            #else
+                return lookupBishopAttacksMagic(sq, occupied);
+            #endif
         }
 
         static inline uint64_t lookupRookAttacksTop(int sq, uint64_t occupied) {
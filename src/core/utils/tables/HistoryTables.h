@@ -0,0 +1,151 @@
+#ifndef HISTORY_TABLES_H
+#define HISTORY_TABLES_H
+
+#include "core/chess/BoardDefinitions.h"
+#include "core/chess/Move.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <stdint.h>
+
+/**
+ * @brief Bündelt alle Vergangenheitsbewertungen (History Heuristics),
+ * die eine Suchinstanz für die Zugvorsortierung verwendet:
+ *
+ * - Butterfly History: [Farbe][Startfeld][Zielfeld] für ruhige Züge.
+ * - Continuation History: [vorherige Figur][vorheriges Zielfeld][Figurtyp][Zielfeld]
+ *   für ruhige Züge als Antwort auf den letzten Zug des Gegners.
+ * - Capture History: [Figur][Zielfeld][geschlagener Figurtyp] für Schlagzüge.
+ *
+ * Alle Einträge sind 16-Bit-Werte und werden mit einem Gravity-Update
+ * aktualisiert, d.h. große Werte werden beim Aktualisieren gedämpft, sodass
+ * jeder Eintrag im Intervall [-HISTORY_MAX, HISTORY_MAX] bleibt.
+ * Die Tabellen liegen zusammenhängend im Speicher (ca. 600 KB pro Suchinstanz).
+ */
+class alignas(64) HistoryTables {
+    public:
+        /**
+         * @brief Der maximale Betrag eines Eintrags.
+         */
+        static constexpr int HISTORY_MAX = 16384;
+
+    private:
+        /**
+         * @brief Die Anzahl der unterschiedlichen Figuren (Farbe und Typ).
+         */
+        static constexpr int NUM_PIECES = 12;
+
+        /**
+         * @brief Die Anzahl der unterschiedlichen Figurentypen.
+         */
+        static constexpr int NUM_PIECE_TYPES = 6;
+
+        int16_t butterfly[2][64][64];
+        int16_t continuation[NUM_PIECES][64][NUM_PIECE_TYPES][64];
+        int16_t capture[NUM_PIECES][64][NUM_PIECE_TYPES];
+
+        /**
+         * @brief Bildet eine Figur (mit Farbe) auf einen Index in [0, 12) ab.
+         */
+        static constexpr int pieceIndex(int piece) {
+            return (piece / COLOR_MASK) * NUM_PIECE_TYPES + TYPEOF(piece) - 1;
+        }
+
+        /**
+         * @brief Aktualisiert einen Eintrag so, dass er sich dem Wert
+         * HISTORY_MAX (bzw. -HISTORY_MAX) asymptotisch annähert.
+         */
+        static constexpr void applyGravity(int16_t& entry, int bonus) {
+            bonus = std::clamp(bonus, -HISTORY_MAX, HISTORY_MAX);
+            entry += bonus - entry * std::abs(bonus) / HISTORY_MAX;
+        }
+
+    public:
+        HistoryTables() {
+            clear();
+        }
+
+        /**
+         * @brief Setzt alle Einträge auf 0.
+         */
+        inline void clear() {
+            memset(butterfly, 0, sizeof(butterfly));
+            memset(continuation, 0, sizeof(continuation));
+            memset(capture, 0, sizeof(capture));
+        }
+
+        /**
+         * @brief Gibt die Vergangenheitsbewertung eines ruhigen Zuges zurück.
+         *
+         * @param side Die Farbe, die am Zug ist.
+         * @param piece Die Figur, die gezogen wird.
+         * @param move Der Zug.
+         * @param prevPiece Die Figur, die im letzten Zug gezogen wurde (oder EMPTY).
+         * @param prevDestination Das Zielfeld des letzten Zuges.
+         */
+        constexpr int getQuietScore(int side, int piece, Move move, int prevPiece, int prevDestination) const {
+            int score = butterfly[side / COLOR_MASK][move.getOrigin()][move.getDestination()];
+
+            if(prevPiece != EMPTY)
+                score += continuation[pieceIndex(prevPiece)][prevDestination][TYPEOF(piece) - 1][move.getDestination()];
+
+            return score;
+        }
+
+        /**
+         * @brief Aktualisiert die Vergangenheitsbewertung eines ruhigen Zuges.
+         *
+         * @param side Die Farbe, die am Zug ist.
+         * @param piece Die Figur, die gezogen wird.
+         * @param move Der Zug.
+         * @param prevPiece Die Figur, die im letzten Zug gezogen wurde (oder EMPTY).
+         * @param prevDestination Das Zielfeld des letzten Zuges.
+         * @param bonus Der Bonus (positiv) oder die Strafe (negativ).
+         */
+        constexpr void updateQuiet(int side, int piece, Move move, int prevPiece, int prevDestination, int bonus) {
+            applyGravity(butterfly[side / COLOR_MASK][move.getOrigin()][move.getDestination()], bonus);
+
+            if(prevPiece != EMPTY)
+                applyGravity(continuation[pieceIndex(prevPiece)][prevDestination][TYPEOF(piece) - 1][move.getDestination()], bonus);
+        }
+
+        /**
+         * @brief Gibt die Vergangenheitsbewertung eines Schlagzuges zurück.
+         *
+         * @param piece Die schlagende Figur.
+         * @param destination Das Zielfeld.
+         * @param capturedPieceType Der Typ der geschlagenen Figur.
+         */
+        constexpr int getCaptureScore(int piece, int destination, int capturedPieceType) const {
+            return capture[pieceIndex(piece)][destination][capturedPieceType - 1];
+        }
+
+        /**
+         * @brief Aktualisiert die Vergangenheitsbewertung eines Schlagzuges.
+         *
+         * @param piece Die schlagende Figur.
+         * @param destination Das Zielfeld.
+         * @param capturedPieceType Der Typ der geschlagenen Figur.
+         * @param bonus Der Bonus (positiv) oder die Strafe (negativ).
+         */
+        constexpr void updateCapture(int piece, int destination, int capturedPieceType, int bonus) {
+            applyGravity(capture[pieceIndex(piece)][destination][capturedPieceType - 1], bonus);
+        }
+
+        /**
+         * @brief Berechnet den Bonus für einen Zug, der einen Beta-Schnitt verursacht hat.
+         */
+        static constexpr int calculateBonus(int depth) {
+            return std::min(16 * depth * depth + 32 * depth, 1600);
+        }
+
+        /**
+         * @brief Berechnet die Strafe für einen Zug, der keinen Beta-Schnitt verursacht hat.
+         */
+        static constexpr int calculateMalus(int depth) {
+            return std::min(8 * depth * depth + 16 * depth, 800);
+        }
+};
+
+#endif
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "core/utils/tables/TranspositionTable.h"
+#include "core/utils/Profiler.h"
 
 #include <immintrin.h>
 #include <new>
@@ -41,6 +42,7 @@ TranspositionTable::TranspositionTable(TranspositionTable&& other) {
     entries = other.entries;
     capacity = other.capacity;
     entriesWritten.store(other.entriesWritten.load());
+    ageOffset = other.ageOffset;
 
     other.entries = nullptr;
     other.capacity = 0;
@@ -51,6 +53,7 @@ TranspositionTable& TranspositionTable::operator=(TranspositionTable&& other) {
     entries = other.entries;
     capacity = other.capacity;
     entriesWritten.store(other.entriesWritten.load());
+    ageOffset = other.ageOffset;
 
     other.entries = nullptr;
     other.capacity = 0;
@@ -60,11 +63,14 @@ TranspositionTable& TranspositionTable::operator=(TranspositionTable&& other) {
 }
 
 void TranspositionTable::put(uint64_t hash, const TranspositionTableEntry& entry) noexcept {
+    PROFILE_SCOPE(Profiler::TT_STORE);
+
     // Wir berechnen den Index des Buckets, in dem wir den Eintrag speichern wollen.
     size_t index = hash % capacity;
     
-    if(entries[index].data == 0) {
-        // Der Bucket ist leer, wir können den Eintrag einfach speichern.
+    if(entries[index].data == 0 || entries[index].data.age < ageOffset) {
+        // Der Bucket ist leer (oder enthält einen Eintrag aus einer
+        // vorherigen Generation), wir können den Eintrag einfach speichern.
 
         #if defined(__SSE4_1__)
             // Wir speichern den Eintrag mit SSE4.1.
@@ -110,6 +116,8 @@ void TranspositionTable::put(uint64_t hash, const TranspositionTableEntry& entry
 }
 
 bool TranspositionTable::probe(uint64_t hash, TranspositionTableEntry& entry) const noexcept {
+    PROFILE_SCOPE(Profiler::TT_PROBE);
+
     // Wir berechnen den Index des Buckets, in dem ein Eintrag zu dem Hashwert
     // gespeichert sein würde (wenn er existiert).
     size_t index = hash % capacity;
@@ -137,7 +145,9 @@ bool TranspositionTable::probe(uint64_t hash, TranspositionTableEntry& entry) co
     if((entryHash ^ entryData) == hash) {
         // Der Eintrag existiert und der Hashwert stimmt überein.
         entry = entryData;
-        return true;
+
+        // Einträge aus einer vorherigen Generation sind ungültig.
+        return entry.age >= ageOffset;
     }
 
     // Die Transpositionstabelle enthält keinen Eintrag für den Hashwert.
@@ -147,6 +157,21 @@ bool TranspositionTable::probe(uint64_t hash, TranspositionTableEntry& entry) co
 void TranspositionTable::clear() noexcept {
     std::fill(entries, entries + capacity, Entry{0, 0});
     entriesWritten.store(0);
+    ageOffset = 0;
+}
+
+void TranspositionTable::newGeneration(unsigned int maxAge) noexcept {
+    unsigned int newOffset = ageOffset + maxAge + 1;
+
+    // Das Alter wird in 16 Bit gespeichert. Bevor es überläuft,
+    // leeren wir die Tabelle und beginnen wieder bei 0.
+    if(newOffset + MAX_GENERATION_AGE > UINT16_MAX) {
+        clear();
+        return;
+    }
+
+    ageOffset = newOffset;
+    entriesWritten.store(0);
 }
 
 void TranspositionTable::resize(size_t capacity) {
@@ -193,6 +218,7 @@ void TranspositionTable::resize(size_t capacity) {
 
     this->capacity = capacity;
     entriesWritten.store(0);
+    ageOffset = 0;
 
     // Wir initialisieren die Tabelle mit leeren Einträgen,
     // sodass wir später feststellen können, ob ein Eintrag
@@ -99,6 +99,19 @@ class TranspositionTable {
         Entry* entries;
         size_t capacity;
         AtomicSize entriesWritten;
+
+        /**
+         * @brief Wird auf das Alter aller neuen Einträge addiert. Einträge mit
+         * einem kleineren Alter stammen aus einer vorherigen Partie und werden
+         * wie leere Einträge behandelt (siehe newGeneration).
+         */
+        uint16_t ageOffset = 0;
+
+        /**
+         * @brief Der Abstand zur oberen Grenze des Alters, der nach einem
+         * Aufruf von newGeneration mindestens frei bleiben muss.
+         */
+        static constexpr unsigned int MAX_GENERATION_AGE = 4096;
     
     public:
         /**
@@ -125,6 +138,10 @@ class TranspositionTable {
             return std::min(entriesWritten.load(), capacity);
         }
 
+        constexpr unsigned int getAgeOffset() const noexcept {
+            return ageOffset;
+        }
+
         /**
          * @brief Speichert einen Eintrag in der Transpositionstabelle,
          * wenn der zugehörige Bucket leer ist oder der Eintrag nach dem
@@ -156,6 +173,20 @@ class TranspositionTable {
          */
         void clear() noexcept;
 
+        /**
+         * @brief Macht alle bisherigen Einträge ungültig, ohne den Speicher
+         * der Tabelle neu zu beschreiben. Dafür wird das Alter aller neuen Einträge
+         * über das Alter aller bisherigen Einträge angehoben. Erst wenn das Alter
+         * überlaufen würde, wird die Tabelle tatsächlich geleert.
+         * 
+         * @param maxAge Das höchste Alter (ohne Versatz), das seit dem
+         * letzten Aufruf in die Tabelle geschrieben wurde.
+         * 
+         * @note Diese Methode ist nicht thread-sicher und sollte nie während
+         * einer laufenden Suche aufgerufen werden.
+         */
+        void newGeneration(unsigned int maxAge) noexcept;
+
         /**
          * @brief Ändert die Kapazität der Transpositionstabelle.
          * 
@@ -2,7 +2,6 @@
 #include "emscripten/WebAPI.h"
 
 #include "core/chess/Referee.h"
-#include "core/utils/magics/Magics.h"
 
 #include "core/engine/MinimaxEngine.h"
 #include "core/engine/StaticEvaluator.h"
@@ -11,10 +10,9 @@
 
 #include <memory>
 
-// Initialisiere die Magic Bitboards
+// Die Tabellen der Magic Bitboards werden zur Kompilierzeit berechnet,
+// es muss also nichts initialisiert werden
 int main() {
-    Magics::initializeMagics();
-
     return 0;
 }
 
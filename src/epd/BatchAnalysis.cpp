@@ -0,0 +1,308 @@
+#include "epd/BatchAnalysis.h"
+#include "epd/EPD.h"
+
+#include "core/engine/evaluation/HandcraftedEvaluator.h"
+#include "core/engine/evaluation/NNUEEvaluator.h"
+#include "core/engine/search/PVSEngine.h"
+#include "core/utils/MoveNotations.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+    struct BatchPosition {
+        size_t line;
+        EPDEntry entry;
+    };
+
+    struct BatchResult {
+        bool valid = false;
+        std::string error;
+
+        PackedBoard board;
+        std::string fen;
+        int staticEvaluation = 0;
+        int score = 0;
+        Move bestMove;
+        int depth = 0;
+        uint64_t nodes = 0;
+        bool scored = false;
+        bool solved = false;
+    };
+
+    struct BatchWorker {
+        Board board;
+        PVSEngine engine;
+
+        BatchWorker() : engine(board, 2, nullptr, false) {}
+
+        void analyse(const BatchConfig& config, const EPDEntry& entry, BatchResult& result);
+    };
+
+    /**
+     * @brief Sucht einen Zug einer bm- oder am-Operation. Neben der
+     * Standard-Algebraischen Notation wird auch die UCI-Notation akzeptiert.
+     */
+    Move findOperandMove(const std::string& str, Board& board) {
+        Move move = fromStandardAlgebraicNotation(str, board);
+        return move.exists() ? move : fromUCINotation(str, board);
+    }
+
+    void BatchWorker::analyse(const BatchConfig& config, const EPDEntry& entry, BatchResult& result) {
+        try {
+            board = Board(entry.fen);
+        } catch(std::exception& e) {
+            result.error = e.what();
+            return;
+        }
+
+        result.valid = true;
+        result.board = board.toPackedBoard();
+        result.fen = board.toFEN();
+
+        {
+            #if defined(USE_HCE)
+                HandcraftedEvaluator evaluator(board);
+            #else
+                NNUEEvaluator evaluator(board);
+            #endif
+
+            result.staticEvaluation = evaluator.evaluate();
+        }
+
+        Array<Move, 256> legalMoves;
+        board.generateLegalMoves(legalMoves);
+
+        if(legalMoves.size() == 0)
+            result.score = board.isCheck() ? -MATE_SCORE : 0;
+        else if(config.depth > 0 || config.nodes > 0) {
+            UCI::SearchParams params;
+            if(config.depth > 0)
+                params.depth = config.depth;
+
+            if(config.nodes > 0)
+                params.nodes = config.nodes;
+
+            engine.newGame();
+            engine.search(params);
+
+            result.score = engine.getBestMoveScore();
+            result.bestMove = engine.getBestMove();
+            result.depth = engine.getMaxDepthReached();
+            result.nodes = engine.getNodesSearched();
+        }
+
+        // Ohne Suche (oder ohne legale Züge) gibt es keinen Zug, der bewertet werden kann
+        if(!result.bestMove.exists() || (entry.bestMoves.empty() && entry.avoidMoves.empty()))
+            return;
+
+        result.scored = true;
+
+        bool isBestMove = entry.bestMoves.empty();
+        for(const std::string& str : entry.bestMoves)
+            isBestMove |= findOperandMove(str, board) == result.bestMove;
+
+        bool isAvoidMove = false;
+        for(const std::string& str : entry.avoidMoves)
+            isAvoidMove |= findOperandMove(str, board) == result.bestMove;
+
+        result.solved = isBestMove && !isAvoidMove;
+    }
+
+    /**
+     * @brief Setzt einen Wert für eine CSV-Spalte in Anführungszeichen, falls nötig.
+     */
+    std::string escapeCSV(const std::string& str) {
+        if(str.find_first_of(",\"\n") == std::string::npos)
+            return str;
+
+        std::string result = "\"";
+        for(char c : str) {
+            if(c == '"')
+                result += '"';
+
+            result += c;
+        }
+
+        return result + "\"";
+    }
+
+    void writeCSV(std::ostream& os, const BatchPosition& position, const BatchResult& result) {
+        os << position.line << "," << escapeCSV(position.entry.id) << "," << result.fen << "," << result.staticEvaluation << ",";
+
+        if(isMateScore(result.score))
+            os << "," << (result.score > 0 ? isMateIn(result.score) : -isMateIn(result.score));
+        else
+            os << result.score << ",";
+
+        os << "," << result.depth << "," << result.nodes << "," <<
+              (result.bestMove.exists() ? result.bestMove.toString() : "0000") << ",";
+
+        if(result.scored)
+            os << (result.solved ? 1 : 0);
+
+        os << "\n";
+    }
+
+    void writeBinary(std::ostream& os, const BatchResult& result) {
+        BatchRecord record{};
+        record.board = result.board;
+        record.flags = (result.scored ? BatchRecord::SCORED : 0) | (result.solved ? BatchRecord::SOLVED : 0);
+        record.staticEvaluation = result.staticEvaluation;
+        record.score = result.score;
+        record.bestMove = result.bestMove.getMove();
+        record.depth = std::min(result.depth, 255);
+        record.nodes = std::min(result.nodes, (uint64_t)UINT32_MAX);
+
+        os.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    }
+}
+
+BatchSummary runBatchAnalysis(const BatchConfig& config) {
+    BatchSummary summary;
+
+    std::ifstream input(config.inputPath);
+    if(!input.is_open()) {
+        std::cerr << "Could not open " << config.inputPath << std::endl;
+        return summary;
+    }
+
+    std::ofstream output(config.outputPath, config.binary ? std::ios::binary : std::ios::out);
+    if(!output.is_open()) {
+        std::cerr << "Could not open " << config.outputPath << std::endl;
+        return summary;
+    }
+
+    if(config.binary) {
+        BatchRecordHeader header{};
+        std::memcpy(header.magic, BatchRecordHeader::MAGIC, sizeof(header.magic));
+        header.version = BatchRecordHeader::VERSION;
+        header.recordSize = sizeof(BatchRecord);
+
+        output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    } else
+        output << "line,id,fen,eval,score,mate,depth,nodes,bestmove,solved\n";
+
+    size_t numThreads = std::max(config.numThreads, (size_t)1);
+    size_t chunkSize = std::max(config.chunkSize, (size_t)1);
+
+    std::vector<std::unique_ptr<BatchWorker>> workers;
+    for(size_t i = 0; i < numThreads; i++) {
+        workers.push_back(std::make_unique<BatchWorker>());
+        workers.back()->engine.setNumThreads(1);
+        workers.back()->engine.setMultiPV(1);
+        workers.back()->engine.setHashTableCapacity(config.hashSize * (1 << 20) / TT_ENTRY_SIZE);
+    }
+
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+    std::vector<BatchPosition> positions;
+    std::vector<BatchResult> results;
+    positions.reserve(chunkSize);
+
+    std::string line;
+    size_t lineNumber = 0;
+    bool endOfInput = false;
+
+    while(!endOfInput) {
+        // Lies den nächsten Block
+        positions.clear();
+        while(positions.size() < chunkSize) {
+            if(!std::getline(input, line)) {
+                endOfInput = true;
+                break;
+            }
+
+            lineNumber++;
+
+            BatchPosition position;
+            position.line = lineNumber;
+            if(parseEPDLine(line, position.entry))
+                positions.push_back(std::move(position));
+        }
+
+        if(positions.empty())
+            break;
+
+        // Verteile die Positionen auf die Threads
+        results.assign(positions.size(), BatchResult());
+        Atomic<size_t> nextIndex = 0;
+
+        auto workerFunc = [&](BatchWorker& worker) {
+            size_t index;
+            while((index = nextIndex.fetch_add(1)) < positions.size())
+                worker.analyse(config, positions[index].entry, results[index]);
+        };
+
+        std::vector<std::thread> threads;
+        for(size_t i = 1; i < std::min(numThreads, positions.size()); i++)
+            threads.emplace_back(workerFunc, std::ref(*workers[i]));
+
+        workerFunc(*workers[0]);
+
+        for(std::thread& thread : threads)
+            thread.join();
+
+        // Schreibe die Ergebnisse in der Reihenfolge der Eingabe
+        for(size_t i = 0; i < positions.size(); i++) {
+            const BatchResult& result = results[i];
+
+            if(!result.valid) {
+                std::cerr << "Line " << positions[i].line << ": " << result.error << std::endl;
+                summary.numInvalid++;
+                continue;
+            }
+
+            summary.numPositions++;
+            summary.nodes += result.nodes;
+            summary.numScored += result.scored;
+            summary.numSolved += result.solved;
+
+            if(config.binary)
+                writeBinary(output, result);
+            else
+                writeCSV(output, positions[i], result);
+        }
+    }
+
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    summary.time = std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count();
+
+    return summary;
+}
+
+void printBatchResults(const BatchConfig& config) {
+    std::cout << "Analysing " << config.inputPath << " with ";
+
+    if(config.depth > 0 || config.nodes > 0) {
+        if(config.depth > 0)
+            std::cout << "depth " << config.depth << ", ";
+
+        if(config.nodes > 0)
+            std::cout << config.nodes << " nodes, ";
+    } else
+        std::cout << "static evaluation only, ";
+
+    std::cout << config.numThreads << " thread(s) and " << config.hashSize << "MB hash per thread" << std::endl;
+
+    BatchSummary summary = runBatchAnalysis(config);
+    int64_t time = std::max(summary.time, (int64_t)1);
+
+    std::cout << "\nPositions: " << summary.numPositions << "\n" <<
+                 "Invalid: " << summary.numInvalid << "\n" <<
+                 "Nodes: " << summary.nodes << "\n" <<
+                 "Time: " << summary.time << "ms\n" <<
+                 "Positions/s: " << summary.numPositions * 1000 / time << "\n" <<
+                 "NPS: " << summary.nodes * 1000 / time << std::endl;
+
+    if(summary.numScored > 0)
+        std::cout << "Solved: " << summary.numSolved << "/" << summary.numScored << std::endl;
+
+    std::cout << "Results written to " << config.outputPath << std::endl;
+}
\ No newline at end of file
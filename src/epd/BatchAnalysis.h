@@ -0,0 +1,135 @@
+#ifndef BATCH_ANALYSIS_H
+#define BATCH_ANALYSIS_H
+
+#include "core/chess/PackedBoard.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <type_traits>
+
+/**
+ * @brief Die Einstellungen einer Stapelanalyse.
+ */
+struct BatchConfig {
+    std::string inputPath;
+    std::string outputPath;
+
+    /**
+     * @brief Bestimmt, ob die Ergebnisse binär (siehe BatchRecord)
+     * statt als CSV geschrieben werden.
+     */
+    bool binary = false;
+
+    /**
+     * @brief Die Grenzen der Suche. Sind beide 0, wird nur
+     * die statische Bewertung berechnet.
+     */
+    int depth = 8;
+    uint64_t nodes = 0;
+
+    size_t numThreads = 1;
+
+    /**
+     * @brief Die Größe der Transpositionstabelle pro Thread in MB.
+     */
+    size_t hashSize = 16;
+
+    /**
+     * @brief Die Anzahl der Positionen, die gemeinsam eingelesen,
+     * auf die Threads verteilt und danach geschrieben werden.
+     */
+    size_t chunkSize = 4096;
+};
+
+/**
+ * @brief Die Zusammenfassung einer Stapelanalyse.
+ */
+struct BatchSummary {
+    size_t numPositions = 0;
+    size_t numInvalid = 0;
+
+    /**
+     * @brief Die Anzahl der durchsuchten Positionen mit bm- oder
+     * am-Operation und wie viele davon gelöst wurden.
+     */
+    size_t numScored = 0;
+    size_t numSolved = 0;
+
+    uint64_t nodes = 0;
+    int64_t time = 0;
+};
+
+/**
+ * @brief Der Kopf einer binären Ergebnisdatei. Auf den Kopf folgen
+ * die Ergebnisse ohne Zwischenraum im Format von BatchRecord.
+ */
+struct BatchRecordHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t recordSize;
+    uint32_t reserved;
+
+    static constexpr char MAGIC[4] = {'C', 'E', 'B', 'A'};
+    static constexpr uint32_t VERSION = 1;
+};
+
+static_assert(sizeof(BatchRecordHeader) == 16);
+
+/**
+ * @brief Das binäre Ergebnis einer Position. Alle Bewertungen
+ * sind aus der Sicht der Seite am Zug.
+ */
+struct BatchRecord {
+    /**
+     * @brief Die Position hat eine bm- oder am-Operation und
+     * die Suche hat einen Zug gefunden.
+     */
+    static constexpr uint8_t SCORED = 1;
+
+    /**
+     * @brief Der beste Zug der Suche erfüllt die bm- und am-Operationen.
+     */
+    static constexpr uint8_t SOLVED = 2;
+
+    PackedBoard board;
+    uint8_t flags;
+    int16_t staticEvaluation;
+
+    /**
+     * @brief Die Bewertung der Suche. Mattbewertungen
+     * sind wie in der Suche kodiert (siehe MATE_SCORE).
+     */
+    int16_t score;
+    uint16_t bestMove;
+    uint8_t depth;
+    uint8_t reserved;
+    uint32_t nodes;
+};
+
+static_assert(sizeof(BatchRecord) == 40);
+static_assert(std::is_trivially_copyable_v<BatchRecord>);
+
+/**
+ * @brief Liest eine EPD- oder FEN-Datei blockweise ein und verteilt die
+ * Positionen auf einen Pool von Threads. Jeder Thread besitzt eine eigene
+ * Engine mit einem Suchthread. Für jede Position werden die statische
+ * Bewertung und eine Suche mit fester Tiefe bzw. Knotenanzahl berechnet und
+ * der beste Zug mit den bm- und am-Operationen verglichen. Die Ergebnisse
+ * werden in der Reihenfolge der Eingabe geschrieben, vor jeder Position
+ * wird die Engine auf eine neue Partie vorbereitet.
+ *
+ * CSV-Spalten: line,id,fen,eval,score,mate,depth,nodes,bestmove,solved
+ * (score ist bei Mattbewertungen leer, mate sonst; solved ist ohne bm/am
+ * oder ohne Suche leer).
+ */
+BatchSummary runBatchAnalysis(const BatchConfig& config);
+
+/**
+ * @brief Führt die Stapelanalyse aus und gibt die Anzahl der Positionen,
+ * die Zeit, die Positionen und Knoten pro Sekunde sowie die Anzahl der
+ * gelösten Positionen aus.
+ */
+void printBatchResults(const BatchConfig& config);
+
+#endif
\ No newline at end of file
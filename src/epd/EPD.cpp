@@ -0,0 +1,113 @@
+#include "epd/EPD.h"
+
+#include <cctype>
+#include <sstream>
+
+namespace {
+    bool isNumber(const std::string& str) {
+        if(str.empty())
+            return false;
+
+        for(char c : str)
+            if(!std::isdigit((unsigned char)c))
+                return false;
+
+        return true;
+    }
+
+    /**
+     * @brief Liest die Operanden einer Operation. Operanden in
+     * Anführungszeichen dürfen Leerzeichen enthalten.
+     */
+    std::vector<std::string> splitOperands(std::string_view str) {
+        std::vector<std::string> operands;
+        size_t i = 0;
+
+        while(i < str.size()) {
+            if(std::isspace((unsigned char)str[i])) {
+                i++;
+                continue;
+            }
+
+            if(str[i] == '"') {
+                size_t end = str.find('"', i + 1);
+                if(end == std::string_view::npos)
+                    end = str.size();
+
+                operands.emplace_back(str.substr(i + 1, end - i - 1));
+                i = end + 1;
+            } else {
+                size_t end = i;
+                while(end < str.size() && !std::isspace((unsigned char)str[end]))
+                    end++;
+
+                operands.emplace_back(str.substr(i, end - i));
+                i = end;
+            }
+        }
+
+        return operands;
+    }
+}
+
+bool parseEPDLine(std::string_view line, EPDEntry& entry) {
+    entry = EPDEntry();
+
+    size_t begin = line.find_first_not_of(" \t\r");
+    if(begin == std::string_view::npos || line[begin] == '#')
+        return false;
+
+    line.remove_prefix(begin);
+
+    // Die ersten vier Felder beschreiben die Position
+    std::string fields[4];
+    size_t pos = 0;
+    for(std::string& field : fields) {
+        pos = line.find_first_not_of(" \t\r", pos);
+        if(pos == std::string_view::npos)
+            return false;
+
+        size_t end = std::min(line.find_first_of(" \t\r", pos), line.size());
+        field = line.substr(pos, end - pos);
+        pos = end;
+    }
+
+    entry.fen = fields[0] + " " + fields[1] + " " + fields[2] + " " + fields[3];
+
+    std::string_view operations = pos < line.size() ? line.substr(pos) : std::string_view();
+
+    // FEN-Zeilen enthalten noch die beiden Zähler
+    std::istringstream ss{std::string(operations)};
+    std::string halfmoveClock, fullmoveNumber;
+    if(ss >> halfmoveClock >> fullmoveNumber && isNumber(halfmoveClock) && isNumber(fullmoveNumber)) {
+        entry.fen += " " + halfmoveClock + " " + fullmoveNumber;
+        operations.remove_prefix(std::min((size_t)ss.tellg(), operations.size()));
+    }
+
+    // Operationen sind durch Semikolons getrennt, die nicht in Anführungszeichen stehen
+    size_t start = 0;
+    bool quoted = false;
+    for(size_t i = 0; i <= operations.size(); i++) {
+        if(i < operations.size() && operations[i] == '"')
+            quoted = !quoted;
+
+        if(i < operations.size() && (quoted || operations[i] != ';'))
+            continue;
+
+        std::vector<std::string> tokens = splitOperands(operations.substr(start, i - start));
+        start = i + 1;
+
+        if(tokens.empty())
+            continue;
+
+        const std::string& opcode = tokens[0];
+        if(opcode == "id" && tokens.size() > 1)
+            entry.id = tokens[1];
+        else if(opcode == "bm")
+            entry.bestMoves.assign(tokens.begin() + 1, tokens.end());
+        else if(opcode == "am")
+            entry.avoidMoves.assign(tokens.begin() + 1, tokens.end());
+    }
+
+    return true;
+}
\ No newline at end of file
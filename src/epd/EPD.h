@@ -0,0 +1,43 @@
+#ifndef EPD_H
+#define EPD_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Eine Position aus einer EPD- oder FEN-Datei.
+ */
+struct EPDEntry {
+    /**
+     * @brief Die Position als FEN-String. Bei EPD-Zeilen fehlen
+     * die Zähler für die 50-Züge-Regel und die Zugnummer.
+     */
+    std::string fen;
+
+    /**
+     * @brief Der Wert der Operation id (leer, falls nicht vorhanden).
+     */
+    std::string id;
+
+    /**
+     * @brief Die Züge der Operationen bm (beste Züge) und am (zu vermeidende
+     * Züge) in Standard-Algebraischer Notation.
+     */
+    std::vector<std::string> bestMoves;
+    std::vector<std::string> avoidMoves;
+};
+
+/**
+ * @brief Liest eine Zeile im EPD-Format
+ * (<Figuren> <Seite> <Rochaderechte> <En-Passant> {<Operation> <Operanden>;})
+ * oder im FEN-Format. Unbekannte Operationen werden ignoriert.
+ *
+ * @param line Die Zeile.
+ * @param entry Wird mit der gelesenen Position überschrieben.
+ * @return false, wenn die Zeile leer oder ein Kommentar (#) ist
+ * oder weniger als vier Felder enthält.
+ */
+bool parseEPDLine(std::string_view line, EPDEntry& entry);
+
+#endif
\ No newline at end of file
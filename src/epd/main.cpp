@@ -0,0 +1,67 @@
+#include "epd/BatchAnalysis.h"
+#include "uci/Options.h"
+
+#include <iostream>
+#include <string>
+#include <thread>
+
+int main(int argc, char* argv[]) {
+    if(argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <input> [output <path>] [format csv|bin] [depth <n>] "
+                     "[nodes <n>] [threads <n>] [hash <MB>] [chunk <n>]" << std::endl;
+        return 1;
+    }
+
+    // Die Threads werden pro Engine gesetzt
+    UCI::options["Threads"] = 1;
+
+    BatchConfig config;
+    config.inputPath = argv[1];
+    config.numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    for(int i = 2; i < argc; i += 2) {
+        std::string key = argv[i];
+        if(i + 1 >= argc) {
+            std::cerr << "Missing value for option " << key << std::endl;
+            return 1;
+        }
+
+        std::string value = argv[i + 1];
+
+        try {
+            if(key == "output")
+                config.outputPath = value;
+            else if(key == "format") {
+                if(value != "csv" && value != "bin") {
+                    std::cerr << "Invalid format " << value << " (expected csv or bin)" << std::endl;
+                    return 1;
+                }
+
+                config.binary = value == "bin";
+            } else if(key == "depth")
+                config.depth = std::stoi(value);
+            else if(key == "nodes")
+                config.nodes = std::stoull(value);
+            else if(key == "threads")
+                config.numThreads = std::stoull(value);
+            else if(key == "hash")
+                config.hashSize = std::stoull(value);
+            else if(key == "chunk")
+                config.chunkSize = std::stoull(value);
+            else {
+                std::cerr << "Unknown option " << key << std::endl;
+                return 1;
+            }
+        } catch(std::exception&) {
+            std::cerr << "Invalid value " << value << " for option " << key << std::endl;
+            return 1;
+        }
+    }
+
+    if(config.outputPath.empty())
+        config.outputPath = config.inputPath + (config.binary ? ".bin" : ".csv");
+
+    printBatchResults(config);
+
+    return 0;
+}
\ No newline at end of file
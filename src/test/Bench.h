@@ -0,0 +1,43 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "core/engine/search/SearchStatistics.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Die Ergebnisse eines Benchmarks.
+ */
+struct BenchResult {
+    size_t numPositions = 0;
+    uint64_t nodes = 0;
+    int64_t time = 0;
+
+    #if defined(SEARCH_STATS)
+    SearchStatistics statistics;
+    #endif
+};
+
+/**
+ * @brief Durchsucht eine feste Menge an Positionen bis zu einer festen Tiefe.
+ * Vor jeder Position wird die Engine auf eine neue Partie vorbereitet.
+ * Mit einem Thread ist die Anzahl der Knoten deterministisch und
+ * dient als Signatur der Suche (z.B. für Regressionstests).
+ *
+ * @param depth Die Suchtiefe.
+ * @param numThreads Die Anzahl der Threads.
+ * @param hashSize Die Größe der Transpositionstabelle in MB.
+ */
+BenchResult runBench(int depth, size_t numThreads, size_t hashSize);
+
+/**
+ * @brief Führt den Benchmark aus und gibt die Anzahl der
+ * Knoten pro Position sowie die Gesamtanzahl, die Zeit und
+ * die Knoten pro Sekunde aus. Mit SEARCH_STATS werden zusätzlich
+ * die Statistiken aller Suchen und mit USE_PROFILER die Messungen
+ * des Profilers ausgegeben.
+ */
+void printBenchResults(int depth, size_t numThreads, size_t hashSize);
+
+#endif
\ No newline at end of file
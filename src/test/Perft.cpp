@@ -85,7 +85,7 @@ void printPerftResults(Board& board, int depth) {
             }
         } else {
             std::vector<std::thread> threads;
-            std::vector<std::tuple<Move, std::vector<Board>>> work(moves.size());
+            std::vector<std::tuple<Move, std::vector<BoardState>>> work(moves.size());
             std::vector<std::atomic_size_t> workProgress(moves.size());
             std::vector<std::atomic_uint64_t> nodes(moves.size());
 
@@ -109,10 +109,12 @@ void printPerftResults(Board& board, int depth) {
             // Die Entpacktiefe darf nicht größer als die Suchtiefe sein
             unpackingDepth = std::min(unpackingDepth, (size_t)depth - 1);
 
-            const std::function<void(Board&, size_t, std::vector<Board>&)> unpackBoards =
-                [&unpackBoards](Board& root, size_t depth, std::vector<Board>& boards) {
+            // Die entpackten Positionen werden ohne Zughistorie gespeichert,
+            // sodass das Kopieren einem memcpy entspricht
+            const std::function<void(Board&, size_t, std::vector<BoardState>&)> unpackBoards =
+                [&unpackBoards](Board& root, size_t depth, std::vector<BoardState>& boards) {
                 if(depth == 0) {
-                    boards.push_back(root);
+                    boards.push_back(root.getState());
                     return;
                 }
 
@@ -141,6 +143,10 @@ void printPerftResults(Board& board, int depth) {
 
             for(size_t i = 0; i < numThreads; i++) {
                 threads.push_back(std::thread([&]() {
+                    // Jeder Thread legt die Zughistorie seiner Positionen
+                    // in einem eigenen Speicherbereich auf dem Stack ab
+                    MoveHistoryEntry historyArena[64];
+
                     do {
                         workMutex.lock();
                         size_t localMoveIndex = moveIndex;
@@ -156,7 +162,7 @@ void printPerftResults(Board& board, int depth) {
                         }
                         workMutex.unlock();
 
-                        Board& board = std::get<1>(work[localMoveIndex])[localBoardIndex];
+                        Board board(std::get<1>(work[localMoveIndex])[localBoardIndex], historyArena, 64);
 
                         uint64_t count = perft(board, depth - unpackingDepth - 1);
                         nodes[localMoveIndex].fetch_add(count);
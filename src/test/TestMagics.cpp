@@ -5,7 +5,9 @@
 #include "core/utils/magics/Magics.h"
 #include "core/utils/magics/MagicsFinder.h"
 
+#include <chrono>
 #include <iostream>
+#include <vector>
 
 bool testRookMagic(int sq) {
     uint64_t occupied = MagicNumbers::rookMasks[sq];
@@ -15,7 +17,13 @@ bool testRookMagic(int sq) {
 
     for(int i = 0; i < numOccupancies; i++) {
         Bitboard expected = MagicsFinder::rookAttackMask(sq, occupancies[i]);
-        Bitboard actual = Magics::lookupRookAttacks(sq, occupancies[i]);
+        Bitboard actual = Magics::lookupRookAttacksMagic(sq, occupancies[i]);
+
+        #if defined(__BMI2__)
+            // Ist das Ergebnis der Magics korrekt, wird zusätzlich PEXT geprüft
+            if(expected == actual)
+                actual = Magics::lookupRookAttacksPext(sq, occupancies[i]);
+        #endif
 
         if(expected != actual) {
             std::cout << "Rook magic test failed for square " << sq << std::endl;
@@ -40,7 +48,13 @@ bool testBishopMagic(int sq) {
 
     for(int i = 0; i < numOccupancies; i++) {
         Bitboard expected = MagicsFinder::bishopAttackMask(sq, occupancies[i]);
-        Bitboard actual = Magics::lookupBishopAttacks(sq, occupancies[i]);
+        Bitboard actual = Magics::lookupBishopAttacksMagic(sq, occupancies[i]);
+
+        #if defined(__BMI2__)
+            // Ist das Ergebnis der Magics korrekt, wird zusätzlich PEXT geprüft
+            if(expected == actual)
+                actual = Magics::lookupBishopAttacksPext(sq, occupancies[i]);
+        #endif
 
         if(expected != actual) {
             std::cout << "Bishop magic test failed for square " << sq << std::endl;
@@ -81,4 +95,68 @@ void testAllBishopMagics() {
     }
 
     std::cout << "Bishop magic test passed!" << std::endl;
+}
+
+volatile uint64_t lookupSink;
+
+/**
+ * @brief Misst die Zeit für count Lookups über alle Stichproben. Im Latenz-Modus
+ * hängt jede Belegung vom Ergebnis des vorherigen Lookups ab, sodass die
+ * Lookups nicht überlappen können (wie bei aufeinanderfolgenden Angriffen
+ * in SEE oder bei Fesselungen). Die Anzahl der Stichproben muss eine Zweierpotenz sein.
+ */
+template <typename F>
+double measureLookups(const std::vector<std::pair<int, uint64_t>>& samples, size_t count, bool latency, F&& lookup) {
+    uint64_t sum = 0;
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    for(size_t i = 0; i < count; i++) {
+        const auto& [sq, occupied] = samples[i & (samples.size() - 1)];
+        uint64_t result = lookup(sq, latency ? occupied ^ (sum & 1) : occupied);
+        sum += result;
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+
+    // Verhindere, dass der Compiler die Schleife entfernt
+    lookupSink = sum;
+
+    return std::chrono::duration<double, std::nano>(end - start).count() / count;
+}
+
+void benchmarkSliderLookups(size_t count) {
+    std::vector<std::pair<int, uint64_t>> samples;
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+
+    // Zufällige Belegungen mit etwa einem Drittel besetzter Felder
+    for(int i = 0; i < (1 << 16); i++) {
+        uint64_t occupied = ~0ULL;
+        for(int j = 0; j < 2; j++) {
+            state ^= state << 13; state ^= state >> 7; state ^= state << 17;
+            occupied &= state;
+        }
+
+        samples.push_back({i % 64, occupied | state >> 60});
+    }
+
+    #if defined(MAGICS_USE_PEXT)
+        std::cout << "Selected backend: pext" << std::endl;
+    #else
+        std::cout << "Selected backend: magic" << std::endl;
+    #endif
+
+    for(bool latency : {false, true}) {
+        const char* mode = latency ? "latency" : "throughput";
+
+        double rookMagic = measureLookups(samples, count, latency, Magics::lookupRookAttacksMagic);
+        double bishopMagic = measureLookups(samples, count, latency, Magics::lookupBishopAttacksMagic);
+        std::cout << "magic " << mode << ": rook " << rookMagic << " ns, bishop " << bishopMagic << " ns" << std::endl;
+
+        #if defined(__BMI2__)
+            double rookPext = measureLookups(samples, count, latency, Magics::lookupRookAttacksPext);
+            double bishopPext = measureLookups(samples, count, latency, Magics::lookupBishopAttacksPext);
+            std::cout << "pext  " << mode << ": rook " << rookPext << " ns, bishop " << bishopPext << " ns" << std::endl;
+        #endif
+    }
 }
\ No newline at end of file
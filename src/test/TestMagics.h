@@ -1,6 +1,7 @@
 #ifndef TEST_MAGICS_H
 #define TEST_MAGICS_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 bool testRookMagic(int sq);
@@ -9,4 +10,13 @@ bool testBishopMagic(int sq);
 void testAllRookMagics();
 void testAllBishopMagics();
 
+/**
+ * @brief Misst die Dauer eines Lookups der Turm- und Läuferangriffe für
+ * Magic Bitboards und (mit BMI2) PEXT, jeweils für unabhängige Lookups
+ * (Durchsatz) und für Lookups, die vom vorherigen Ergebnis abhängen (Latenz).
+ *
+ * @param count Die Anzahl der Lookups pro Messung.
+ */
+void benchmarkSliderLookups(size_t count);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,134 @@
+#include "test/TimeManagerReplay.h"
+
+#include "core/engine/search/PVSEngine.h"
+#include "core/utils/MoveNotations.h"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+/**
+ * @brief Liest die Startposition und die Züge einer Partie
+ * im Format des UCI-Befehls position.
+ *
+ * @return false, wenn die Partie nicht gelesen werden konnte.
+ */
+bool parseReplayGame(const std::string& line, Board& board, std::vector<Move>& moves) {
+    std::stringstream ss(line);
+    std::string token;
+
+    ss >> token;
+
+    if(token == "fen") {
+        std::string fen;
+        while(ss >> token && token != "moves")
+            fen += " " + token;
+
+        try { board = Board(fen); }
+        catch(std::invalid_argument& e) { return false; }
+    } else if(token == "startpos") {
+        board = Board();
+        ss >> token;
+    } else
+        return false;
+
+    // Die Züge werden auf einer Kopie ausgeführt,
+    // damit die Startposition erhalten bleibt.
+    Board temp = board;
+    moves.clear();
+
+    while(ss >> token) {
+        Move move = fromUCINotation(token, temp);
+        if(!move.exists())
+            return false;
+
+        temp.makeMove(move);
+        moves.push_back(move);
+    }
+
+    return true;
+}
+
+TimeManagerReplayResult replayGames(const std::vector<std::string>& games, uint32_t time, uint32_t increment, uint32_t lag) {
+    TimeManagerReplayResult result;
+
+    Board board;
+    std::vector<Move> moves;
+
+    for(const std::string& game : games) {
+        if(!parseReplayGame(game, board, moves))
+            continue;
+
+        PVSEngine engine(board);
+        engine.setUCIOutput(false);
+
+        int64_t clock[2] = {time, time};
+        result.numGames++;
+
+        for(Move move : moves) {
+            int side = board.getSideToMove() == WHITE ? 0 : 1;
+
+            UCI::SearchParams params = {
+                .wtime = (uint32_t)clock[0],
+                .btime = (uint32_t)clock[1],
+                .winc = increment,
+                .binc = increment,
+                .useWBTime = true
+            };
+
+            std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+            engine.search(params);
+            std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+            int64_t elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count();
+
+            result.numMoves++;
+            result.totalTime += elapsed;
+            result.maxTime = std::max(result.maxTime, elapsed);
+
+            clock[side] -= elapsed + lag;
+
+            // Zeitüberschreitung
+            if(clock[side] < 0) {
+                result.numFlags++;
+                break;
+            }
+
+            clock[side] += increment;
+
+            // Spiele immer den Zug aus der Partie
+            board.makeMove(move);
+        }
+    }
+
+    return result;
+}
+
+void printReplayResults(const std::string& filename, uint32_t time, uint32_t increment, uint32_t lag) {
+    std::ifstream file(filename);
+    if(!file.is_open()) {
+        std::cout << "Could not open " << filename << std::endl;
+        return;
+    }
+
+    std::vector<std::string> games;
+    std::string line;
+    while(std::getline(file, line))
+        if(!line.empty())
+            games.push_back(line);
+
+    std::cout << "Replaying " << games.size() << " games with " << time << "+" << increment <<
+                 "ms (lag " << lag << "ms)" << std::endl;
+
+    TimeManagerReplayResult result = replayGames(games, time, increment, lag);
+
+    double avgTime = result.numMoves > 0 ? (double)result.totalTime / result.numMoves : 0.0;
+    double flagRate = result.numGames > 0 ? (double)result.numFlags / result.numGames : 0.0;
+
+    std::cout << "Games: " << result.numGames << "\n" <<
+                 "Moves: " << result.numMoves << "\n" <<
+                 "Average time per move: " << avgTime << "ms\n" <<
+                 "Maximum time per move: " << result.maxTime << "ms\n" <<
+                 "Flags: " << result.numFlags << " (" << flagRate * 100.0 << "%)" << std::endl;
+}
\ No newline at end of file
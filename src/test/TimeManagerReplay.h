@@ -0,0 +1,41 @@
+#ifndef TIME_MANAGER_REPLAY_H
+#define TIME_MANAGER_REPLAY_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Die Ergebnisse einer Wiederholung von Partien mit simulierter Uhr.
+ */
+struct TimeManagerReplayResult {
+    size_t numGames = 0;
+    size_t numMoves = 0;
+    size_t numFlags = 0;
+    int64_t totalTime = 0;
+    int64_t maxTime = 0;
+};
+
+/**
+ * @brief Spielt eine feste Menge an Partien nach und lässt die Engine in jeder
+ * Position mit einer simulierten Uhr suchen. Gespielt wird immer der Zug aus
+ * der Partie, sodass die Positionen unabhängig von der Zeitkontrolle sind.
+ * Überschreitet eine Seite ihre Bedenkzeit, wird die Partie abgebrochen.
+ *
+ * @param games Die Partien, eine pro Eintrag im Format des UCI-Befehls position
+ * ("startpos moves ..." oder "fen ... moves ...").
+ * @param time Die Bedenkzeit pro Seite in Millisekunden.
+ * @param increment Das Inkrement pro Zug in Millisekunden.
+ * @param lag Eine simulierte Verzögerung der GUI in Millisekunden,
+ * die nach jedem Zug zusätzlich von der Uhr abgezogen wird.
+ */
+TimeManagerReplayResult replayGames(const std::vector<std::string>& games, uint32_t time, uint32_t increment, uint32_t lag);
+
+/**
+ * @brief Liest die Partien aus einer Datei (eine Partie pro Zeile),
+ * spielt sie nach und gibt die durchschnittliche Zeit pro Zug
+ * und die Rate der Zeitüberschreitungen aus.
+ */
+void printReplayResults(const std::string& filename, uint32_t time, uint32_t increment, uint32_t lag);
+
+#endif
\ No newline at end of file
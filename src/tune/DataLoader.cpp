@@ -0,0 +1,271 @@
+#include "tune/DataLoader.h"
+#include "tune/TrainingData.h"
+
+#include "core/utils/Random.h"
+
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include <random>
+
+uint32_t DataLoader::epochSeed(uint32_t seed, size_t epoch) {
+    return Random::mix32(seed ^ Random::mix32((uint32_t)epoch * 0x9E3779B9u));
+}
+
+std::vector<TrainingSample> decodeSamples(const std::vector<DataPoint>& data) {
+    std::vector<TrainingSample> samples(data.size());
+
+    size_t numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    size_t samplesPerThread = (data.size() + numThreads - 1) / numThreads;
+
+    auto threadFunc = [&](size_t start, size_t end) {
+        for(size_t i = start; i < end; i++)
+            samples[i] = TrainingSample(data[i]);
+    };
+
+    std::vector<std::thread> threads;
+    for(size_t start = 0; start < data.size(); start += samplesPerThread)
+        threads.push_back(std::thread(threadFunc, start, std::min(start + samplesPerThread, data.size())));
+
+    for(std::thread& t : threads)
+        t.join();
+
+    return samples;
+}
+
+MemoryDataLoader::MemoryDataLoader(const std::vector<DataPoint>& data, size_t batchSize, uint32_t seed) :
+    samples(decodeSamples(data)), indices(data.size()), batchSize(std::max(batchSize, (size_t)1)), seed(seed) {
+
+    std::iota(indices.begin(), indices.end(), 0);
+}
+
+void MemoryDataLoader::startEpoch(size_t epoch) {
+    std::mt19937 rng(epochSeed(seed, epoch));
+    std::shuffle(indices.begin(), indices.end(), rng);
+    position = 0;
+}
+
+bool MemoryDataLoader::nextBatch(std::vector<TrainingSample>& batch) {
+    if(position >= indices.size())
+        return false;
+
+    batch.clear();
+
+    size_t end = std::min(position + batchSize, indices.size());
+    for(; position < end; position++)
+        batch.push_back(samples[indices[position]]);
+
+    return true;
+}
+
+StreamingDataLoader::StreamingDataLoader(const std::string& path, size_t batchSize, size_t shuffleBufferSize,
+                                         size_t numPrefetchBatches, uint32_t seed, double validationFraction) :
+    batchSize(std::max(batchSize, (size_t)1)), shuffleBufferSize(std::max(shuffleBufferSize, (size_t)1)),
+    numPrefetchBatches(std::max(numPrefetchBatches, (size_t)1)), seed(seed), validationFraction(validationFraction) {
+
+    for(const std::string& shard : findTrainingDataShards(path)) {
+        TrainingDataFile file(shard);
+        if(!file.isOpen()) {
+            std::cerr << "Could not open " << shard << " or it is not a valid training data file" << std::endl;
+            continue;
+        }
+
+        shards.push_back(shard);
+        numRecords += file.size();
+    }
+}
+
+StreamingDataLoader::~StreamingDataLoader() {
+    stopProducer();
+}
+
+bool StreamingDataLoader::isValidationGame(size_t shardIndex, size_t gameStart) const {
+    if(validationFraction <= 0.0)
+        return false;
+
+    uint32_t hash = Random::mix32((uint32_t)gameStart ^ (uint32_t)(gameStart >> 32));
+    hash = Random::mix32(hash ^ ((uint32_t)shardIndex * 0x85EBCA6Bu));
+    hash = Random::mix32(hash ^ seed);
+
+    return hash < validationFraction * 4294967296.0;
+}
+
+void StreamingDataLoader::stopProducer() {
+    if(producer.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopRequested = true;
+        }
+
+        cvProducer.notify_all();
+        producer.join();
+    }
+
+    // Übrig gebliebene Batches können in der nächsten Epoche wiederverwendet werden
+    while(!readyBatches.empty()) {
+        freeBatches.push_back(std::move(readyBatches.front()));
+        readyBatches.pop_front();
+    }
+
+    stopRequested = false;
+    epochFinished = true;
+}
+
+void StreamingDataLoader::startEpoch(size_t epoch) {
+    stopProducer();
+
+    epochFinished = false;
+    producer = std::thread(&StreamingDataLoader::produceEpoch, this, epochSeed(seed, epoch));
+}
+
+bool StreamingDataLoader::nextBatch(std::vector<TrainingSample>& batch) {
+    std::unique_lock<std::mutex> lock(mutex);
+    cvConsumer.wait(lock, [this] { return !readyBatches.empty() || epochFinished; });
+
+    if(readyBatches.empty())
+        return false;
+
+    // Der bisherige Batch des Aufrufers wird für das Vorladen wiederverwendet
+    freeBatches.push_back(std::move(batch));
+    batch = std::move(readyBatches.front());
+    readyBatches.pop_front();
+
+    lock.unlock();
+    cvProducer.notify_one();
+
+    return true;
+}
+
+bool StreamingDataLoader::pushBatch(std::vector<TrainingSample>& batch) {
+    std::unique_lock<std::mutex> lock(mutex);
+    cvProducer.wait(lock, [this] { return readyBatches.size() < numPrefetchBatches || stopRequested; });
+
+    if(stopRequested)
+        return false;
+
+    readyBatches.push_back(std::move(batch));
+
+    if(!freeBatches.empty()) {
+        batch = std::move(freeBatches.back());
+        freeBatches.pop_back();
+    } else
+        batch = std::vector<TrainingSample>();
+
+    batch.clear();
+    batch.reserve(batchSize);
+
+    lock.unlock();
+    cvConsumer.notify_one();
+
+    return true;
+}
+
+void StreamingDataLoader::produceEpoch(uint32_t epochSeed) {
+    std::mt19937 rng(epochSeed);
+
+    std::vector<size_t> shardOrder(shards.size());
+    std::iota(shardOrder.begin(), shardOrder.end(), 0);
+    std::shuffle(shardOrder.begin(), shardOrder.end(), rng);
+
+    std::vector<TrainingSample> shuffleBuffer;
+    shuffleBuffer.reserve(std::min(shuffleBufferSize, numRecords));
+
+    std::vector<TrainingSample> batch;
+    batch.reserve(batchSize);
+
+    std::vector<DataPoint> game;
+
+    std::uniform_int_distribution<size_t> bufferDist(0, shuffleBufferSize - 1);
+
+    // Fügt einen Datenpunkt dem aktuellen Batch hinzu und
+    // gibt den Batch weiter, sobald er voll ist
+    auto emit = [&](const TrainingSample& sample) {
+        batch.push_back(sample);
+        return batch.size() < batchSize || pushBatch(batch);
+    };
+
+    auto finish = [&]() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            epochFinished = true;
+        }
+
+        cvConsumer.notify_all();
+    };
+
+    for(size_t shardIndex : shardOrder) {
+        TrainingDataFile file(shards[shardIndex]);
+        if(!file.isOpen())
+            continue;
+
+        size_t gameStart = 0;
+        for(size_t i = 0; i < file.size(); i++) {
+            if(!(file[i].flags & DataPoint::END_OF_GAME) && i != file.size() - 1)
+                continue;
+
+            if(!isValidationGame(shardIndex, gameStart)) {
+                game.assign(file.begin() + gameStart, file.begin() + i + 1);
+                calculateTDTargets(game.data(), game.size());
+
+                // Mische die Datenpunkte über den Puffer: Ist er voll,
+                // ersetzt jeder neue Datenpunkt einen zufälligen alten
+                for(const DataPoint& dp : game) {
+                    TrainingSample sample(dp);
+
+                    if(shuffleBuffer.size() < shuffleBufferSize) {
+                        shuffleBuffer.push_back(sample);
+                        continue;
+                    }
+
+                    size_t index = bufferDist(rng);
+                    if(!emit(shuffleBuffer[index]))
+                        return finish();
+
+                    shuffleBuffer[index] = sample;
+                }
+            }
+
+            gameStart = i + 1;
+        }
+    }
+
+    // Leere den Puffer
+    std::shuffle(shuffleBuffer.begin(), shuffleBuffer.end(), rng);
+    for(const TrainingSample& sample : shuffleBuffer)
+        if(!emit(sample))
+            return finish();
+
+    if(!batch.empty())
+        pushBatch(batch);
+
+    finish();
+}
+
+std::vector<DataPoint> StreamingDataLoader::loadValidationData(size_t maxSamples) const {
+    std::vector<DataPoint> data;
+
+    for(size_t shardIndex = 0; shardIndex < shards.size() && data.size() < maxSamples; shardIndex++) {
+        TrainingDataFile file(shards[shardIndex]);
+        if(!file.isOpen())
+            continue;
+
+        size_t gameStart = 0;
+        for(size_t i = 0; i < file.size() && data.size() < maxSamples; i++) {
+            if(!(file[i].flags & DataPoint::END_OF_GAME) && i != file.size() - 1)
+                continue;
+
+            if(validationFraction <= 0.0 || isValidationGame(shardIndex, gameStart)) {
+                size_t offset = data.size();
+                data.insert(data.end(), file.begin() + gameStart, file.begin() + i + 1);
+                calculateTDTargets(data.data() + offset, data.size() - offset);
+            }
+
+            gameStart = i + 1;
+        }
+    }
+
+    if(data.size() > maxSamples)
+        data.resize(maxSamples);
+
+    return data;
+}
\ No newline at end of file
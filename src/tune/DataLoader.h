@@ -0,0 +1,201 @@
+#ifndef DATA_LOADER_H
+#define DATA_LOADER_H
+
+#include "tune/Definitions.h"
+#include "tune/ml/HalfKAv2_hm.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Ein für das Training dekodierter Datenpunkt. Die aktiven
+ * Features der Position sind bereits extrahiert.
+ */
+struct TrainingSample {
+    ML::HalfKAv2_hmFeatures features;
+    float tdTarget;
+    int8_t finalResult;
+
+    TrainingSample() = default;
+
+    inline explicit TrainingSample(const DataPoint& dp) :
+        features(Board(dp.board)), tdTarget(dp.tdTarget), finalResult(dp.finalResult) {}
+
+    inline int getSideToMove() const {
+        return features.side;
+    }
+};
+
+/**
+ * @brief Extrahiert die Features aller Datenpunkte. Die Berechnung
+ * wird auf mehrere Threads aufgeteilt.
+ */
+std::vector<TrainingSample> decodeSamples(const std::vector<DataPoint>& data);
+
+/**
+ * @brief Liefert die Trainingsdaten einer Epoche in gemischten Batches.
+ */
+class DataLoader {
+    public:
+        virtual ~DataLoader() {}
+
+        /**
+         * @brief Beginnt eine neue Epoche. Die Reihenfolge der Datenpunkte
+         * hängt nur vom Startwert des Datenladers und der Epoche ab.
+         */
+        virtual void startEpoch(size_t epoch) = 0;
+
+        /**
+         * @brief Liefert den nächsten Batch der aktuellen Epoche.
+         *
+         * @param batch Wird mit dem nächsten Batch überschrieben.
+         * @return false, wenn die Epoche beendet ist.
+         */
+        virtual bool nextBatch(std::vector<TrainingSample>& batch) = 0;
+
+        /**
+         * @brief Die (ungefähre) Anzahl der Batches pro Epoche.
+         */
+        virtual size_t getNumBatches() const = 0;
+
+        /**
+         * @brief Berechnet den Startwert des Zufallsgenerators einer Epoche.
+         */
+        static uint32_t epochSeed(uint32_t seed, size_t epoch);
+};
+
+/**
+ * @brief Ein Datenlader für einen Datensatz, der vollständig im Speicher liegt.
+ * Die Features werden beim Erstellen einmalig extrahiert und in jeder Epoche wiederverwendet.
+ */
+class MemoryDataLoader : public DataLoader {
+    private:
+        std::vector<TrainingSample> samples;
+        std::vector<uint32_t> indices;
+        size_t batchSize;
+        uint32_t seed;
+        size_t position = 0;
+
+    public:
+        MemoryDataLoader(const std::vector<DataPoint>& data, size_t batchSize, uint32_t seed);
+
+        void startEpoch(size_t epoch) override;
+        bool nextBatch(std::vector<TrainingSample>& batch) override;
+
+        inline size_t getNumBatches() const override {
+            return (samples.size() + batchSize - 1) / batchSize;
+        }
+};
+
+/**
+ * @brief Ein Datenlader, der die Trainingsdaten während des Trainings aus
+ * einer oder mehreren Trainingsdateien (Shards) liest, anstatt sie vollständig
+ * in den Speicher zu laden.
+ *
+ * Ein Hintergrundthread liest die Shards in zufälliger Reihenfolge, berechnet
+ * die TD(lambda)-Zielwerte jeder Partie, extrahiert die Features und mischt
+ * die Datenpunkte über einen Puffer fester Größe. Die fertigen Batches werden
+ * in einer Warteschlange bereitgestellt, während der aktuelle Batch trainiert wird.
+ *
+ * Die Partien werden anhand ihrer Position im Datensatz fest in Trainings- und
+ * Validierungsdaten aufgeteilt, sodass Positionen einer Partie nie in beiden landen.
+ */
+class StreamingDataLoader : public DataLoader {
+    private:
+        std::vector<std::string> shards;
+        size_t numRecords = 0;
+
+        size_t batchSize;
+        size_t shuffleBufferSize;
+        size_t numPrefetchBatches;
+        uint32_t seed;
+        double validationFraction;
+
+        std::thread producer;
+        std::mutex mutex;
+        std::condition_variable cvProducer;
+        std::condition_variable cvConsumer;
+
+        /**
+         * @brief Die fertigen Batches und bereits verbrauchte Batches,
+         * deren Speicher wiederverwendet werden kann.
+         */
+        std::deque<std::vector<TrainingSample>> readyBatches;
+        std::vector<std::vector<TrainingSample>> freeBatches;
+
+        bool epochFinished = true;
+        bool stopRequested = false;
+
+        /**
+         * @brief Liest alle Shards einmal vollständig und stellt die Batches bereit.
+         */
+        void produceEpoch(uint32_t epochSeed);
+
+        /**
+         * @brief Übergibt einen vollen Batch an die Warteschlange und wartet,
+         * wenn bereits genug Batches vorbereitet sind.
+         *
+         * @return false, wenn der Datenlader beendet werden soll.
+         */
+        bool pushBatch(std::vector<TrainingSample>& batch);
+
+        /**
+         * @brief Beendet den Hintergrundthread.
+         */
+        void stopProducer();
+
+        /**
+         * @brief Gibt an, ob eine Partie zu den Validierungsdaten gehört.
+         *
+         * @param shardIndex Der Index des Shards.
+         * @param gameStart Der Index des ersten Datenpunkts der Partie im Shard.
+         */
+        bool isValidationGame(size_t shardIndex, size_t gameStart) const;
+
+    public:
+        /**
+         * @param path Eine Trainingsdatei oder ein Verzeichnis mit Trainingsdateien.
+         * @param batchSize Die Anzahl der Datenpunkte pro Batch.
+         * @param shuffleBufferSize Die Anzahl der Datenpunkte im Mischpuffer.
+         * @param numPrefetchBatches Die Anzahl der Batches, die im Voraus vorbereitet werden.
+         * @param seed Der Startwert für die Reihenfolge der Shards und Datenpunkte.
+         * @param validationFraction Der Anteil der Partien, die für die Validierung zurückgehalten werden.
+         */
+        StreamingDataLoader(const std::string& path, size_t batchSize, size_t shuffleBufferSize,
+                            size_t numPrefetchBatches, uint32_t seed, double validationFraction);
+
+        ~StreamingDataLoader();
+
+        StreamingDataLoader(const StreamingDataLoader&) = delete;
+        StreamingDataLoader& operator=(const StreamingDataLoader&) = delete;
+
+        void startEpoch(size_t epoch) override;
+        bool nextBatch(std::vector<TrainingSample>& batch) override;
+
+        inline size_t getNumBatches() const override {
+            double trainingFraction = 1.0 - validationFraction;
+            return ((size_t)(numRecords * trainingFraction) + batchSize - 1) / batchSize;
+        }
+
+        inline size_t getNumShards() const {
+            return shards.size();
+        }
+
+        inline size_t getNumRecords() const {
+            return numRecords;
+        }
+
+        /**
+         * @brief Lädt die Validierungsdaten (höchstens maxSamples Datenpunkte).
+         * Ohne Validierungsanteil werden stattdessen die ersten Datenpunkte
+         * des Datensatzes verwendet.
+         */
+        std::vector<DataPoint> loadValidationData(size_t maxSamples) const;
+};
+
+#endif
\ No newline at end of file
@@ -2,21 +2,35 @@
 #define TUNE_DEFINITIONS_H
 
 #include "core/chess/Board.h"
+#include "core/chess/PackedBoard.h"
 
 #include <sstream>
 #include <tuple>
 #include <type_traits>
 #include <vector>
 
+/**
+ * @brief Ein Trainingsdatenpunkt (40 Bytes). Wird in genau
+ * diesem Format in Trainingsdateien gespeichert.
+ */
 struct DataPoint {
-    Board board;
-    Board leafBoard;
-    int leafEvaluation;
-    int finalResult;
-    double logProb;
-    double tdTarget;
+    /**
+     * @brief Gibt an, dass der Datenpunkt die letzte Position einer Partie ist.
+     */
+    static constexpr uint8_t END_OF_GAME = 1;
+
+    PackedBoard board;
+    uint8_t flags;
+    int16_t leafEvaluation;
+    int8_t finalResult;
+    uint8_t reserved;
+    float logProb;
+    float tdTarget;
 };
 
+static_assert(sizeof(DataPoint) == 40);
+static_assert(std::is_trivially_copyable_v<DataPoint>);
+
 class Variable;
 
 extern std::vector<Variable*> tuneVariables;
@@ -255,6 +269,8 @@ class Variable {
 
 extern Variable pgnFilePath;
 extern Variable samplesFilePath;
+extern Variable openingsFilePath;
+extern Variable textSamplesFilePath;
 
 /**
  * Variablen der Trainingsdatengenerierung.
@@ -271,6 +287,11 @@ extern Variable openingBookMovesMax;
 extern Variable randomMovesMin;
 extern Variable randomMovesMax;
 extern Variable virtualMateScore;
+extern Variable simHashSize;
+extern Variable simNodes;
+extern Variable simDepth;
+extern Variable simNodesPerMs;
+extern Variable simSeed;
 
 #ifdef USE_HCE
 extern Variable useNoisyParameters;
@@ -309,6 +330,16 @@ extern Variable weightDecay;
 extern Variable encLossWeight;
 extern Variable maxSpectralRadius;
 
+/**
+ * Variablen des Datenladers.
+ */
+
+extern Variable streamData;
+extern Variable dataSeed;
+extern Variable shuffleBufferSize;
+extern Variable prefetchBatches;
+extern Variable maxValidationSamples;
+
 /**
  * Variablen der Validierung.
  */
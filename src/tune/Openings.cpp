@@ -0,0 +1,263 @@
+#include "tune/Openings.h"
+
+#include "core/chess/Board.h"
+#include "core/utils/Random.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+/**
+ * @brief Die Größe der Abschnitte, in die eine PGN-Datei aufgeteilt wird.
+ */
+static constexpr size_t PGN_CHUNK_SIZE = 1 << 22;
+
+namespace {
+    struct Sample {
+        uint64_t key;
+        PackedBoard board;
+
+        inline bool operator<(const Sample& other) const {
+            return key < other.key;
+        }
+    };
+
+    /**
+     * @brief Behält die n Datenpunkte mit den kleinsten Schlüsseln.
+     * Der Datenpunkt mit dem größten Schlüssel steht am Anfang (Max-Heap).
+     */
+    class Reservoir {
+        private:
+            std::vector<Sample> heap;
+            size_t capacity;
+
+        public:
+            explicit Reservoir(size_t capacity) : capacity(capacity) {
+                heap.reserve(capacity);
+            }
+
+            /**
+             * @brief Gibt an, ob ein Datenpunkt mit diesem Schlüssel aufgenommen würde.
+             */
+            inline bool accepts(uint64_t key) const {
+                return heap.size() < capacity || key < heap.front().key;
+            }
+
+            inline void add(const Sample& sample) {
+                if(!accepts(sample.key))
+                    return;
+
+                if(heap.size() == capacity) {
+                    std::pop_heap(heap.begin(), heap.end());
+                    heap.pop_back();
+                }
+
+                heap.push_back(sample);
+                std::push_heap(heap.begin(), heap.end());
+            }
+
+            inline const std::vector<Sample>& getSamples() const {
+                return heap;
+            }
+    };
+
+    /**
+     * @brief Berechnet den zufälligen Schlüssel eines Datenpunkts aus seiner Position in der Datei.
+     */
+    inline uint64_t sampleKey(uint32_t seed, uint64_t position) {
+        uint32_t high = Random::mix32(seed ^ Random::mix32((uint32_t)position ^ Random::mix32((uint32_t)(position >> 32))));
+        uint32_t low = Random::mix32(high ^ (uint32_t)position ^ 0x9E3779B9u);
+        return ((uint64_t)high << 32) | low;
+    }
+
+    /**
+     * @brief Liest einen Abschnitt einer PGN-Datei. Ein Abschnitt enthält alle
+     * Partien, die in ihm beginnen. Die letzte Partie wird über das Ende des
+     * Abschnitts hinaus gelesen.
+     *
+     * @return Die Anzahl der Partien im Abschnitt.
+     */
+    size_t readPGNChunk(std::ifstream& file, uint64_t start, uint64_t end, size_t minMoves, size_t maxMoves,
+                        uint32_t seed, Reservoir& reservoir) {
+        std::string line, game;
+
+        // Beginne mit der ersten vollständigen Zeile des Abschnitts
+        file.clear();
+        if(start > 0) {
+            file.seekg(start - 1);
+            std::getline(file, line);
+        } else
+            file.seekg(0);
+
+        if(!file.good())
+            return 0;
+
+        uint64_t offset = file.tellg();
+        uint64_t key = 0;
+        bool inGame = false, keepGame = false;
+        size_t numGames = 0;
+
+        auto finishGame = [&]() {
+            if(!keepGame)
+                return;
+
+            size_t numMoves = minMoves + (uint32_t)key % (maxMoves - minMoves + 1);
+
+            std::istringstream ss(game);
+            Board board = std::get<0>(Board::fromPGN(ss, numMoves));
+            reservoir.add({key, board.toPackedBoard()});
+        };
+
+        while(std::getline(file, line)) {
+            if(line.starts_with("[Event")) {
+                if(inGame)
+                    finishGame();
+
+                inGame = false;
+                if(offset >= end)
+                    break;
+
+                // Nur Partien, die in das Reservoir aufgenommen würden, werden gespeichert und geparst
+                inGame = true;
+                key = sampleKey(seed, offset);
+                keepGame = reservoir.accepts(key);
+                game.clear();
+                numGames++;
+            }
+
+            if(inGame && keepGame) {
+                game += line;
+                game += '\n';
+            }
+
+            offset += line.size() + 1;
+        }
+
+        if(inGame)
+            finishGame();
+
+        return numGames;
+    }
+
+    std::vector<Sample> samplePGN(const std::string& path, size_t n, size_t minMoves, size_t maxMoves,
+                                  uint32_t seed, size_t numThreads) {
+        std::error_code error;
+        uint64_t fileSize = std::filesystem::file_size(path, error);
+        if(error) {
+            std::cerr << "Could not open " << path << std::endl;
+            return {};
+        }
+
+        maxMoves = std::max(minMoves, maxMoves);
+        size_t numChunks = (fileSize + PGN_CHUNK_SIZE - 1) / PGN_CHUNK_SIZE;
+        numThreads = std::clamp(numThreads, (size_t)1, std::max(numChunks, (size_t)1));
+
+        std::vector<Reservoir> reservoirs(numThreads, Reservoir(n));
+        std::atomic<size_t> nextChunk = 0, numChunksRead = 0, numGames = 0;
+
+        auto threadFunc = [&](size_t threadIndex) {
+            std::ifstream file(path, std::ios::binary);
+
+            for(size_t chunk = nextChunk++; chunk < numChunks; chunk = nextChunk++) {
+                uint64_t start = chunk * PGN_CHUNK_SIZE;
+                uint64_t end = std::min(start + PGN_CHUNK_SIZE, fileSize);
+
+                numGames += readPGNChunk(file, start, end, minMoves, maxMoves, seed, reservoirs[threadIndex]);
+                numChunksRead++;
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for(size_t i = 0; i < numThreads; i++)
+            threads.push_back(std::thread(threadFunc, i));
+
+        while(numChunksRead < numChunks) {
+            std::cout << "\rLoaded " << numGames << " games" << std::flush;
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+
+        for(std::thread& t : threads)
+            t.join();
+
+        std::cout << "\rLoaded " << numGames << " games" << std::endl;
+
+        std::vector<Sample> samples;
+        for(const Reservoir& reservoir : reservoirs)
+            samples.insert(samples.end(), reservoir.getSamples().begin(), reservoir.getSamples().end());
+
+        return samples;
+    }
+
+    std::vector<Sample> sampleOpeningsFile(std::ifstream& file, size_t n, uint32_t seed) {
+        Reservoir reservoir(n);
+
+        PackedBoard board;
+        for(uint64_t index = 0; file.read(reinterpret_cast<char*>(&board), sizeof(board)); index++) {
+            // Eine beschädigte oder fremde Datei wird vollständig abgelehnt
+            const char* error = Board::validatePackedBoard(board);
+            if(error) {
+                std::cerr << "Invalid opening " << index << ": " << error << std::endl;
+                return {};
+            }
+
+            reservoir.add({sampleKey(seed, index), board});
+        }
+
+        return reservoir.getSamples();
+    }
+}
+
+std::vector<PackedBoard> sampleOpenings(const std::string& path, size_t n, size_t minMoves, size_t maxMoves,
+                                        uint32_t seed, size_t numThreads) {
+    if(n == 0)
+        return {};
+
+    std::vector<Sample> samples;
+
+    // Überprüfe, ob es sich um eine Eröffnungsdatei handelt
+    std::ifstream file(path, std::ios::binary);
+    OpeningsHeader header;
+    if(file.read(reinterpret_cast<char*>(&header), sizeof(header)) &&
+       std::memcmp(header.magic, OpeningsHeader::MAGIC, sizeof(header.magic)) == 0 &&
+       header.version == OpeningsHeader::VERSION && header.recordSize == sizeof(PackedBoard)) {
+        samples = sampleOpeningsFile(file, n, seed);
+        std::cout << "Loaded " << samples.size() << " openings" << std::endl;
+    } else {
+        file.close();
+        samples = samplePGN(path, n, minMoves, maxMoves, seed, numThreads);
+    }
+
+    // Die Schlüssel sind zufällig, die Sortierung mischt also die Positionen
+    std::sort(samples.begin(), samples.end());
+    if(samples.size() > n)
+        samples.resize(n);
+
+    std::vector<PackedBoard> openings;
+    openings.reserve(samples.size());
+    for(const Sample& sample : samples)
+        openings.push_back(sample.board);
+
+    return openings;
+}
+
+bool writeOpenings(const std::string& path, const std::vector<PackedBoard>& openings) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if(!file.is_open())
+        return false;
+
+    OpeningsHeader header{};
+    std::memcpy(header.magic, OpeningsHeader::MAGIC, sizeof(header.magic));
+    header.version = OpeningsHeader::VERSION;
+    header.recordSize = sizeof(PackedBoard);
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(openings.data()), openings.size() * sizeof(PackedBoard));
+
+    return file.good();
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+#ifndef OPENINGS_H
+#define OPENINGS_H
+
+#include "core/chess/PackedBoard.h"
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Der Kopf einer binären Eröffnungsdatei. Auf den Kopf
+ * folgen die Positionen ohne Zwischenraum im Format von PackedBoard.
+ */
+struct OpeningsHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t recordSize;
+    uint32_t reserved;
+
+    static constexpr char MAGIC[4] = {'C', 'E', 'O', 'P'};
+    static constexpr uint32_t VERSION = 1;
+};
+
+static_assert(sizeof(OpeningsHeader) == 16);
+
+/**
+ * @brief Wählt n zufällige Startpositionen aus einer PGN-Datei oder einer
+ * binären Eröffnungsdatei aus.
+ *
+ * Eine PGN-Datei wird in Abschnitte aufgeteilt, die von mehreren Threads
+ * parallel gelesen werden. Jede Partie erhält anhand ihrer Position in der
+ * Datei einen zufälligen Schlüssel und es werden die n Partien mit den kleinsten
+ * Schlüsseln behalten (Reservoir Sampling). Nur diese Partien werden tatsächlich
+ * geparst, der Speicherbedarf hängt also nur von n ab. Das Ergebnis hängt nur
+ * vom Startwert und nicht von der Anzahl der Threads ab. Jede Partie muss
+ * (wie im PGN-Standard vorgesehen) mit dem Event-Tag beginnen.
+ *
+ * Positionen aus einer Eröffnungsdatei werden unverändert übernommen.
+ *
+ * @param path Der Pfad der PGN- oder Eröffnungsdatei.
+ * @param n Die Anzahl der Startpositionen.
+ * @param minMoves Die minimale Anzahl an Halbzügen, die aus einer Partie gespielt werden.
+ * @param maxMoves Die maximale Anzahl an Halbzügen, die aus einer Partie gespielt werden.
+ * @param seed Der Startwert für die Auswahl der Partien und der Anzahl der Halbzüge.
+ * @param numThreads Die Anzahl der Threads zum Lesen einer PGN-Datei.
+ * @return Die Startpositionen in zufälliger Reihenfolge.
+ */
+std::vector<PackedBoard> sampleOpenings(const std::string& path, size_t n, size_t minMoves, size_t maxMoves,
+                                        uint32_t seed, size_t numThreads);
+
+/**
+ * @brief Schreibt Startpositionen in eine binäre Eröffnungsdatei, damit
+ * sie später ohne erneutes Parsen der PGN-Datei verwendet werden können.
+ *
+ * @return false, wenn die Datei nicht geschrieben werden konnte.
+ */
+bool writeOpenings(const std::string& path, const std::vector<PackedBoard>& openings);
+
+#endif
\ No newline at end of file
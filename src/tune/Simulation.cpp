@@ -1,9 +1,11 @@
 #include "tune/Simulation.h"
 
 #include "tune/Definitions.h"
+#include "tune/TrainingData.h"
 
 #include "core/chess/Referee.h"
 #include "core/engine/search/PVSEngine.h"
+#include "core/engine/search/TimeManager.h"
 #include "core/utils/Random.h"
 
 #include <algorithm>
@@ -11,6 +13,7 @@
 #include <iomanip>
 #include <iostream>
 #include <random>
+#include <sstream>
 #include <thread>
 
 Simulation::Simulation(std::vector<Board>& startingPositions, uint32_t timeControl, uint32_t increment) :
@@ -28,9 +31,51 @@ Simulation::Simulation(std::vector<Board>& startingPositions, uint32_t timeContr
     results.resize(startingPositions.size());
     temperature = 0.0;
     temperatureDecay = 1.0;
+    hashSize = DEFAULT_HASH_SIZE;
+    nodeLimit = 0;
+    depthLimit = 0;
+    nodesPerMillisecond = 0.0;
+    seed = Random::BASE_SEED;
 }
 
-std::pair<double, std::vector<Move>> sampleVariation(const std::vector<Variation>& variations, double temperature) {
+struct Simulation::Worker {
+    /**
+     * @brief Das Schachbrett, auf dem die Engines suchen.
+     * Die Partien werden zu Beginn hineinkopiert.
+     */
+    Board board;
+
+    /**
+     * @brief Die Parameter der beiden Spieler. Die Engines halten eine
+     * Referenz darauf, sodass neue Parameter einfach zugewiesen werden können.
+     */
+    Parameters whiteParams;
+    Parameters blackParams;
+
+    PVSEngine white;
+    PVSEngine black;
+
+    /**
+     * @brief Der Zufallsgenerator der aktuellen Partie. Er wird vor jeder Partie
+     * aus deren Index initialisiert, damit das Ergebnis nicht davon abhängt,
+     * welcher Thread die Partie spielt.
+     */
+    std::mt19937 rng;
+
+    #ifdef USE_HCE
+    HandcraftedEvaluator neutralEvaluator;
+    #else
+    NNUEEvaluator neutralEvaluator;
+    #endif
+
+    Worker(const Parameters& params, size_t hashSize) :
+        whiteParams(params), blackParams(params),
+        white(board, whiteParams, 2, nullptr, false, hashSize * (1 << 20) / TT_ENTRY_SIZE),
+        black(board, blackParams, 2, nullptr, false, hashSize * (1 << 20) / TT_ENTRY_SIZE),
+        neutralEvaluator(board, params) {}
+};
+
+std::pair<double, std::vector<Move>> sampleVariation(const std::vector<Variation>& variations, double temperature, std::mt19937& rng) {
     if(temperature <= 0.0)
         return {0.0, variations[0].moves};
     
@@ -49,7 +94,6 @@ std::pair<double, std::vector<Move>> sampleVariation(const std::vector<Variation
     }
 
     std::uniform_real_distribution<double> dis(0.0, sumExp);
-    std::mt19937& rng = Random::generator<1>();
     double rand = dis(rng);
     double cumulative = 0.0;
     
@@ -62,22 +106,112 @@ std::pair<double, std::vector<Move>> sampleVariation(const std::vector<Variation
     return {logProbs.back(), variations.back().moves};
 }
 
-Result Simulation::simulateSingleGame(Board& board, Parameters whiteParameters, Parameters blackParameters) {
+uint32_t Simulation::gameSeed(size_t gameIndex) const {
+    return Random::mix32(seed ^ Random::mix32((uint32_t)gameIndex * 0x9E3779B9u));
+}
+
+UCI::SearchParams Simulation::getSearchParams(const Board& board, int32_t wtime, int32_t btime) const {
+    UCI::SearchParams params;
+
+    if(nodesPerMillisecond > 0.0) {
+        // Die Bedenkzeit wird in Knoten gemessen. Der Zeitmanager der Engine
+        // bestimmt die Zeit für den Zug, die dann in ein Knotenlimit umgerechnet wird.
+        Array<Move, 256> legalMoves;
+        board.generateLegalMoves(legalMoves);
+
+        UCI::SearchParams clock = {
+            .wtime = (uint32_t)wtime,
+            .btime = (uint32_t)btime,
+            .winc = increment,
+            .binc = increment,
+            .useWBTime = true
+        };
+
+        TimeManager timeManager;
+        timeManager.start(clock, board.getSideToMove(), legalMoves.size(), 0);
+        params.nodes = std::max((uint64_t)(timeManager.getSoftLimit() * nodesPerMillisecond), (uint64_t)1);
+    } else if(nodeLimit > 0 || depthLimit > 0) {
+        if(nodeLimit > 0)
+            params.nodes = nodeLimit;
+
+        if(depthLimit > 0)
+            params.depth = depthLimit;
+    } else {
+        params.wtime = (uint32_t)wtime;
+        params.btime = (uint32_t)btime;
+        params.winc = increment;
+        params.binc = increment;
+        params.useWBTime = true;
+    }
+
+    return params;
+}
+
+int64_t Simulation::getElapsedTime(const PVSEngine& engine, std::chrono::steady_clock::time_point begin,
+                                   std::chrono::steady_clock::time_point end) const {
+    if(nodesPerMillisecond > 0.0)
+        return (int64_t)(engine.getNodesSearched() / nodesPerMillisecond);
+
+    return std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count();
+}
+
+std::string Simulation::getLimitsDescription() const {
+    std::stringstream ss;
+
+    if(nodesPerMillisecond > 0.0)
+        ss << timeControl / 1000.0 << "s + " << increment / 1000.0 << "s increment at " << nodesPerMillisecond << " nodes/ms";
+    else if(nodeLimit > 0 || depthLimit > 0) {
+        if(nodeLimit > 0)
+            ss << nodeLimit << " nodes";
+
+        if(nodeLimit > 0 && depthLimit > 0)
+            ss << ", ";
+
+        if(depthLimit > 0)
+            ss << "depth " << depthLimit;
+
+        ss << " per move";
+    } else
+        ss << timeControl / 1000.0 << "s + " << increment / 1000.0 << "s increment";
+
+    return ss.str();
+}
+
+Result Simulation::simulateSingleGame(Worker& worker, const Parameters& whiteParams, const Parameters& blackParams, size_t gameIndex) {
+    Board& board = worker.board;
+    worker.rng.seed(gameSeed(gameIndex));
+
     if(Referee::isCheckmate(board))
-        return board.getSideToMove() == WHITE ? Result{BLACK_WIN, {}, {}, {}} : Result{WHITE_WIN, {}, {}, {}};
+        return board.getSideToMove() == WHITE ? Result{BLACK_WIN, {}, {}} : Result{WHITE_WIN, {}, {}};
     else if(Referee::isDraw(board))
-        return Result{DRAW, {}, {}, {}};
+        return Result{DRAW, {}, {}};
+
+    worker.whiteParams = whiteParams;
+    worker.blackParams = blackParams;
+    worker.white.setParameters(worker.whiteParams);
+    worker.black.setParameters(worker.blackParams);
+
+    // Die Transpositionstabellen werden über ihr Alter geleert
+    worker.white.newGame();
+    worker.black.newGame();
+
+    PVSEngine& white = worker.white;
+    PVSEngine& black = worker.black;
 
     Result result;
 
     #ifdef USE_HCE
+    // Das Rauschen wird direkt in die Parameter der Engines geschrieben
+    HCEParameters& whiteParameters = worker.whiteParams;
+    HCEParameters& blackParameters = worker.blackParams;
+
     std::vector<double> whiteNoise(currentParams.size(), 0.0);
     std::vector<double> blackNoise(currentParams.size(), 0.0);
     double whiteDecayFactor = 1.0;
     double blackDecayFactor = 1.0;
 
     if(addParameterNoise) {
-        std::mt19937& rng = Random::generator<2>();
+        std::mt19937& rng = worker.rng;
         std::normal_distribution<double> defaultDist(0.0, noiseStdDev);
         std::normal_distribution<double> linearDist(0.0, noiseLinearStdDev);
 
@@ -99,28 +233,18 @@ Result Simulation::simulateSingleGame(Board& board, Parameters whiteParameters,
         }
     }
 
-    HandcraftedEvaluator neutralEvaluator(board, currentParams);
     #else
-    NNUEEvaluator neutralEvaluator(board, currentParams);
     double tau = temperature;
     #endif
 
-    PVSEngine white(board, whiteParameters);
-    white.setUCIOutput(false);
-    PVSEngine black(board, blackParameters);
-    black.setUCIOutput(false);
+    auto& neutralEvaluator = worker.neutralEvaluator;
+    neutralEvaluator.setBoard(board);
 
     int32_t wtime = timeControl;
     int32_t btime = timeControl;
 
     while(true) {
-        UCI::SearchParams params = {
-            .wtime = (uint32_t)wtime,
-            .btime = (uint32_t)btime,
-            .winc = increment,
-            .binc = increment,
-            .useWBTime = true
-        };
+        UCI::SearchParams params = getSearchParams(board, wtime, btime);
 
         if(board.getSideToMove() == WHITE) {
             #ifdef USE_HCE
@@ -147,7 +271,7 @@ Result Simulation::simulateSingleGame(Board& board, Parameters whiteParameters,
             std::vector<Move> sampledVar = white.getPrincipalVariation();
             #else
             std::vector<Move> sampledVar;
-            std::tie(logProb, sampledVar) = sampleVariation(white.getVariations(), tau);
+            std::tie(logProb, sampledVar) = sampleVariation(white.getVariations(), tau, worker.rng);
             tau *= temperatureDecay;
             #endif
 
@@ -159,7 +283,6 @@ Result Simulation::simulateSingleGame(Board& board, Parameters whiteParameters,
             if(board.getSideToMove() == BLACK)
                 evaluation = -evaluation;
             result.leafEvaluations.push_back(evaluation);
-            result.leafFENs.push_back(board.toFEN());
             result.logProbs.push_back(logProb);
             
             // Mache die Züge wieder rückgängig
@@ -169,7 +292,7 @@ Result Simulation::simulateSingleGame(Board& board, Parameters whiteParameters,
             Move chosenMove = sampledVar[0];
             board.makeMove(chosenMove);
 
-            wtime -= std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count();
+            wtime -= getElapsedTime(white, begin, end);
             wtime = std::max(wtime, 0);
             wtime += increment;
 
@@ -202,7 +325,7 @@ Result Simulation::simulateSingleGame(Board& board, Parameters whiteParameters,
             std::vector<Move> sampledVar = black.getPrincipalVariation();
             #else
             std::vector<Move> sampledVar;
-            std::tie(logProb, sampledVar) = sampleVariation(black.getVariations(), tau);
+            std::tie(logProb, sampledVar) = sampleVariation(black.getVariations(), tau, worker.rng);
             tau *= temperatureDecay;
             #endif
 
@@ -214,7 +337,6 @@ Result Simulation::simulateSingleGame(Board& board, Parameters whiteParameters,
             if(board.getSideToMove() == BLACK)
                 evaluation = -evaluation;
             result.leafEvaluations.push_back(evaluation);
-            result.leafFENs.push_back(board.toFEN());
             result.logProbs.push_back(logProb);
 
             // Mache die Züge wieder rückgängig
@@ -224,7 +346,7 @@ Result Simulation::simulateSingleGame(Board& board, Parameters whiteParameters,
             Move chosenMove = sampledVar[0];
             board.makeMove(chosenMove);
 
-            btime -= std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count();
+            btime -= getElapsedTime(black, begin, end);
             btime = std::max(btime, 0);
             btime += increment;
 
@@ -242,8 +364,7 @@ Result Simulation::simulateSingleGame(Board& board, Parameters whiteParameters,
 }
 
 void Simulation::run() {
-    std::cout << "Simulating " << startingPositions.size() << " games ("
-              << timeControl / 1000.0 << "s + " << increment / 1000.0 << "s increment) "
+    std::cout << "Simulating " << startingPositions.size() << " games (" << getLimitsDescription() << ") "
               << "with " << numThreads << " threads..." << std::endl;
 
     std::cout << "Remaining games: " << std::left << std::setw(7) << startingPositions.size();
@@ -256,7 +377,11 @@ void Simulation::run() {
     std::atomic_uint64_t whiteWins = 0, blackWins = 0, draws = 0;
     std::atomic_uint64_t completedGames = 0;
 
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
     auto threadFunction = [&]() {
+        Worker worker(currentParams, hashSize);
+
         lock.lock();
         while(true) {
             if(currentIdx.load() < 0) {
@@ -265,10 +390,13 @@ void Simulation::run() {
             }
 
             size_t index = currentIdx.fetch_sub(1);
-            Board& board = startingPositions[index];
             lock.unlock();
 
-            Result result = simulateSingleGame(board, currentParams, currentParams);
+            // Die Partie wird auf dem Schachbrett des Threads gespielt und
+            // anschließend mit allen Zügen in die Startposition zurückkopiert
+            worker.board = startingPositions[index];
+            Result result = simulateSingleGame(worker, currentParams, currentParams, index);
+            startingPositions[index] = worker.board;
             results[index] = result;
             completedGames.fetch_add(1);
 
@@ -308,11 +436,12 @@ void Simulation::run() {
     std::cout << " | White wins: " << std::setw(7) << whiteWins.load();
     std::cout << " | Black wins: " << std::setw(7) << blackWins.load();
     std::cout << " | Draws: " << std::setw(7) << draws.load() << std::endl;
+
+    printThroughput(startingPositions.size(), start);
 }
 
 void Simulation::run(EloTableType& eloTable, double playerChoiceTemperature) {
-    std::cout << "Refining Elo ratings with " << startingPositions.size() << " games ("
-              << timeControl / 1000.0 << "s + " << increment / 1000.0 << "s increment) "
+    std::cout << "Refining Elo ratings with " << startingPositions.size() << " games (" << getLimitsDescription() << ") "
               << "with " << numThreads << " threads..." << std::endl;
 
     // Bestimme die Matchups
@@ -332,7 +461,11 @@ void Simulation::run(EloTableType& eloTable, double playerChoiceTemperature) {
     std::atomic_int64_t currentIdx = startingPositions.size() - 1;
     std::atomic_uint64_t completedGames = 0;
 
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
     auto threadFunction = [&]() {
+        Worker worker(currentParams, hashSize);
+
         lock.lock();
         while(true) {
             if(currentIdx.load() < 0) {
@@ -341,8 +474,6 @@ void Simulation::run(EloTableType& eloTable, double playerChoiceTemperature) {
             }
 
             size_t index = currentIdx.fetch_sub(1);
-            Board board1 = startingPositions[index];
-            Board board2 = startingPositions[index];
             std::string player1 = matchups[index].first;
             std::string player2 = matchups[index].second;
             lock.unlock();
@@ -351,11 +482,13 @@ void Simulation::run(EloTableType& eloTable, double playerChoiceTemperature) {
             Parameters params2 = eloTable.getData(player2);
 
             // Hinspiel
-            Result result1 = simulateSingleGame(board1, params1, params2);
+            worker.board = startingPositions[index];
+            Result result1 = simulateSingleGame(worker, params1, params2, index * 2);
             results[index * 2] = result1;
 
             // Rückspiel
-            Result result2 = simulateSingleGame(board2, params2, params1);
+            worker.board = startingPositions[index];
+            Result result2 = simulateSingleGame(worker, params2, params1, index * 2 + 1);
             results[index * 2 + 1] = result2;
 
             // Sieger bestimmen
@@ -418,4 +551,69 @@ void Simulation::run(EloTableType& eloTable, double playerChoiceTemperature) {
         threads[i].join();
 
     std::cout << std::endl;
+
+    printThroughput(startingPositions.size() * 2, start);
+}
+
+void Simulation::printThroughput(size_t numGames, std::chrono::steady_clock::time_point start) {
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double gamesPerHour = seconds > 0.0 ? numGames * 3600.0 / seconds : 0.0;
+
+    std::cout << "Played " << numGames << " games in " << std::fixed << std::setprecision(1) << seconds
+              << "s (" << std::setprecision(0) << gamesPerHour << " games/hour)" << std::defaultfloat
+              << std::setprecision(6) << std::endl;
+}
+
+void Simulation::writeResults(TrainingDataWriter& writer, const std::vector<unsigned int>& startingMoves) {
+    std::cout << "Writing results to file..." << std::endl;
+    std::cout << "Remaining games: " << startingPositions.size() << std::flush;
+
+    std::vector<DataPoint> game;
+
+    for(size_t i = 0; i < startingPositions.size(); i++) {
+        int outputSize = (int)startingPositions[i].getAge() - (int)startingMoves[i];
+        if(outputSize <= 0)
+            continue;
+
+        int8_t finalResult;
+        switch(results[i].result) {
+            case WHITE_WIN:
+                finalResult = 1;
+                break;
+            case BLACK_WIN:
+                finalResult = -1;
+                break;
+            default:
+                finalResult = 0;
+                break;
+        }
+
+        game.resize(results[i].leafEvaluations.size());
+
+        for(int j = (int)results[i].leafEvaluations.size() - 1; j >= 0; j--) {
+            // Mache den letzten Zug rückgängig, das Spiel ist da schon vorbei
+            startingPositions[i].undoMove();
+
+            int leafEvaluation = std::clamp(results[i].leafEvaluations[j], (int)std::numeric_limits<int16_t>::min(),
+                                            (int)std::numeric_limits<int16_t>::max());
+
+            game[j] = {
+                .board = startingPositions[i].toPackedBoard(),
+                .flags = 0,
+                .leafEvaluation = (int16_t)leafEvaluation,
+                .finalResult = finalResult,
+                .reserved = 0,
+                .logProb = (float)results[i].logProbs[j],
+                .tdTarget = 0.0f
+            };
+        }
+
+        writer.writeGame(game);
+
+        if(i % 10 == 0)
+            std::cout << "\rRemaining games: " << std::left << std::setw(7) <<
+            startingPositions.size() - i << std::right << std::flush;
+    }
+
+    std::cout << "\rRemaining games: 0      " << std::endl;
 }
\ No newline at end of file
@@ -7,16 +7,22 @@
 #include "core/utils/hce/HCEParameters.h"
 #include "core/utils/nnue/NNUEInstance.h"
 #include "tune/EloTable.h"
+#include "uci/UCI.h"
 
+#include <algorithm>
+#include <chrono>
 #include <optional>
 #include <stdint.h>
+#include <string>
 #include <vector>
 
+class PVSEngine;
+class TrainingDataWriter;
+
 class Result {
     public:
         GameResult result;
         std::vector<int> leafEvaluations;
-        std::vector<std::string> leafFENs;
         std::vector<double> logProbs;
 };
 
@@ -49,10 +55,80 @@ class Simulation {
         double temperature;
         double temperatureDecay;
 
-        Result simulateSingleGame(Board& board, Parameters whiteParams, Parameters blackParams);
+        /**
+         * @brief Die Größe der Transpositionstabelle jeder Engine in MB.
+         */
+        size_t hashSize;
+
+        /**
+         * Die Suchlimits für eine deterministische Simulation. Ist eines der
+         * Limits gesetzt, wird die Bedenkzeit ignoriert und das Ergebnis einer
+         * Partie hängt weder von der Auslastung noch von der Anzahl der Threads ab.
+         */
+
+        uint64_t nodeLimit;
+        int depthLimit;
+
+        /**
+         * @brief Wenn größer 0, wird die Bedenkzeit nicht in Millisekunden,
+         * sondern in Knoten gemessen (Knoten pro Millisekunde).
+         */
+        double nodesPerMillisecond;
+
+        /**
+         * @brief Der Startwert, aus dem die Zufallsgeneratoren der Partien abgeleitet werden.
+         */
+        uint32_t seed;
+
+        /**
+         * @brief Die Engines eines Simulationsthreads. Sie werden einmal pro
+         * Thread erstellt und für alle Partien des Threads wiederverwendet.
+         */
+        struct Worker;
+
+        /**
+         * @brief Spielt eine Partie ausgehend von der Position
+         * auf dem Schachbrett des Threads.
+         */
+        Result simulateSingleGame(Worker& worker, const Parameters& whiteParams, const Parameters& blackParams, size_t gameIndex);
+
+        /**
+         * @brief Berechnet den Startwert des Zufallsgenerators einer Partie.
+         */
+        uint32_t gameSeed(size_t gameIndex) const;
+
+        /**
+         * @brief Bestimmt die Suchparameter für den nächsten Zug.
+         *
+         * @param board Die aktuelle Position.
+         * @param wtime Die verbleibende Bedenkzeit von Weiß.
+         * @param btime Die verbleibende Bedenkzeit von Schwarz.
+         */
+        UCI::SearchParams getSearchParams(const Board& board, int32_t wtime, int32_t btime) const;
+
+        /**
+         * @brief Bestimmt die Bedenkzeit, die eine Suche verbraucht hat.
+         * Wird die Bedenkzeit in Knoten gemessen, ist das Ergebnis deterministisch.
+         */
+        int64_t getElapsedTime(const PVSEngine& engine, std::chrono::steady_clock::time_point begin,
+                               std::chrono::steady_clock::time_point end) const;
+
+        std::string getLimitsDescription() const;
+
+        /**
+         * @brief Gibt die Anzahl der gespielten Partien pro Stunde aus.
+         */
+        static void printThroughput(size_t numGames, std::chrono::steady_clock::time_point start);
 
         static constexpr unsigned int DRAW_AFTER_N_MOVES = 400;
 
+        /**
+         * @brief Die Standardgröße der Transpositionstabellen in MB.
+         * Bei kurzen Bedenkzeiten reicht eine deutlich kleinere Tabelle
+         * als im regulären Betrieb.
+         */
+        static constexpr size_t DEFAULT_HASH_SIZE = 16;
+
     public:
         Simulation(std::vector<Board>& startingPositions, uint32_t timeControl, uint32_t increment);
         Simulation(std::vector<Board>& startingPositions, uint32_t timeControl, uint32_t increment, size_t numThreads);
@@ -60,6 +136,16 @@ class Simulation {
         void run();
         void run(EloTableType& eloTable, double playerChoiceTemperature = 0.0);
 
+        /**
+         * @brief Schreibt die Positionen aller simulierten Partien als Datenpunkte
+         * in eine Trainingsdatei. Dabei werden die Züge der Partien zurückgenommen.
+         *
+         * @param writer Die Trainingsdatei.
+         * @param startingMoves Die Anzahl der Halbzüge, die vor der Simulation
+         * in der jeweiligen Startposition bereits gespielt waren.
+         */
+        void writeResults(TrainingDataWriter& writer, const std::vector<unsigned int>& startingMoves);
+
         inline std::vector<Result>& getResults() {
             return results;
         }
@@ -93,6 +179,37 @@ class Simulation {
         inline void setTemperatureDecay(double decay) {
             temperatureDecay = decay;
         }
+
+        /**
+         * @brief Setzt die Größe der Transpositionstabelle jeder Engine in MB.
+         * Jeder Thread verwendet zwei Engines.
+         */
+        inline void setHashSize(size_t megabytes) {
+            hashSize = std::max(megabytes, (size_t)1);
+        }
+
+        /**
+         * @brief Begrenzt jede Suche auf eine feste Anzahl an Knoten
+         * und/oder eine feste Tiefe (0 = kein Limit). Die Bedenkzeit
+         * wird dann ignoriert.
+         */
+        inline void setSearchLimits(uint64_t nodes, int depth) {
+            nodeLimit = nodes;
+            depthLimit = std::max(depth, 0);
+        }
+
+        /**
+         * @brief Misst die Bedenkzeit in Knoten anstatt in Millisekunden
+         * (0 = Millisekunden). Jede Millisekunde der Bedenkzeit entspricht
+         * dabei der gegebenen Anzahl an Knoten.
+         */
+        inline void setNodesPerMillisecond(double nodesPerMs) {
+            nodesPerMillisecond = std::max(nodesPerMs, 0.0);
+        }
+
+        inline void setSeed(uint32_t seed) {
+            this->seed = seed;
+        }
 };
 
 #endif
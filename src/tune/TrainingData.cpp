@@ -0,0 +1,247 @@
+#include "tune/TrainingData.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+TrainingDataWriter::TrainingDataWriter(const std::string& path, bool append) {
+    std::error_code error;
+    bool writeHeader = !append || !std::filesystem::exists(path, error) || std::filesystem::file_size(path, error) == 0;
+
+    file.open(path, std::ios::binary | (append ? std::ios::app : std::ios::trunc));
+    if(!file.is_open() || !writeHeader)
+        return;
+
+    TrainingDataHeader header{};
+    std::memcpy(header.magic, TrainingDataHeader::MAGIC, sizeof(header.magic));
+    header.version = TrainingDataHeader::VERSION;
+    header.recordSize = sizeof(DataPoint);
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+void TrainingDataWriter::writeGame(std::vector<DataPoint>& game) {
+    if(game.empty())
+        return;
+
+    for(DataPoint& dp : game)
+        dp.flags &= ~DataPoint::END_OF_GAME;
+
+    game.back().flags |= DataPoint::END_OF_GAME;
+
+    file.write(reinterpret_cast<const char*>(game.data()), game.size() * sizeof(DataPoint));
+    numRecords += game.size();
+}
+
+namespace {
+    /**
+     * @brief Überprüft, ob ein Dateikopf zu diesem Programm passt.
+     */
+    bool isValidHeader(const TrainingDataHeader& header) {
+        return std::memcmp(header.magic, TrainingDataHeader::MAGIC, sizeof(header.magic)) == 0 &&
+               header.version == TrainingDataHeader::VERSION &&
+               header.recordSize == sizeof(DataPoint);
+    }
+}
+
+TrainingDataFile::TrainingDataFile(const std::string& path) {
+    #ifdef _WIN32
+        std::ifstream file(path, std::ios::binary);
+        if(!file.is_open())
+            return;
+
+        TrainingDataHeader header;
+        if(!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || !isValidHeader(header))
+            return;
+
+        file.seekg(0, std::ios::end);
+        size_t fileSize = file.tellg();
+        file.seekg(sizeof(header), std::ios::beg);
+
+        buffer.resize((fileSize - sizeof(header)) / sizeof(DataPoint));
+        file.read(reinterpret_cast<char*>(buffer.data()), buffer.size() * sizeof(DataPoint));
+
+        records = buffer.data();
+        numRecords = buffer.size();
+    #else
+        int fd = open(path.c_str(), O_RDONLY);
+        if(fd < 0)
+            return;
+
+        struct stat fileStat;
+        if(fstat(fd, &fileStat) != 0 || (size_t)fileStat.st_size < sizeof(TrainingDataHeader)) {
+            close(fd);
+            return;
+        }
+
+        mappingSize = fileStat.st_size;
+        mapping = mmap(nullptr, mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+
+        if(mapping == MAP_FAILED) {
+            mapping = nullptr;
+            mappingSize = 0;
+            return;
+        }
+
+        const TrainingDataHeader* header = static_cast<const TrainingDataHeader*>(mapping);
+        if(!isValidHeader(*header))
+            return;
+
+        // Die Datenpunkte beginnen direkt nach dem Kopf. Da der Kopf 16 Bytes groß
+        // ist und die Einblendung an einer Seitengrenze beginnt, sind sie korrekt ausgerichtet.
+        records = reinterpret_cast<const DataPoint*>(static_cast<const char*>(mapping) + sizeof(TrainingDataHeader));
+        numRecords = (mappingSize - sizeof(TrainingDataHeader)) / sizeof(DataPoint);
+    #endif
+}
+
+TrainingDataFile::~TrainingDataFile() {
+    #ifndef _WIN32
+        if(mapping != nullptr)
+            munmap(mapping, mappingSize);
+    #endif
+}
+
+size_t convertTextSamples(const std::string& textPath, const std::string& binaryPath) {
+    std::ifstream textFile(textPath);
+    if(!textFile.is_open()) {
+        std::cerr << "Could not open " << textPath << std::endl;
+        return 0;
+    }
+
+    TrainingDataWriter writer(binaryPath);
+    if(!writer.isOpen()) {
+        std::cerr << "Could not open " << binaryPath << std::endl;
+        return 0;
+    }
+
+    std::cout << "Converted 0 data points" << std::flush;
+
+    std::vector<DataPoint> currentGame;
+
+    std::string line;
+    while(std::getline(textFile, line)) {
+        if(line == "NEW_GAME") {
+            writer.writeGame(currentGame);
+            currentGame.clear();
+
+            std::cout << "\rConverted " << writer.getNumRecords() << " data points" << std::flush;
+            continue;
+        }
+
+        if(line.empty())
+            continue;
+
+        std::stringstream ss(line);
+        std::string segment;
+        std::vector<std::string> parts;
+        while(std::getline(ss, segment, ';'))
+            parts.push_back(segment);
+
+        if(parts.size() < 5)
+            continue;
+
+        int leafEvaluation = std::clamp(std::stoi(parts[2]), (int)std::numeric_limits<int16_t>::min(),
+                                        (int)std::numeric_limits<int16_t>::max());
+
+        currentGame.push_back({
+            .board = Board(parts[0]).toPackedBoard(),
+            .flags = 0,
+            .leafEvaluation = (int16_t)leafEvaluation,
+            .finalResult = (int8_t)std::stoi(parts[3]),
+            .reserved = 0,
+            .logProb = std::stof(parts[4]),
+            .tdTarget = 0.0f
+        });
+    }
+
+    writer.writeGame(currentGame);
+
+    std::cout << "\rConverted " << writer.getNumRecords() << " data points" << std::endl;
+
+    return writer.getNumRecords();
+}
+
+void calculateTDTargets(DataPoint* game, size_t size) {
+    if(size == 0)
+        return;
+
+    double currentLambda = lambda.get<double>();
+    double currentDiscount = discount.get<double>();
+
+    double terminalValue = game[size - 1].finalResult * virtualMateScore.get<double>();
+    double tdTarget = terminalValue;
+
+    for(int i = (int)size - 1; i >= 0; i--) {
+        double nextSearchValue;
+        if(i == (int)size - 1)
+            nextSearchValue = terminalValue;
+        else
+            nextSearchValue = game[i + 1].leafEvaluation;
+
+        tdTarget = currentDiscount * ((1.0 - currentLambda) * nextSearchValue + currentLambda * tdTarget);
+        game[i].tdTarget = tdTarget;
+    }
+}
+
+std::vector<std::string> findTrainingDataShards(const std::string& path) {
+    std::vector<std::string> shards;
+
+    std::error_code error;
+    if(!std::filesystem::is_directory(path, error)) {
+        shards.push_back(path);
+        return shards;
+    }
+
+    for(const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(path, error))
+        if(entry.is_regular_file() && entry.path().extension() == ".bin")
+            shards.push_back(entry.path().string());
+
+    // Die Reihenfolge des Verzeichnisses ist nicht festgelegt
+    std::sort(shards.begin(), shards.end());
+
+    return shards;
+}
+
+std::vector<DataPoint> loadData(const std::string& path, size_t n) {
+    std::cout << "Loading data..." << std::endl;
+
+    std::vector<DataPoint> data;
+
+    for(const std::string& shard : findTrainingDataShards(path)) {
+        if(data.size() >= n)
+            break;
+
+        TrainingDataFile file(shard);
+        if(!file.isOpen()) {
+            std::cerr << "Could not open " << shard << " or it is not a valid training data file" << std::endl;
+            continue;
+        }
+
+        size_t gameStart = data.size();
+        data.insert(data.end(), file.begin(), file.begin() + std::min(n - data.size(), file.size()));
+
+        // Berechne die TD(lambda)-Zielwerte für jede Partie.
+        // Eine unvollständige letzte Partie wird wie eine beendete behandelt.
+        for(size_t i = gameStart; i < data.size(); i++) {
+            if((data[i].flags & DataPoint::END_OF_GAME) || i == data.size() - 1) {
+                calculateTDTargets(data.data() + gameStart, i + 1 - gameStart);
+                gameStart = i + 1;
+            }
+        }
+    }
+
+    std::cout << "Loaded " << data.size() << " data points" << std::endl;
+
+    return data;
+}
\ No newline at end of file
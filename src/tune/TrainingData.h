@@ -0,0 +1,144 @@
+#ifndef TRAINING_DATA_H
+#define TRAINING_DATA_H
+
+#include "tune/Definitions.h"
+
+#include <fstream>
+#include <limits>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Der Kopf einer binären Trainingsdatei. Auf den Kopf
+ * folgen die Datenpunkte ohne Zwischenraum im Format von DataPoint.
+ */
+struct TrainingDataHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t recordSize;
+    uint32_t reserved;
+
+    static constexpr char MAGIC[4] = {'C', 'E', 'T', 'D'};
+    static constexpr uint32_t VERSION = 1;
+};
+
+static_assert(sizeof(TrainingDataHeader) == 16);
+
+/**
+ * @brief Schreibt Datenpunkte in eine binäre Trainingsdatei.
+ */
+class TrainingDataWriter {
+    private:
+        std::ofstream file;
+        size_t numRecords = 0;
+
+    public:
+        /**
+         * @brief Öffnet eine Trainingsdatei zum Schreiben.
+         *
+         * @param path Der Pfad der Datei.
+         * @param append Gibt an, ob an eine bestehende Datei angehängt werden soll.
+         * Ist die Datei leer oder existiert sie nicht, wird ein neuer Kopf geschrieben.
+         */
+        TrainingDataWriter(const std::string& path, bool append = false);
+
+        inline bool isOpen() const {
+            return file.is_open();
+        }
+
+        inline void close() {
+            file.close();
+        }
+
+        /**
+         * @brief Schreibt alle Datenpunkte einer Partie in chronologischer Reihenfolge.
+         * Der letzte Datenpunkt wird als Ende der Partie markiert.
+         */
+        void writeGame(std::vector<DataPoint>& game);
+
+        inline size_t getNumRecords() const {
+            return numRecords;
+        }
+};
+
+/**
+ * @brief Eine binäre Trainingsdatei, die in den Speicher eingeblendet wird.
+ * Die Datenpunkte können direkt aus der Datei gelesen werden, ohne sie zu parsen.
+ * Auf Systemen ohne mmap wird die Datei stattdessen vollständig eingelesen.
+ */
+class TrainingDataFile {
+    private:
+        const DataPoint* records = nullptr;
+        size_t numRecords = 0;
+
+        void* mapping = nullptr;
+        size_t mappingSize = 0;
+
+        std::vector<DataPoint> buffer;
+
+    public:
+        /**
+         * @brief Öffnet eine Trainingsdatei zum Lesen.
+         * Wenn die Datei nicht geöffnet werden kann oder kein gültiges
+         * Format hat, ist das Objekt leer und isOpen() gibt false zurück.
+         */
+        explicit TrainingDataFile(const std::string& path);
+        ~TrainingDataFile();
+
+        TrainingDataFile(const TrainingDataFile&) = delete;
+        TrainingDataFile& operator=(const TrainingDataFile&) = delete;
+
+        inline bool isOpen() const {
+            return records != nullptr;
+        }
+
+        inline size_t size() const {
+            return numRecords;
+        }
+
+        inline const DataPoint& operator[](size_t index) const {
+            return records[index];
+        }
+
+        inline const DataPoint* begin() const {
+            return records;
+        }
+
+        inline const DataPoint* end() const {
+            return records + numRecords;
+        }
+};
+
+/**
+ * @brief Wandelt eine Textdatei mit Datenpunkten (eine Zeile
+ * FEN;leafFEN;leafEvaluation;finalResult;logProb pro Position,
+ * Partien getrennt durch NEW_GAME) in eine binäre Trainingsdatei um.
+ *
+ * @return Die Anzahl der geschriebenen Datenpunkte.
+ */
+size_t convertTextSamples(const std::string& textPath, const std::string& binaryPath);
+
+/**
+ * @brief Berechnet die TD(lambda)-Zielwerte aller Datenpunkte einer Partie.
+ *
+ * @param game Die Datenpunkte der Partie in chronologischer Reihenfolge.
+ * @param size Die Anzahl der Datenpunkte.
+ */
+void calculateTDTargets(DataPoint* game, size_t size);
+
+/**
+ * @brief Bestimmt die Dateien eines Trainingsdatensatzes. Ist der Pfad ein
+ * Verzeichnis, besteht der Datensatz aus allen .bin-Dateien darin (sortiert
+ * nach Namen), ansonsten nur aus der Datei selbst.
+ */
+std::vector<std::string> findTrainingDataShards(const std::string& path);
+
+/**
+ * @brief Lädt die ersten n Datenpunkte aus einer binären Trainingsdatei
+ * (oder einem Verzeichnis mit mehreren Dateien) und berechnet für
+ * jede Partie die TD(lambda)-Zielwerte.
+ */
+std::vector<DataPoint> loadData(const std::string& path, size_t n = std::numeric_limits<size_t>::max());
+
+#endif
\ No newline at end of file
@@ -5,8 +5,10 @@
 
 std::vector<Variable*> tuneVariables;
 
-Variable pgnFilePath("pgnFile", "Path to the PGN file for sampling opening positions", "pgn/o-deville.pgn");
-Variable samplesFilePath("samplesFilePath", "Path to the file for storing generated samples", "data/samples.txt");
+Variable pgnFilePath("pgnFile", "Path to the PGN file (or openings file) for sampling opening positions", "pgn/o-deville.pgn");
+Variable samplesFilePath("samplesFilePath", "Path to the file for storing generated samples", "data/samples.bin");
+Variable openingsFilePath("openingsFile", "Path to the file for storing sampled opening positions", "data/openings.bin");
+Variable textSamplesFilePath("textSamplesFilePath", "Path to a text samples file to convert with the convert command", "data/samples.txt");
 unsigned int nThreads = std::thread::hardware_concurrency();
 Variable numThreads("numThreads", "Number of threads to use for the simulation", std::max(1u, (unsigned int)std::round(nThreads * 7.0 / 8)));
 Variable numGames("numGames", "Number of games to simulate at generation 0", 25ull);
@@ -19,6 +21,11 @@ Variable openingBookMovesMax("openingBookMovesMax", "Maximum number of half move
 Variable randomMovesMin("randomMovesMin", "Minimum number of random half moves to play before simulation", 0ull);
 Variable randomMovesMax("randomMovesMax", "Maximum number of random half moves to play before simulation", 0ull);
 Variable virtualMateScore("virtualMateScore", "Score in centipawns used for mate in TD(lambda)", 5000u);
+Variable simHashSize("simHash", "Transposition table size in MB of each engine during simulation", 16ull);
+Variable simNodes("simNodes", "Fixed number of nodes per move during simulation (0 = use time control)", 0ull);
+Variable simDepth("simDepth", "Fixed search depth per move during simulation (0 = use time control)", 0ull);
+Variable simNodesPerMs("simNodesPerMs", "Measure the time control in nodes instead of milliseconds at this rate (0 = use real time)", 0.0);
+Variable simSeed("simSeed", "Seed for the random parts of the simulated games", 42u);
 Variable startFromScratch("startFromScratch", "Whether to start training from scratch or continue with existing parameters", true);
 Variable validationSplit("validationSplit", "Fraction of the training data to use for validation", 0.0);
 Variable k("k", "Factor multiplied with the evaluation value inside the tanh function", 0.0025);
@@ -2,8 +2,10 @@
 #include "core/utils/Random.h"
 #include "tune/Definitions.h"
 #include "tune/hce/Tune.h"
+#include "tune/ml/AdamW.h"
 
 #include <atomic>
+#include <chrono>
 #include <iomanip>
 #include <iostream>
 #include <mutex>
@@ -39,13 +41,14 @@ namespace Tune {
         for(size_t i : indices) {
             // Extrahiere den Datenpunkt
             DataPoint& dp = data[i % data.size()];
+            Board board(dp.board);
 
             // Setze das Schachbrett auf die aktuelle Position
-            HandcraftedEvaluator evaluator(dp.board, hceParams);
+            HandcraftedEvaluator evaluator(board, hceParams);
 
             // Berechne die Vorhersage
             double prediction = tanh(evaluator.evaluate(), k);
-            if(dp.board.getSideToMove() == BLACK)
+            if(board.getSideToMove() == BLACK)
                 prediction = -prediction;
 
             double target = (1.0 - kappa) * tanh(dp.tdTarget, k) + kappa * (double)dp.finalResult;
@@ -85,13 +88,14 @@ namespace Tune {
                 for(size_t i = start; i < end; i++) {
                     // Extrahiere den Datenpunkt
                     DataPoint& dp = data[i];
+                    Board board(dp.board);
 
                     // Setze das Schachbrett auf die aktuelle Position
-                    HandcraftedEvaluator evaluator(dp.board, hceParams);
+                    HandcraftedEvaluator evaluator(board, hceParams);
 
                     // Berechne die Vorhersage
                     double prediction = tanh(evaluator.evaluate(), k);
-                    if(dp.board.getSideToMove() == BLACK)
+                    if(board.getSideToMove() == BLACK)
                         prediction = -prediction;
 
                     double target = (1.0 - kappa) * tanh(dp.tdTarget, k) + kappa * (double)dp.finalResult;
@@ -138,35 +142,46 @@ namespace Tune {
         std::mutex mutex;
 
         auto threadFunc = [&]() {
-            // Sperre den Mutex um den nächsten Parameter zu extrahieren
-            mutex.lock();
-            while(currIndex < HCEParameters::size()) {
-                size_t i = currIndex++;
-
-                // Überspringe nicht optimierbare Parameter
-                if(!hceParams.isOptimizable(i))
-                    continue;
+            // Jeder Thread summiert seinen Anteil des Gradienten lokal
+            std::vector<double> localGrad(hceParams.size(), 0);
+            HCETrace trace;
 
+            // Sperre den Mutex um die zu bearbeitenden Datenpunkte zu extrahieren
+            mutex.lock();
+            while(currIndex < indices.size()) {
+                // Bearbeite immer Blöcke von 256 Datenpunkten
+                size_t start = currIndex;
+                size_t end = std::min(currIndex + 256, indices.size());
+                currIndex = end;
                 mutex.unlock();
 
-                // Finite-Differenzen-Methode
-                HCEParameters hceParamsCopy = hceParams;
-                hceParamsCopy[i] += 1;
-                hceParamsCopy.unpackPSQT();
+                for(size_t j = start; j < end; j++) {
+                    // Extrahiere den Datenpunkt
+                    DataPoint& dp = data[indices[j] % data.size()];
+                    Board board(dp.board);
 
-                double l1 = loss(data, indices, hceParamsCopy, k, kappa, weightDecay);
+                    // Bewerte die Position und zeichne die Ableitung
+                    // der Bewertung nach den Parametern auf
+                    TracedHandcraftedEvaluator evaluator(board, hceParams, trace);
+                    double sign = board.getSideToMove() == BLACK ? -1.0 : 1.0;
+                    double t = tanh(evaluator.evaluate(), k);
 
-                hceParamsCopy[i] -= 2;
-                hceParamsCopy.unpackPSQT();
+                    double target = (1.0 - kappa) * tanh(dp.tdTarget, k) + kappa * (double)dp.finalResult;
 
-                double l2 = loss(data, indices, hceParamsCopy, k, kappa, weightDecay);
+                    // d/de (sign * tanh(k * e) - target)^2
+                    double dLossdEval = 2.0 * (sign * t - target) * sign * k * (1.0 - t * t);
 
-                grad[i] = (l1 - l2) / (2.0 * k);
+                    for(const HCETrace::Coefficient& coefficient : trace.getGradient())
+                        localGrad[coefficient.index] += dLossdEval * coefficient.value;
+                }
 
-                // Sperre den Mutex um den nächsten Parameter zu extrahieren
+                // Sperre den Mutex um die nächsten Datenpunkte zu extrahieren
                 mutex.lock();
             }
 
+            for(size_t i = 0; i < grad.size(); i++)
+                grad[i] += localGrad[i];
+
             mutex.unlock();
         };
 
@@ -179,9 +194,97 @@ namespace Tune {
         for(std::thread& t : threads)
             t.join();
 
+        for(size_t i = 0; i < grad.size(); i++) {
+            // Nicht optimierbare Parameter werden nicht verändert
+            if(!hceParams.isOptimizable(i)) {
+                grad[i] = 0;
+                continue;
+            }
+
+            grad[i] /= indices.size();
+
+            // Ableitung des Gewichtungsabfalls
+            if(hceParams[i] != 0)
+                grad[i] += weightDecay * (hceParams[i] > 0 ? 1.0 : -1.0) / (double)hceParams.size();
+        }
+
         return grad;
     }
 
+    void checkGradient(std::vector<DataPoint>& data, const HCEParameters& hceParams, double k, double kappa, size_t numSamples) {
+        std::vector<size_t> indices(std::min(numSamples, data.size()));
+        std::mt19937 rng(1);
+        std::uniform_int_distribution<size_t> dist(0, data.size() - 1);
+        for(size_t& i : indices)
+            i = dist(rng);
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<double> grad = gradient(data, indices, hceParams, k, kappa);
+        auto end = std::chrono::steady_clock::now();
+
+        std::cout << "Analytical gradient: " << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+                  << " ms for " << indices.size() << " positions" << std::endl;
+
+        // Vergleiche mit dem zentralen Differenzenquotienten. Da die Parameter ganzzahlig
+        // sind, ist der Vergleich nur für die (stückweise) linearen Terme exakt.
+        std::vector<double> numericalGrad(hceParams.size(), 0);
+        std::atomic<size_t> currIndex = 0;
+
+        auto threadFunc = [&]() {
+            HCEParameters hceParamsCopy = hceParams;
+
+            for(size_t i = currIndex++; i < hceParams.size(); i = currIndex++) {
+                if(!hceParams.isOptimizable(i))
+                    continue;
+
+                hceParamsCopy[i] = hceParams[i] + 1;
+                hceParamsCopy.unpackPSQT();
+                double l1 = loss(data, indices, hceParamsCopy, k, kappa);
+
+                hceParamsCopy[i] = hceParams[i] - 1;
+                hceParamsCopy.unpackPSQT();
+                double l2 = loss(data, indices, hceParamsCopy, k, kappa);
+
+                hceParamsCopy[i] = hceParams[i];
+                numericalGrad[i] = (l1 - l2) / 2.0;
+            }
+        };
+
+        start = std::chrono::steady_clock::now();
+
+        std::vector<std::thread> threads;
+        for(size_t i = 0; i < std::max(std::thread::hardware_concurrency(), 1u); i++)
+            threads.push_back(std::thread(threadFunc));
+
+        for(std::thread& t : threads)
+            t.join();
+
+        end = std::chrono::steady_clock::now();
+
+        std::cout << "Numerical gradient: " << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+                  << " ms" << std::endl;
+
+        double dot = 0, normAnalytical = 0, normNumerical = 0, maxError = 0;
+        size_t maxErrorIndex = 0;
+        for(size_t i = 0; i < grad.size(); i++) {
+            dot += grad[i] * numericalGrad[i];
+            normAnalytical += grad[i] * grad[i];
+            normNumerical += numericalGrad[i] * numericalGrad[i];
+
+            double error = std::abs(grad[i] - numericalGrad[i]);
+            if(error > maxError) {
+                maxError = error;
+                maxErrorIndex = i;
+            }
+        }
+
+        double cosine = dot / std::max(std::sqrt(normAnalytical * normNumerical), 1e-300);
+
+        std::cout << "Cosine similarity: " << cosine << std::endl;
+        std::cout << "Max abs error: " << maxError << " at index " << maxErrorIndex << " (analytical " << grad[maxErrorIndex]
+                  << ", numerical " << numericalGrad[maxErrorIndex] << ")" << std::endl;
+    }
+
     HCEParameters adam(std::vector<DataPoint>& data, const HCEParameters& hceParams, size_t numEpochs, double learningRate) {
         HCEParameters currentParams = hceParams;
         HCEParameters bestParams = hceParams;
@@ -206,6 +309,9 @@ namespace Tune {
 
         std::mt19937& rng = Random::generator<9>();
 
+        // Der Weight Decay ist bereits im Fehler enthalten
+        ML::AdamW adam(beta1.get<double>(), beta2.get<double>(), epsilon.get<double>(), 0.0, 1);
+
         // Initialisiere den Zähler für die Geduld
         size_t patience = 0;
 
@@ -247,31 +353,18 @@ namespace Tune {
             // Berechne den Gradienten
             grad = Tune::gradient(data, indices, currentParams, k.get<double>(), kappa.get<double>(), weightDecay.get<double>());
 
-            // Berechne die ersten und zweiten Momente
-            for(size_t i = 0; i < currentParams.size(); i++) {
-                trainingSession.m[i] = beta1.get<double>() * trainingSession.m[i] + (1.0 - beta1.get<double>()) * grad[i];
-                trainingSession.v[i] = beta2.get<double>() * trainingSession.v[i] + (1.0 - beta2.get<double>()) * grad[i] * grad[i];
-            }
-
-            // Aktualisiere die Parameter
-            for(size_t i = 0; i < currentParams.size(); i++) {
-                // Überspringe nicht optimierbare Parameter
+            // Nicht optimierbare Parameter werden nicht verändert
+            for(size_t i = 0; i < currentParams.size(); i++)
                 if(!currentParams.isOptimizable(i))
-                    continue;
+                    grad[i] = 0.0;
 
-                // Berechne den Bias-korrigierten ersten und zweiten Moment
-                double mHat = trainingSession.m[i] / (1 - std::pow(beta1.get<double>(), trainingSession.epoch + 1));
-                double vHat = trainingSession.v[i] / (1 - std::pow(beta2.get<double>(), trainingSession.epoch + 1));
+            // Aktualisiere die Parameter mit Adam
+            adam.beginStep(trainingSession.epoch + 1, learningRate);
+            adam.update(trainingSession.exactParams.data(), trainingSession.m.data(), trainingSession.v.data(), grad.data(), grad.size());
 
-                // Berechne die Lernrate
-                double lr = learningRate / (std::sqrt(vHat) + epsilon.get<double>());
-
-                // Aktualisiere den Parameter
-                trainingSession.exactParams[i] -= lr * mHat;
-
-                // Aktualisiere den Parameter im Parametersatz
-                currentParams[i] = std::round(trainingSession.exactParams[i]);
-            }
+            for(size_t i = 0; i < currentParams.size(); i++)
+                if(currentParams.isOptimizable(i))
+                    currentParams[i] = std::round(trainingSession.exactParams[i]);
 
             // Die Positionstabellen müssen neu entpackt werden
             currentParams.unpackPSQT();
@@ -85,6 +85,8 @@ namespace Tune {
      * @brief Berechnet den Gradienten des MSE eines Parametersatzes auf einem Datensatz.
      * Zusätzlich werden die Indizes der Datenpunkte übergeben,
      * die für die Berechnung des Gradienten verwendet werden sollen.
+     * Die Ableitung der Bewertung nach den Parametern wird über einen HCETrace
+     * bestimmt, sodass jede Position nur einmal bewertet werden muss.
      * 
      * @param data Der Datensatz.
      * @param indices Die Indizes der Datenpunkte, die für die Berechnung des Gradienten verwendet werden sollen.
@@ -96,6 +98,18 @@ namespace Tune {
      */
     std::vector<double> gradient(std::vector<DataPoint>& data, const std::vector<size_t>& indices, const HCEParameters& hceParams, double k, double kappa, double weightDecay = 0.0);
 
+    /**
+     * @brief Vergleicht den Gradienten aus gradient() mit dem zentralen
+     * Differenzenquotienten und gibt die Abweichung und die Laufzeiten aus.
+     *
+     * @param data Der Datensatz.
+     * @param hceParams Der Parametersatz.
+     * @param k Ein Faktor, der mit dem Argument der Sigmoid-Funktion multipliziert wird.
+     * @param kappa Wie stark soll das finale Ergebnis in das TD-Ziel einfließen.
+     * @param numSamples Die Anzahl der zufällig gewählten Datenpunkte.
+     */
+    void checkGradient(std::vector<DataPoint>& data, const HCEParameters& hceParams, double k, double kappa, size_t numSamples);
+
     /**
      * @brief Verbessert die Parameter eines HCE-Modells über Adam.
      * 
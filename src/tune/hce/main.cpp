@@ -1,7 +1,8 @@
 #include "core/chess/Board.h"
-#include "core/utils/magics/Magics.h"
 #include "core/utils/Random.h"
+#include "tune/Openings.h"
 #include "tune/Simulation.h"
+#include "tune/TrainingData.h"
 #include "tune/Definitions.h"
 #include "tune/hce/Tune.h"
 #include "uci/Options.h"
@@ -15,23 +16,19 @@
 #include <random>
 
 void simulateGames(size_t n, uint32_t timeControl, uint32_t increment, bool useNoisyParameters, double noiseDefaultStdDev,
-                   double noiseLinearStdDev, double noiseDecay, std::istream& pgnFile, std::ostream& outFile,
+                   double noiseLinearStdDev, double noiseDecay, TrainingDataWriter& writer,
                    std::optional<HCEParameters> params = std::nullopt);
 
 void generateData() {
-    std::ifstream pgnFile(pgnFilePath.get<std::string>());
-    std::ofstream resultFile(samplesFilePath.get<std::string>(), std::ios::app);
+    TrainingDataWriter writer(samplesFilePath.get<std::string>(), true);
 
     simulateGames(numGames.get<size_t>(), timeControl.get<uint32_t>(), increment.get<uint32_t>(), 
                   useNoisyParameters.get<bool>(), noiseDefaultStdDev.get<double>(), noiseLinearStdDev.get<double>(),
-                  noiseDecay.get<double>(), pgnFile, resultFile);
+                  noiseDecay.get<double>(), writer);
 
-    pgnFile.close();
-    resultFile.close();
+    writer.close();
 }
 
-std::vector<DataPoint> loadData(std::istream& resultFile, size_t n = std::numeric_limits<size_t>::max());
-
 void findOptimalK();
 
 void gradientDescent();
@@ -61,9 +58,6 @@ void displayParameters() {
 }
 
 int main() {
-    // Initialisere die Magic Bitboards
-    Magics::initializeMagics();
-
     // Setze die UCI-Option Threads auf 1
     UCI::options["Threads"] = 1;
 
@@ -77,11 +71,27 @@ int main() {
 
         if(input == "gen")
             generateData();
+        else if(input == "convert")
+            convertTextSamples(textSamplesFilePath.get<std::string>(), samplesFilePath.get<std::string>());
+        else if(input == "openings") {
+            std::vector<PackedBoard> openings = sampleOpenings(pgnFilePath.get<std::string>(), numGames.get<size_t>(),
+                                                               openingBookMovesMin.get<size_t>(), openingBookMovesMax.get<size_t>(),
+                                                               simSeed.get<uint32_t>(), numThreads.get<size_t>());
+
+            if(writeOpenings(openingsFilePath.get<std::string>(), openings))
+                std::cout << "Saved " << openings.size() << " openings to " << openingsFilePath.get<std::string>() << std::endl;
+            else
+                std::cerr << "Could not write " << openingsFilePath.get<std::string>() << std::endl;
+        }
         else if(input == "findK")
             findOptimalK();
         else if(input == "grad")
             gradientDescent();
-        else if(input == "printResult")
+        else if(input == "checkgrad") {
+            std::vector<DataPoint> data = loadData(samplesFilePath.get<std::string>());
+            if(!data.empty())
+                Tune::checkGradient(data, HCE_PARAMS, k.get<double>(), kappa.get<double>(), batchSize.get<size_t>());
+        } else if(input == "printResult")
             displayFinalEpoch();
         else if(input == "dp")
             displayParameters();
@@ -108,39 +118,22 @@ int main() {
 }
 
 void simulateGames(size_t n, uint32_t timeControl, uint32_t increment, bool useNoisyParameters, double noiseDefaultStdDev,
-                   double noiseLinearStdDev, double noiseDecay, std::istream& pgnFile, std::ostream& outFile,
+                   double noiseLinearStdDev, double noiseDecay, TrainingDataWriter& writer,
                    std::optional<HCEParameters> params) {
-    std::vector<Board> startingPositions;
-    std::vector<unsigned int> startingMoves;
-    startingPositions.reserve(n);
-    startingMoves.reserve(n);
-
     std::mt19937& generator = Random::generator<7>();
-    std::uniform_int_distribution openingBookMoves(openingBookMovesMin.get<size_t>(), openingBookMovesMax.get<size_t>());
     std::uniform_int_distribution randomMoves(randomMovesMin.get<size_t>(), randomMovesMax.get<size_t>());
 
-    std::cout << "Loaded 0 games" << std::flush;
+    // Wähle n zufällige Positionen aus der PGN-Datei aus
+    std::vector<PackedBoard> openings = sampleOpenings(pgnFilePath.get<std::string>(), n, openingBookMovesMin.get<size_t>(),
+                                                       openingBookMovesMax.get<size_t>(), generator(), numThreads.get<size_t>());
 
-    // Lade alle Positionen aus der PGN-Datei
-    size_t i = 0;
-    while(pgnFile.good()) {
-        startingPositions.push_back(std::get<0>(Board::fromPGN(pgnFile, openingBookMoves(generator))));
-        i++;
-
-        if(i % 10 == 0)
-            std::cout << "\rLoaded " << i << " games" << std::flush;
-    }
-
-    // Entferne die letzte Position, da sie nicht vollständig geladen wurde
-    if(!startingPositions.empty())
-        startingPositions.pop_back();
-
-    std::cout << "\rLoaded " << startingPositions.size() << " games" << std::endl;
+    std::vector<Board> startingPositions;
+    std::vector<unsigned int> startingMoves;
+    startingPositions.reserve(openings.size());
+    startingMoves.reserve(openings.size());
 
-    // Wähle n zufällige Positionen aus
-    std::shuffle(startingPositions.begin(), startingPositions.end(), generator);
-    if(startingPositions.size() > n)
-        startingPositions.resize(n);
+    for(const PackedBoard& opening : openings)
+        startingPositions.push_back(Board(opening));
 
     for(size_t i = 0; i < startingPositions.size(); i++) {
         size_t numRandomMoves = randomMoves(generator);
@@ -157,6 +150,10 @@ void simulateGames(size_t n, uint32_t timeControl, uint32_t increment, bool useN
     }
 
     Simulation sim(startingPositions, timeControl, increment, numThreads.get<size_t>());
+    sim.setHashSize(simHashSize.get<size_t>());
+    sim.setSearchLimits(simNodes.get<uint64_t>(), simDepth.get<int>());
+    sim.setNodesPerMillisecond(simNodesPerMs.get<double>());
+    sim.setSeed(simSeed.get<uint32_t>());
 
     if(params.has_value())
         sim.setParams(params.value());
@@ -168,136 +165,13 @@ void simulateGames(size_t n, uint32_t timeControl, uint32_t increment, bool useN
     }
     sim.run();
 
-    std::cout << "Writing results to file..." << std::endl;
-    std::cout << "Remaining games: " << startingPositions.size() << std::flush;
-
-    std::vector<Result>& results = sim.getResults();
-
-    for(size_t i = 0; i < startingPositions.size(); i++) {
-        int outputSize = (int)startingPositions[i].getAge() - (int)startingMoves[i];
-        if(outputSize <= 0)
-            continue;
-
-        std::vector<std::string> output;
-        output.resize(outputSize);
-
-        int finalResult;
-        switch(results[i].result) {
-            case WHITE_WIN:
-                finalResult = 1;
-                break;
-            case BLACK_WIN:
-                finalResult = -1;
-                break;
-            default:
-                finalResult = 0;
-                break;
-        }
-
-        for(int j = (int)results[i].leafEvaluations.size() - 1; j >= 0; j--) {
-            // Mache den letzten Zug rückgängig, das Spiel ist da schon vorbei
-            startingPositions[i].undoMove();
-
-            std::stringstream ss;
-            ss << startingPositions[i].toFEN() << ";" << results[i].leafFENs[j] << ";" <<
-                results[i].leafEvaluations[j] << ";" << finalResult << ";" << results[i].logProbs[j];
-            output[j] = ss.str();
-        }
-
-        for(int j = 0; j < outputSize; j++)
-            outFile << output[j] << "\n";
-
-        outFile << "NEW_GAME\n";
-
-        if(i % 10 == 0)
-            std::cout << "\rRemaining games: " << std::left << std::setw(7) <<
-            startingPositions.size() - i << std::right << std::flush;
-    }
-
-    std::cout << "\rRemaining games: 0      " << std::endl;
-}
-
-void calculateTDTargets(std::vector<DataPoint>& dest, std::vector<DataPoint>& rawData) {
-    double terminalValue = 0.0;
-    int finalResult = rawData.empty() ? 0 : rawData.back().finalResult;
-    
-    if(finalResult == 1)
-        terminalValue = virtualMateScore.get<double>();
-    else if(finalResult == -1)
-        terminalValue = -virtualMateScore.get<double>();
-    
-    double tdTarget = terminalValue;
-    double currentLambda = lambda.get<double>();
-    double currentDiscount = discount.get<double>();
-
-    for(int j = (int)rawData.size() - 1; j >= 0; j--) {
-        double nextSearchValue;
-        if(j == (int)rawData.size() - 1)
-            nextSearchValue = terminalValue;
-        else
-            nextSearchValue = rawData[j + 1].leafEvaluation;
-
-        tdTarget = currentDiscount * ((1.0 - currentLambda) * nextSearchValue + currentLambda * tdTarget);
-
-        dest.push_back({rawData[j].board, rawData[j].leafBoard, rawData[j].leafEvaluation, finalResult, rawData[j].logProb, tdTarget});
-    }
-}
-
-std::vector<DataPoint> loadData(std::istream& resultFile, size_t n) {
-    std::cout << "Loading data..." << std::endl;
-
-    std::vector<DataPoint> data;
-
-    std::cout << "Loaded 0 data points" << std::flush;
-
-    std::vector<DataPoint> currentGame;
-
-    std::string line;
-    while(std::getline(resultFile, line) && data.size() < n) {
-        if(line == "NEW_GAME") {
-            calculateTDTargets(data, currentGame);
-            currentGame.clear();
-
-            if(data.size() % 10 == 0)
-                std::cout << "\rLoaded " << data.size() << " data points" << std::flush;
-
-            continue;
-        }
-
-        if(line.empty())
-            continue;
-
-        std::stringstream ss(line);
-        std::string segment;
-        std::vector<std::string> parts;
-        while(std::getline(ss, segment, ';'))
-            parts.push_back(segment);
-
-        if(parts.size() < 5)
-            continue;
-
-        Board board(parts[0]);
-        Board leafBoard(parts[1]);
-        int leafEvaluation = std::stoi(parts[2]);
-        int finalResult = std::stoi(parts[3]);
-        double logProb = std::stod(parts[4]);
-
-        currentGame.push_back({board, leafBoard, leafEvaluation, finalResult, logProb, 0.0});
-    }
-
-    calculateTDTargets(data, currentGame);
-
-    std::cout << "\rLoaded " << data.size() << " data points" << std::endl;
-
-    return data;
+    sim.writeResults(writer, startingMoves);
 }
 
 void findOptimalK() {
     std::cout << "Finding optimal k..." << std::endl;
 
-    std::ifstream samplesFile(samplesFilePath.get<std::string>());
-    std::vector<DataPoint> data = loadData(samplesFile);
-    samplesFile.close();
+    std::vector<DataPoint> data = loadData(samplesFilePath.get<std::string>());
 
     double bestLoss = std::numeric_limits<double>::max(), loss = 1.0, bestK = 0.0;
     int i = 1;
@@ -331,9 +205,7 @@ void gradientDescent() {
 
     Tune::trainingSession = Tune::TrainingSession(currentHCEParams);
 
-    std::ifstream samplesFile(samplesFilePath.get<std::string>());
-    std::vector<DataPoint> data = loadData(samplesFile);
-    samplesFile.close();
+    std::vector<DataPoint> data = loadData(samplesFilePath.get<std::string>());
 
     HCEParameters bestHCEParams = Tune::adam(data, currentHCEParams, numEpochs.get<size_t>(), learningRate.get<double>());
 
@@ -398,16 +270,13 @@ void learn() {
         double currentLearningRate = learningRate.get<double>() * std::pow(learningRateDecay.get<double>(), i);
                 
         // Generiere die Datenpunkte
-        std::ifstream pgnFile(pgnFilePath.get<std::string>());
-        std::ofstream resultFile(samplesFilePath.get<std::string>(), std::ios::trunc);
+        TrainingDataWriter writer(samplesFilePath.get<std::string>());
         simulateGames(currentNumGames, currentTimeControl, currentIncrement, useNoisyParameters.get<bool>(),
-                      noiseDefaultStdDev.get<double>(), noiseLinearStdDev.get<double>(), noiseDecay.get<double>(), pgnFile, resultFile, params);
-        pgnFile.close();
-        resultFile.close();
+                      noiseDefaultStdDev.get<double>(), noiseLinearStdDev.get<double>(), noiseDecay.get<double>(), writer, params);
+        writer.close();
 
         // Lade die Datenpunkte
-        std::ifstream samplesFile(samplesFilePath.get<std::string>());
-        std::vector<DataPoint> data = loadData(samplesFile);
+        std::vector<DataPoint> data = loadData(samplesFilePath.get<std::string>());
 
         // Führe den Gradientenabstieg durch
         std::cout << "Optimizing parameters:" << std::endl;
@@ -0,0 +1,93 @@
+#include "tune/ml/AdamW.h"
+#include "tune/ml/Parallel.h"
+
+#include <cmath>
+
+using namespace ML;
+
+AdamW::AdamW(double beta1, double beta2, double epsilon, double weightDecay, size_t numThreads) :
+    beta1(beta1), beta2(beta2), epsilon(epsilon), weightDecay(weightDecay), numThreads(numThreads) {
+
+    for(size_t tDelta = 0; tDelta < DECAY_TABLE_SIZE; tDelta++) {
+        mDecayTable[tDelta] = std::pow(beta1, tDelta);
+        vDecayTable[tDelta] = std::pow(beta2, tDelta);
+    }
+
+    weightDecayTable.fill(1.0f);
+}
+
+void AdamW::beginStep(size_t t, double learningRate) {
+    mHatScale = 1.0 / (1.0 - std::pow(beta1, t));
+    vHatScale = 1.0 / (1.0 - std::pow(beta2, t));
+
+    // Der Weight Decay hängt von der Lernrate ab, die sich nur selten ändert
+    if(learningRate != this->learningRate) {
+        this->learningRate = learningRate;
+
+        for(size_t tDelta = 0; tDelta < DECAY_TABLE_SIZE; tDelta++)
+            weightDecayTable[tDelta] = std::pow(1.0 - learningRate * weightDecay, tDelta);
+    }
+}
+
+AdamWStep AdamW::getStep(size_t tDelta, float minWeight, float maxWeight) const {
+    AdamWStep step;
+
+    if(tDelta < DECAY_TABLE_SIZE) {
+        step.mDecay = mDecayTable[tDelta];
+        step.vDecay = vDecayTable[tDelta];
+        step.weightDecay = weightDecayTable[tDelta];
+    } else {
+        step.mDecay = std::pow(beta1, tDelta);
+        step.vDecay = std::pow(beta2, tDelta);
+        step.weightDecay = std::pow(1.0 - learningRate * weightDecay, tDelta);
+    }
+
+    step.mGradScale = 1.0 - beta1;
+    step.vGradScale = 1.0 - beta2;
+    step.mHatScale = mHatScale;
+    step.vHatScale = vHatScale;
+    step.learningRate = learningRate;
+    step.epsilon = epsilon;
+    step.minWeight = minWeight;
+    step.maxWeight = maxWeight;
+
+    return step;
+}
+
+void AdamW::update(float* w, float* m, float* v, const float* g, size_t n, float minWeight, float maxWeight) const {
+    AdamWStep step = getStep(1, minWeight, maxWeight);
+
+    parallelFor(n, MIN_WEIGHTS_PER_THREAD, numThreads, [&](size_t start, size_t end) {
+        __unsafe_adamw(w + start, m + start, v + start, g + start, end - start, step);
+    });
+}
+
+void AdamW::update(double* w, double* m, double* v, const double* g, size_t n) const {
+    double decay = 1.0 - learningRate * weightDecay;
+
+    for(size_t i = 0; i < n; i++) {
+        m[i] = beta1 * m[i] + (1.0 - beta1) * g[i];
+        v[i] = beta2 * v[i] + (1.0 - beta2) * g[i] * g[i];
+
+        w[i] = w[i] * decay - learningRate * m[i] * mHatScale / (std::sqrt(v[i] * vHatScale) + epsilon);
+    }
+}
+
+void AdamW::updateRows(HalfKAv2_hmLayer& layer, float* m, float* v, size_t* lastUpdate, size_t t,
+                       const HalfKAv2_hmLayer::Gradients& grads, float minWeight, float maxWeight) const {
+    size_t rowSize = layer.subnetSize;
+
+    parallelFor(grads.touchedRows.size(), MIN_ROWS_PER_THREAD, numThreads, [&](size_t start, size_t end) {
+        for(size_t i = start; i < end; i++) {
+            uint16_t feature = grads.touchedRows[i];
+            size_t offset = feature * rowSize;
+
+            // Anzahl der Schritte seit dem letzten Update dieses Features
+            size_t tDelta = t - lastUpdate[offset];
+            lastUpdate[offset] = t;
+
+            AdamWStep step = getStep(tDelta, minWeight, maxWeight);
+            __unsafe_adamw(layer.getRow(feature), m + offset, v + offset, grads.getRow(feature), rowSize, step);
+        }
+    });
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+#ifndef ML_ADAMW_H
+#define ML_ADAMW_H
+
+#include "tune/ml/HalfKAv2_hm.h"
+#include "tune/ml/MathImpl.h"
+
+#include <array>
+#include <limits>
+#include <stdint.h>
+#include <vector>
+
+namespace ML {
+    /**
+     * @brief Der AdamW-Optimierer für alle Trainer (HCE, NNUE und REN).
+     *
+     * Die Hyperparameter werden beim Erstellen und zu Beginn jedes Schritts
+     * in die Faktoren von AdamWStep umgerechnet, sodass die inneren Schleifen
+     * nur noch aus den Kernels in MathImpl.h bestehen. Die Faktoren des
+     * nachgetragenen Decays (Lazy AdamW) für dünn besetzte Gradienten werden
+     * aus Tabellen gelesen, anstatt für jede Zeile std::pow aufzurufen.
+     */
+    class AdamW {
+        public:
+            /**
+             * @brief Die Anzahl der Schritte, für die die Decay-Faktoren tabelliert werden.
+             * Größere Abstände werden mit std::pow berechnet.
+             */
+            static constexpr size_t DECAY_TABLE_SIZE = 64;
+
+            /**
+             * @brief Ab dieser Anzahl an Gewichten (bzw. Zeilen) pro Thread
+             * lohnt sich ein zusätzlicher Thread.
+             */
+            static constexpr size_t MIN_WEIGHTS_PER_THREAD = 1 << 16;
+            static constexpr size_t MIN_ROWS_PER_THREAD = 256;
+
+        private:
+            double beta1, beta2, epsilon, weightDecay;
+            double learningRate = 0.0;
+            size_t numThreads;
+
+            double mHatScale = 1.0, vHatScale = 1.0;
+
+            std::array<float, DECAY_TABLE_SIZE> mDecayTable, vDecayTable, weightDecayTable;
+
+        public:
+            /**
+             * @param weightDecay Der entkoppelte Weight Decay (pro Schritt wird mit 1 - learningRate * weightDecay multipliziert).
+             * @param numThreads Die maximale Anzahl an Threads für die Aktualisierung großer Parametermengen.
+             */
+            AdamW(double beta1, double beta2, double epsilon, double weightDecay, size_t numThreads);
+
+            /**
+             * @brief Bereitet einen Schritt vor.
+             *
+             * @param t Der Schritt, für den die Bias-Korrektur berechnet wird (beginnend bei 1).
+             * @param learningRate Die Lernrate des Schritts.
+             */
+            void beginStep(size_t t, double learningRate);
+
+            /**
+             * @brief Die Faktoren des aktuellen Schritts für Gewichte, deren
+             * letzte Aktualisierung tDelta Schritte zurückliegt.
+             */
+            AdamWStep getStep(size_t tDelta = 1, float minWeight = std::numeric_limits<float>::lowest(),
+                              float maxWeight = std::numeric_limits<float>::max()) const;
+
+            /**
+             * @brief Aktualisiert dicht besetzte Gewichte (und Momente) mit ihrem Gradienten.
+             * Große Parametermengen werden auf mehrere Threads aufgeteilt.
+             */
+            void update(float* w, float* m, float* v, const float* g, size_t n,
+                        float minWeight = std::numeric_limits<float>::lowest(),
+                        float maxWeight = std::numeric_limits<float>::max()) const;
+
+            /**
+             * @brief Aktualisiert Parameter in doppelter Genauigkeit (für die HCE-Parameter).
+             */
+            void update(double* w, double* m, double* v, const double* g, size_t n) const;
+
+            /**
+             * @brief Aktualisiert die Gewichtszeilen eines HalfKAv2_hm-Layers, die einen
+             * Gradienten haben (Lazy AdamW). Der Decay der Schritte seit der letzten
+             * Aktualisierung einer Zeile wird exakt nachgetragen. Die Zeilen werden
+             * auf mehrere Threads aufgeteilt, jede Zeile wird von genau einem Thread geschrieben.
+             *
+             * @param lastUpdate Der Schritt der letzten Aktualisierung. Nur der Eintrag
+             * am Anfang jeder Zeile wird gelesen und geschrieben.
+             * @param t Der aktuelle Schritt (wie in beginStep).
+             */
+            void updateRows(HalfKAv2_hmLayer& layer, float* m, float* v, size_t* lastUpdate, size_t t,
+                            const HalfKAv2_hmLayer::Gradients& grads, float minWeight, float maxWeight) const;
+    };
+}
+
+#endif
\ No newline at end of file
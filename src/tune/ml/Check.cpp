@@ -0,0 +1,360 @@
+#include "tune/ml/AdamW.h"
+#include "tune/ml/Check.h"
+#include "tune/ml/DenseLayer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace ML;
+
+namespace {
+    /**
+     * @brief Füllt einen Speicherbereich mit gleichverteilten Zufallszahlen.
+     */
+    void fillRandom(float* data, size_t n, std::mt19937& rng, float min = -1.0f, float max = 1.0f) {
+        std::uniform_real_distribution<float> dist(min, max);
+        for(size_t i = 0; i < n; i++)
+            data[i] = dist(rng);
+    }
+
+    /**
+     * @brief Gibt das Ergebnis einer Überprüfung aus.
+     */
+    bool report(const char* name, double error, double tolerance) {
+        bool passed = error <= tolerance;
+        std::cout << std::left << std::setw(48) << name << " max error: " << std::setw(12) << error
+                  << (passed ? "ok" : "FAILED") << std::endl;
+
+        return passed;
+    }
+
+    bool checkGemm(std::mt19937& rng) {
+        bool passed = true;
+
+        // Größen, die weder durch 4 Zeilen noch durch die Vektorbreite teilbar sind
+        const size_t sizes[][3] = {{1, 1, 1}, {3, 7, 5}, {4, 16, 16}, {5, 130, 33}, {32, 1024, 32}, {33, 32, 1}, {7, 300, 1024}};
+
+        double gemmError = 0.0, gemmTNError = 0.0;
+        for(const auto& [m, k, n] : sizes) {
+            std::vector<float> a(m * k), b(k * n), c(m * n), expected(m * n);
+            fillRandom(a.data(), a.size(), rng);
+            fillRandom(b.data(), b.size(), rng);
+            fillRandom(c.data(), c.size(), rng);
+
+            // C += A * B
+            expected = c;
+            for(size_t i = 0; i < m; i++)
+                for(size_t j = 0; j < n; j++)
+                    for(size_t p = 0; p < k; p++)
+                        expected[i * n + j] += a[i * k + p] * b[p * n + j];
+
+            __unsafe_gemm(c.data(), a.data(), b.data(), m, k, n);
+            for(size_t i = 0; i < c.size(); i++)
+                gemmError = std::max(gemmError, (double)std::abs(c[i] - expected[i]));
+
+            // C += A^T * B mit A als k x m (mit Nullen wie nach einer ReLU)
+            std::vector<float> at(k * m), bt(k * n), ct(m * n);
+            fillRandom(at.data(), at.size(), rng);
+            fillRandom(bt.data(), bt.size(), rng);
+            for(float& x : at)
+                x = std::max(x, 0.0f);
+
+            expected.assign(m * n, 0.0f);
+            for(size_t i = 0; i < m; i++)
+                for(size_t j = 0; j < n; j++)
+                    for(size_t p = 0; p < k; p++)
+                        expected[i * n + j] += at[p * m + i] * bt[p * n + j];
+
+            __unsafe_gemm_tn(ct.data(), at.data(), bt.data(), m, k, n);
+            for(size_t i = 0; i < ct.size(); i++)
+                gemmTNError = std::max(gemmTNError, (double)std::abs(ct[i] - expected[i]));
+        }
+
+        passed &= report("gemm (C += A * B)", gemmError, 1e-3);
+        passed &= report("gemm_tn (C += A^T * B)", gemmTNError, 1e-3);
+
+        return passed;
+    }
+
+    bool checkDenseLayer(std::mt19937& rng, size_t inputSize, size_t outputSize, bool useActivation) {
+        constexpr size_t BATCH_SIZE = 7;
+
+        DenseLayer layer(inputSize, outputSize, useActivation);
+        fillRandom(layer.weights.data(), layer.weights.size, rng, -0.3f, 0.3f);
+        fillRandom(layer.bias.data(), layer.bias.size, rng, 0.0f, 0.5f);
+
+        Matrix input(BATCH_SIZE, inputSize);
+        Matrix outputGrad(BATCH_SIZE, outputSize);
+        fillRandom(input.data(), input.size, rng, 0.0f, 1.0f);
+        fillRandom(outputGrad.data(), outputGrad.size, rng);
+
+        // Batch-Rückwärtspass
+        DenseLayer::BatchForwardResult batchForward = layer.forward(input, false);
+        DenseLayer::Gradients batchGrads(inputSize, outputSize);
+        Matrix batchInputGrad(BATCH_SIZE, inputSize);
+        layer.backward(input, batchForward, outputGrad, false, batchGrads, batchInputGrad);
+
+        // Rückwärtspass pro Datenpunkt
+        DenseLayer::Gradients sampleGrads(inputSize, outputSize);
+        double forwardError = 0.0, inputGradError = 0.0;
+        for(size_t b = 0; b < BATCH_SIZE; b++) {
+            Vector x(inputSize), dy(outputSize);
+            __unsafe_copy(x.data(), input.data() + b * inputSize, inputSize);
+            __unsafe_copy(dy.data(), outputGrad.data() + b * outputSize, outputSize);
+
+            DenseLayer::ForwardResult forward = layer.forward(x, false);
+            DenseLayer::Gradients grads = layer.backward(x, forward, dy, false);
+
+            for(size_t i = 0; i < outputSize; i++)
+                forwardError = std::max(forwardError, (double)std::abs(forward.output(i) - batchForward.output(i, b)));
+
+            for(size_t j = 0; j < inputSize; j++)
+                inputGradError = std::max(inputGradError, (double)std::abs(grads.inputGrad(j) - batchInputGrad(j, b)));
+
+            sampleGrads.weights += grads.weights;
+            sampleGrads.bias += grads.bias;
+        }
+
+        double weightGradError = 0.0;
+        for(size_t i = 0; i < sampleGrads.weights.size; i++)
+            weightGradError = std::max(weightGradError, (double)std::abs(sampleGrads.weights(i) - batchGrads.weights(i)));
+
+        for(size_t i = 0; i < outputSize; i++)
+            weightGradError = std::max(weightGradError, (double)std::abs(sampleGrads.bias(i) - batchGrads.bias(i)));
+
+        // Numerischer Gradient von L = sum(outputGrad * output) für einige Gewichte
+        auto lossFunc = [&]() {
+            DenseLayer::BatchForwardResult forward = layer.forward(input, false);
+            double loss = 0.0;
+            for(size_t i = 0; i < forward.output.size; i++)
+                loss += (double)forward.output(i) * outputGrad(i);
+
+            return loss;
+        };
+
+        constexpr double H = 1e-3;
+        double numericError = 0.0;
+        std::uniform_int_distribution<size_t> weightDist(0, layer.weights.size - 1);
+        for(size_t t = 0; t < 32; t++) {
+            size_t index = weightDist(rng);
+            float original = layer.weights(index);
+
+            layer.weights(index) = original + H;
+            double lossPlus = lossFunc();
+            layer.weights(index) = original - H;
+            double lossMinus = lossFunc();
+            layer.weights(index) = original;
+
+            double numeric = (lossPlus - lossMinus) / (2.0 * H);
+            numericError = std::max(numericError, std::abs(numeric - batchGrads.weights(index)) / std::max(1.0, std::abs(numeric)));
+        }
+
+        std::string name = "dense " + std::to_string(inputSize) + "x" + std::to_string(outputSize) + (useActivation ? " (ReLU)" : "");
+
+        bool passed = true;
+        passed &= report((name + " forward batch vs single").c_str(), forwardError, 1e-4);
+        passed &= report((name + " dW/db batch vs single").c_str(), weightGradError, 1e-3);
+        passed &= report((name + " dX batch vs single").c_str(), inputGradError, 1e-4);
+        passed &= report((name + " dW numeric").c_str(), numericError, 2e-2);
+
+        return passed;
+    }
+}
+
+bool ML::checkKernels() {
+    std::mt19937 rng(12345);
+
+    bool passed = checkGemm(rng);
+    passed &= checkDenseLayer(rng, 1024, 32, true);
+    passed &= checkDenseLayer(rng, 32, 32, true);
+    passed &= checkDenseLayer(rng, 32, 1, false);
+
+    std::cout << (passed ? "All checks passed" : "Some checks FAILED") << std::endl;
+
+    return passed;
+}
+
+void ML::benchmarkKernels() {
+    constexpr size_t BATCH_SIZE = 32;
+    constexpr size_t NUM_BATCHES = 2000;
+    constexpr size_t LAYER_SIZES[] = {1024, 32, 32, 1};
+
+    std::mt19937 rng(12345);
+
+    DenseLayer layers[3] = {
+        DenseLayer(LAYER_SIZES[0], LAYER_SIZES[1]),
+        DenseLayer(LAYER_SIZES[1], LAYER_SIZES[2]),
+        DenseLayer(LAYER_SIZES[2], LAYER_SIZES[3], false)
+    };
+
+    for(DenseLayer& layer : layers) {
+        fillRandom(layer.weights.data(), layer.weights.size, rng, -0.2f, 0.2f);
+        fillRandom(layer.bias.data(), layer.bias.size, rng, 0.0f, 0.2f);
+    }
+
+    Matrix input(BATCH_SIZE, LAYER_SIZES[0]);
+    fillRandom(input.data(), input.size, rng, 0.0f, 1.0f);
+
+    // Multiplikationen und Additionen eines Vorwärts- und Rückwärtspasses (3 Matrixprodukte pro Layer)
+    double flopsPerSample = 0.0;
+    for(size_t l = 0; l < 3; l++)
+        flopsPerSample += 3.0 * 2.0 * LAYER_SIZES[l] * LAYER_SIZES[l + 1];
+
+    double checksum = 0.0;
+
+    // Pro Datenpunkt
+    auto start = std::chrono::steady_clock::now();
+    for(size_t iteration = 0; iteration < NUM_BATCHES; iteration++) {
+        for(size_t b = 0; b < BATCH_SIZE; b++) {
+            Vector x(LAYER_SIZES[0]);
+            __unsafe_copy(x.data(), input.data() + b * LAYER_SIZES[0], LAYER_SIZES[0]);
+
+            DenseLayer::ForwardResult f1 = layers[0].forward(x, true);
+            DenseLayer::ForwardResult f2 = layers[1].forward(f1.output, true);
+            DenseLayer::ForwardResult f3 = layers[2].forward(f2.output, true);
+
+            Vector outputGrad(1);
+            outputGrad(0) = f3.output(0);
+
+            DenseLayer::Gradients g3 = layers[2].backward(f2.output, f3, outputGrad, true);
+            DenseLayer::Gradients g2 = layers[1].backward(f1.output, f2, g3.inputGrad, true);
+            DenseLayer::Gradients g1 = layers[0].backward(x, f1, g2.inputGrad, true);
+
+            checksum += g1.inputGrad(0);
+        }
+    }
+
+    double singleSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Im Batch
+    DenseLayer::Gradients grads[3] = {
+        DenseLayer::Gradients(LAYER_SIZES[0], LAYER_SIZES[1]),
+        DenseLayer::Gradients(LAYER_SIZES[1], LAYER_SIZES[2]),
+        DenseLayer::Gradients(LAYER_SIZES[2], LAYER_SIZES[3])
+    };
+
+    Matrix inputGrads[3] = {Matrix(BATCH_SIZE, LAYER_SIZES[0]), Matrix(BATCH_SIZE, LAYER_SIZES[1]), Matrix(BATCH_SIZE, LAYER_SIZES[2])};
+
+    start = std::chrono::steady_clock::now();
+    for(size_t iteration = 0; iteration < NUM_BATCHES; iteration++) {
+        DenseLayer::BatchForwardResult f1 = layers[0].forward(input, true);
+        DenseLayer::BatchForwardResult f2 = layers[1].forward(f1.output, true);
+        DenseLayer::BatchForwardResult f3 = layers[2].forward(f2.output, true);
+
+        layers[2].backward(f2.output, f3, f3.output, true, grads[2], inputGrads[2]);
+        layers[1].backward(f1.output, f2, inputGrads[2], true, grads[1], inputGrads[1]);
+        layers[0].backward(input, f1, inputGrads[1], true, grads[0], inputGrads[0]);
+
+        checksum += inputGrads[0](0);
+    }
+
+    double batchSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double numSamples = (double)BATCH_SIZE * NUM_BATCHES;
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Dense layers 1024->32->32->1, forward + backward, batch size " << BATCH_SIZE << std::endl;
+    std::cout << "Single: " << std::setw(8) << numSamples / singleSeconds / 1000.0 << "k samples/s "
+              << std::setw(8) << flopsPerSample * numSamples / singleSeconds / 1e9 << " GFLOP/s" << std::endl;
+    std::cout << "Batch:  " << std::setw(8) << numSamples / batchSeconds / 1000.0 << "k samples/s "
+              << std::setw(8) << flopsPerSample * numSamples / batchSeconds / 1e9 << " GFLOP/s" << std::endl;
+    std::cout << "Speedup: " << singleSeconds / batchSeconds << "x (checksum " << std::scientific << checksum << ")" << std::endl;
+    std::cout << std::defaultfloat;
+}
+
+void ML::benchmarkOptimizer() {
+    constexpr size_t OUTPUT_SIZE = 1024;
+    constexpr size_t NUM_TOUCHED_ROWS = 4096;
+    constexpr size_t NUM_STEPS = 200;
+
+    constexpr double BETA1 = 0.9, BETA2 = 0.999, EPSILON = 1e-8, WEIGHT_DECAY = 0.01, LEARNING_RATE = 0.001;
+
+    std::mt19937 rng(12345);
+
+    HalfKAv2_hmLayer layer(OUTPUT_SIZE);
+    fillRandom(layer.weights.data(), layer.weights.size, rng, -0.5f, 0.5f);
+
+    size_t rowSize = layer.subnetSize;
+    size_t numWeights = HalfKAv2_hmLayer::INPUT_SIZE * rowSize;
+
+    std::vector<float> m(numWeights, 0.0f), v(numWeights, 0.0f);
+    std::vector<size_t> lastUpdate(numWeights, 0);
+
+    // Jeder Schritt berührt eine andere zufällige Auswahl an Zeilen, damit
+    // die Decay-Faktoren unterschiedlich weit nachgetragen werden müssen
+    std::vector<HalfKAv2_hmLayer::Gradients> grads(8, HalfKAv2_hmLayer::Gradients(OUTPUT_SIZE));
+    std::uniform_int_distribution<size_t> featureDist(0, HalfKAv2_hmLayer::INPUT_SIZE - 1);
+    for(HalfKAv2_hmLayer::Gradients& g : grads)
+        for(size_t i = 0; i < NUM_TOUCHED_ROWS; i++)
+            fillRandom(g.row(featureDist(rng)), rowSize, rng, -0.01f, 0.01f);
+
+    double checksum = 0.0;
+
+    // Bisherige Aktualisierung: std::pow pro Zeile, ein Thread
+    auto start = std::chrono::steady_clock::now();
+    for(size_t t = 1; t <= NUM_STEPS; t++) {
+        const HalfKAv2_hmLayer::Gradients& g = grads[t % grads.size()];
+
+        AdamWStep step;
+        step.mGradScale = 1.0 - BETA1;
+        step.vGradScale = 1.0 - BETA2;
+        step.mHatScale = 1.0 / (1.0 - std::pow(BETA1, t));
+        step.vHatScale = 1.0 / (1.0 - std::pow(BETA2, t));
+        step.learningRate = LEARNING_RATE;
+        step.epsilon = EPSILON;
+        step.minWeight = std::numeric_limits<float>::lowest();
+        step.maxWeight = std::numeric_limits<float>::max();
+
+        for(uint16_t feature : g.touchedRows) {
+            size_t offset = feature * rowSize;
+            size_t tDelta = t - lastUpdate[offset];
+            std::fill_n(lastUpdate.begin() + offset, rowSize, t);
+
+            step.mDecay = std::pow(BETA1, tDelta);
+            step.vDecay = std::pow(BETA2, tDelta);
+            step.weightDecay = std::pow(1.0 - LEARNING_RATE * WEIGHT_DECAY, tDelta);
+
+            __unsafe_adamw(layer.getRow(feature), m.data() + offset, v.data() + offset, g.getRow(feature), rowSize, step);
+        }
+
+        checksum += layer.weights.data()[0];
+    }
+
+    double legacySeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::fill(m.begin(), m.end(), 0.0f);
+    std::fill(v.begin(), v.end(), 0.0f);
+    std::fill(lastUpdate.begin(), lastUpdate.end(), 0);
+
+    // Optimierer
+    AdamW adam(BETA1, BETA2, EPSILON, WEIGHT_DECAY, std::max(std::thread::hardware_concurrency(), 1u));
+
+    start = std::chrono::steady_clock::now();
+    for(size_t t = 1; t <= NUM_STEPS; t++) {
+        adam.beginStep(t, LEARNING_RATE);
+        adam.updateRows(layer, m.data(), v.data(), lastUpdate.data(), t, grads[t % grads.size()],
+                        std::numeric_limits<float>::lowest(), std::numeric_limits<float>::max());
+
+        checksum += layer.weights.data()[0];
+    }
+
+    double optimizerSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Gelesen werden Gewicht, Momente und Gradient, geschrieben Gewicht und Momente
+    double bytesPerStep = 7.0 * sizeof(float) * rowSize * NUM_TOUCHED_ROWS;
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Sparse AdamW step, " << NUM_TOUCHED_ROWS << " of " << HalfKAv2_hmLayer::INPUT_SIZE << " rows with " << rowSize << " weights" << std::endl;
+    std::cout << "Legacy:    " << std::setw(8) << legacySeconds / NUM_STEPS * 1000.0 << " ms/step "
+              << std::setw(8) << bytesPerStep * NUM_STEPS / legacySeconds / 1e9 << " GB/s" << std::endl;
+    std::cout << "Optimizer: " << std::setw(8) << optimizerSeconds / NUM_STEPS * 1000.0 << " ms/step "
+              << std::setw(8) << bytesPerStep * NUM_STEPS / optimizerSeconds / 1e9 << " GB/s" << std::endl;
+    std::cout << "Speedup: " << legacySeconds / optimizerSeconds << "x (checksum " << std::scientific << checksum << ")" << std::endl;
+    std::cout << std::defaultfloat;
+}
\ No newline at end of file
@@ -0,0 +1,27 @@
+#ifndef ML_CHECK_H
+#define ML_CHECK_H
+
+namespace ML {
+    /**
+     * @brief Überprüft die Matrixmultiplikationen gegen eine naive Implementierung
+     * und die Gradienten der Dense-Layer (einzeln und im Batch) gegen
+     * numerisch bestimmte Gradienten (zentrale Differenzen).
+     *
+     * @return true, wenn alle Abweichungen innerhalb der Toleranz liegen.
+     */
+    bool checkKernels();
+
+    /**
+     * @brief Misst die Laufzeit der Dense-Layer des NNUE-Netzwerks (1024 -> 32 -> 32 -> 1)
+     * für Vorwärts- und Rückwärtspässe pro Datenpunkt und im Batch.
+     */
+    void benchmarkKernels();
+
+    /**
+     * @brief Misst die Laufzeit eines AdamW-Schritts für den HalfKAv2_hm-Layer
+     * des NNUE-Netzwerks und vergleicht sie mit der bisherigen skalaren Aktualisierung.
+     */
+    void benchmarkOptimizer();
+}
+
+#endif
\ No newline at end of file
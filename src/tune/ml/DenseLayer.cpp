@@ -1,6 +1,8 @@
 #include "tune/ml/DenseLayer.h"
 #include "tune/ml/Quantization.h"
 
+#include <type_traits>
+
 using namespace ML;
 
 template <bool UseActivation, typename Q>
@@ -47,6 +49,111 @@ DenseLayer::Gradients DenseLayer::backwardImpl(const Vector& input,
     return grads;
 }
 
+template <typename Q>
+Matrix DenseLayer::quantizedWeights(Q q) const {
+    Matrix result(inputSize, outputSize);
+    for(size_t i = 0; i < weights.size; i++)
+        result(i) = q(weights(i));
+
+    return result;
+}
+
+template <bool UseActivation, typename Q>
+DenseLayer::BatchForwardResult DenseLayer::forwardBatchImpl(const Matrix& input, Q q) const {
+    size_t batchSize = input.outerDim;
+    assert(input.innerDim == inputSize);
+
+    BatchForwardResult result(batchSize, outputSize);
+
+    // Initialisiere jede Zeile mit dem Bias
+    for(size_t b = 0; b < batchSize; b++)
+        for(size_t i = 0; i < outputSize; i++)
+            result.preActivations(i, b) = q(bias(i));
+
+    // Die Gewichte sind bereits als inputSize x outputSize gespeichert
+    if constexpr (std::is_same_v<Q, Identity>)
+        __unsafe_gemm(result.preActivations.data(), input.data(), weights.data(), batchSize, inputSize, outputSize);
+    else
+        __unsafe_gemm(result.preActivations.data(), input.data(), quantizedWeights(q).data(), batchSize, inputSize, outputSize);
+
+    for(size_t i = 0; i < result.output.size; i++) {
+        if constexpr (UseActivation)
+            result.output(i) = clippedReLU(result.preActivations(i), Q::CLIPPED_RELU_MAX);
+        else
+            result.output(i) = result.preActivations(i);
+    }
+
+    return result;
+}
+
+template <bool UseActivation, typename Q>
+void DenseLayer::backwardBatchImpl(const Matrix& input, const BatchForwardResult& forwardResult, const Matrix& outputGrad,
+    Gradients& grads, Matrix& inputGrad, Q q) const {
+
+    size_t batchSize = input.outerDim;
+    assert(input.innerDim == inputSize && outputGrad.outerDim == batchSize && outputGrad.innerDim == outputSize);
+
+    // Gradient bezüglich der Voraktivierungen
+    Matrix preActivationGrad(batchSize, outputSize);
+    for(size_t i = 0; i < preActivationGrad.size; i++) {
+        if constexpr (UseActivation)
+            preActivationGrad(i) = clippedReLUDerivative(forwardResult.preActivations(i), Q::CLIPPED_RELU_MAX) ? outputGrad(i) : 0.0f;
+        else
+            preActivationGrad(i) = outputGrad(i);
+    }
+
+    for(size_t b = 0; b < batchSize; b++)
+        for(size_t i = 0; i < outputSize; i++)
+            grads.bias(i) += preActivationGrad(i, b);
+
+    // dW = X^T * dZ
+    __unsafe_gemm_tn(grads.weights.data(), input.data(), preActivationGrad.data(), inputSize, batchSize, outputSize);
+
+    // dX = dZ * W^T
+    Matrix transposedWeights(outputSize, inputSize);
+    if constexpr (std::is_same_v<Q, Identity>)
+        __unsafe_transpose(transposedWeights.data(), weights.data(), inputSize, outputSize);
+    else
+        __unsafe_transpose(transposedWeights.data(), quantizedWeights(q).data(), inputSize, outputSize);
+
+    if(inputGrad.outerDim != batchSize || inputGrad.innerDim != inputSize)
+        inputGrad = Matrix(batchSize, inputSize);
+    else
+        __unsafe_set_zero(inputGrad.data(), inputGrad.size);
+
+    __unsafe_gemm(inputGrad.data(), preActivationGrad.data(), transposedWeights.data(), batchSize, outputSize, inputSize);
+}
+
+DenseLayer::BatchForwardResult DenseLayer::forward(const Matrix& input, bool fakeQuant) const {
+    if(fakeQuant) {
+        if(useActivation)
+            return forwardBatchImpl<true>(input, ML::FakeQuantizationI8());
+        else
+            return forwardBatchImpl<false>(input, ML::FakeQuantizationI8());
+    } else {
+        if(useActivation)
+            return forwardBatchImpl<true>(input, ML::Identity());
+        else
+            return forwardBatchImpl<false>(input, ML::Identity());
+    }
+}
+
+void DenseLayer::backward(const Matrix& input, const BatchForwardResult& forwardResult, const Matrix& outputGrad,
+    bool fakeQuant, Gradients& grads, Matrix& inputGrad) const {
+
+    if(fakeQuant) {
+        if(useActivation)
+            backwardBatchImpl<true>(input, forwardResult, outputGrad, grads, inputGrad, ML::FakeQuantizationI8());
+        else
+            backwardBatchImpl<false>(input, forwardResult, outputGrad, grads, inputGrad, ML::FakeQuantizationI8());
+    } else {
+        if(useActivation)
+            backwardBatchImpl<true>(input, forwardResult, outputGrad, grads, inputGrad, ML::Identity());
+        else
+            backwardBatchImpl<false>(input, forwardResult, outputGrad, grads, inputGrad, ML::Identity());
+    }
+}
+
 DenseLayer::ForwardResult DenseLayer::forward(const Vector& input, bool fakeQuant) const {
     if(fakeQuant) {
         if(useActivation)
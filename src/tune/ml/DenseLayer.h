@@ -22,6 +22,18 @@ namespace ML {
                 inline ForwardResult(size_t s) : preActivations(s), output(s) {}
             };
 
+            /**
+             * @brief Die Aktivierungen eines Vorwärtspasses über einen ganzen Batch.
+             * Jede Zeile (batchSize x outputSize) gehört zu einem Datenpunkt.
+             */
+            struct BatchForwardResult {
+                Matrix preActivations;
+                Matrix output;
+
+                inline BatchForwardResult(size_t batchSize, size_t outputSize) :
+                    preActivations(batchSize, outputSize), output(batchSize, outputSize) {}
+            };
+
             Matrix weights;
             Vector bias;
             size_t inputSize;
@@ -35,12 +47,45 @@ namespace ML {
             ForwardResult forward(const Vector& input, bool fakeQuant) const;
             Gradients backward(const Vector& input, const ForwardResult& forwardResult, const Vector& outputGrad, bool fakeQuant) const;
 
+            /**
+             * @brief Führt einen Vorwärtspass für einen ganzen Batch als Matrixmultiplikation durch.
+             *
+             * @param input Die Eingaben (batchSize x inputSize), ein Datenpunkt pro Zeile.
+             */
+            BatchForwardResult forward(const Matrix& input, bool fakeQuant) const;
+
+            /**
+             * @brief Führt einen Rückwärtspass für einen ganzen Batch als Matrixmultiplikation durch.
+             *
+             * @param input Die Eingaben des Vorwärtspasses (batchSize x inputSize).
+             * @param forwardResult Die Aktivierungen des Vorwärtspasses.
+             * @param outputGrad Die Gradienten bezüglich der Ausgaben (batchSize x outputSize).
+             * @param grads Die über den Batch summierten Gradienten der Parameter werden hierzu addiert.
+             * Der Eingabegradient in grads wird nicht verwendet.
+             * @param inputGrad Wird mit den Gradienten bezüglich der Eingaben überschrieben (batchSize x inputSize).
+             */
+            void backward(const Matrix& input, const BatchForwardResult& forwardResult, const Matrix& outputGrad,
+                          bool fakeQuant, Gradients& grads, Matrix& inputGrad) const;
+
         private:
             template <bool UseActivation, typename Q>
             ForwardResult forwardImpl(const Vector& input, Q q) const;
 
             template <bool UseActivation, typename Q>
             Gradients backwardImpl(const Vector& input, const ForwardResult& forwardResult, const Vector& outputGrad, Q q) const;
+
+            template <bool UseActivation, typename Q>
+            BatchForwardResult forwardBatchImpl(const Matrix& input, Q q) const;
+
+            template <bool UseActivation, typename Q>
+            void backwardBatchImpl(const Matrix& input, const BatchForwardResult& forwardResult, const Matrix& outputGrad,
+                                   Gradients& grads, Matrix& inputGrad, Q q) const;
+
+            /**
+             * @brief Gibt die (ggf. quantisierten) Gewichte zeilenweise als inputSize x outputSize zurück.
+             */
+            template <typename Q>
+            Matrix quantizedWeights(Q q) const;
     };
 }
 
@@ -1,16 +1,86 @@
 #include "tune/ml/HalfKAv2_hm.h"
+#include "tune/ml/Parallel.h"
 #include "tune/ml/Quantization.h"
 
+#include <algorithm>
+
 using namespace ML;
 
-template <typename Q>
-HalfKAv2_hmLayer::ForwardResult HalfKAv2_hmLayer::forwardImpl(const Board& board, Q q) const {
-    HalfKAv2_hmLayer::ForwardResult result(subnetSize * 2);
+HalfKAv2_hmFeatures::HalfKAv2_hmFeatures(const Board& board) {
+    side = board.getSideToMove();
+
+    for(int perspective = 0; perspective < 2; perspective++) {
+        int color = perspective == 0 ? side : side ^ COLOR_MASK;
+        Array<int, 68> activeFeatures = NNUE::getHalfKPFeatures(board, color);
+
+        assert(activeFeatures.size() <= MAX_ACTIVE_FEATURES);
+
+        numActive[perspective] = activeFeatures.size();
+        for(size_t i = 0; i < activeFeatures.size(); i++)
+            indices[perspective][i] = activeFeatures[i];
+    }
+}
+
+float* HalfKAv2_hmLayer::Gradients::row(size_t feature) {
+    uint32_t offset = rowOffsets[feature];
+    if(offset != NO_ROW)
+        return rows.data() + offset;
+
+    offset = touchedRows.size() * rowSize;
+    rowOffsets[feature] = offset;
+    touchedRows.push_back(feature);
+
+    // Zeilen aus früheren Batches werden wiederverwendet
+    if(rows.size() < offset + rowSize)
+        rows.resize(offset + rowSize, 0.0f);
+    else
+        __unsafe_set_zero(rows.data() + offset, rowSize);
+
+    return rows.data() + offset;
+}
+
+void HalfKAv2_hmLayer::Gradients::clear() {
+    for(uint16_t feature : touchedRows)
+        rowOffsets[feature] = NO_ROW;
+
+    touchedRows.clear();
+    __unsafe_set_zero(bias.data(), bias.size);
+}
 
-    int color = board.getSideToMove();
+void HalfKAv2_hmLayer::Gradients::merge(const std::vector<const Gradients*>& sources, float scale, size_t numThreads) {
+    clear();
 
-    Array<int, 68> activeFeatures = NNUE::getHalfKPFeatures(board, color);
-    Array<int, 68> oppActiveFeatures = NNUE::getHalfKPFeatures(board, color ^ COLOR_MASK);
+    // Lege zuerst alle Zeilen an, damit die Threads
+    // den Speicher nicht mehr verändern müssen
+    for(const Gradients* source : sources) {
+        bias += source->bias;
+
+        for(uint16_t feature : source->touchedRows)
+            row(feature);
+    }
+
+    bias *= scale;
+
+    // Kleine Gradienten lohnen keine zusätzlichen Threads
+    parallelFor(touchedRows.size(), 256, numThreads, [&](size_t start, size_t end) {
+        for(size_t i = start; i < end; i++) {
+            uint16_t feature = touchedRows[i];
+            float* dest = rows.data() + rowOffsets[feature];
+
+            for(const Gradients* source : sources) {
+                const float* src = source->getRow(feature);
+                if(src != nullptr)
+                    __unsafe_add_self(dest, src, rowSize);
+            }
+
+            __unsafe_mul_self(dest, scale, rowSize);
+        }
+    });
+}
+
+template <typename Q>
+HalfKAv2_hmLayer::ForwardResult HalfKAv2_hmLayer::forwardImpl(const HalfKAv2_hmFeatures& features, Q q) const {
+    HalfKAv2_hmLayer::ForwardResult result(subnetSize * 2);
 
     // Kopiere Biases
     for(size_t i = 0; i < subnetSize; i++) {
@@ -20,14 +90,18 @@ HalfKAv2_hmLayer::ForwardResult HalfKAv2_hmLayer::forwardImpl(const Board& board
     }
 
     // Subnetz des Spielers am Zug
-    for(int feature : activeFeatures)
+    for(size_t f = 0; f < features.numActive[0]; f++) {
+        const float* row = getRow(features.indices[0][f]);
         for(size_t i = 0; i < subnetSize; i++)
-            result.preActivations(i) += q(weights(feature, i));
+            result.preActivations(i) += q(row[i]);
+    }
 
     // Subnetz des Gegners
-    for(int feature : oppActiveFeatures)
+    for(size_t f = 0; f < features.numActive[1]; f++) {
+        const float* row = getRow(features.indices[1][f]);
         for(size_t i = 0; i < subnetSize; i++)
-            result.preActivations(i + subnetSize) += q(weights(feature, i));
+            result.preActivations(i + subnetSize) += q(row[i]);
+    }
 
     // Aktivierungsfunktion (clipped ReLU)
     for(size_t i = 0; i < subnetSize * 2; i++)
@@ -37,49 +111,39 @@ HalfKAv2_hmLayer::ForwardResult HalfKAv2_hmLayer::forwardImpl(const Board& board
 }
 
 template <typename Q>
-HalfKAv2_hmLayer::Gradients HalfKAv2_hmLayer::backwardImpl(const Board& board,
-    const HalfKAv2_hmLayer::ForwardResult& forwardResult, const Vector& outputGrad) const {
-
-    Gradients grads(subnetSize * 2);
+void HalfKAv2_hmLayer::backwardImpl(const HalfKAv2_hmFeatures& features,
+    const HalfKAv2_hmLayer::ForwardResult& forwardResult, const Vector& outputGrad, Gradients& grads) const {
 
     Vector preActivationGrad(subnetSize * 2);
     for(size_t i = 0; i < subnetSize * 2; i++)
         preActivationGrad(i) = outputGrad(i) * (float)clippedReLUDerivative(forwardResult.preActivations(i), Q::CLIPPED_RELU_MAX);
 
-    int color = board.getSideToMove();
-    Array<int, 68> activeFeatures = NNUE::getHalfKPFeatures(board, color);
-    Array<int, 68> oppActiveFeatures = NNUE::getHalfKPFeatures(board, color ^ COLOR_MASK);
-
     // Bias ist in beiden Subnetzen gleich, Gradienten addieren
     for(size_t i = 0; i < subnetSize; i++)
-        grads.bias(i) = preActivationGrad(i) + preActivationGrad(i + subnetSize);
+        grads.bias(i) += preActivationGrad(i) + preActivationGrad(i + subnetSize);
 
     // Betrachte nur Gewichte zu aktiven Features,
     // alle anderen sind 0
 
-    for(int feature : activeFeatures)
-        for(size_t i = 0; i < subnetSize; i++)
-            grads.weights[feature * subnetSize + i] += preActivationGrad(i);
-
-    for(int feature : oppActiveFeatures)
-        for(size_t i = 0; i < subnetSize; i++)
-            grads.weights[feature * subnetSize + i] += preActivationGrad(i + subnetSize);
+    for(size_t f = 0; f < features.numActive[0]; f++)
+        __unsafe_add_self(grads.row(features.indices[0][f]), preActivationGrad.data(), subnetSize);
 
-    return grads;
+    for(size_t f = 0; f < features.numActive[1]; f++)
+        __unsafe_add_self(grads.row(features.indices[1][f]), preActivationGrad.data() + subnetSize, subnetSize);
 }
 
-HalfKAv2_hmLayer::ForwardResult HalfKAv2_hmLayer::forward(const Board& board, bool fakeQuant) const {
+HalfKAv2_hmLayer::ForwardResult HalfKAv2_hmLayer::forward(const HalfKAv2_hmFeatures& features, bool fakeQuant) const {
     if(fakeQuant)
-        return forwardImpl(board, ML::FakeQuantizationI16());
+        return forwardImpl(features, ML::FakeQuantizationI16());
     else
-        return forwardImpl(board, ML::Identity());
+        return forwardImpl(features, ML::Identity());
 }
 
-HalfKAv2_hmLayer::Gradients HalfKAv2_hmLayer::backward(const Board& board,
-    const HalfKAv2_hmLayer::ForwardResult& forwardResult, const Vector& outputGrad, bool fakeQuant) const {
+void HalfKAv2_hmLayer::backward(const HalfKAv2_hmFeatures& features,
+    const HalfKAv2_hmLayer::ForwardResult& forwardResult, const Vector& outputGrad, bool fakeQuant, Gradients& grads) const {
 
     if(fakeQuant)
-        return backwardImpl<ML::FakeQuantizationI16>(board, forwardResult, outputGrad);
+        backwardImpl<ML::FakeQuantizationI16>(features, forwardResult, outputGrad, grads);
     else
-        return backwardImpl<ML::Identity>(board, forwardResult, outputGrad);
+        backwardImpl<ML::Identity>(features, forwardResult, outputGrad, grads);
 }
\ No newline at end of file
@@ -1,24 +1,103 @@
 #ifndef ML_HALFKAV2_HM_H
 #define ML_HALFKAV2_HM_H
 
-#include <unordered_map>
+#include <limits>
+#include <stdint.h>
+#include <vector>
 
 #include "core/chess/Board.h"
 #include "core/utils/nnue/NNUEUtils.h"
 #include "tune/ml/Math.h"
 
 namespace ML {
+    /**
+     * @brief Die aktiven Features einer Position aus beiden Perspektiven.
+     * Kann einmalig aus einem Schachbrett extrahiert und danach
+     * beliebig oft für Vorwärts- und Rückwärtspässe verwendet werden.
+     */
+    struct HalfKAv2_hmFeatures {
+        /**
+         * @brief Höchstens 15 eigene Figuren (ohne König), 16 gegnerische Figuren,
+         * 4 Rochaden und ein En Passant Feld.
+         */
+        static constexpr size_t MAX_ACTIVE_FEATURES = 40;
+
+        /**
+         * @brief Die Indizes der aktiven Features. Index 0 enthält
+         * die Perspektive des Spielers am Zug, Index 1 die des Gegners.
+         */
+        uint16_t indices[2][MAX_ACTIVE_FEATURES];
+        uint8_t numActive[2];
+
+        /**
+         * @brief Die Farbe, die am Zug ist.
+         */
+        uint8_t side;
+
+        HalfKAv2_hmFeatures() = default;
+
+        explicit HalfKAv2_hmFeatures(const Board& board);
+    };
+
+    static_assert(NNUE::INPUT_SIZE <= std::numeric_limits<uint16_t>::max());
+
     /**
      * @brief Ein HalfKAv2_hmLayer mit Gewichten in voller Präzision.
      */
     class HalfKAv2_hmLayer {
         public:
+            /**
+             * @brief Die Gradienten des Layers. Nur die Gewichtszeilen aktiver Features
+             * haben einen Gradienten ungleich 0, daher werden nur die berührten Zeilen
+             * gespeichert, jede davon aber dicht (subnetSize Werte am Stück).
+             *
+             * Die Gradienten sind als Akkumulator gedacht, der über viele Datenpunkte
+             * und Batches wiederverwendet wird. Der Speicher der Zeilen wird beim
+             * Zurücksetzen nicht freigegeben.
+             */
             struct Gradients {
-                // Map (Index -> Gewicht), da die meisten Gradienten 0 sind
-                std::unordered_map<size_t, float> weights;
+                static constexpr uint32_t NO_ROW = std::numeric_limits<uint32_t>::max();
+
+                // Die berührten Features in der Reihenfolge ihrer ersten Berührung
+                std::vector<uint16_t> touchedRows;
+
+                // Der Offset der Gradientenzeile jedes Features in rows oder NO_ROW
+                std::vector<uint32_t> rowOffsets;
+
+                std::vector<float, AlignedAllocator<float, REQUIRED_ALIGNMENT>> rows;
                 Vector bias;
+                size_t rowSize;
 
-                inline Gradients(size_t outputSize) : bias(outputSize / 2) {}
+                inline Gradients(size_t outputSize) :
+                    rowOffsets(NNUE::INPUT_SIZE, NO_ROW), bias(outputSize / 2), rowSize(outputSize / 2) {}
+
+                /**
+                 * @brief Gibt die Gradientenzeile eines Features zurück und legt sie an
+                 * (mit 0 initialisiert), falls das Feature noch nicht berührt wurde.
+                 * Der Zeiger ist nur bis zum Anlegen der nächsten Zeile gültig.
+                 */
+                float* row(size_t feature);
+
+                /**
+                 * @brief Gibt die Gradientenzeile eines Features zurück
+                 * oder nullptr, falls das Feature nicht berührt wurde.
+                 */
+                inline const float* getRow(size_t feature) const {
+                    uint32_t offset = rowOffsets[feature];
+                    return offset == NO_ROW ? nullptr : rows.data() + offset;
+                }
+
+                /**
+                 * @brief Setzt alle Gradienten auf 0 zurück.
+                 */
+                void clear();
+
+                /**
+                 * @brief Ersetzt die Gradienten durch die mit scale multiplizierte Summe
+                 * der übergebenen Gradienten. Die berührten Zeilen werden auf numThreads
+                 * Threads aufgeteilt, sodass jede Zeile von genau einem Thread geschrieben wird.
+                 */
+                void merge(const std::vector<const Gradients*>& sources, float scale, size_t numThreads);
             };
 
             struct ForwardResult {
@@ -33,22 +112,41 @@ namespace ML {
             constexpr static size_t INPUT_SIZE = NNUE::INPUT_SIZE;
             size_t subnetSize;
 
+            /**
+             * @brief Die Gewichte sind nach Features geordnet: Die subnetSize
+             * Gewichte eines Features liegen zusammenhängend im Speicher.
+             */
             inline HalfKAv2_hmLayer(size_t outputSize) :
-                weights(outputSize / 2, INPUT_SIZE), bias(outputSize / 2), subnetSize(outputSize / 2) {
+                weights(INPUT_SIZE, outputSize / 2), bias(outputSize / 2), subnetSize(outputSize / 2) {
 
                 assert(outputSize % 2 == 0);
             }
 
-            ForwardResult forward(const Board& board, bool fakeQuant) const;
+            ForwardResult forward(const HalfKAv2_hmFeatures& features, bool fakeQuant) const;
+
+            /**
+             * @brief Führt einen Rückwärtspass durch und addiert die Gradienten zu grads.
+             */
+            void backward(const HalfKAv2_hmFeatures& features, const ForwardResult& forwardResult, const Vector& outputGrad, bool fakeQuant, Gradients& grads) const;
+
+            inline ForwardResult forward(const Board& board, bool fakeQuant) const {
+                return forward(HalfKAv2_hmFeatures(board), fakeQuant);
+            }
+
+            inline const float* getRow(size_t feature) const {
+                return weights.data() + feature * subnetSize;
+            }
 
-            Gradients backward(const Board& board, const ForwardResult& forwardResult, const Vector& outputGrad, bool fakeQuant) const;
+            inline float* getRow(size_t feature) {
+                return weights.data() + feature * subnetSize;
+            }
 
         private:
             template <typename Q>
-            ForwardResult forwardImpl(const Board& board, Q q) const;
+            ForwardResult forwardImpl(const HalfKAv2_hmFeatures& features, Q q) const;
 
             template <typename Q>
-            Gradients backwardImpl(const Board& board, const ForwardResult& forwardResult, const Vector& outputGrad) const;
+            void backwardImpl(const HalfKAv2_hmFeatures& features, const ForwardResult& forwardResult, const Vector& outputGrad, Gradients& grads) const;
     };          
 }
 
@@ -2,6 +2,7 @@
 #define ML_MATH_IMPL_H
 
 #include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <immintrin.h>
 #include <memory>
@@ -143,6 +144,226 @@ namespace ML {
         #endif
     }
 
+    /**
+     * @brief Berechnet C += A * B. Alle Matrizen sind zeilenweise gespeichert,
+     * A hat die Größe m x k, B die Größe k x n und C die Größe m x n.
+     *
+     * Es werden jeweils 4 Zeilen von C gleichzeitig in Registern gehalten, während
+     * ein Block von B durchlaufen wird, der in den L1-Cache passt.
+     */
+    inline void __unsafe_gemm(float* __restrict c, const float* __restrict a, const float* __restrict b, size_t m, size_t k, size_t n) {
+        constexpr size_t BLOCK_K = 128;
+
+        for(size_t k0 = 0; k0 < k; k0 += BLOCK_K) {
+            size_t k1 = std::min(k0 + BLOCK_K, k);
+            size_t i = 0, j;
+
+            #if defined(__AVX512F__)
+
+            for(; i + 4 <= m; i += 4) {
+                for(j = 0; j + 16 <= n; j += 16) {
+                    __m512 c0 = _mm512_loadu_ps(&c[i * n + j]);
+                    __m512 c1 = _mm512_loadu_ps(&c[(i + 1) * n + j]);
+                    __m512 c2 = _mm512_loadu_ps(&c[(i + 2) * n + j]);
+                    __m512 c3 = _mm512_loadu_ps(&c[(i + 3) * n + j]);
+
+                    for(size_t p = k0; p < k1; p++) {
+                        __m512 b_vec = _mm512_loadu_ps(&b[p * n + j]);
+                        c0 = _mm512_fmadd_ps(_mm512_set1_ps(a[i * k + p]), b_vec, c0);
+                        c1 = _mm512_fmadd_ps(_mm512_set1_ps(a[(i + 1) * k + p]), b_vec, c1);
+                        c2 = _mm512_fmadd_ps(_mm512_set1_ps(a[(i + 2) * k + p]), b_vec, c2);
+                        c3 = _mm512_fmadd_ps(_mm512_set1_ps(a[(i + 3) * k + p]), b_vec, c3);
+                    }
+
+                    _mm512_storeu_ps(&c[i * n + j], c0);
+                    _mm512_storeu_ps(&c[(i + 1) * n + j], c1);
+                    _mm512_storeu_ps(&c[(i + 2) * n + j], c2);
+                    _mm512_storeu_ps(&c[(i + 3) * n + j], c3);
+                }
+
+                // Restliche Spalten
+                for(; j < n; j++)
+                    for(size_t r = i; r < i + 4; r++)
+                        for(size_t p = k0; p < k1; p++)
+                            c[r * n + j] += a[r * k + p] * b[p * n + j];
+            }
+
+            #elif defined(__AVX2__) && defined(__FMA__)
+
+            for(; i + 4 <= m; i += 4) {
+                for(j = 0; j + 8 <= n; j += 8) {
+                    __m256 c0 = _mm256_loadu_ps(&c[i * n + j]);
+                    __m256 c1 = _mm256_loadu_ps(&c[(i + 1) * n + j]);
+                    __m256 c2 = _mm256_loadu_ps(&c[(i + 2) * n + j]);
+                    __m256 c3 = _mm256_loadu_ps(&c[(i + 3) * n + j]);
+
+                    for(size_t p = k0; p < k1; p++) {
+                        __m256 b_vec = _mm256_loadu_ps(&b[p * n + j]);
+                        c0 = _mm256_fmadd_ps(_mm256_set1_ps(a[i * k + p]), b_vec, c0);
+                        c1 = _mm256_fmadd_ps(_mm256_set1_ps(a[(i + 1) * k + p]), b_vec, c1);
+                        c2 = _mm256_fmadd_ps(_mm256_set1_ps(a[(i + 2) * k + p]), b_vec, c2);
+                        c3 = _mm256_fmadd_ps(_mm256_set1_ps(a[(i + 3) * k + p]), b_vec, c3);
+                    }
+
+                    _mm256_storeu_ps(&c[i * n + j], c0);
+                    _mm256_storeu_ps(&c[(i + 1) * n + j], c1);
+                    _mm256_storeu_ps(&c[(i + 2) * n + j], c2);
+                    _mm256_storeu_ps(&c[(i + 3) * n + j], c3);
+                }
+
+                // Restliche Spalten
+                for(; j < n; j++)
+                    for(size_t r = i; r < i + 4; r++)
+                        for(size_t p = k0; p < k1; p++)
+                            c[r * n + j] += a[r * k + p] * b[p * n + j];
+            }
+
+            #endif
+
+            // Restliche Zeilen (bzw. alle ohne AVX)
+            for(; i < m; i++)
+                for(size_t p = k0; p < k1; p++) {
+                    float a_val = a[i * k + p];
+                    for(j = 0; j < n; j++)
+                        c[i * n + j] += a_val * b[p * n + j];
+                }
+        }
+    }
+
+    /**
+     * @brief Berechnet C += A^T * B. Alle Matrizen sind zeilenweise gespeichert,
+     * A hat die Größe k x m, B die Größe k x n und C die Größe m x n.
+     *
+     * Wird für die Gradienten der Gewichte verwendet (k ist die Batchgröße).
+     * Da die Eingaben nach einer clipped ReLU oft 0 sind, werden Nullen übersprungen.
+     */
+    inline void __unsafe_gemm_tn(float* __restrict c, const float* __restrict a, const float* __restrict b, size_t m, size_t k, size_t n) {
+        for(size_t p = 0; p < k; p++) {
+            const float* __restrict b_row = &b[p * n];
+
+            for(size_t i = 0; i < m; i++) {
+                float a_val = a[p * m + i];
+                if(a_val == 0.0f)
+                    continue;
+
+                float* __restrict c_row = &c[i * n];
+                size_t j = 0;
+
+                #if defined(__AVX512F__)
+
+                __m512 a_vec = _mm512_set1_ps(a_val);
+                for(; j + 16 <= n; j += 16)
+                    _mm512_storeu_ps(&c_row[j], _mm512_fmadd_ps(a_vec, _mm512_loadu_ps(&b_row[j]), _mm512_loadu_ps(&c_row[j])));
+
+                #elif defined(__AVX2__) && defined(__FMA__)
+
+                __m256 a_vec = _mm256_set1_ps(a_val);
+                for(; j + 8 <= n; j += 8)
+                    _mm256_storeu_ps(&c_row[j], _mm256_fmadd_ps(a_vec, _mm256_loadu_ps(&b_row[j]), _mm256_loadu_ps(&c_row[j])));
+
+                #endif
+
+                for(; j < n; j++)
+                    c_row[j] += a_val * b_row[j];
+            }
+        }
+    }
+
+    /**
+     * @brief Transponiert eine zeilenweise gespeicherte Matrix der Größe rows x cols.
+     */
+    inline void __unsafe_transpose(float* __restrict dest, const float* __restrict src, size_t rows, size_t cols) {
+        constexpr size_t BLOCK = 16;
+
+        for(size_t r0 = 0; r0 < rows; r0 += BLOCK)
+            for(size_t c0 = 0; c0 < cols; c0 += BLOCK)
+                for(size_t r = r0; r < std::min(r0 + BLOCK, rows); r++)
+                    for(size_t c = c0; c < std::min(c0 + BLOCK, cols); c++)
+                        dest[c * rows + r] = src[r * cols + c];
+    }
+
+    /**
+     * @brief Die für einen Schritt von AdamW vorberechneten Faktoren.
+     * Die Momente werden als m = mDecay * m + mGradScale * g (und analog v)
+     * aktualisiert, die Gewichte als
+     * w = clamp(w * weightDecay - learningRate * m * mHatScale / (sqrt(v * vHatScale) + epsilon)).
+     */
+    struct AdamWStep {
+        float mDecay, mGradScale;
+        float vDecay, vGradScale;
+        float mHatScale, vHatScale;
+        float weightDecay;
+        float learningRate;
+        float epsilon;
+        float minWeight, maxWeight;
+    };
+
+    inline void __unsafe_adamw(float* __restrict w, float* __restrict m, float* __restrict v,
+                               const float* __restrict g, size_t n, const AdamWStep& step) {
+        size_t i = 0;
+
+        #if defined(__AVX512F__)
+
+        __m512 mDecay512 = _mm512_set1_ps(step.mDecay), mGradScale512 = _mm512_set1_ps(step.mGradScale);
+        __m512 vDecay512 = _mm512_set1_ps(step.vDecay), vGradScale512 = _mm512_set1_ps(step.vGradScale);
+        __m512 mHatScale512 = _mm512_set1_ps(step.mHatScale), vHatScale512 = _mm512_set1_ps(step.vHatScale);
+        __m512 weightDecay512 = _mm512_set1_ps(step.weightDecay), learningRate512 = _mm512_set1_ps(step.learningRate);
+        __m512 epsilon512 = _mm512_set1_ps(step.epsilon);
+        __m512 minWeight512 = _mm512_set1_ps(step.minWeight), maxWeight512 = _mm512_set1_ps(step.maxWeight);
+
+        // Die maskz-Varianten mit voller Maske vermeiden eine falsche
+        // maybe-uninitialized-Warnung des GCC für _mm512_undefined_ps
+        constexpr __mmask16 ALL = 0xFFFF;
+
+        for(; i + 16 <= n; i += 16) {
+            __m512 g_vec = _mm512_loadu_ps(g + i);
+            __m512 m_vec = _mm512_fmadd_ps(mDecay512, _mm512_loadu_ps(m + i), _mm512_mul_ps(mGradScale512, g_vec));
+            __m512 v_vec = _mm512_fmadd_ps(vDecay512, _mm512_loadu_ps(v + i), _mm512_mul_ps(vGradScale512, _mm512_mul_ps(g_vec, g_vec)));
+            _mm512_storeu_ps(m + i, m_vec);
+            _mm512_storeu_ps(v + i, v_vec);
+
+            __m512 denom = _mm512_add_ps(_mm512_maskz_sqrt_ps(ALL, _mm512_mul_ps(v_vec, vHatScale512)), epsilon512);
+            __m512 update = _mm512_div_ps(_mm512_mul_ps(learningRate512, _mm512_mul_ps(m_vec, mHatScale512)), denom);
+            __m512 w_vec = _mm512_fmsub_ps(_mm512_loadu_ps(w + i), weightDecay512, update);
+            _mm512_storeu_ps(w + i, _mm512_maskz_min_ps(ALL, _mm512_maskz_max_ps(ALL, w_vec, minWeight512), maxWeight512));
+        }
+
+        #endif
+
+        #if defined(__AVX2__) && defined(__FMA__)
+
+        __m256 mDecay = _mm256_set1_ps(step.mDecay), mGradScale = _mm256_set1_ps(step.mGradScale);
+        __m256 vDecay = _mm256_set1_ps(step.vDecay), vGradScale = _mm256_set1_ps(step.vGradScale);
+        __m256 mHatScale = _mm256_set1_ps(step.mHatScale), vHatScale = _mm256_set1_ps(step.vHatScale);
+        __m256 weightDecay = _mm256_set1_ps(step.weightDecay), learningRate = _mm256_set1_ps(step.learningRate);
+        __m256 epsilon = _mm256_set1_ps(step.epsilon);
+        __m256 minWeight = _mm256_set1_ps(step.minWeight), maxWeight = _mm256_set1_ps(step.maxWeight);
+
+        for(; i + 8 <= n; i += 8) {
+            __m256 g_vec = _mm256_loadu_ps(g + i);
+            __m256 m_vec = _mm256_fmadd_ps(mDecay, _mm256_loadu_ps(m + i), _mm256_mul_ps(mGradScale, g_vec));
+            __m256 v_vec = _mm256_fmadd_ps(vDecay, _mm256_loadu_ps(v + i), _mm256_mul_ps(vGradScale, _mm256_mul_ps(g_vec, g_vec)));
+            _mm256_storeu_ps(m + i, m_vec);
+            _mm256_storeu_ps(v + i, v_vec);
+
+            __m256 denom = _mm256_add_ps(_mm256_sqrt_ps(_mm256_mul_ps(v_vec, vHatScale)), epsilon);
+            __m256 update = _mm256_div_ps(_mm256_mul_ps(learningRate, _mm256_mul_ps(m_vec, mHatScale)), denom);
+            __m256 w_vec = _mm256_fmsub_ps(_mm256_loadu_ps(w + i), weightDecay, update);
+            _mm256_storeu_ps(w + i, _mm256_min_ps(_mm256_max_ps(w_vec, minWeight), maxWeight));
+        }
+
+        #endif
+
+        // Restliche Elemente (bzw. alle ohne AVX)
+        for(; i < n; i++) {
+            m[i] = step.mDecay * m[i] + step.mGradScale * g[i];
+            v[i] = step.vDecay * v[i] + step.vGradScale * g[i] * g[i];
+
+            float update = step.learningRate * m[i] * step.mHatScale / (std::sqrt(v[i] * step.vHatScale) + step.epsilon);
+            w[i] = std::clamp(w[i] * step.weightDecay - update, step.minWeight, step.maxWeight);
+        }
+    }
+
     inline float __unsafe_spectral_radius(const float* __restrict m, size_t size, size_t maxIterations = 400, float tol = 1e-5f) {
         // Power-Iteration zur Berechnung der Spektralradius
         float* __restrict b_k = new (std::align_val_t(REQUIRED_ALIGNMENT)) float[size];
@@ -0,0 +1,36 @@
+#ifndef ML_PARALLEL_H
+#define ML_PARALLEL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace ML {
+    /**
+     * @brief Teilt count Elemente auf höchstens numThreads Threads auf, sodass
+     * jeder Thread mindestens minPerThread Elemente bearbeitet. Der aufrufende
+     * Thread bearbeitet den ersten Abschnitt selbst.
+     *
+     * @param func Wird mit dem Bereich [start, end) jedes Abschnitts aufgerufen.
+     */
+    template <typename F>
+    inline void parallelFor(size_t count, size_t minPerThread, size_t numThreads, F&& func) {
+        numThreads = std::clamp(count / minPerThread, (size_t)1, std::max(numThreads, (size_t)1));
+        size_t perThread = (count + numThreads - 1) / numThreads;
+
+        std::vector<std::thread> threads;
+        for(size_t t = 1; t < numThreads; t++) {
+            size_t start = std::min(t * perThread, count);
+            size_t end = std::min(start + perThread, count);
+            threads.push_back(std::thread(func, start, end));
+        }
+
+        func(0, std::min(perThread, count));
+
+        for(std::thread& t : threads)
+            t.join();
+    }
+}
+
+#endif
\ No newline at end of file
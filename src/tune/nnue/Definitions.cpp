@@ -5,8 +5,10 @@
 
 std::vector<Variable*> tuneVariables;
 
-Variable pgnFilePath("pgnFile", "Path to the PGN file for sampling opening positions", "pgn/o-deville.pgn");
-Variable samplesFilePath("samplesFilePath", "Path to the file for storing generated samples", "data/samples.txt");
+Variable pgnFilePath("pgnFile", "Path to the PGN file (or openings file) for sampling opening positions", "pgn/o-deville.pgn");
+Variable samplesFilePath("samplesFilePath", "Path to the file for storing generated samples", "data/samples.bin");
+Variable openingsFilePath("openingsFile", "Path to the file for storing sampled opening positions", "data/openings.bin");
+Variable textSamplesFilePath("textSamplesFilePath", "Path to a text samples file to convert with the convert command", "data/samples.txt");
 unsigned int nThreads = std::thread::hardware_concurrency();
 Variable numThreads("numThreads", "Number of threads to use for the simulation", std::max(1u, (unsigned int)std::round(nThreads * 7.0 / 8)));
 Variable numGames("numGames", "Number of games to simulate at generation 0", 100ull);
@@ -19,6 +21,11 @@ Variable openingBookMovesMax("openingBookMovesMax", "Maximum number of half move
 Variable randomMovesMin("randomMovesMin", "Minimum number of random half moves to play before simulation", 0ull);
 Variable randomMovesMax("randomMovesMax", "Maximum number of random half moves to play before simulation", 0ull);
 Variable virtualMateScore("virtualMateScore", "Score in centipawns used for mate in TD(lambda)", 5000u);
+Variable simHashSize("simHash", "Transposition table size in MB of each engine during simulation", 16ull);
+Variable simNodes("simNodes", "Fixed number of nodes per move during simulation (0 = use time control)", 0ull);
+Variable simDepth("simDepth", "Fixed search depth per move during simulation (0 = use time control)", 0ull);
+Variable simNodesPerMs("simNodesPerMs", "Measure the time control in nodes instead of milliseconds at this rate (0 = use real time)", 0.0);
+Variable simSeed("simSeed", "Seed for the random parts of the simulated games", 42u);
 Variable simMultiPV("simMultiPV", "Number of PV lines to calculate during simulation", 256u);
 Variable temperature("temperature", "Temperature parameter in centipawns for move selection during simulation (0 = greedy, inf = uniform random)", 30.0);
 Variable temperatureDecay("temperatureDecay", "Decay factor for temperature with each half move during simulation", 0.99);
@@ -32,6 +39,11 @@ Variable numEpochsIncrement("numEpochsIncr", "Additional number of epochs for tr
 Variable numGenerations("numGenerations", "Number of generations for training", 100000ull);
 Variable noImprovementPatience("noImprovementPatience", "Number of generations without improvement before stopping training", 10ull);
 Variable batchSize("batchSize", "Batch size for training", 1024ull);
+Variable streamData("streamData", "Whether to stream the training data from the samples file(s) instead of loading it into memory", false);
+Variable dataSeed("dataSeed", "Seed for the order of the training data in each epoch", 42u);
+Variable shuffleBufferSize("shuffleBufferSize", "Number of samples in the shuffle buffer when streaming the training data", 1000000ull);
+Variable prefetchBatches("prefetchBatches", "Number of batches to prepare in advance when streaming the training data", 8ull);
+Variable maxValidationSamples("maxValidationSamples", "Maximum number of validation samples when streaming the training data", 1000000ull);
 Variable epsilon("epsilon", "Epsilon value for the AdamW optimizer", 1e-8);
 Variable discount("discount", "Discount factor for the learning algorithm", 1.0);
 Variable lambda("lambda", "Base lambda parameter for TD(lambda) updates", 0.95);
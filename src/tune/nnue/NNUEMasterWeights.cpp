@@ -13,7 +13,7 @@ NNUE::MasterWeights::MasterWeights(const NNUE::Network& network) {
     // Gewichte, dequantisiert
     for(size_t i = 0; i < NNUE::Network::INPUT_SIZE; i++) {
         for(size_t j = 0; j < NNUE::Network::SINGLE_SUBNET_SIZE; j++)
-            halfKPLayer.weights(i, j) = halfKP.getWeight(i, j) / 128.0f;
+            halfKPLayer.weights(j, i) = halfKP.getWeight(i, j) / 128.0f;
     }
 
     const auto& layer1 = network.getLayer1();
@@ -54,7 +54,7 @@ NNUE::Network* NNUE::MasterWeights::toNetwork() const {
     for(size_t i = 0; i < NNUE::Network::INPUT_SIZE; i++) {
         int16_t* weightPtr = (int16_t*)halfKP.getWeightPtr(i);
         for(size_t j = 0; j < NNUE::Network::SINGLE_SUBNET_SIZE; j++)
-            weightPtr[j] = (int16_t)(std::round(halfKPLayer.weights(i, j) * 128.0f));
+            weightPtr[j] = (int16_t)(std::round(halfKPLayer.weights(j, i) * 128.0f));
     }
 
     auto& layer1 = network->getLayer1();
@@ -92,10 +92,10 @@ NNUE::Network* NNUE::MasterWeights::toNetwork() const {
     return network;
 }
 
-NNUE::NetworkActivations NNUE::MasterWeights::forward(const Board& board, bool fakeQuantization) const {
+NNUE::NetworkActivations NNUE::MasterWeights::forward(const ML::HalfKAv2_hmFeatures& features, bool fakeQuantization) const {
     NNUE::NetworkActivations activations;
 
-    activations.halfKPActivations = halfKPLayer.forward(board, fakeQuantization);
+    activations.halfKPActivations = halfKPLayer.forward(features, fakeQuantization);
     activations.denseLayerOutputs[0] = denseLayers[0].forward(activations.halfKPActivations.output, fakeQuantization);
     activations.denseLayerOutputs[1] = denseLayers[1].forward(activations.denseLayerOutputs[0].output, fakeQuantization);
     activations.denseLayerOutputs[2] = denseLayers[2].forward(activations.denseLayerOutputs[1].output, fakeQuantization);
@@ -103,22 +103,24 @@ NNUE::NetworkActivations NNUE::MasterWeights::forward(const Board& board, bool f
     return activations;
 }
 
-NNUE::Gradients NNUE::MasterWeights::backward(const Board& board, const NetworkActivations& activations, float outputGrad, bool fakeQuantization) const {
+void NNUE::MasterWeights::backward(const ML::HalfKAv2_hmFeatures& features, const NetworkActivations& activations, float outputGrad, bool fakeQuantization, Gradients& gradients) const {
     ML::Vector outputGradVec(1);
     outputGradVec(0) = outputGrad;
-    Gradients gradients;
 
-    gradients.denseLayerGradients[2] = denseLayers[2].backward(activations.denseLayerOutputs[1].output,
+    ML::DenseLayer::Gradients layer3Gradients = denseLayers[2].backward(activations.denseLayerOutputs[1].output,
         activations.denseLayerOutputs[2], outputGradVec, fakeQuantization);
 
-    gradients.denseLayerGradients[1] = denseLayers[1].backward(activations.denseLayerOutputs[0].output,
-        activations.denseLayerOutputs[1], gradients.denseLayerGradients[2].inputGrad, fakeQuantization);
+    ML::DenseLayer::Gradients layer2Gradients = denseLayers[1].backward(activations.denseLayerOutputs[0].output,
+        activations.denseLayerOutputs[1], layer3Gradients.inputGrad, fakeQuantization);
 
-    gradients.denseLayerGradients[0] = denseLayers[0].backward(activations.halfKPActivations.output,
-        activations.denseLayerOutputs[0], gradients.denseLayerGradients[1].inputGrad, fakeQuantization);
+    ML::DenseLayer::Gradients layer1Gradients = denseLayers[0].backward(activations.halfKPActivations.output,
+        activations.denseLayerOutputs[0], layer2Gradients.inputGrad, fakeQuantization);
 
-    gradients.halfKAGradients = halfKPLayer.backward(board,
-        activations.halfKPActivations, gradients.denseLayerGradients[0].inputGrad, fakeQuantization);
+    halfKPLayer.backward(features, activations.halfKPActivations, layer1Gradients.inputGrad, fakeQuantization, gradients.halfKAGradients);
 
-    return gradients;
+    const ML::DenseLayer::Gradients* denseGradients[NNUE::Network::NUM_LAYERS] = {&layer1Gradients, &layer2Gradients, &layer3Gradients};
+    for(size_t layer = 0; layer < NNUE::Network::NUM_LAYERS; layer++) {
+        gradients.denseLayerGradients[layer].bias += denseGradients[layer]->bias;
+        gradients.denseLayerGradients[layer].weights += denseGradients[layer]->weights;
+    }
 }
\ No newline at end of file
@@ -7,7 +7,6 @@
 
 #include <cmath>
 #include <limits>
-#include <unordered_map>
 #include <vector>
 
 namespace NNUE {
@@ -15,12 +14,24 @@ namespace NNUE {
      * @brief Kapselt die Gradienten eines Rückwärtspasses durch das Netzwerk mit Master-Parametern.
      */
     struct Gradients {
-        ML::HalfKAv2_hmLayer::Gradients halfKAGradients{NNUE::Network::SINGLE_SUBNET_SIZE};
+        ML::HalfKAv2_hmLayer::Gradients halfKAGradients{NNUE::Network::LAYER_SIZES[0]};
         ML::DenseLayer::Gradients denseLayerGradients[NNUE::Network::NUM_LAYERS] {
             ML::DenseLayer::Gradients(NNUE::Network::LAYER_SIZES[0], NNUE::Network::LAYER_SIZES[1]),
             ML::DenseLayer::Gradients(NNUE::Network::LAYER_SIZES[1], NNUE::Network::LAYER_SIZES[2]),
             ML::DenseLayer::Gradients(NNUE::Network::LAYER_SIZES[2], NNUE::Network::LAYER_SIZES[3])
         };
+
+        /**
+         * @brief Setzt alle Gradienten auf 0 zurück, ohne den Speicher freizugeben.
+         */
+        inline void clear() {
+            halfKAGradients.clear();
+
+            for(ML::DenseLayer::Gradients& grads : denseLayerGradients) {
+                ML::__unsafe_set_zero(grads.weights.data(), grads.weights.size);
+                ML::__unsafe_set_zero(grads.bias.data(), grads.bias.size);
+            }
+        }
     };
 
     /**
@@ -73,23 +84,29 @@ namespace NNUE {
         /**
          * @brief Führt einen Vorwärtspass durch das Netzwerk mit den Master-Parametern durch und gibt die Aktivierungen zurück.
          * 
-         * @param board Das Schachbrett, für das die Aktivierungen berechnet werden sollen.
+         * @param features Die aktiven Features der Position, für die die Aktivierungen berechnet werden sollen.
          * @param fakeQuantization Wenn true ist, werden während des Vorwärtspasses "Fake-Quantisierungen"
          * durchgeführt um das Verhalten des quantisierten Netzwerks besser zu approximieren.
          * Andernfalls werden die genauen Werte der Master-Parameter verwendet.
          */
-        NetworkActivations forward(const Board& board, bool fakeQuantization) const;
+        NetworkActivations forward(const ML::HalfKAv2_hmFeatures& features, bool fakeQuantization) const;
+
+        inline NetworkActivations forward(const Board& board, bool fakeQuantization) const {
+            return forward(ML::HalfKAv2_hmFeatures(board), fakeQuantization);
+        }
 
         /**
-         * @brief Führt einen Rückwärtspass durch das Netzwerk mit den Master-Parametern durch und gibt die Gradienten zurück.
+         * @brief Führt einen Rückwärtspass durch das Netzwerk mit den Master-Parametern durch
+         * und addiert die Gradienten zu gradients.
          * 
-         * @param board Das Schachbrett, für das die Gradienten berechnet werden sollen.
+         * @param features Die aktiven Features der Position, für die die Gradienten berechnet werden sollen.
          * @param activations Die Aktivierungen, die während des Vorwärtspasses berechnet wurden.
          * @param outputGrad Der Gradient des Fehlers bezüglich der Ausgabe des Netzwerks (dL/d(output)).
          * @param fakeQuantization Wenn true ist, werden während des Rückwärtspasses "Fake-Quantisierungen" durchgeführt um das Verhalten des quantisierten Netzwerks besser zu approximieren.
          * Andernfalls werden die genauen Werte der Master-Parameter verwendet.
+         * @param gradients Die Gradienten, zu denen die Gradienten dieses Datenpunkts addiert werden.
          */
-        Gradients backward(const Board& board, const NetworkActivations& activations, float outputGrad, bool fakeQuantization) const;
+        void backward(const ML::HalfKAv2_hmFeatures& features, const NetworkActivations& activations, float outputGrad, bool fakeQuantization, Gradients& gradients) const;
     };
 }
 
@@ -2,6 +2,7 @@
 #include "core/engine/evaluation/NNUEEvaluator.h"
 #include "core/utils/Random.h"
 #include "core/utils/nnue/NNUEUtils.h"
+#include "tune/ml/AdamW.h"
 
 #include <algorithm>
 #include <atomic>
@@ -40,7 +41,7 @@ double networkOutputToCentipawns(float output) {
     return (output * (128.0 * 128.0) * 100.0 / 6656.0);
 }
 
-double Train::loss(std::vector<DataPoint>& data, const NNUE::MasterWeights& masterWeights, double k, double kappa) {
+double Train::loss(const std::vector<TrainingSample>& data, const NNUE::MasterWeights& masterWeights, double k, double kappa) {
     std::atomic<double> sum = 0.0;
 
     size_t currIndex = 0;
@@ -56,12 +57,12 @@ double Train::loss(std::vector<DataPoint>& data, const NNUE::MasterWeights& mast
             mutex.unlock();
 
             for(size_t i = start; i < end; i++) {
-                DataPoint& dp = data[i];
+                const TrainingSample& sample = data[i];
 
-                float networkOutput = masterWeights.forward(dp.board, true).output();
+                float networkOutput = masterWeights.forward(sample.features, true).output();
                 double prediction = tanh(networkOutputToCentipawns(networkOutput), k);
-                double target = (1.0 - kappa) * tanh(dp.tdTarget, k) + kappa * (double)dp.finalResult;
-                if(dp.board.getSideToMove() == BLACK)
+                double target = (1.0 - kappa) * tanh(sample.tdTarget, k) + kappa * (double)sample.finalResult;
+                if(sample.getSideToMove() == BLACK)
                     prediction = -prediction;
 
                 sum.fetch_add(mse(prediction, target));
@@ -105,11 +106,12 @@ double Train::loss(std::vector<DataPoint>& data, const NNUE::Network& network, d
 
             for(size_t i = start; i < end; i++) {
                 DataPoint& dp = data[i];
-                evaluator.setBoard(dp.board);
+                Board board(dp.board);
+                evaluator.setBoard(board);
 
                 double prediction = tanh(evaluator.evaluate(), k);
                 double target = (1.0 - kappa) * tanh(dp.tdTarget, k) + kappa * (double)dp.finalResult;
-                if(dp.board.getSideToMove() == BLACK)
+                if(board.getSideToMove() == BLACK)
                     prediction = -prediction;
 
                 sum.fetch_add(mse(prediction, target));
@@ -133,52 +135,77 @@ double Train::loss(std::vector<DataPoint>& data, const NNUE::Network& network, d
     return sum.load() / data.size();
 }
 
-NNUE::Gradients Train::gradient(std::vector<DataPoint>& data, const std::vector<size_t>& indices, const NNUE::MasterWeights& masterWeights, double k, double kappa) {
+/**
+ * @brief Die Gradienten-Akkumulatoren der Threads. Sie werden für alle Batches
+ * wiederverwendet, damit der Speicher der Gradientenzeilen nur einmal angefordert wird.
+ */
+static std::vector<NNUE::Gradients> threadGradientAccum;
+
+void Train::gradient(const std::vector<TrainingSample>& batch, const NNUE::MasterWeights& masterWeights, double k, double kappa, NNUE::Gradients& totalGrad) {
     size_t currIndex = 0;
     std::mutex mutex;
 
     size_t numThreads = std::max(std::thread::hardware_concurrency(), 1u);
-    std::vector<NNUE::Gradients> threadGradientAccum;
     threadGradientAccum.resize(numThreads);
 
     auto threadFunc = [&](size_t threadId) {
         NNUE::Gradients& grads = threadGradientAccum[threadId];
+        grads.clear();
 
         mutex.lock();
-        while(currIndex < indices.size()) {
+        while(currIndex < batch.size()) {
             // Bearbeite Blöcke von 32 Datenpunkten
             size_t start = currIndex;
-            size_t end = std::min(currIndex + 32, indices.size());
+            size_t end = std::min(currIndex + 32, batch.size());
             currIndex = end;
             mutex.unlock();
 
-            for(size_t i = start; i < end; i++) {
-                size_t dataIndex = indices[i];
-                DataPoint& dp = data[dataIndex];
+            size_t n = end - start;
+
+            // Der HalfKP-Layer ist dünn besetzt und wird pro Datenpunkt berechnet,
+            // die Dense-Layer als Matrixmultiplikationen über den ganzen Block
+            std::vector<ML::HalfKAv2_hmLayer::ForwardResult> halfKPActivations;
+            halfKPActivations.reserve(n);
+
+            ML::Matrix halfKPOutput(n, NNUE::Network::LAYER_SIZES[0]);
+            for(size_t i = 0; i < n; i++) {
+                halfKPActivations.push_back(masterWeights.halfKPLayer.forward(batch[start + i].features, true));
+                ML::__unsafe_copy(halfKPOutput.data() + i * NNUE::Network::LAYER_SIZES[0],
+                    halfKPActivations[i].output.data(), NNUE::Network::LAYER_SIZES[0]);
+            }
+
+            ML::DenseLayer::BatchForwardResult layer1 = masterWeights.denseLayers[0].forward(halfKPOutput, true);
+            ML::DenseLayer::BatchForwardResult layer2 = masterWeights.denseLayers[1].forward(layer1.output, true);
+            ML::DenseLayer::BatchForwardResult layer3 = masterWeights.denseLayers[2].forward(layer2.output, true);
+
+            ML::Matrix outputGrad(n, 1);
+            for(size_t i = 0; i < n; i++) {
+                const TrainingSample& sample = batch[start + i];
 
-                NNUE::NetworkActivations activations = masterWeights.forward(dp.board, true);
-                float networkOutput = activations.output();
+                float networkOutput = layer3.output(i);
                 double cp = networkOutputToCentipawns(networkOutput);
                 double prediction = tanh(cp, k);
 
-                double target = (1.0 - kappa) * tanh(dp.tdTarget, k) + kappa * (double)dp.finalResult;
-                if(dp.board.getSideToMove() == BLACK)
+                double target = (1.0 - kappa) * tanh(sample.tdTarget, k) + kappa * (double)sample.finalResult;
+                if(sample.getSideToMove() == BLACK)
                     target = -target;
 
-                double errorGrad = 2.0 * (prediction - target) * (1.0 - prediction * prediction) * k * 100.0 * (16384.0 / 6656.0);
-
-                // Berechne die Gradienten für die Master-Parameter und addiere sie zum Thread-Gradienten
-                NNUE::Gradients dpGrad = masterWeights.backward(dp.board, activations, errorGrad, true);
+                outputGrad(i) = 2.0 * (prediction - target) * (1.0 - prediction * prediction) * k * 100.0 * (16384.0 / 6656.0);
+            }
 
-                grads.halfKAGradients.bias += dpGrad.halfKAGradients.bias;
+            // Berechne die Gradienten für die Master-Parameter und addiere sie zum Thread-Gradienten
+            ML::Matrix layer3InputGrad(n, NNUE::Network::LAYER_SIZES[2]);
+            ML::Matrix layer2InputGrad(n, NNUE::Network::LAYER_SIZES[1]);
+            ML::Matrix layer1InputGrad(n, NNUE::Network::LAYER_SIZES[0]);
 
-                for(const auto& [feature, value] : dpGrad.halfKAGradients.weights)
-                    grads.halfKAGradients.weights[feature] += value;
+            masterWeights.denseLayers[2].backward(layer2.output, layer3, outputGrad, true, grads.denseLayerGradients[2], layer3InputGrad);
+            masterWeights.denseLayers[1].backward(layer1.output, layer2, layer3InputGrad, true, grads.denseLayerGradients[1], layer2InputGrad);
+            masterWeights.denseLayers[0].backward(halfKPOutput, layer1, layer2InputGrad, true, grads.denseLayerGradients[0], layer1InputGrad);
 
-                for(size_t layer = 0; layer < NNUE::Network::NUM_LAYERS; layer++) {
-                    grads.denseLayerGradients[layer].bias += dpGrad.denseLayerGradients[layer].bias;
-                    grads.denseLayerGradients[layer].weights += dpGrad.denseLayerGradients[layer].weights;
-                }
+            ML::Vector halfKPOutputGrad(NNUE::Network::LAYER_SIZES[0]);
+            for(size_t i = 0; i < n; i++) {
+                ML::__unsafe_copy(halfKPOutputGrad.data(), layer1InputGrad.data() + i * NNUE::Network::LAYER_SIZES[0], NNUE::Network::LAYER_SIZES[0]);
+                masterWeights.halfKPLayer.backward(batch[start + i].features, halfKPActivations[i], halfKPOutputGrad, true, grads.halfKAGradients);
             }
 
             mutex.lock();
@@ -197,19 +224,13 @@ NNUE::Gradients Train::gradient(std::vector<DataPoint>& data, const std::vector<
         t.join();
 
     // Durchschnittsbildung
-    NNUE::Gradients totalGrad;
-
-    for(size_t i = 0; i < numThreads; i++) {
-        totalGrad.halfKAGradients.bias += threadGradientAccum[i].halfKAGradients.bias;
-
-        for(const auto& [feature, value] : threadGradientAccum[i].halfKAGradients.weights)
-            totalGrad.halfKAGradients.weights[feature] += value;
-    }
+    totalGrad.clear();
 
-    totalGrad.halfKAGradients.bias /= indices.size();
+    std::vector<const ML::HalfKAv2_hmLayer::Gradients*> halfKASources;
+    for(size_t i = 0; i < numThreads; i++)
+        halfKASources.push_back(&threadGradientAccum[i].halfKAGradients);
 
-    for(const auto& [feature, value] : totalGrad.halfKAGradients.weights)
-        totalGrad.halfKAGradients.weights[feature] = totalGrad.halfKAGradients.weights[feature] / indices.size();
+    totalGrad.halfKAGradients.merge(halfKASources, 1.0f / batch.size(), numThreads);
 
     for(size_t layer = 0; layer < NNUE::Network::NUM_LAYERS; layer++) {
         for(size_t i = 0; i < numThreads; i++) {
@@ -217,17 +238,12 @@ NNUE::Gradients Train::gradient(std::vector<DataPoint>& data, const std::vector<
             totalGrad.denseLayerGradients[layer].weights += threadGradientAccum[i].denseLayerGradients[layer].weights;
         }
 
-        totalGrad.denseLayerGradients[layer].bias /= indices.size();
-        totalGrad.denseLayerGradients[layer].weights /= indices.size();
+        totalGrad.denseLayerGradients[layer].bias /= batch.size();
+        totalGrad.denseLayerGradients[layer].weights /= batch.size();
     }
-
-    return totalGrad;
 }
 
 NNUE::Network* Train::adamW(std::vector<DataPoint>& data, size_t numEpochs, double learningRate, double kappa) {
-    NNUE::MasterWeights& masterWeights = trainingSession.masterWeights;
-    NNUE::Network* bestNetwork = masterWeights.toNetwork();
-
     // Teile die Daten in Trainings- und Validierungsdaten auf
     size_t validationSize = data.size() * validationSplit.get<double>();
     std::vector<DataPoint> validationData;
@@ -240,12 +256,23 @@ NNUE::Network* Train::adamW(std::vector<DataPoint>& data, size_t numEpochs, doub
         data.erase(data.end() - validationSize, data.end());
     }
 
-    // Initialisiere den Indexvektor
-    std::vector<size_t> indices(data.size());
-    for(size_t i = 0; i < indices.size(); i++)
-        indices[i] = i;
+    MemoryDataLoader loader(data, batchSize.get<size_t>(), dataSeed.get<uint32_t>());
 
-    std::mt19937& rng = Random::generator<11>();
+    return adamW(loader, validationData, numEpochs, learningRate, kappa);
+}
+
+NNUE::Network* Train::adamW(DataLoader& loader, std::vector<DataPoint>& validationData, size_t numEpochs, double learningRate, double kappa) {
+    NNUE::MasterWeights& masterWeights = trainingSession.masterWeights;
+    NNUE::Network* bestNetwork = masterWeights.toNetwork();
+
+    // Die Features der Validierungsdaten werden nur einmal extrahiert
+    std::vector<TrainingSample> validationSamples = decodeSamples(validationData);
+
+    std::vector<TrainingSample> batch;
+    NNUE::Gradients grad;
+
+    ML::AdamW adam(beta1.get<double>(), beta2.get<double>(), epsilon.get<double>(), weightDecay.get<double>(),
+                   std::max(std::thread::hardware_concurrency(), 1u));
 
     size_t patience = 0;
 
@@ -255,7 +282,7 @@ NNUE::Network* Train::adamW(std::vector<DataPoint>& data, size_t numEpochs, doub
 
     for(; trainingSession.epoch < targetEpochs; trainingSession.epoch++) {
         // Berechne den Fehler
-        double masterLoss = Train::loss(validationData, masterWeights, k.get<double>(), kappa);
+        double masterLoss = Train::loss(validationSamples, masterWeights, k.get<double>(), kappa);
 
         NNUE::Network* currentNetwork = masterWeights.toNetwork();
         double networkLoss = Train::loss(validationData, *currentNetwork, k.get<double>(), kappa);
@@ -284,103 +311,42 @@ NNUE::Network* Train::adamW(std::vector<DataPoint>& data, size_t numEpochs, doub
         }
 
         // Mische die Trainingsdaten
-        std::shuffle(indices.begin(), indices.end(), rng);
-
-        // Zerlege die Trainingsdaten in Batches
-        size_t numBatches = indices.size() / batchSize.get<size_t>();
-        if(indices.size() % batchSize.get<size_t>() != 0)
-            numBatches++;
-
-        std::vector<std::vector<size_t>> batches(numBatches);
-        for(size_t i = 0; i < indices.size(); i++)
-            batches[i / batchSize.get<size_t>()].push_back(indices[i]);
+        loader.startEpoch(trainingSession.epoch);
 
+        size_t numBatches = std::max(loader.getNumBatches(), (size_t)1);
         size_t batchIndex = 0;
 
-        for(const std::vector<size_t>& batchIndices : batches) {
+        while(loader.nextBatch(batch)) {
             // Berechne die Gradienten
-            NNUE::Gradients grad = Train::gradient(data, batchIndices, masterWeights, k.get<double>(), kappa);
-
-            // Aktualisiere die ersten und zweiten Momente
-            for(size_t i = 0; i < grad.halfKAGradients.bias.size; i++) {
-                trainingSession.mHalfKPBiases[i] = beta1.get<double>() * trainingSession.mHalfKPBiases[i] + (1.0 - beta1.get<double>()) * grad.halfKAGradients.bias(i);
-                trainingSession.vHalfKPBiases[i] = beta2.get<double>() * trainingSession.vHalfKPBiases[i] + (1.0 - beta2.get<double>()) * grad.halfKAGradients.bias(i) * grad.halfKAGradients.bias(i);
-            }
+            Train::gradient(batch, masterWeights, k.get<double>(), kappa, grad);
 
-            double wd = weightDecay.get<double>();
-            for(const auto& [feature, value] : grad.halfKAGradients.weights) {
-                // Anzahl der Schritte seit dem letzten Update dieses Features (inklusive aktuellem Schritt)
-                size_t tDelta = trainingSession.epoch - trainingSession.lastUpdateHalfKPWeights[feature] + 1;
-                trainingSession.lastUpdateHalfKPWeights[feature] = trainingSession.epoch + 1;
-
-                trainingSession.mHalfKPWeights[feature] = std::pow(beta1.get<double>(), tDelta) * trainingSession.mHalfKPWeights[feature] + (1.0 - beta1.get<double>()) * value;
-                trainingSession.vHalfKPWeights[feature] = std::pow(beta2.get<double>(), tDelta) * trainingSession.vHalfKPWeights[feature] + (1.0 - beta2.get<double>()) * value * value;
-
-                double mHat = trainingSession.mHalfKPWeights[feature] / (1.0 - std::pow(beta1.get<double>(), trainingSession.epoch + 1));
-                double vHat = trainingSession.vHalfKPWeights[feature] / (1.0 - std::pow(beta2.get<double>(), trainingSession.epoch + 1));
-
-                // Lazy AdamW: trage den verpassten Decay exakt nach, bevor der Gradienten-Schritt angewendet wird.
-                double decayFactor = std::pow(1.0 - learningRate * wd, tDelta);
-                masterWeights.halfKPLayer.weights(feature) = masterWeights.halfKPLayer.weights(feature) * decayFactor
-                    - learningRate * mHat / (std::sqrt(vHat) + epsilon.get<double>());
-
-                masterWeights.halfKPLayer.weights(feature) = std::clamp(masterWeights.halfKPLayer.weights(feature),
-                    NNUE::MasterWeights::HALF_KP_MIN, NNUE::MasterWeights::HALF_KP_MAX);
-            }
+            // Aktualisiere die Master-Parameter mit AdamW
+            adam.beginStep(trainingSession.epoch + 1, learningRate);
 
-            for(size_t layer = 0; layer < NNUE::Network::NUM_LAYERS; layer++) {
-                for(size_t i = 0; i < masterWeights.denseLayers[layer].bias.size; i++) {
-                    trainingSession.mDenseLayerBiases[layer][i] = beta1.get<double>() * trainingSession.mDenseLayerBiases[layer][i] + (1.0 - beta1.get<double>()) * grad.denseLayerGradients[layer].bias(i);
-                    trainingSession.vDenseLayerBiases[layer][i] = beta2.get<double>() * trainingSession.vDenseLayerBiases[layer][i] + (1.0 - beta2.get<double>()) * grad.denseLayerGradients[layer].bias(i) * grad.denseLayerGradients[layer].bias(i);
-                }
-
-                for(size_t i = 0; i < masterWeights.denseLayers[layer].weights.size; i++) {
-                    trainingSession.mDenseLayerWeights[layer][i] = beta1.get<double>() * trainingSession.mDenseLayerWeights[layer][i] + (1.0 - beta1.get<double>()) * grad.denseLayerGradients[layer].weights(i);
-                    trainingSession.vDenseLayerWeights[layer][i] = beta2.get<double>() * trainingSession.vDenseLayerWeights[layer][i] + (1.0 - beta2.get<double>()) * grad.denseLayerGradients[layer].weights(i) * grad.denseLayerGradients[layer].weights(i);
-                }
-            }
+            // Sparse AdamW für die Gewichte des HalfKP-Layers: Nur die Zeilen aktiver Features
+            // haben einen Gradienten. Alle Gewichte einer Zeile werden immer gemeinsam aktualisiert.
+            adam.updateRows(masterWeights.halfKPLayer, trainingSession.mHalfKPWeights.data(), trainingSession.vHalfKPWeights.data(),
+                            trainingSession.lastUpdateHalfKPWeights.data(), trainingSession.epoch + 1, grad.halfKAGradients,
+                            NNUE::MasterWeights::HALF_KP_MIN, NNUE::MasterWeights::HALF_KP_MAX);
 
-            // Aktualisiere die Master-Parameter mit AdamW
-            for(size_t i = 0; i < masterWeights.halfKPLayer.bias.size; i++) {
-                double mHat = trainingSession.mHalfKPBiases[i] / (1.0 - std::pow(beta1.get<double>(), trainingSession.epoch + 1));
-                double vHat = trainingSession.vHalfKPBiases[i] / (1.0 - std::pow(beta2.get<double>(), trainingSession.epoch + 1));
-                
-                // AdamW: Weight Decay wird direkt bei der Parameter-Aktualisierung angewendet
-                masterWeights.halfKPLayer.bias(i) = masterWeights.halfKPLayer.bias(i) * (1.0 - learningRate * wd) 
-                    - learningRate * mHat / (std::sqrt(vHat) + epsilon.get<double>());
-
-                masterWeights.halfKPLayer.bias(i) = std::clamp(masterWeights.halfKPLayer.bias(i),
-                    NNUE::MasterWeights::HALF_KP_MIN, NNUE::MasterWeights::HALF_KP_MAX);
-            }
+            adam.update(masterWeights.halfKPLayer.bias.data(), trainingSession.mHalfKPBiases.data(), trainingSession.vHalfKPBiases.data(),
+                        grad.halfKAGradients.bias.data(), masterWeights.halfKPLayer.bias.size,
+                        NNUE::MasterWeights::HALF_KP_MIN, NNUE::MasterWeights::HALF_KP_MAX);
 
             for(size_t layer = 0; layer < NNUE::Network::NUM_LAYERS; layer++) {
-                for(size_t i = 0; i < masterWeights.denseLayers[layer].bias.size; i++) {
-                    double mHat = trainingSession.mDenseLayerBiases[layer][i] / (1.0 - std::pow(beta1.get<double>(), trainingSession.epoch + 1));
-                    double vHat = trainingSession.vDenseLayerBiases[layer][i] / (1.0 - std::pow(beta2.get<double>(), trainingSession.epoch + 1));
-                    
-                    // AdamW: Weight Decay wird direkt bei der Parameter-Aktualisierung angewendet
-                    masterWeights.denseLayers[layer].bias(i) = masterWeights.denseLayers[layer].bias(i) * (1.0 - learningRate * wd)
-                        - learningRate * mHat / (std::sqrt(vHat) + epsilon.get<double>());
-
-                    masterWeights.denseLayers[layer].bias(i) = std::clamp(masterWeights.denseLayers[layer].bias(i),
-                        NNUE::MasterWeights::DENSE_BIAS_MIN, NNUE::MasterWeights::DENSE_BIAS_MAX);
-                }
-
-                for(size_t i = 0; i < masterWeights.denseLayers[layer].weights.size; i++) {
-                    double mHat = trainingSession.mDenseLayerWeights[layer][i] / (1.0 - std::pow(beta1.get<double>(), trainingSession.epoch + 1));
-                    double vHat = trainingSession.vDenseLayerWeights[layer][i] / (1.0 - std::pow(beta2.get<double>(), trainingSession.epoch + 1));
-                    
-                    // AdamW: Weight Decay wird direkt bei der Parameter-Aktualisierung angewendet
-                    masterWeights.denseLayers[layer].weights(i) = masterWeights.denseLayers[layer].weights(i) * (1.0 - learningRate * wd)
-                        - learningRate * mHat / (std::sqrt(vHat) + epsilon.get<double>());
-
-                    masterWeights.denseLayers[layer].weights(i) = std::clamp(masterWeights.denseLayers[layer].weights(i),
-                        NNUE::MasterWeights::DENSE_WEIGHT_MIN, NNUE::MasterWeights::DENSE_WEIGHT_MAX);
-                }
+                adam.update(masterWeights.denseLayers[layer].bias.data(), trainingSession.mDenseLayerBiases[layer].data(),
+                            trainingSession.vDenseLayerBiases[layer].data(), grad.denseLayerGradients[layer].bias.data(),
+                            masterWeights.denseLayers[layer].bias.size,
+                            NNUE::MasterWeights::DENSE_BIAS_MIN, NNUE::MasterWeights::DENSE_BIAS_MAX);
+
+                adam.update(masterWeights.denseLayers[layer].weights.data(), trainingSession.mDenseLayerWeights[layer].data(),
+                            trainingSession.vDenseLayerWeights[layer].data(), grad.denseLayerGradients[layer].weights.data(),
+                            masterWeights.denseLayers[layer].weights.size,
+                            NNUE::MasterWeights::DENSE_WEIGHT_MIN, NNUE::MasterWeights::DENSE_WEIGHT_MAX);
             }
 
             batchIndex++;
-            double batchProgress = (double)batchIndex / numBatches * 100.0;
+            double batchProgress = std::min((double)batchIndex / numBatches, 1.0) * 100.0;
             std::streamsize currPrecision = std::cout.precision();
             std::cout << "Batch: " << std::setw(3) << (int)batchProgress << "%\r" << std::flush;
             std::cout.precision(currPrecision);
@@ -388,7 +354,7 @@ NNUE::Network* Train::adamW(std::vector<DataPoint>& data, size_t numEpochs, doub
     }
 
     // Berechne den finalen Fehler
-    double masterLoss = Train::loss(validationData, masterWeights, k.get<double>(), kappa);
+    double masterLoss = Train::loss(validationSamples, masterWeights, k.get<double>(), kappa);
     NNUE::Network* currentNetwork = masterWeights.toNetwork();
     double networkLoss = Train::loss(validationData, *currentNetwork, k.get<double>(), kappa);
     std::cout << "\rEpoch: " << std::left << std::setw(4) << trainingSession.epoch;
@@ -2,12 +2,15 @@
 #define NNUE_TRAIN_H
 
 #include "core/utils/nnue/NNUENetwork.h"
+#include "tune/DataLoader.h"
 #include "tune/Definitions.h"
 #include "tune/EloTable.h"
 #include "tune/nnue/NNUEMasterWeights.h"
 
 #include <cmath>
+#include <cstring>
 #include <fstream>
+#include <stdint.h>
 #include <vector>
 
 namespace Train {
@@ -52,7 +55,24 @@ namespace Train {
         }
     };
 
+    /**
+     * @brief Der Kopf einer gespeicherten Trainingssession. Ältere Dateien ohne
+     * Kopf speichern die HalfKP-Gewichte transponiert und werden abgelehnt.
+     */
+    struct TrainingSessionHeader {
+        char magic[4];
+        uint32_t version;
+
+        static constexpr char MAGIC[4] = {'C', 'E', 'N', 'S'};
+        static constexpr uint32_t VERSION = 1;
+    };
+
     inline std::ostream& operator<<(std::ostream& os, const TrainingSession& session) {
+        TrainingSessionHeader header{};
+        std::memcpy(header.magic, TrainingSessionHeader::MAGIC, sizeof(header.magic));
+        header.version = TrainingSessionHeader::VERSION;
+        os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
         os.write(reinterpret_cast<const char*>(&session.generation), sizeof(session.generation));
         os.write(reinterpret_cast<const char*>(&session.epoch), sizeof(session.epoch));
         os.write(reinterpret_cast<const char*>(&session.averageLoss), sizeof(session.averageLoss));
@@ -97,7 +117,19 @@ namespace Train {
         return os;
     }
 
+    /**
+     * @brief Lädt eine Trainingssession. Passt der Kopf nicht zu dieser Version,
+     * wird nichts geladen und das failbit des Streams gesetzt.
+     */
     inline std::istream& operator>>(std::istream& is, TrainingSession& session) {
+        TrainingSessionHeader header;
+        if(!is.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+           std::memcmp(header.magic, TrainingSessionHeader::MAGIC, sizeof(header.magic)) != 0 ||
+           header.version != TrainingSessionHeader::VERSION) {
+            is.setstate(std::ios::failbit);
+            return is;
+        }
+
         is.read(reinterpret_cast<char*>(&session.generation), sizeof(session.generation));
         is.read(reinterpret_cast<char*>(&session.epoch), sizeof(session.epoch));
         is.read(reinterpret_cast<char*>(&session.averageLoss), sizeof(session.averageLoss));
@@ -176,7 +208,7 @@ namespace Train {
      * @param kappa Bestimmt, wie stark das finale Ergebnis in das TD-Ziel einfließen soll.
      * @return double Der mittlere quadratische Fehler.
      */
-    double loss(std::vector<DataPoint>& data, const NNUE::MasterWeights& masterWeights, double k, double kappa);
+    double loss(const std::vector<TrainingSample>& data, const NNUE::MasterWeights& masterWeights, double k, double kappa);
 
     /**
      * @brief Bestimmt den MSE eines quantisierten Parametersatzes auf einem Datensatz.
@@ -192,18 +224,15 @@ namespace Train {
     double loss(std::vector<DataPoint>& data, const NNUE::Network& network, double k, double kappa);
 
     /**
-     * @brief Berechnet den Gradienten des MSE eines unquantisierten Parametersatzes auf einem Datensatz.
-     * Zusätzlich werden die Indizes der Datenpunkte übergeben,
-     * die für die Berechnung des Gradienten verwendet werden sollen.
+     * @brief Berechnet den Gradienten des MSE eines unquantisierten Parametersatzes auf einem Batch.
      * 
-     * @param data Der Datensatz.
-     * @param indices Die Indizes der Datenpunkte, die für die Berechnung des Gradienten verwendet werden sollen.
+     * @param batch Die Datenpunkte des Batches.
      * @param masterWeights Die unquantisierten Parameter des Netzwerks.
      * @param k Der Faktor, der mit dem Bewertungswert innerhalb der tanh-Funktion multipliziert wird.
      * @param kappa Bestimmt, wie stark das finale Ergebnis in das TD-Ziel einfließen soll.
-     * @return std::vector<float> Der Gradient.
+     * @param totalGrad Wird mit dem Gradienten überschrieben.
      */
-    NNUE::Gradients gradient(std::vector<DataPoint>& data, const std::vector<size_t>& indices, const NNUE::MasterWeights& masterWeights, double k, double kappa);
+    void gradient(const std::vector<TrainingSample>& batch, const NNUE::MasterWeights& masterWeights, double k, double kappa, NNUE::Gradients& totalGrad);
 
     /**
      * @brief Verbessert die Parameter eines HCE-Modells über den AdamW-Algorithmus.
@@ -216,6 +245,19 @@ namespace Train {
      */
     NNUE::Network* adamW(std::vector<DataPoint>& data, size_t numEpochs, double learningRate, double kappa);
 
+    /**
+     * @brief Verbessert die Parameter eines NNUE-Modells über den AdamW-Algorithmus.
+     * Die Trainingsdaten werden dabei von einem Datenlader bereitgestellt.
+     * 
+     * @param loader Der Datenlader für die Trainingsdaten.
+     * @param validationData Die Validierungsdaten.
+     * @param numEpochs Die Anzahl der Epochen.
+     * @param learningRate Die Lernrate.
+     * @param kappa Bestimmt, wie stark das finale Ergebnis in das Ziel einfließen soll.
+     * @return NNUE::Network* Die verbesserten Parameter.
+     */
+    NNUE::Network* adamW(DataLoader& loader, std::vector<DataPoint>& validationData, size_t numEpochs, double learningRate, double kappa);
+
     /**
      * @brief Initialisiert die Master-Parameter mit der Kaiming-Initialisierung.
      * 
@@ -5,8 +5,12 @@
 #include <random>
 
 #include "core/utils/Random.h"
+#include "tune/DataLoader.h"
 #include "tune/Definitions.h"
+#include "tune/Openings.h"
 #include "tune/Simulation.h"
+#include "tune/TrainingData.h"
+#include "tune/ml/Check.h"
 #include "tune/nnue/Train.h"
 #include "uci/Options.h"
 
@@ -17,8 +21,6 @@ void generateData() {
     simulateGames(numGames.get<size_t>(), timeControl.get<uint32_t>(), increment.get<uint32_t>(), NNUE::DEFAULT_NETWORK);
 }
 
-std::vector<DataPoint> loadData(std::istream& resultFile, size_t n = std::numeric_limits<size_t>::max());
-
 void findOptimalK();
 
 void gradientDescent();
@@ -46,9 +48,6 @@ void displayParameters() {
 }
 
 int main() {
-    // Initialisere die Magic Bitboards
-    Magics::initializeMagics();
-
     // Setze die UCI-Option Threads auf 1
     UCI::options["Threads"] = 1;
 
@@ -62,6 +61,18 @@ int main() {
 
         if(input == "gen")
             generateData();
+        else if(input == "convert")
+            convertTextSamples(textSamplesFilePath.get<std::string>(), samplesFilePath.get<std::string>());
+        else if(input == "openings") {
+            std::vector<PackedBoard> openings = sampleOpenings(pgnFilePath.get<std::string>(), numGames.get<size_t>(),
+                                                               openingBookMovesMin.get<size_t>(), openingBookMovesMax.get<size_t>(),
+                                                               simSeed.get<uint32_t>(), numThreads.get<size_t>());
+
+            if(writeOpenings(openingsFilePath.get<std::string>(), openings))
+                std::cout << "Saved " << openings.size() << " openings to " << openingsFilePath.get<std::string>() << std::endl;
+            else
+                std::cerr << "Could not write " << openingsFilePath.get<std::string>() << std::endl;
+        }
         // else if(input == "findK")
         //     findOptimalK();
         else if(input == "grad")
@@ -70,6 +81,12 @@ int main() {
             displayParameters();
          else if(input == "learn")
              learn();
+        else if(input == "checkml")
+            ML::checkKernels();
+        else if(input == "benchml")
+            ML::benchmarkKernels();
+        else if(input == "benchadam")
+            ML::benchmarkOptimizer();
         else {
             size_t pos = input.find("=");
             if(pos != std::string::npos) {
@@ -91,39 +108,20 @@ int main() {
 }
 
 void simulateGames(size_t n, uint32_t timeControl, uint32_t increment, const NNUE::Network& network) {
-    std::ifstream pgnFile(pgnFilePath.get<std::string>());
-
-    std::vector<Board> startingPositions;
-    std::vector<unsigned int> startingMoves;
-    startingPositions.reserve(n);
-    startingMoves.reserve(n);
-
     std::mt19937& generator = Random::generator<5>();
-    std::uniform_int_distribution openingBookMoves(openingBookMovesMin.get<size_t>(), openingBookMovesMax.get<size_t>());
     std::uniform_int_distribution randomMoves(randomMovesMin.get<size_t>(), randomMovesMax.get<size_t>());
 
-    std::cout << "Loaded 0 games" << std::flush;
-
-    // Lade alle Positionen aus der PGN-Datei
-    size_t i = 0;
-    while(pgnFile.good()) {
-        startingPositions.push_back(std::get<0>(Board::fromPGN(pgnFile, openingBookMoves(generator))));
-        i++;
+    // Wähle n zufällige Positionen aus der PGN-Datei aus
+    std::vector<PackedBoard> openings = sampleOpenings(pgnFilePath.get<std::string>(), n, openingBookMovesMin.get<size_t>(),
+                                                       openingBookMovesMax.get<size_t>(), generator(), numThreads.get<size_t>());
 
-        if(i % 10 == 0)
-            std::cout << "\rLoaded " << i << " games" << std::flush;
-    }
-
-    // Entferne die letzte Position, da sie nicht vollständig geladen wurde
-    if(!startingPositions.empty())
-        startingPositions.pop_back();
-
-    std::cout << "\rLoaded " << startingPositions.size() << " games" << std::endl;
+    std::vector<Board> startingPositions;
+    std::vector<unsigned int> startingMoves;
+    startingPositions.reserve(openings.size());
+    startingMoves.reserve(openings.size());
 
-    // Wähle n zufällige Positionen aus
-    std::shuffle(startingPositions.begin(), startingPositions.end(), generator);
-    if(startingPositions.size() > n)
-        startingPositions.resize(n);
+    for(const PackedBoard& opening : openings)
+        startingPositions.push_back(Board(opening));
 
     for(size_t i = 0; i < startingPositions.size(); i++) {
         size_t numRandomMoves = randomMoves(generator);
@@ -139,13 +137,16 @@ void simulateGames(size_t n, uint32_t timeControl, uint32_t increment, const NNU
         startingMoves.push_back(startingPositions[i].getAge());
     }
 
-    pgnFile.close();
 
     size_t numPVs = simMultiPV.get<size_t>();
     numPVs = std::max(numPVs, (size_t)1);
     UCI::options["MultiPV"] = numPVs;
 
     Simulation sim(startingPositions, timeControl, increment, numThreads.get<size_t>());
+    sim.setHashSize(simHashSize.get<size_t>());
+    sim.setSearchLimits(simNodes.get<uint64_t>(), simDepth.get<int>());
+    sim.setNodesPerMillisecond(simNodesPerMs.get<double>());
+    sim.setSeed(simSeed.get<uint32_t>());
 
     sim.setParams(network);
     sim.setTemperature(temperature.get<double>());
@@ -153,91 +154,23 @@ void simulateGames(size_t n, uint32_t timeControl, uint32_t increment, const NNU
 
     sim.run();
 
-    std::ofstream outFile(samplesFilePath.get<std::string>(), std::ios::trunc);
-
-    std::cout << "Writing results to file..." << std::endl;
-    std::cout << "Remaining games: " << startingPositions.size() << std::flush;
-
-    std::vector<Result>& results = sim.getResults();
-
-    for(size_t i = 0; i < startingPositions.size(); i++) {
-        int outputSize = (int)startingPositions[i].getAge() - (int)startingMoves[i];
-        if(outputSize <= 0)
-            continue;
-
-        std::vector<std::string> output;
-        output.resize(outputSize);
-
-        int finalResult;
-        switch(results[i].result) {
-            case WHITE_WIN:
-                finalResult = 1;
-                break;
-            case BLACK_WIN:
-                finalResult = -1;
-                break;
-            default:
-                finalResult = 0;
-                break;
-        }
-
-        for(int j = (int)results[i].leafEvaluations.size() - 1; j >= 0; j--) {
-            // Mache den letzten Zug rückgängig, das Spiel ist da schon vorbei
-            startingPositions[i].undoMove();
-
-            std::stringstream ss;
-            ss << startingPositions[i].toFEN() << ";" << results[i].leafFENs[j] << ";" <<
-                results[i].leafEvaluations[j] << ";" << finalResult << ";" << results[i].logProbs[j];
-            output[j] = ss.str();
-        }
-
-        for(int j = 0; j < outputSize; j++)
-            outFile << output[j] << "\n";
-
-        outFile << "NEW_GAME\n";
-
-        if(i % 10 == 0)
-            std::cout << "\rRemaining games: " << std::left << std::setw(7) <<
-            startingPositions.size() - i << std::right << std::flush;
-    }
-
-    std::cout << "\rRemaining games: 0      " << std::endl;
-
-    outFile.close();
+    TrainingDataWriter writer(samplesFilePath.get<std::string>());
+    sim.writeResults(writer, startingMoves);
 }
 
 void updateEloTable(size_t n, uint32_t timeControl, uint32_t increment, EloTable<NNUE::Network>& eloTable) {
-    std::ifstream pgnFile(pgnFilePath.get<std::string>());
-
-    std::vector<Board> startingPositions;
-    startingPositions.reserve(n);
-
     std::mt19937& generator = Random::generator<6>();
-    std::uniform_int_distribution openingBookMoves(eloOpeningBookMovesMin.get<size_t>(), eloOpeningBookMovesMax.get<size_t>());
     std::uniform_int_distribution randomMoves(eloRandomMovesMin.get<size_t>(), eloRandomMovesMax.get<size_t>());
 
-    std::cout << "Loaded 0 games" << std::flush;
-
-    // Lade alle Positionen aus der PGN-Datei
-    size_t i = 0;
-    while(pgnFile.good()) {
-        startingPositions.push_back(std::get<0>(Board::fromPGN(pgnFile, openingBookMoves(generator))));
-        i++;
-
-        if(i % 10 == 0)
-            std::cout << "\rLoaded " << i << " games" << std::flush;
-    }
-
-    // Entferne die letzte Position, da sie nicht vollständig geladen wurde
-    if(!startingPositions.empty())
-        startingPositions.pop_back();
+    // Wähle n zufällige Positionen aus der PGN-Datei aus
+    std::vector<PackedBoard> openings = sampleOpenings(pgnFilePath.get<std::string>(), n, eloOpeningBookMovesMin.get<size_t>(),
+                                                       eloOpeningBookMovesMax.get<size_t>(), generator(), numThreads.get<size_t>());
 
-    std::cout << "\rLoaded " << startingPositions.size() << " games" << std::endl;
+    std::vector<Board> startingPositions;
+    startingPositions.reserve(openings.size());
 
-    // Wähle n zufällige Positionen aus
-    std::shuffle(startingPositions.begin(), startingPositions.end(), generator);
-    if(startingPositions.size() > n)
-        startingPositions.resize(n);
+    for(const PackedBoard& opening : openings)
+        startingPositions.push_back(Board(opening));
 
     for(size_t i = 0; i < startingPositions.size(); i++) {
         size_t numRandomMoves = randomMoves(generator);
@@ -251,100 +184,39 @@ void updateEloTable(size_t n, uint32_t timeControl, uint32_t increment, EloTable
         }
     }
 
-    pgnFile.close();
 
     UCI::options["MultiPV"] = 1;
 
     Simulation sim(startingPositions, timeControl, increment, numThreads.get<size_t>());
+    sim.setHashSize(simHashSize.get<size_t>());
+    sim.setSearchLimits(simNodes.get<uint64_t>(), simDepth.get<int>());
+    sim.setNodesPerMillisecond(simNodesPerMs.get<double>());
+    sim.setSeed(simSeed.get<uint32_t>());
     sim.run(eloTable, eloPlayerChoiceTemperature.get<double>());
 }
 
-void calculateTDTargets(std::vector<DataPoint>& dest, std::vector<DataPoint>& rawData) {
-    double terminalValue = 0.0;
-    int finalResult = rawData.empty() ? 0 : rawData.back().finalResult;
-    
-    if(finalResult == 1)
-        terminalValue = virtualMateScore.get<double>();
-    else if(finalResult == -1)
-        terminalValue = -virtualMateScore.get<double>();
-    
-    double tdTarget = terminalValue;
-    double currentLambda = lambda.get<double>();
-    double currentDiscount = discount.get<double>();
-
-    for(int j = (int)rawData.size() - 1; j >= 0; j--) {
-        double nextSearchValue;
-        if(j == (int)rawData.size() - 1)
-            nextSearchValue = terminalValue;
-        else
-            nextSearchValue = rawData[j + 1].leafEvaluation;
-        
-        tdTarget = currentDiscount * ((1.0 - currentLambda) * nextSearchValue + currentLambda * tdTarget);
-
-        dest.push_back({rawData[j].board, rawData[j].leafBoard, rawData[j].leafEvaluation, finalResult, rawData[j].logProb, tdTarget});
+NNUE::Network* optimize(size_t numEpochs, double learningRate) {
+    if(!streamData.get<bool>()) {
+        std::vector<DataPoint> data = loadData(samplesFilePath.get<std::string>());
+        return Train::adamW(data, numEpochs, learningRate, kappa.get<double>());
     }
-}
-
-std::vector<DataPoint> loadData(std::istream& resultFile, size_t n) {
-    std::cout << "Loading data..." << std::endl;
-
-    std::vector<DataPoint> data;
-
-    std::cout << "Loaded 0 data points" << std::flush;
 
-    std::vector<DataPoint> currentGame;
+    StreamingDataLoader loader(samplesFilePath.get<std::string>(), batchSize.get<size_t>(), shuffleBufferSize.get<size_t>(),
+                               prefetchBatches.get<size_t>(), dataSeed.get<uint32_t>(), validationSplit.get<double>());
 
-    std::string line;
-    while(std::getline(resultFile, line) && data.size() < n) {
-        if(line == "NEW_GAME") {
-            calculateTDTargets(data, currentGame);
-            currentGame.clear();
+    std::cout << "Streaming " << loader.getNumRecords() << " data points from " << loader.getNumShards() << " shard(s)" << std::endl;
 
-            if(data.size() % 10 == 0)
-                std::cout << "\rLoaded " << data.size() << " data points" << std::flush;
-
-            continue;
-        }
-
-        if(line.empty())
-            continue;
-
-        std::stringstream ss(line);
-        std::string segment;
-        std::vector<std::string> parts;
-        while(std::getline(ss, segment, ';'))
-            parts.push_back(segment);
-
-        if(parts.size() < 5)
-            continue;
-
-        Board board(parts[0]);
-        Board leafBoard(parts[1]);
-        int leafEvaluation = std::stoi(parts[2]);
-        int finalResult = std::stoi(parts[3]);
-        double logProb = std::stod(parts[4]);
-
-        currentGame.push_back({board, leafBoard, leafEvaluation, finalResult, logProb, 0.0});
-    }
-
-    calculateTDTargets(data, currentGame);
-
-    std::cout << "\rLoaded " << data.size() << " data points" << std::endl;
-
-    return data;
+    std::vector<DataPoint> validationData = loader.loadValidationData(maxValidationSamples.get<size_t>());
+    return Train::adamW(loader, validationData, numEpochs, learningRate, kappa.get<double>());
 }
 
 void gradientDescent() {
-    std::ifstream samplesFile(samplesFilePath.get<std::string>());
-    std::vector<DataPoint> data = loadData(samplesFile);
-    samplesFile.close();
-
     if(startFromScratch.get<bool>())
         Train::kaimingInitialization(Train::trainingSession.masterWeights);
     else
         Train::trainingSession = Train::TrainingSession(NNUE::DEFAULT_NETWORK);
 
-    NNUE::Network* network = Train::adamW(data, numEpochs.get<size_t>(), learningRate.get<double>(), kappa.get<double>());
+    NNUE::Network* network = optimize(numEpochs.get<size_t>(), learningRate.get<double>());
 
     std::ofstream outFile("data/optimized.nnue", std::ios::binary);
     outFile << *network;
@@ -357,7 +229,12 @@ void learn() {
 
     std::ifstream trainingSessionFile("data/trainingSessionNNUE.tsession");
     if(trainingSessionFile.good()) {
-        trainingSessionFile >> Train::trainingSession;
+        if(!(trainingSessionFile >> Train::trainingSession)) {
+            std::cerr << "data/trainingSessionNNUE.tsession was saved by an incompatible version, "
+                         "remove it to start a new training session." << std::endl;
+            return;
+        }
+
         trainingSessionFile.close();
 
         std::cout << "Loaded training session from file." << std::endl;
@@ -413,14 +290,10 @@ void learn() {
         // Generiere die Datenpunkte
         simulateGames(currentNumGames, currentTimeControl, currentIncrement, *network);
 
-        // Lade die Datenpunkte
-        std::ifstream samplesFile(samplesFilePath.get<std::string>());
-        std::vector<DataPoint> data = loadData(samplesFile);
-
         // Führe den Gradientenabstieg durch
         std::cout << "Optimizing parameters:" << std::endl;
         delete network;
-        network = Train::adamW(data, currentNumEpochs, currentLearningRate, kappa.get<double>());
+        network = optimize(currentNumEpochs, currentLearningRate);
 
         // Speichere die Parameter als current.nnue
         std::ofstream currentNetworkFile("data/current.nnue", std::ios::binary);
@@ -432,9 +305,7 @@ void learn() {
 
         // Alle eloUpdatePeriod Generationen: Aktualisiere die Elo-Werte
         if((i + 1) % eloUpdatePeriod.get<size_t>() == 0) {
-            std::ifstream pgnFile(pgnFilePath.get<std::string>());
             updateEloTable(eloNumGamesPerUpdate.get<size_t>(), currentTimeControl, currentIncrement, Train::trainingSession.eloTable);
-            pgnFile.close();
 
             std::cout << "\nElo Table (Generation " << i + 1 << "):\n";
             Train::trainingSession.eloTable.write(std::cout);
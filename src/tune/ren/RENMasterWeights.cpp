@@ -2,32 +2,30 @@
 
 #include <cmath>
 
-REN::NetworkActivations REN::MasterWeights::forward(const Board& board, bool fakeQuantization,
+REN::NetworkActivations REN::MasterWeights::forward(const ML::HalfKAv2_hmFeatures& features, bool fakeQuantization,
     size_t maxIterations, float tol) const {
 
     NetworkActivations activations;
 
-    activations.halfKPActivations = halfKAv2Layer.forward(board, fakeQuantization);
+    activations.halfKPActivations = halfKAv2Layer.forward(features, fakeQuantization);
     activations.renActivations = renLayer.forward(activations.halfKPActivations.output, fakeQuantization, maxIterations, tol);
     activations.outputLayerActivations = outputLayer.forward(activations.renActivations.h_opt, fakeQuantization);
 
     return activations;
 }
 
-REN::Gradients REN::MasterWeights::backward(const Board& board, const NetworkActivations& activations, const ML::DenseLayer::ForwardResult& encActivations,
-    float outputGrad, float encOutputGrad, bool fakeQuantization) const {
-
-    Gradients gradients;
+void REN::MasterWeights::backward(const ML::HalfKAv2_hmFeatures& features, const NetworkActivations& activations, const ML::DenseLayer::ForwardResult& encActivations,
+    float outputGrad, float encOutputGrad, bool fakeQuantization, Gradients& gradients) const {
 
     // Pfad A: outputGrad -> outputLayer -> renLayer -> halfKAv2Layer
     ML::Vector mainGradVec(1);
     mainGradVec(0) = outputGrad;
 
-    gradients.outputLayerGradients = outputLayer.backward(activations.renActivations.h_opt,
+    ML::DenseLayer::Gradients outputLayerGradients = outputLayer.backward(activations.renActivations.h_opt,
         activations.outputLayerActivations, mainGradVec, fakeQuantization);
 
-    gradients.renGradients = renLayer.backward(activations.renActivations,
-        gradients.outputLayerGradients.inputGrad, fakeQuantization);
+    SparseRENLayer::Gradients renGradients = renLayer.backward(activations.renActivations,
+        outputLayerGradients.inputGrad, fakeQuantization);
 
     // Pfad B: encOutputGrad -> outputLayer -> halfKAv2Layer
     ML::Vector encGradVec(1);
@@ -36,14 +34,18 @@ REN::Gradients REN::MasterWeights::backward(const Board& board, const NetworkAct
     ML::DenseLayer::Gradients encOutputLayerGradients = outputLayer.backward(activations.halfKPActivations.output,
         encActivations, encGradVec, fakeQuantization);
 
-    gradients.outputLayerGradients.bias += encOutputLayerGradients.bias;
-    gradients.outputLayerGradients.weights += encOutputLayerGradients.weights;
-
     // Gradienten für Encoder zusammenführen
-    gradients.renGradients.inputGrad += encOutputLayerGradients.inputGrad;
+    renGradients.inputGrad += encOutputLayerGradients.inputGrad;
 
-    gradients.halfKAGradients = halfKAv2Layer.backward(board,
-        activations.halfKPActivations, gradients.renGradients.inputGrad, fakeQuantization);
+    halfKAv2Layer.backward(features, activations.halfKPActivations, renGradients.inputGrad, fakeQuantization, gradients.halfKAGradients);
 
-    return gradients;
+    gradients.renGradients.bias += renGradients.bias;
+    for(size_t j = 0; j < renGradients.q.size(); j++)
+        gradients.renGradients.q[j] += renGradients.q[j];
+    gradients.renGradients.gammaRaw += renGradients.gammaRaw;
+
+    gradients.outputLayerGradients.bias += outputLayerGradients.bias;
+    gradients.outputLayerGradients.weights += outputLayerGradients.weights;
+    gradients.outputLayerGradients.bias += encOutputLayerGradients.bias;
+    gradients.outputLayerGradients.weights += encOutputLayerGradients.weights;
 }
\ No newline at end of file
@@ -15,6 +15,21 @@ namespace REN {
         ML::HalfKAv2_hmLayer::Gradients halfKAGradients{HALF_KA_OUTPUT_SIZE};
         SparseRENLayer::Gradients renGradients{SQRT_REN_SIZE};
         ML::DenseLayer::Gradients outputLayerGradients{REN_SIZE, 1};
+
+        /**
+         * @brief Setzt alle Gradienten auf 0 zurück, ohne den Speicher freizugeben.
+         */
+        inline void clear() {
+            halfKAGradients.clear();
+
+            for(ML::Matrix& q : renGradients.q)
+                ML::__unsafe_set_zero(q.data(), q.size);
+
+            ML::__unsafe_set_zero(renGradients.gammaRaw.data(), renGradients.gammaRaw.size);
+            ML::__unsafe_set_zero(renGradients.bias.data(), renGradients.bias.size);
+            ML::__unsafe_set_zero(outputLayerGradients.weights.data(), outputLayerGradients.weights.size);
+            ML::__unsafe_set_zero(outputLayerGradients.bias.data(), outputLayerGradients.bias.size);
+        }
     };
 
     struct NetworkActivations {
@@ -34,11 +49,20 @@ namespace REN {
         
         inline MasterWeights() = default;
 
-        NetworkActivations forward(const Board& board, bool fakeQuantization,
+        NetworkActivations forward(const ML::HalfKAv2_hmFeatures& features, bool fakeQuantization,
             size_t maxIterations = std::numeric_limits<size_t>::max(), float tol = 1e-4f) const;
 
-        Gradients backward(const Board& board, const NetworkActivations& activations, const ML::DenseLayer::ForwardResult& encActivations,
-            float outputGrad, float encOutputGrad, bool fakeQuantization) const;
+        /**
+         * @brief Führt einen Rückwärtspass durch und addiert die Gradienten zu gradients.
+         */
+        void backward(const ML::HalfKAv2_hmFeatures& features, const NetworkActivations& activations, const ML::DenseLayer::ForwardResult& encActivations,
+            float outputGrad, float encOutputGrad, bool fakeQuantization, Gradients& gradients) const;
+
+        inline NetworkActivations forward(const Board& board, bool fakeQuantization,
+            size_t maxIterations = std::numeric_limits<size_t>::max(), float tol = 1e-4f) const {
+
+            return forward(ML::HalfKAv2_hmFeatures(board), fakeQuantization, maxIterations, tol);
+        }
     };
 }
 
@@ -1,5 +1,6 @@
 #include "tune/ren/Train.h"
 #include "core/utils/Random.h"
+#include "tune/ml/AdamW.h"
 
 #include <cmath>
 #include <iomanip>
@@ -34,7 +35,7 @@ double networkOutputToCentipawns(float output) {
     return (output * (128.0 * 128.0) * 100.0 / 6656.0);
 }
 
-Train::LossSummary Train::loss(const std::vector<DataPoint>& data, const REN::MasterWeights& masterWeights, double k,
+Train::LossSummary Train::loss(const std::vector<TrainingSample>& data, const REN::MasterWeights& masterWeights, double k,
     double kappa, double encLossWeight, size_t iterationLimit) {
 
     std::atomic<double> sum = 0.0;
@@ -58,17 +59,17 @@ Train::LossSummary Train::loss(const std::vector<DataPoint>& data, const REN::Ma
             uint64_t localMaxIterations = 0;
 
             for(size_t i = start; i < end; i++) {
-                const DataPoint& dp = data[i];
+                const TrainingSample& sample = data[i];
 
-                REN::NetworkActivations activations = masterWeights.forward(dp.board, true, iterationLimit);
+                REN::NetworkActivations activations = masterWeights.forward(sample.features, true, iterationLimit);
                 float networkOutput = activations.output();
                 double prediction = tanh(networkOutputToCentipawns(networkOutput), k);
 
                 double encPrediction = masterWeights.outputLayer.forward(activations.halfKPActivations.output, true).output(0);
                 encPrediction = tanh(networkOutputToCentipawns(encPrediction), k);
 
-                double target = (1.0 - kappa) * tanh(dp.tdTarget, k) + kappa * (double)dp.finalResult;
-                if(dp.board.getSideToMove() == BLACK)
+                double target = (1.0 - kappa) * tanh(sample.tdTarget, k) + kappa * (double)sample.finalResult;
+                if(sample.getSideToMove() == BLACK)
                     target = -target;
 
                 sum.fetch_add(mse(prediction, target) + encLossWeight * mse(encPrediction, target));
@@ -102,32 +103,37 @@ constexpr double lossGrad(double prediction, double target, double k) {
     return 2.0 * (prediction - target) * (1.0 - prediction * prediction) * k * 100.0 * (16384.0 / 6656.0);
 }
 
-REN::Gradients Train::gradient(const std::vector<DataPoint>& data, const std::vector<size_t>& indices, const REN::MasterWeights& masterWeights,
-    double k, double kappa, double encLossWeight) {
+/**
+ * @brief Die Gradienten-Akkumulatoren der Threads. Sie werden für alle Batches
+ * wiederverwendet, damit der Speicher der Gradientenzeilen nur einmal angefordert wird.
+ */
+static std::vector<REN::Gradients> threadGradientAccum;
+
+void Train::gradient(const std::vector<TrainingSample>& batch, const REN::MasterWeights& masterWeights,
+    double k, double kappa, double encLossWeight, REN::Gradients& totalGrad) {
 
     size_t currIndex = 0;
     std::mutex mutex;
 
     size_t numThreads = std::max(std::thread::hardware_concurrency(), 1u);
-    std::vector<REN::Gradients> threadGradientAccum;
     threadGradientAccum.resize(numThreads);
 
     auto threadFunc = [&](size_t threadId) {
         REN::Gradients& grads = threadGradientAccum[threadId];
+        grads.clear();
 
         mutex.lock();
-        while(currIndex < indices.size()) {
+        while(currIndex < batch.size()) {
             // Bearbeite Blöcke von 16 Datenpunkten
             size_t start = currIndex;
-            size_t end = std::min(currIndex + 16, indices.size());
+            size_t end = std::min(currIndex + 16, batch.size());
             currIndex = end;
             mutex.unlock();
 
             for(size_t i = start; i < end; i++) {
-                size_t dataIndex = indices[i];
-                const DataPoint& dp = data[dataIndex];
+                const TrainingSample& sample = batch[i];
 
-                REN::NetworkActivations activations = masterWeights.forward(dp.board, true);
+                REN::NetworkActivations activations = masterWeights.forward(sample.features, true);
                 float networkOutput = activations.output();
                 double cp = networkOutputToCentipawns(networkOutput);
                 double prediction = tanh(cp, k);
@@ -137,28 +143,15 @@ REN::Gradients Train::gradient(const std::vector<DataPoint>& data, const std::ve
                 double encCp = networkOutputToCentipawns(encOutput);
                 double encPrediction = tanh(encCp, k);
 
-                double target = (1.0 - kappa) * tanh(dp.tdTarget, k) + kappa * (double)dp.finalResult;
-                if(dp.board.getSideToMove() == BLACK)
+                double target = (1.0 - kappa) * tanh(sample.tdTarget, k) + kappa * (double)sample.finalResult;
+                if(sample.getSideToMove() == BLACK)
                     target = -target;
 
                 double errorGrad = lossGrad(prediction, target, k);
                 double encErrorGrad = lossGrad(encPrediction, target, k) * encLossWeight;
 
                 // Berechne die Gradienten für die Master-Parameter und addiere sie zum Thread-Gradienten
-                REN::Gradients dpGrad = masterWeights.backward(dp.board, activations, encActivations, errorGrad, encErrorGrad, true);
-
-                grads.halfKAGradients.bias += dpGrad.halfKAGradients.bias;
-
-                for(const auto& [feature, value] : dpGrad.halfKAGradients.weights)
-                    grads.halfKAGradients.weights[feature] += value;
-
-                grads.renGradients.bias += dpGrad.renGradients.bias;
-                for(size_t j = 0; j < dpGrad.renGradients.q.size(); j++)
-                    grads.renGradients.q[j] += dpGrad.renGradients.q[j];
-                grads.renGradients.gammaRaw += dpGrad.renGradients.gammaRaw;
-
-                grads.outputLayerGradients.bias += dpGrad.outputLayerGradients.bias;
-                grads.outputLayerGradients.weights += dpGrad.outputLayerGradients.weights;
+                masterWeights.backward(sample.features, activations, encActivations, errorGrad, encErrorGrad, true, grads);
             }
 
             mutex.lock();
@@ -177,13 +170,15 @@ REN::Gradients Train::gradient(const std::vector<DataPoint>& data, const std::ve
         t.join();
 
     // Durchschnittsbildung für die Gradienten des Threads
-    REN::Gradients totalGrad;
+    totalGrad.clear();
 
-    for(size_t i = 0; i < numThreads; i++) {
-        totalGrad.halfKAGradients.bias += threadGradientAccum[i].halfKAGradients.bias;
-        for(const auto& [feature, value] : threadGradientAccum[i].halfKAGradients.weights)
-            totalGrad.halfKAGradients.weights[feature] += value;
+    std::vector<const ML::HalfKAv2_hmLayer::Gradients*> halfKASources;
+    for(size_t i = 0; i < numThreads; i++)
+        halfKASources.push_back(&threadGradientAccum[i].halfKAGradients);
 
+    totalGrad.halfKAGradients.merge(halfKASources, 1.0f / batch.size(), numThreads);
+
+    for(size_t i = 0; i < numThreads; i++) {
         totalGrad.renGradients.bias += threadGradientAccum[i].renGradients.bias;
         for(size_t j = 0; j < threadGradientAccum[i].renGradients.q.size(); j++)
             totalGrad.renGradients.q[j] += threadGradientAccum[i].renGradients.q[j];
@@ -193,24 +188,16 @@ REN::Gradients Train::gradient(const std::vector<DataPoint>& data, const std::ve
         totalGrad.outputLayerGradients.weights += threadGradientAccum[i].outputLayerGradients.weights;
     }
 
-    totalGrad.halfKAGradients.bias /= indices.size();
-    for(const auto& [feature, value] : totalGrad.halfKAGradients.weights)
-        totalGrad.halfKAGradients.weights[feature] = totalGrad.halfKAGradients.weights[feature] / indices.size();
-
-    totalGrad.renGradients.bias /= indices.size();
+    totalGrad.renGradients.bias /= batch.size();
     for(size_t j = 0; j < totalGrad.renGradients.q.size(); j++)
-        totalGrad.renGradients.q[j] /= indices.size();
-    totalGrad.renGradients.gammaRaw /= indices.size();
+        totalGrad.renGradients.q[j] /= batch.size();
+    totalGrad.renGradients.gammaRaw /= batch.size();
 
-    totalGrad.outputLayerGradients.bias /= indices.size();
-    totalGrad.outputLayerGradients.weights /= indices.size();
-
-    return totalGrad;
+    totalGrad.outputLayerGradients.bias /= batch.size();
+    totalGrad.outputLayerGradients.weights /= batch.size();
 }
 
 void Train::adamW(std::vector<DataPoint>& data, size_t numEpochs, double learningRate, double kappa, double encLossWeight) {
-    REN::MasterWeights& masterWeights = trainingSession.masterWeights;
-
     // Teile die Daten in Trainings- und Validierungsdaten auf
     size_t validationSize = data.size() * validationSplit.get<double>();
     std::vector<DataPoint> validationData;
@@ -223,12 +210,22 @@ void Train::adamW(std::vector<DataPoint>& data, size_t numEpochs, double learnin
         data.erase(data.end() - validationSize, data.end());
     }
 
-    // Initialisiere den Indexvektor
-    std::vector<size_t> indices(data.size());
-    for(size_t i = 0; i < indices.size(); i++)
-        indices[i] = i;
+    MemoryDataLoader loader(data, batchSize.get<size_t>(), dataSeed.get<uint32_t>());
+
+    adamW(loader, validationData, numEpochs, learningRate, kappa, encLossWeight);
+}
+
+void Train::adamW(DataLoader& loader, std::vector<DataPoint>& validationData, size_t numEpochs, double learningRate, double kappa, double encLossWeight) {
+    REN::MasterWeights& masterWeights = trainingSession.masterWeights;
+
+    // Die Features der Validierungsdaten werden nur einmal extrahiert
+    std::vector<TrainingSample> validationSamples = decodeSamples(validationData);
+
+    std::vector<TrainingSample> batch;
+    REN::Gradients grad;
 
-    std::mt19937& rng = Random::generator<11>();
+    ML::AdamW adam(beta1.get<double>(), beta2.get<double>(), epsilon.get<double>(), weightDecay.get<double>(),
+                   std::max(std::thread::hardware_concurrency(), 1u));
 
     size_t patience = 0;
 
@@ -238,7 +235,7 @@ void Train::adamW(std::vector<DataPoint>& data, size_t numEpochs, double learnin
 
     for(; trainingSession.epoch < targetEpochs; trainingSession.epoch++) {
         // Berechne den Fehler
-        auto [masterLossExact, avgIterations, minIterations, maxIterations] = Train::loss(validationData, masterWeights, k.get<double>(), kappa, encLossWeight);
+        auto [masterLossExact, avgIterations, minIterations, maxIterations] = Train::loss(validationSamples, masterWeights, k.get<double>(), kappa, encLossWeight);
 
         // Überprüfe, ob der Fehler besser ist
         if(masterLossExact < bestLoss) {
@@ -254,22 +251,14 @@ void Train::adamW(std::vector<DataPoint>& data, size_t numEpochs, double learnin
         }
 
         // Shuffle die Trainingsdaten für die nächste Epoche
-        std::shuffle(indices.begin(), indices.end(), rng);
-
-        // Zerlege die Trainingsdaten in Batches
-        size_t numBatches = indices.size() / batchSize.get<size_t>();
-        if(indices.size() % batchSize.get<size_t>() != 0)
-            numBatches++;
-
-        std::vector<std::vector<size_t>> batches(numBatches);
-        for(size_t i = 0; i < indices.size(); i++)
-            batches[i / batchSize.get<size_t>()].push_back(indices[i]);
+        loader.startEpoch(trainingSession.epoch);
 
+        size_t numBatches = std::max(loader.getNumBatches(), (size_t)1);
         size_t batchesProcessed = 0;
 
-        float loss0It = Train::loss(validationData, masterWeights, k.get<double>(), kappa, 0.0, 0).loss;
-        float loss2It = Train::loss(validationData, masterWeights, k.get<double>(), kappa, 0.0, 2).loss;
-        float lossOpt = Train::loss(validationData, masterWeights, k.get<double>(), kappa, 0.0).loss;
+        float loss0It = Train::loss(validationSamples, masterWeights, k.get<double>(), kappa, 0.0, 0).loss;
+        float loss2It = Train::loss(validationSamples, masterWeights, k.get<double>(), kappa, 0.0, 2).loss;
+        float lossOpt = Train::loss(validationSamples, masterWeights, k.get<double>(), kappa, 0.0).loss;
         float spectralRadius = masterWeights.renLayer.spectralRadius();
 
         std::stringstream ssLoss;
@@ -289,121 +278,57 @@ void Train::adamW(std::vector<DataPoint>& data, size_t numEpochs, double learnin
         std::cout << ssOutput.str() << std::endl;
 
         // Berechne die Gradienten für alle Batches und aktualisiere die Master-Parameter mit AdamW
-        for(const std::vector<size_t>& batchIndices : batches) {
-            REN::Gradients grad = Train::gradient(data, batchIndices, masterWeights, k.get<double>(), kappa, encLossWeight);
+        while(loader.nextBatch(batch)) {
+            Train::gradient(batch, masterWeights, k.get<double>(), kappa, encLossWeight, grad);
 
             batchesProcessed++;
-            double batchProgress = (double)batchesProcessed / numBatches * 100.0;
+            double batchProgress = std::min((double)batchesProcessed / numBatches, 1.0) * 100.0;
             std::cout << "\rBatch: "  << std::setw(3) << (int)batchProgress << "%" << std::flush;
 
             // Aktualisiere die Master-Parameter mit AdamW
+            adam.beginStep(trainingSession.epoch + 1, learningRate);
 
-            double wd = weightDecay.get<double>();
-            double b1 = beta1.get<double>();
-            double b2 = beta2.get<double>();
-            double eps = epsilon.get<double>();
-
-            // HalfKAv2_hm-Layer
-            for(const auto& [feature, value] : grad.halfKAGradients.weights) {
-                // Anzahl der Schritte seit dem letzten Update dieses Features (inklusive aktuellem Schritt)
-                size_t tDelta = trainingSession.epoch - trainingSession.lastUpdateHalfKPWeights[feature] + 1;
-                trainingSession.lastUpdateHalfKPWeights[feature] = trainingSession.epoch + 1;
+            // HalfKAv2_hm-Layer: Sparse AdamW, nur die Zeilen aktiver Features haben einen Gradienten.
+            // Alle Gewichte einer Zeile werden immer gemeinsam aktualisiert.
+            adam.updateRows(masterWeights.halfKAv2Layer, trainingSession.mHalfKPWeights.data(), trainingSession.vHalfKPWeights.data(),
+                            trainingSession.lastUpdateHalfKPWeights.data(), trainingSession.epoch + 1, grad.halfKAGradients,
+                            std::numeric_limits<float>::lowest(), std::numeric_limits<float>::max());
 
-                trainingSession.mHalfKPWeights[feature] = std::pow(b1, tDelta) * trainingSession.mHalfKPWeights[feature] + (1.0 - b1) * value;
-                trainingSession.vHalfKPWeights[feature] = std::pow(b2, tDelta) * trainingSession.vHalfKPWeights[feature] + (1.0 - b2) * value * value;
-
-                double mHat = trainingSession.mHalfKPWeights[feature] / (1.0 - std::pow(b1, trainingSession.epoch + 1));
-                double vHat = trainingSession.vHalfKPWeights[feature] / (1.0 - std::pow(b2, trainingSession.epoch + 1));
-
-                // Lazy AdamW: trage den verpassten Decay exakt nach, bevor der Gradienten-Schritt angewendet wird.
-                double decayFactor = std::pow(1.0 - learningRate * wd, tDelta);
-
-                masterWeights.halfKAv2Layer.weights(feature) = masterWeights.halfKAv2Layer.weights(feature) * decayFactor
-                    - learningRate * mHat / (std::sqrt(vHat) + eps);
-            }
-
-            for(size_t i = 0; i < grad.halfKAGradients.bias.size; i++) {
-                trainingSession.mHalfKPBiases[i] = b1 * trainingSession.mHalfKPBiases[i] + (1.0 - b1) * grad.halfKAGradients.bias(i);
-                trainingSession.vHalfKPBiases[i] = b2 * trainingSession.vHalfKPBiases[i] + (1.0 - b2) * grad.halfKAGradients.bias(i) * grad.halfKAGradients.bias(i);
-
-                double mHat = trainingSession.mHalfKPBiases[i] / (1.0 - std::pow(b1, trainingSession.epoch + 1));
-                double vHat = trainingSession.vHalfKPBiases[i] / (1.0 - std::pow(b2, trainingSession.epoch + 1));
-
-                masterWeights.halfKAv2Layer.bias(i) = masterWeights.halfKAv2Layer.bias(i) * (1.0 - learningRate * wd) 
-                    - learningRate * mHat / (std::sqrt(vHat) + eps);
-            }
-
-            // REN-Layer
+            adam.update(masterWeights.halfKAv2Layer.bias.data(), trainingSession.mHalfKPBiases.data(), trainingSession.vHalfKPBiases.data(),
+                        grad.halfKAGradients.bias.data(), grad.halfKAGradients.bias.size);
 
+            // REN-Layer: Jeder Block der Surrogat-Gewichte hat eigene Momente
+            size_t qOffset = 0;
             for(size_t k = 0; k < grad.renGradients.q.size(); k++) {
-                for(size_t i = 0; i < grad.renGradients.q[k].size; i++) {
-                    trainingSession.mRENQWeights[i] = b1 * trainingSession.mRENQWeights[i] + (1.0 - b1) * grad.renGradients.q[k](i);
-                    trainingSession.vRENQWeights[i] = b2 * trainingSession.vRENQWeights[i] + (1.0 - b2) * grad.renGradients.q[k](i) * grad.renGradients.q[k](i);
+                adam.update(masterWeights.renLayer.surrogateWeights.q[k].data(), trainingSession.mRENQWeights.data() + qOffset,
+                            trainingSession.vRENQWeights.data() + qOffset, grad.renGradients.q[k].data(), grad.renGradients.q[k].size);
 
-                    double mHat = trainingSession.mRENQWeights[i] / (1.0 - std::pow(b1, trainingSession.epoch + 1));
-                    double vHat = trainingSession.vRENQWeights[i] / (1.0 - std::pow(b2, trainingSession.epoch + 1));
-
-                    masterWeights.renLayer.surrogateWeights.q[k](i) = masterWeights.renLayer.surrogateWeights.q[k](i) * (1.0 - learningRate * wd) 
-                        - learningRate * mHat / (std::sqrt(vHat) + eps);
-                }
+                qOffset += grad.renGradients.q[k].size;
             }
 
-            for(size_t i = 0; i < grad.renGradients.gammaRaw.size; i++) {
-                trainingSession.mRENGammaRawWeights[i] = b1 * trainingSession.mRENGammaRawWeights[i] + (1.0 - b1) * grad.renGradients.gammaRaw(i);
-                trainingSession.vRENGammaRawWeights[i] = b2 * trainingSession.vRENGammaRawWeights[i] + (1.0 - b2) * grad.renGradients.gammaRaw(i) * grad.renGradients.gammaRaw(i);
-
-                double mHat = trainingSession.mRENGammaRawWeights[i] / (1.0 - std::pow(b1, trainingSession.epoch + 1));
-                double vHat = trainingSession.vRENGammaRawWeights[i] / (1.0 - std::pow(b2, trainingSession.epoch + 1));
+            adam.update(masterWeights.renLayer.surrogateWeights.gammaRaw.data(), trainingSession.mRENGammaRawWeights.data(),
+                        trainingSession.vRENGammaRawWeights.data(), grad.renGradients.gammaRaw.data(), grad.renGradients.gammaRaw.size);
 
-                masterWeights.renLayer.surrogateWeights.gammaRaw(i) = masterWeights.renLayer.surrogateWeights.gammaRaw(i) * (1.0 - learningRate * wd) 
-                    - learningRate * mHat / (std::sqrt(vHat) + eps);
-            }
-
-            for(size_t i = 0; i < grad.renGradients.bias.size; i++) {
-                trainingSession.mRENBiases[i] = b1 * trainingSession.mRENBiases[i] + (1.0 - b1) * grad.renGradients.bias(i);
-                trainingSession.vRENBiases[i] = b2 * trainingSession.vRENBiases[i] + (1.0 - b2) * grad.renGradients.bias(i) * grad.renGradients.bias(i);
-
-                double mHat = trainingSession.mRENBiases[i] / (1.0 - std::pow(b1, trainingSession.epoch + 1));
-                double vHat = trainingSession.vRENBiases[i] / (1.0 - std::pow(b2, trainingSession.epoch + 1));
-
-                masterWeights.renLayer.bias(i) = masterWeights.renLayer.bias(i) * (1.0 - learningRate * wd) 
-                    - learningRate * mHat / (std::sqrt(vHat) + eps);
-            }
+            adam.update(masterWeights.renLayer.bias.data(), trainingSession.mRENBiases.data(), trainingSession.vRENBiases.data(),
+                        grad.renGradients.bias.data(), grad.renGradients.bias.size);
 
             masterWeights.renLayer.constructTransform();
             masterWeights.renLayer.normalize(maxSpectralRadius.get<double>());
 
             // Output-Layer
+            adam.update(masterWeights.outputLayer.weights.data(), trainingSession.mOutputWeights.data(), trainingSession.vOutputWeights.data(),
+                        grad.outputLayerGradients.weights.data(), grad.outputLayerGradients.weights.size);
 
-            for(size_t i = 0; i < grad.outputLayerGradients.weights.size; i++) {
-                trainingSession.mOutputWeights[i] = b1 * trainingSession.mOutputWeights[i] + (1.0 - b1) * grad.outputLayerGradients.weights(i);
-                trainingSession.vOutputWeights[i] = b2 * trainingSession.vOutputWeights[i] + (1.0 - b2) * grad.outputLayerGradients.weights(i) * grad.outputLayerGradients.weights(i);
-
-                double mHat = trainingSession.mOutputWeights[i] / (1.0 - std::pow(b1, trainingSession.epoch + 1));
-                double vHat = trainingSession.vOutputWeights[i] / (1.0 - std::pow(b2, trainingSession.epoch + 1));
-
-                masterWeights.outputLayer.weights(i) = masterWeights.outputLayer.weights(i) * (1.0 - learningRate * wd) 
-                    - learningRate * mHat / (std::sqrt(vHat) + eps);
-            }
-
-            for(size_t i = 0; i < grad.outputLayerGradients.bias.size; i++) {
-                trainingSession.mOutputBiases[i] = b1 * trainingSession.mOutputBiases[i] + (1.0 - b1) * grad.outputLayerGradients.bias(i);
-                trainingSession.vOutputBiases[i] = b2 * trainingSession.vOutputBiases[i] + (1.0 - b2) * grad.outputLayerGradients.bias(i) * grad.outputLayerGradients.bias(i);
-
-                double mHat = trainingSession.mOutputBiases[i] / (1.0 - std::pow(b1, trainingSession.epoch + 1));
-                double vHat = trainingSession.vOutputBiases[i] / (1.0 - std::pow(b2, trainingSession.epoch + 1));
-
-                masterWeights.outputLayer.bias(i) = masterWeights.outputLayer.bias(i) * (1.0 - learningRate * wd) 
-                    - learningRate * mHat / (std::sqrt(vHat) + eps);
-            }
+            adam.update(masterWeights.outputLayer.bias.data(), trainingSession.mOutputBiases.data(), trainingSession.vOutputBiases.data(),
+                        grad.outputLayerGradients.bias.data(), grad.outputLayerGradients.bias.size);
         }
     }
 
     // Berechne den finalen Fehler
-    auto [masterLossExact, avgIterations, minIterations, maxIterations] = Train::loss(validationData, masterWeights, k.get<double>(), kappa, encLossWeight);
-    float loss0It = Train::loss(validationData, masterWeights, k.get<double>(), kappa, 0.0, 0).loss;
-    float loss2It = Train::loss(validationData, masterWeights, k.get<double>(), kappa, 0.0, 2).loss;
-    float lossOpt = Train::loss(validationData, masterWeights, k.get<double>(), kappa, 0.0).loss;
+    auto [masterLossExact, avgIterations, minIterations, maxIterations] = Train::loss(validationSamples, masterWeights, k.get<double>(), kappa, encLossWeight);
+    float loss0It = Train::loss(validationSamples, masterWeights, k.get<double>(), kappa, 0.0, 0).loss;
+    float loss2It = Train::loss(validationSamples, masterWeights, k.get<double>(), kappa, 0.0, 2).loss;
+    float lossOpt = Train::loss(validationSamples, masterWeights, k.get<double>(), kappa, 0.0).loss;
     float spectralRadius = masterWeights.renLayer.spectralRadius();
     
     std::cout << "\rEpoch: " << std::left << std::setw(6) << trainingSession.epoch;
@@ -2,11 +2,14 @@
 #define REN_TRAIN_H
 
 #include "core/utils/nnue/NNUENetwork.h"
+#include "tune/DataLoader.h"
 #include "tune/Definitions.h"
 #include "tune/EloTable.h"
 #include "tune/ren/RENMasterWeights.h"
 
+#include <cstring>
 #include <fstream>
+#include <stdint.h>
 #include <vector>
 
 namespace Train {
@@ -50,7 +53,24 @@ namespace Train {
         inline TrainingSession() = default;
     };
 
+    /**
+     * @brief Der Kopf einer gespeicherten Trainingssession. Ältere Dateien ohne
+     * Kopf speichern die HalfKP-Gewichte transponiert und werden abgelehnt.
+     */
+    struct TrainingSessionHeader {
+        char magic[4];
+        uint32_t version;
+
+        static constexpr char MAGIC[4] = {'C', 'E', 'R', 'S'};
+        static constexpr uint32_t VERSION = 1;
+    };
+
     inline std::ostream& operator<<(std::ostream& os, const TrainingSession& session) {
+        TrainingSessionHeader header{};
+        std::memcpy(header.magic, TrainingSessionHeader::MAGIC, sizeof(header.magic));
+        header.version = TrainingSessionHeader::VERSION;
+        os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
         os.write(reinterpret_cast<const char*>(&session.generation), sizeof(session.generation));
         os.write(reinterpret_cast<const char*>(&session.epoch), sizeof(session.epoch));
         os.write(reinterpret_cast<const char*>(&session.averageLoss), sizeof(session.averageLoss));
@@ -105,7 +125,19 @@ namespace Train {
         return os;
     };
 
+    /**
+     * @brief Lädt eine Trainingssession. Passt der Kopf nicht zu dieser Version,
+     * wird nichts geladen und das failbit des Streams gesetzt.
+     */
     inline std::istream& operator>>(std::istream& is, TrainingSession& session) {
+        TrainingSessionHeader header;
+        if(!is.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+           std::memcmp(header.magic, TrainingSessionHeader::MAGIC, sizeof(header.magic)) != 0 ||
+           header.version != TrainingSessionHeader::VERSION) {
+            is.setstate(std::ios::failbit);
+            return is;
+        }
+
         is.read(reinterpret_cast<char*>(&session.generation), sizeof(session.generation));
         is.read(reinterpret_cast<char*>(&session.epoch), sizeof(session.epoch));
         is.read(reinterpret_cast<char*>(&session.averageLoss), sizeof(session.averageLoss));
@@ -202,23 +234,20 @@ namespace Train {
      * @param maxIterations Die maximale Anzahl von Iterationen für die Berechnung.
      * @return double Der mittlere quadratische Fehler.
      */
-    LossSummary loss(const std::vector<DataPoint>& data, const REN::MasterWeights& masterWeights, double k,
+    LossSummary loss(const std::vector<TrainingSample>& data, const REN::MasterWeights& masterWeights, double k,
         double kappa, double encLossWeight, size_t maxIterations = std::numeric_limits<size_t>::max());
 
     /**
-     * @brief Berechnet den Gradienten des MSE eines unquantisierten Parametersatzes auf einem Datensatz.
-     * Zusätzlich werden die Indizes der Datenpunkte übergeben,
-     * die für die Berechnung des Gradienten verwendet werden sollen.
+     * @brief Berechnet den Gradienten des MSE eines unquantisierten Parametersatzes auf einem Batch.
      * 
-     * @param data Der Datensatz.
-     * @param indices Die Indizes der Datenpunkte, die für die Berechnung des Gradienten verwendet werden sollen.
+     * @param batch Die Datenpunkte des Batches.
      * @param masterWeights Die unquantisierten Parameter des Netzwerks.
      * @param k Der Faktor, der mit dem Bewertungswert innerhalb der tanh-Funktion multipliziert wird.
      * @param kappa Bestimmt, wie stark das finale Ergebnis in das TD-Ziel einfließen soll.
      * @param encLossWeight Bestimmt, wie stark der Fehler des Encodings in den finalen Fehler einfließen soll.
-     * @return std::vector<float> Der Gradient.
+     * @param totalGrad Wird mit dem Gradienten überschrieben.
      */
-    REN::Gradients gradient(const std::vector<DataPoint>& data, const std::vector<size_t>& indices, const REN::MasterWeights& masterWeights, double k, double kappa, double encLossWeight);
+    void gradient(const std::vector<TrainingSample>& batch, const REN::MasterWeights& masterWeights, double k, double kappa, double encLossWeight, REN::Gradients& totalGrad);
 
     /**
      * @brief Verbessert die Parameter eines HCE-Modells über den AdamW-Algorithmus.
@@ -231,6 +260,19 @@ namespace Train {
      */
     void adamW(std::vector<DataPoint>& data, size_t numEpochs, double learningRate, double kappa, double encLossWeight);
 
+    /**
+     * @brief Verbessert die Parameter eines REN-Modells über den AdamW-Algorithmus.
+     * Die Trainingsdaten werden dabei von einem Datenlader bereitgestellt.
+     * 
+     * @param loader Der Datenlader für die Trainingsdaten.
+     * @param validationData Die Validierungsdaten.
+     * @param numEpochs Die Anzahl der Epochen.
+     * @param learningRate Die Lernrate.
+     * @param kappa Bestimmt, wie stark das finale Ergebnis in das Ziel einfließen soll.
+     * @param encLossWeight Bestimmt, wie stark der Fehler des Encodings in den finalen Fehler einfließen soll.
+     */
+    void adamW(DataLoader& loader, std::vector<DataPoint>& validationData, size_t numEpochs, double learningRate, double kappa, double encLossWeight);
+
     /**
      * @brief Initialisiert die Master-Parameter des REN.
      * Die HalfKAv2_hm- und Dense-Layer werden mit der Kaiming-Initialisierung initialisiert.
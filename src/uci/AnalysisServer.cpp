@@ -0,0 +1,326 @@
+#include "uci/AnalysisServer.h"
+
+#if not defined(DISABLE_THREADS)
+
+#include "core/engine/search/PVSEngine.h"
+#include "core/utils/MoveNotations.h"
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    /**
+     * @brief Überprüft, ob ein Token eine Grenze oder Option einer Anfrage einleitet.
+     */
+    bool isLimitToken(const std::string& token) {
+        return token == "depth" || token == "nodes" || token == "movetime" || token == "multipv";
+    }
+
+    struct AnalysisRequest {
+        std::string id;
+        Board board;
+        UCI::SearchParams params;
+        size_t multiPV = 1;
+
+        /**
+         * @brief Die Generation des Servers beim Eingang der Anfrage.
+         * Anfragen aus einer älteren Generation wurden abgebrochen.
+         */
+        uint64_t generation = 0;
+    };
+
+    struct AnalysisWorker {
+        Board board;
+        PVSEngine engine;
+        std::thread thread;
+
+        /**
+         * @brief Die Generation der Anfrage, die gerade bearbeitet wird.
+         */
+        uint64_t generation = 0;
+
+        AnalysisWorker() : engine(board, 2, nullptr, false) {}
+    };
+
+    class AnalysisServer {
+        private:
+            std::ostream& os;
+            std::vector<std::unique_ptr<AnalysisWorker>> workers;
+            std::unique_ptr<TranspositionTable> sharedTable;
+
+            std::deque<AnalysisRequest> queue;
+            std::mutex queueMutex;
+            std::condition_variable queueCondition;
+            bool closing = false;
+
+            /**
+             * @brief Wird bei jedem Abbruch erhöht (siehe AnalysisRequest::generation).
+             */
+            Atomic<uint64_t> generation = 0;
+
+            std::mutex outputMutex;
+
+            void workerLoop(AnalysisWorker& worker);
+            void analyse(AnalysisWorker& worker, AnalysisRequest& request);
+
+        public:
+            AnalysisServer(std::ostream& os, size_t numWorkers, size_t hashSize, bool sharedHash);
+            ~AnalysisServer();
+
+            /**
+             * @brief Liest eine Anfrage und stellt sie in die Warteschlange.
+             *
+             * @return false, wenn die Anfrage ungültig ist.
+             */
+            bool enqueue(const std::string& args);
+
+            /**
+             * @brief Verwirft alle wartenden Anfragen und bricht die laufenden Suchen ab.
+             */
+            void stop();
+
+            void printLine(const std::string& line);
+    };
+
+    AnalysisServer::AnalysisServer(std::ostream& os, size_t numWorkers, size_t hashSize, bool sharedHash) : os(os) {
+        numWorkers = std::max(numWorkers, (size_t)1);
+
+        if(sharedHash)
+            sharedTable = std::make_unique<TranspositionTable>(hashSize * (1 << 20) / TT_ENTRY_SIZE);
+
+        for(size_t i = 0; i < numWorkers; i++) {
+            std::unique_ptr<AnalysisWorker> worker = std::make_unique<AnalysisWorker>();
+            worker->engine.setNumThreads(1);
+
+            if(sharedHash)
+                worker->engine.setSharedHashTable(sharedTable.get());
+            else
+                worker->engine.setHashTableCapacity(hashSize * (1 << 20) / numWorkers / TT_ENTRY_SIZE);
+
+            // Bricht die Suche ab, sobald ihre Anfrage abgebrochen wurde
+            AnalysisWorker* workerPtr = worker.get();
+            worker->engine.setCheckupCallback([this, workerPtr]() {
+                if(workerPtr->generation != generation.load())
+                    workerPtr->engine.stop();
+            });
+
+            workers.push_back(std::move(worker));
+        }
+
+        for(std::unique_ptr<AnalysisWorker>& worker : workers)
+            worker->thread = std::thread(&AnalysisServer::workerLoop, this, std::ref(*worker));
+    }
+
+    AnalysisServer::~AnalysisServer() {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            closing = true;
+        }
+
+        queueCondition.notify_all();
+
+        for(std::unique_ptr<AnalysisWorker>& worker : workers)
+            worker->thread.join();
+    }
+
+    void AnalysisServer::workerLoop(AnalysisWorker& worker) {
+        while(true) {
+            AnalysisRequest request;
+
+            {
+                std::unique_lock<std::mutex> lock(queueMutex);
+                queueCondition.wait(lock, [this]() { return closing || !queue.empty(); });
+
+                if(queue.empty())
+                    return;
+
+                request = std::move(queue.front());
+                queue.pop_front();
+            }
+
+            if(request.generation == generation.load())
+                analyse(worker, request);
+        }
+    }
+
+    void AnalysisServer::analyse(AnalysisWorker& worker, AnalysisRequest& request) {
+        worker.board = request.board;
+        worker.generation = request.generation;
+        worker.engine.setMultiPV(request.multiPV);
+        worker.engine.search(request.params);
+
+        // Abgebrochene Suchen liefern kein verwertbares Ergebnis
+        if(worker.generation != generation.load()) {
+            printLine("result id " + request.id + " aborted");
+            return;
+        }
+
+        std::ostringstream ss;
+        std::vector<Variation> variations = worker.engine.getVariations();
+
+        for(size_t i = 0; i < variations.size(); i++) {
+            const Variation& variation = variations[i];
+
+            ss << "info id " << request.id << " multipv " << i + 1 << " depth " << variation.depth <<
+                  " seldepth " << variation.selectiveDepth << " score ";
+
+            if(isMateScore(variation.score))
+                ss << "mate " << (variation.score > 0 ? isMateIn(variation.score) : -isMateIn(variation.score));
+            else
+                ss << "cp " << variation.score;
+
+            ss << " pv";
+            for(Move move : variation.moves)
+                ss << " " << move.toString();
+
+            ss << "\n";
+        }
+
+        ss << "result id " << request.id << " bestmove " << worker.engine.getBestMove().toString() <<
+              " nodes " << worker.engine.getNodesSearched() << " time " << worker.engine.getElapsedTime();
+
+        printLine(ss.str());
+    }
+
+    bool AnalysisServer::enqueue(const std::string& args) {
+        std::istringstream ss(args);
+        AnalysisRequest request;
+        std::string token;
+
+        if(!(ss >> request.id)) {
+            printLine("error Missing request id");
+            return false;
+        }
+
+        auto error = [&](const std::string& message) {
+            printLine("error id " + request.id + " " + message);
+            return false;
+        };
+
+        ss >> token;
+        if(token == "fen") {
+            std::string fen;
+            while(ss >> token && token != "moves" && !isLimitToken(token))
+                fen += token + " ";
+
+            // Die Anfrage endet mit der FEN
+            if(!ss)
+                token.clear();
+
+            try { request.board = Board(fen); }
+            catch(std::invalid_argument& e) { return error(e.what()); }
+        } else if(token == "startpos") {
+            request.board = Board();
+            if(!(ss >> token))
+                token.clear();
+        } else
+            return error("Expected startpos or fen");
+
+        if(token == "moves") {
+            while(ss >> token && !isLimitToken(token)) {
+                Move move = fromUCINotation(token, request.board);
+                if(!move.exists())
+                    return error("Invalid move " + token);
+
+                request.board.makeMove(move);
+            }
+
+            // Die Anfrage endet mit den Zügen
+            if(!ss)
+                token.clear();
+        }
+
+        bool hasLimit = false;
+        do {
+            try {
+                if(token == "depth") {
+                    ss >> token;
+                    request.params.depth = std::stoi(token);
+                    hasLimit = true;
+                } else if(token == "nodes") {
+                    ss >> token;
+                    request.params.nodes = std::stoull(token);
+                    hasLimit = true;
+                } else if(token == "movetime") {
+                    ss >> token;
+                    request.params.movetime = std::stoul(token);
+                    request.params.useMovetime = true;
+                    hasLimit = true;
+                } else if(token == "multipv") {
+                    ss >> token;
+                    request.multiPV = std::max(std::stoull(token), 1ULL);
+                } else if(!token.empty())
+                    return error("Unknown token " + token);
+            } catch(std::exception&) {
+                return error("Invalid value " + token);
+            }
+
+            token.clear();
+        } while(ss >> token);
+
+        if(!hasLimit)
+            request.params.depth = DEFAULT_ANALYSIS_DEPTH;
+
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            request.generation = generation.load();
+            queue.push_back(std::move(request));
+        }
+
+        queueCondition.notify_one();
+        return true;
+    }
+
+    void AnalysisServer::stop() {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            queue.clear();
+            generation.fetch_add(1);
+        }
+
+        for(std::unique_ptr<AnalysisWorker>& worker : workers)
+            worker->engine.stop();
+    }
+
+    void AnalysisServer::printLine(const std::string& line) {
+        std::lock_guard<std::mutex> lock(outputMutex);
+        os << line << std::endl;
+    }
+}
+
+void runAnalysisServer(std::istream& is, std::ostream& os, size_t numWorkers, size_t hashSize, bool sharedHash) {
+    AnalysisServer server(os, numWorkers, hashSize, sharedHash);
+    server.printLine("info string Analysis server with " + std::to_string(std::max(numWorkers, (size_t)1)) + " workers and " +
+                     std::to_string(hashSize) + "MB " + (sharedHash ? "shared" : "private") + " hash");
+
+    std::string line;
+    while(std::getline(is, line)) {
+        std::istringstream ss(line);
+        std::string command;
+        ss >> command;
+
+        if(command == "analyse") {
+            std::string args;
+            std::getline(ss, args);
+            server.enqueue(args);
+        } else if(command == "stop")
+            server.stop();
+        else if(command == "isready")
+            server.printLine("readyok");
+        else if(command == "quit") {
+            server.stop();
+            break;
+        }
+    }
+
+    // Am Ende der Eingabe wartet der Destruktor, bis alle wartenden Anfragen
+    // bearbeitet wurden. Nach quit ist die Warteschlange bereits leer.
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,46 @@
+#ifndef ANALYSIS_SERVER_H
+#define ANALYSIS_SERVER_H
+
+#include <istream>
+#include <ostream>
+#include <stddef.h>
+
+/**
+ * @brief Analysiert einen Strom von Positionen mit einem festen Pool an
+ * Workern. Jeder Worker besitzt eine eigene Engine mit einem Suchthread.
+ * Die Anfragen werden in der Reihenfolge ihres Eingangs auf die freien
+ * Worker verteilt und die Ergebnisse ausgegeben, sobald sie fertig sind.
+ *
+ * Anfragen (eine pro Zeile):
+ * analyse <id> startpos|fen <FEN> [moves <Züge>] [depth <n>] [nodes <n>] [movetime <ms>] [multipv <n>]
+ * stop: Verwirft alle wartenden Anfragen und bricht die laufenden Suchen ab.
+ * Für abgebrochene Suchen wird nur "result id <id> aborted" ausgegeben.
+ * isready: Antwortet mit readyok.
+ * quit: Wie stop, beendet danach den Server, ohne auf wartende Anfragen zu warten.
+ *
+ * Am Ende der Eingabe werden alle wartenden Anfragen abgearbeitet.
+ * Ohne Grenzen wird bis zur Tiefe DEFAULT_ANALYSIS_DEPTH gesucht.
+ *
+ * Beispiele:
+ * analyse a fen r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3
+ * analyse b startpos moves e2e4
+ * analyse c startpos moves e2e4 e7e5 depth 12 multipv 3
+ *
+ * Ausgabe pro Anfrage (zusammenhängend):
+ * info id <id> multipv <k> depth <d> seldepth <s> score cp <x>|mate <n> pv <Züge>
+ * result id <id> bestmove <Zug> nodes <n> time <ms>
+ * bzw. error id <id> <Beschreibung>
+ *
+ * @param numWorkers Die Anzahl der Worker.
+ * @param hashSize Die Größe der Transpositionstabelle in MB. Ohne geteilte
+ * Tabelle erhält jeder Worker einen entsprechenden Anteil.
+ * @param sharedHash Bestimmt, ob sich alle Worker eine Transpositionstabelle teilen.
+ */
+void runAnalysisServer(std::istream& is, std::ostream& os, size_t numWorkers, size_t hashSize, bool sharedHash);
+
+/**
+ * @brief Die Suchtiefe von Anfragen ohne Grenzen.
+ */
+static constexpr int DEFAULT_ANALYSIS_DEPTH = 10;
+
+#endif
\ No newline at end of file
@@ -1,13 +1,19 @@
 #include "core/engine/search/PVSEngine.h"
+#include "core/utils/MoveNotations.h"
 
+#include "uci/AnalysisServer.h"
 #include "uci/Options.h"
 #include "uci/PortabilityHelper.h"
 #include "uci/UCI.h"
 
+#include "test/Bench.h"
 #include "test/Perft.h"
+#include "test/TestMagics.h"
+#include "test/TimeManagerReplay.h"
 
 #include <iostream>
 #include <sstream>
+#include <string_view>
 #include <thread>
 
 Board board;
@@ -25,6 +31,7 @@ UCI::Options UCI::options = {
         UCI::Option("Threads", "1", "1", "512"),
     #endif
     UCI::Option("MultiPV", "1", "1", "256"),
+    UCI::Option("Move Overhead", "10", "0", "5000"),
     UCI::Option("Ponder", "false")
 };
 
@@ -35,6 +42,13 @@ UCI::Options UCI::options = {
 bool quitFlag = false;
 bool debug = false;
 
+/**
+ * @brief Die Ausgangsstellung des letzten position-Befehls ("startpos"
+ * oder die FEN) und der Hashwert der daraus erreichten Stellung.
+ */
+std::string positionBase;
+uint64_t positionHash = 0;
+
 void readAndHandleNextCommand(std::istream& is);
 
 std::string getNextToken(std::istream& is);
@@ -50,6 +64,9 @@ void handlePositionCommand(std::string args);
 void handleGoCommand(std::string args);
 void handleStopCommand();
 void handlePonderHitCommand();
+void handleBenchCommand(std::string args);
+void handleSearchStatsCommand();
+void handleServerCommand(std::string args);
 
 // struct stringbuf :
 
@@ -105,6 +122,12 @@ void readAndHandleNextCommand(std::istream& is) {
         handleSetOptionCommand(getNextLine(is));
     else if(command == "register")
         handleRegisterCommand();
+    else if(command == "bench")
+        handleBenchCommand(getNextLine(is));
+    else if(command == "searchstats")
+        handleSearchStatsCommand();
+    else if(command == "server")
+        handleServerCommand(getNextLine(is));
     else if(command == "quit")
         quitFlag = true;
 }
@@ -158,6 +181,8 @@ void handleDebugCommand(std::string args) {
         debug = true;
     else
         debug = false;
+
+    engine.setDebugOutput(debug);
 }
 
 void handleIsReadyCommand() {
@@ -180,13 +205,19 @@ void handleSetOptionCommand(std::string args) {
     std::string name;
     std::string value;
 
+    // Optionsnamen können aus mehreren Wörtern bestehen (z.B. "Move Overhead")
+    bool readingName = false;
+
     while(ss.good()) {
         token = getNextToken(ss);
 
         if(token == "name")
-            name = getNextToken(ss);
-        else if(token == "value")
+            readingName = true;
+        else if(token == "value") {
+            readingName = false;
             value = getNextToken(ss);
+        } else if(readingName && !token.empty())
+            name += name.empty() ? token : " " + token;
     }
 
     try {
@@ -223,6 +254,51 @@ void handleUCINewGameCommand() {
     engine.clearHashTable();
 }
 
+/**
+ * @brief Gibt das nächste durch Leerzeichen getrennte Token zurück
+ * und entfernt es (und die führenden Leerzeichen) aus str.
+ */
+std::string_view popToken(std::string_view& str) {
+    size_t begin = str.find_first_not_of(" \t\r\n");
+    if(begin == std::string_view::npos) {
+        str = {};
+        return {};
+    }
+
+    size_t end = std::min(str.find_first_of(" \t\r\n", begin), str.size());
+    std::string_view token = str.substr(begin, end - begin);
+    str.remove_prefix(end);
+
+    return token;
+}
+
+/**
+ * @brief Führt Züge in UCI-Notation auf einem Spielfeld aus.
+ * 
+ * @param numMoves Die Anzahl der ausgeführten Züge. Bei einem
+ * ungültigen Zug bleiben die vorherigen Züge ausgeführt.
+ * @return false, wenn ein Zug ungültig war.
+ */
+bool makeUCIMoves(Board& b, std::string_view moves, size_t& numMoves) {
+    numMoves = 0;
+
+    for(std::string_view token = popToken(moves); !token.empty(); token = popToken(moves)) {
+        Move move = fromUCINotation(token, b);
+
+        if(!move.exists()) {
+            if(debug)
+                std::cout << "info string Invalid move: " << token << std::endl;
+
+            return false;
+        }
+
+        b.makeMove(move);
+        numMoves++;
+    }
+
+    return true;
+}
+
 void handlePositionCommand(std::string args) {
     if(engine.isSearching())
         return;
@@ -230,72 +306,88 @@ void handlePositionCommand(std::string args) {
     if(debug)
         std::cout << "info string Received position " << args << std::endl;
 
-    std::stringstream ss(args + "\n"); // Füge ein Zeilenende hinzu, damit getNextToken() "funktioniert"
-    std::string moves;
-
-    std::string token;
+    std::string_view rest = args;
+    std::string_view token = popToken(rest);
+    std::string base;
 
-    Board temp = board;
-    
     // Read FEN
-    token = getNextToken(ss);
-
     if(token == "fen") {
-        std::string fen;
+        for(token = popToken(rest); !token.empty() && token != "moves"; token = popToken(rest)) {
+            if(!base.empty())
+                base += ' ';
 
-        while(ss.good() && !((token = getNextToken(ss)) == "moves"))
-            fen += " " + token;
+            base += token;
+        }
 
         if(debug)
-            std::cout << "info string fen: " << fen << std::endl;
-
-        try { temp = Board(fen); }
-        catch(std::invalid_argument& e) {
-            if(debug)
-                std::cout << "info string " << e.what() << std::endl;
-
-            return;
-        }
+            std::cout << "info string fen: " << base << std::endl;
     } else if(token == "startpos") {
         if(debug)
             std::cout << "info string startpos" << std::endl;
 
-        temp = Board();
-
-        token = getNextToken(ss);
-    }
+        base = "startpos";
+        token = popToken(rest);
+    } else
+        return;
 
     // Read moves
-    if(token == "moves")
-        moves = getNextLine(ss);
+    std::string_view moves = token == "moves" ? rest : std::string_view();
 
-    if(!moves.empty()) {
-        std::stringstream ss(moves + " "); // Füge ein Leerzeichen hinzu, damit getNextToken() "funktioniert"
-        std::string moveStr;
+    // Setzt der Befehl die aktuelle Partie fort (gleiche Ausgangsstellung und
+    // die bisherigen Züge stimmen überein), werden nur die neuen Züge ausgeführt.
+    // Weicht die Zugfolge ab, werden die Züge bis zur Abweichung zurückgenommen.
+    if(base == positionBase && board.getHashValue() == positionHash) {
+        const MoveHistory& history = board.getMoveHistory();
+        size_t commonPly = 0;
 
-        while(ss.good()) {
-            moveStr = getNextToken(ss);
+        for(; commonPly < history.size(); commonPly++) {
+            std::string_view next = moves;
+            if(!matchesUCINotation(history[commonPly].move, popToken(next)))
+                break;
 
-            Move move;
-            for(Move m : temp.generateLegalMoves()) {
-                if(m.toString() == moveStr) {
-                    move = m;
-                    break;
-                }
-            }
+            moves = next;
+        }
 
-            if(!temp.isMoveLegal(move)) {
-                if(debug)
-                    std::cout << "info string Invalid move: " << moveStr << std::endl;
+        std::vector<Move> undoneMoves;
+        while(history.size() > commonPly) {
+            undoneMoves.push_back(board.getLastMove());
+            board.undoMove();
+        }
 
-                return;
-            }
+        size_t numMoves;
+        if(!makeUCIMoves(board, moves, numMoves)) {
+            // Stelle die vorherige Stellung wieder her
+            for(size_t i = 0; i < numMoves; i++)
+                board.undoMove();
+
+            for(auto it = undoneMoves.rbegin(); it != undoneMoves.rend(); it++)
+                board.makeMove(*it);
 
-            temp.makeMove(move);
+            return;
+        }
+
+        positionHash = board.getHashValue();
+        return;
+    }
+
+    Board temp;
+    if(base != "startpos") {
+        try { temp = Board(base); }
+        catch(std::invalid_argument& e) {
+            if(debug)
+                std::cout << "info string " << e.what() << std::endl;
+
+            return;
         }
     }
 
+    size_t numMoves;
+    if(!makeUCIMoves(temp, moves, numMoves))
+        return;
+
     board = temp;
+    positionBase = std::move(base);
+    positionHash = board.getHashValue();
 }
 
 void handleGoCommand(std::string args) {
@@ -324,6 +416,41 @@ void handleGoCommand(std::string args) {
             return;
         }
 
+        if(token == "magics") {
+            // go magics [Anzahl der Lookups]
+            size_t count = 1 << 26;
+
+            token = getNextToken(ss);
+            if(!token.empty())
+                count = std::stoull(token);
+
+            testAllRookMagics();
+            testAllBishopMagics();
+            benchmarkSliderLookups(count);
+            return;
+        }
+
+        if(token == "replay") {
+            // go replay <Datei> [Bedenkzeit] [Inkrement] [Verzögerung]
+            std::string filename = getNextToken(ss);
+            uint32_t time = 10000, increment = 100, lag = 0;
+
+            token = getNextToken(ss);
+            if(!token.empty())
+                time = std::stoul(token);
+
+            token = getNextToken(ss);
+            if(!token.empty())
+                increment = std::stoul(token);
+
+            token = getNextToken(ss);
+            if(!token.empty())
+                lag = std::stoul(token);
+
+            printReplayResults(filename, time, increment, lag);
+            return;
+        }
+
         if(token == "depth")
             params.depth = std::stoul(getNextToken(ss));
         else if(token == "nodes")
@@ -340,7 +467,7 @@ void handleGoCommand(std::string args) {
             while(ss.good()) {
                 Move move;
                 for(Move m : legalMoves) {
-                    if(m.toString() == token) {
+                    if(matchesUCINotation(m, token)) {
                         move = m;
                         break;
                     }
@@ -433,4 +560,75 @@ void handleStopCommand() {
 void handlePonderHitCommand() {
     if(debug)
         std::cout << "info string Received ponderhit" << std::endl;
+
+    // Ab jetzt gilt die reguläre Zeitkontrolle.
+    engine.setPondering(false);
+}
+
+void handleBenchCommand(std::string args) {
+    if(engine.isSearching())
+        return;
+
+    if(debug)
+        std::cout << "info string Received bench " << args << std::endl;
+
+    // bench [Tiefe] [Threads] [Hash in MB]
+    std::stringstream ss(args + "\n");
+    int depth = 10;
+    size_t numThreads = 1, hashSize = 16;
+
+    std::string token = getNextToken(ss);
+    if(!token.empty())
+        depth = std::stoi(token);
+
+    token = getNextToken(ss);
+    if(!token.empty())
+        numThreads = std::stoull(token);
+
+    token = getNextToken(ss);
+    if(!token.empty())
+        hashSize = std::stoull(token);
+
+    printBenchResults(depth, numThreads, hashSize);
+}
+
+void handleSearchStatsCommand() {
+    if(engine.isSearching())
+        return;
+
+    #if defined(SEARCH_STATS)
+        engine.getSearchStatistics().print(std::cout);
+    #else
+        std::cout << "info string Search statistics are disabled (build with SEARCH_STATS=1)" << std::endl;
+    #endif
+}
+
+void handleServerCommand(std::string args) {
+    if(engine.isSearching())
+        return;
+
+    #if not defined(DISABLE_THREADS)
+        // server [Worker] [Hash in MB] [shared|private]
+        std::stringstream ss(args + "\n");
+        size_t numWorkers = std::max(std::thread::hardware_concurrency(), 1u), hashSize = 256;
+        bool sharedHash = true;
+
+        std::string token = getNextToken(ss);
+        if(!token.empty())
+            numWorkers = std::stoull(token);
+
+        token = getNextToken(ss);
+        if(!token.empty())
+            hashSize = std::stoull(token);
+
+        token = getNextToken(ss);
+        if(!token.empty())
+            sharedHash = token != "private";
+
+        runAnalysisServer(std::cin, std::cout, numWorkers, hashSize, sharedHash);
+        quitFlag = true;
+    #else
+        (void)args;
+        std::cout << "info string The analysis server requires threads" << std::endl;
+    #endif
 }
\ No newline at end of file